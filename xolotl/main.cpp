@@ -212,7 +212,10 @@ int main(int argc, char **argv) {
 	// with overlapping Timer scopes.
 	// We do this before our own parsing of the command line,
 	// because it may change the command line.
-	MPI_Init(&argc, &argv);
+	// The asynchronous checkpoint writer needs MPI_THREAD_MULTIPLE,
+	// it falls back to synchronous writes if it is not provided.
+	int threadSupport;
+	MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &threadSupport);
 
 	try {
 		// Check the command line arguments.
@@ -110,7 +110,8 @@ BOOST_AUTO_TEST_CASE(goodParamFile) {
 			<< std::endl << "voidPortion=60.0" << std::endl << "regularGrid=no"
 			<< std::endl << "process=diff" << std::endl << "grouping=11 2 4"
 			<< std::endl << "sputtering=0.5" << std::endl << "boundary=1 1"
-			<< std::endl << "burstingDepth=5.0" << std::endl << "zeta=0.6" << std::endl;
+			<< std::endl << "burstingDepth=5.0" << std::endl << "zeta=0.6"
+			<< std::endl << "compression=shuffle deflate 4" << std::endl;
 	goodParamFile.close();
 
 	string pathToFile("param_good.txt");
@@ -165,6 +166,7 @@ BOOST_AUTO_TEST_CASE(goodParamFile) {
 
 	// Check the regular grid option
 	BOOST_REQUIRE_EQUAL(opts.useRegularXGrid(), false);
+	BOOST_REQUIRE_EQUAL(opts.useAdaptiveXGrid(), false);
 
 	// Check the grouping option
 	BOOST_REQUIRE_EQUAL(opts.getGroupingMin(), 11);
@@ -188,6 +190,11 @@ BOOST_AUTO_TEST_CASE(goodParamFile) {
 	// Check the electronic stopping power option
 	BOOST_REQUIRE_EQUAL(opts.getZeta(), 0.6);
 
+	// Check the compression option
+	BOOST_REQUIRE_EQUAL(opts.useCheckpointShuffle(), true);
+	BOOST_REQUIRE_EQUAL(opts.getCheckpointDeflateLevel(), 4);
+	BOOST_REQUIRE_EQUAL(opts.getCheckpointLossyBits(), 0);
+
 	// Check the physical processes option
 	auto map = opts.getProcesses();
 	BOOST_REQUIRE_EQUAL(map["diff"], true);
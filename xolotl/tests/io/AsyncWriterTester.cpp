@@ -0,0 +1,185 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Regression
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/framework.hpp>
+#include <mpi.h>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include "xolotlCore/io/AsyncWriter.h"
+#include "xolotlCore/io/CheckpointWriter.h"
+
+using namespace std;
+using namespace xolotlCore;
+
+// Initialize MPI with the thread support the writer needs.
+struct MPIThreadFixture {
+	MPIThreadFixture(void) {
+		auto& mts = boost::unit_test::framework::master_test_suite();
+		int provided;
+		MPI_Init_thread(&mts.argc, &mts.argv, MPI_THREAD_MULTIPLE, &provided);
+	}
+
+	~MPIThreadFixture(void) {
+		MPI_Finalize();
+	}
+};
+BOOST_GLOBAL_FIXTURE(MPIThreadFixture);
+
+/**
+ * This suite is responsible for testing the AsyncWriter.
+ */
+BOOST_AUTO_TEST_SUITE(AsyncWriter_testSuite)
+
+/**
+ * Method checking that the tasks are run in order with a
+ * communicator of the same size as the one given.
+ */
+BOOST_AUTO_TEST_CASE(checkOrder) {
+
+	for (bool async : { false, true }) {
+		AsyncWriter writer(MPI_COMM_WORLD, async);
+
+		std::vector<int> written;
+		for (int i = 0; i < 5; i++) {
+			writer.submit([i, &written](MPI_Comm comm) {
+				// Make the writes slower than the submissions
+				std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				int commSize = 0;
+				MPI_Comm_size(comm, &commSize);
+				if (commSize > 0)
+					written.push_back(i);
+			});
+		}
+		writer.flush();
+
+		BOOST_REQUIRE_EQUAL(written.size(), 5);
+		for (int i = 0; i < 5; i++) {
+			BOOST_REQUIRE_EQUAL(written[i], i);
+		}
+	}
+}
+
+/**
+ * Method checking that the destruction waits for the pending tasks.
+ */
+BOOST_AUTO_TEST_CASE(checkDestruction) {
+
+	std::atomic<int> nWritten(0);
+	{
+		AsyncWriter writer(MPI_COMM_WORLD, true);
+		for (int i = 0; i < 3; i++) {
+			writer.submit([&nWritten](MPI_Comm) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				nWritten++;
+			});
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(nWritten.load(), 3);
+}
+
+/**
+ * Method checking that the writer runs the tasks without MPI when given
+ * MPI_COMM_NULL, even on the I/O thread.
+ */
+BOOST_AUTO_TEST_CASE(checkWithoutMPI) {
+
+	AsyncWriter writer(MPI_COMM_NULL, true);
+	BOOST_REQUIRE(writer.isAsync());
+
+	std::vector<int> written;
+	for (int i = 0; i < 3; i++) {
+		writer.submit([i, &written](MPI_Comm comm) {
+			if (comm == MPI_COMM_NULL)
+				written.push_back(i);
+		});
+	}
+	writer.flush();
+
+	BOOST_REQUIRE_EQUAL(written.size(), 3);
+	for (int i = 0; i < 3; i++) {
+		BOOST_REQUIRE_EQUAL(written[i], i);
+	}
+}
+
+/**
+ * Method checking that the errors of the tasks are given back.
+ */
+BOOST_AUTO_TEST_CASE(checkError) {
+
+	for (bool async : { false, true }) {
+		AsyncWriter writer(MPI_COMM_WORLD, async);
+
+		if (writer.isAsync()) {
+			writer.submit([](MPI_Comm) {
+				throw std::runtime_error("Failed to write");
+			});
+			BOOST_REQUIRE_THROW(writer.flush(), std::runtime_error);
+		} else {
+			BOOST_REQUIRE_THROW(writer.submit([](MPI_Comm) {
+				throw std::runtime_error("Failed to write");
+			}), std::runtime_error);
+		}
+
+		// The error is only given back once
+		bool written = false;
+		writer.submit([&written](MPI_Comm) {written = true;});
+		writer.flush();
+		BOOST_REQUIRE(written);
+	}
+}
+
+/**
+ * Method checking that the checkpoint writer keeps its files open
+ * across the tasks and closes them when destroyed.
+ */
+BOOST_AUTO_TEST_CASE(checkCheckpointWriter) {
+
+	const std::vector<std::string> testFileNames = {
+			"test_checkpoint_writer.h5", "test_checkpoint_writer_analysis.h5" };
+	for (bool async : { false, true }) {
+		// Create the files
+		for (auto const& testFileName : testFileNames) {
+			std::vector<double> grid = { 0.0, 0.5, 1.0, 1.5 };
+			XFile::HeaderGroup::NetworkCompsType comps = { { 1, 0, 0 } };
+			XFile testFile(testFileName, grid, comps, MPI_COMM_WORLD);
+		}
+
+		// Add time step groups to both files from several tasks
+		{
+			CheckpointWriter writer(MPI_COMM_WORLD, async);
+			for (int i = 0; i < 4; i++) {
+				writer.submit([i, &writer, &testFileNames](MPI_Comm comm) {
+					for (auto const& testFileName : testFileNames) {
+						auto& checkpointFile = writer.getFile(comm, testFileName);
+						auto concGroup =
+						checkpointFile.getGroup<XFile::ConcentrationGroup>();
+						BOOST_REQUIRE(concGroup);
+						concGroup->addTimestepGroup(i, 0.1 * (double) (i + 1),
+								0.1 * (double) i, 0.1);
+						// The file is the same from one task to the next
+						BOOST_REQUIRE(
+								&checkpointFile == &writer.getFile(comm, testFileName));
+						checkpointFile.flush();
+					}
+				});
+			}
+		}
+
+		// The files are closed and have all the groups
+		for (auto const& testFileName : testFileNames) {
+			XFile testFile(testFileName, MPI_COMM_WORLD);
+			auto concGroup = testFile.getGroup<XFile::ConcentrationGroup>();
+			BOOST_REQUIRE(concGroup);
+			BOOST_REQUIRE_EQUAL(concGroup->getLastTimeStep(), 3);
+			for (int i = 0; i < 4; i++) {
+				BOOST_REQUIRE(concGroup->getTimestepGroup(i));
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -9,7 +9,10 @@
 #include <XolotlConfig.h>
 #include <mpi.h>
 #include <memory>
+#include <cmath>
+#include <fstream>
 #include <Options.h>
+#include "hdf5.h"
 #include "xolotlCore/io/XFile.h"
 #include "tests/utils/MPIFixture.h"
 
@@ -320,6 +323,48 @@ BOOST_AUTO_TEST_CASE(checkIO) {
 	std::remove(tempFile.c_str());
 }
 
+/**
+ * Method checking that the grid in the x direction is read back with its
+ * boundaries, and can be replaced.
+ */
+BOOST_AUTO_TEST_CASE(checkXGrid) {
+
+	// An irregular grid, with its two boundary points
+	std::vector<double> grid = { 0.0, 0.1, 0.3, 0.6, 1.0, 1.5, 2.5 };
+	const std::string testFileName = "test_grid.h5";
+	{
+		xolotlCore::XFile testFile(testFileName, grid, createTestNetworkComps(),
+		MPI_COMM_WORLD);
+		auto headerGroup = testFile.getGroup<xolotlCore::XFile::HeaderGroup>();
+		BOOST_REQUIRE(headerGroup);
+		auto fileGrid = headerGroup->readXGrid();
+		BOOST_REQUIRE_EQUAL(fileGrid.size(), grid.size());
+		for (int i = 0; i < grid.size(); i++) {
+			BOOST_REQUIRE_CLOSE(fileGrid[i], grid[i], 1.0e-10);
+		}
+	}
+
+	// Move the points, as when the grid is adapted
+	std::vector<double> adaptedGrid = { 0.0, 0.1, 0.2, 0.4, 0.8, 1.5, 2.5 };
+	{
+		xolotlCore::XFile testFile(testFileName, MPI_COMM_WORLD,
+				xolotlCore::XFile::AccessMode::OpenReadWrite);
+		auto headerGroup = testFile.getGroup<xolotlCore::XFile::HeaderGroup>();
+		BOOST_REQUIRE(headerGroup);
+		headerGroup->writeXGrid(adaptedGrid);
+	}
+
+	xolotlCore::XFile testFile(testFileName, MPI_COMM_WORLD,
+			xolotlCore::XFile::AccessMode::OpenReadOnly);
+	auto headerGroup = testFile.getGroup<xolotlCore::XFile::HeaderGroup>();
+	BOOST_REQUIRE(headerGroup);
+	auto fileGrid = headerGroup->readXGrid();
+	BOOST_REQUIRE_EQUAL(fileGrid.size(), adaptedGrid.size());
+	for (int i = 0; i < adaptedGrid.size(); i++) {
+		BOOST_REQUIRE_CLOSE(fileGrid[i], adaptedGrid[i], 1.0e-10);
+	}
+}
+
 /**
  * Method checking the writing and reading of the surface position specifically
  * in the case of a 2D grid.
@@ -417,6 +462,647 @@ BOOST_AUTO_TEST_CASE(checkSurface2D) {
 	}
 }
 
+/**
+ * Method checking the writing and reading of the concentrations
+ * in the case of a 2D grid.
+ */
+BOOST_AUTO_TEST_CASE(checkConcentrations2D) {
+
+	// Determine where we are in the MPI world.
+	int commRank = -1;
+	int commSize = -1;
+	MPI_Comm_rank(MPI_COMM_WORLD, &commRank);
+	MPI_Comm_size(MPI_COMM_WORLD, &commSize);
+
+	// Each rank owns a block of rows
+	const int nX = 3, nYPerRank = 2;
+	const int baseY = commRank * nYPerRank;
+
+	// The concentrations at each grid point, some points
+	// not having any.
+	auto concsAt =
+			[](int i, int j) {
+				std::vector<XFile::TimestepGroup::ConcType> ret;
+				for (int n = 0; n < (i + j) % 3; n++) {
+					ret.emplace_back(n, 1.5 * (double) (i + 10 * j) + (double) n);
+				}
+				return ret;
+			};
+
+	// Create the test HDF5 file.
+	const std::string testFileName = "test_concs2D.h5";
+	{
+		std::vector<double> grid;
+		for (int i = 0; i < nX + 2; i++)
+			grid.push_back((double) i * 0.5);
+
+		xolotlCore::XFile testFile(testFileName, grid, createTestNetworkComps(),
+		MPI_COMM_WORLD);
+	}
+
+	// Write our part of the concentrations
+	{
+		BOOST_TEST_MESSAGE("Adding 2D concentrations");
+
+		xolotlCore::XFile testFile(testFileName,
+		MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadWrite);
+		auto concGroup =
+				testFile.getGroup<xolotlCore::XFile::ConcentrationGroup>();
+		BOOST_REQUIRE(concGroup);
+		auto tsGroup = concGroup->addTimestepGroup(0, 0.0001, 0.00001,
+				0.000001);
+		BOOST_REQUIRE(tsGroup);
+
+		XFile::TimestepGroup::Concs1DType myConcs;
+		for (int j = 0; j < nYPerRank; j++) {
+			for (int i = 0; i < nX; i++) {
+				myConcs.push_back(concsAt(i, baseY + j));
+			}
+		}
+		tsGroup->writeConcentrations(testFile, 0, baseY, nX, nYPerRank,
+				myConcs);
+	}
+
+	// Read the concentrations of each grid point
+	{
+		BOOST_TEST_MESSAGE("Checking 2D concentrations");
+
+		xolotlCore::XFile testFile(testFileName,
+		MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadOnly);
+		auto concGroup =
+				testFile.getGroup<xolotlCore::XFile::ConcentrationGroup>();
+		BOOST_REQUIRE(concGroup);
+		auto tsGroup = concGroup->getLastTimestepGroup();
+		BOOST_REQUIRE(tsGroup);
+
+		for (int j = 0; j < nYPerRank * commSize; j++) {
+			for (int i = 0; i < nX; i++) {
+				auto expected = concsAt(i, j);
+				auto returnedVector = tsGroup->readGridPoint(i, j);
+				BOOST_REQUIRE_EQUAL(returnedVector.size(), expected.size());
+				for (int n = 0; n < expected.size(); n++) {
+					BOOST_REQUIRE_CLOSE(returnedVector[n][0],
+							expected[n].first, 0.0001);
+					BOOST_REQUIRE_CLOSE(returnedVector[n][1],
+							expected[n].second, 0.0001);
+				}
+			}
+		}
+
+		// Read a block that does not match the written decomposition
+		const int baseX = 1, numX = nX - 1, numY = nYPerRank * commSize - 1;
+		auto readConcs = tsGroup->readConcentrations(testFile, baseX, 1, numX,
+				numY);
+		BOOST_REQUIRE_EQUAL(readConcs.size(), numX * numY);
+		for (int j = 0; j < numY; j++) {
+			for (int i = 0; i < numX; i++) {
+				auto expected = concsAt(baseX + i, 1 + j);
+				auto const& pointConcs = readConcs[j * numX + i];
+				BOOST_REQUIRE_EQUAL(pointConcs.size(), expected.size());
+				for (int n = 0; n < expected.size(); n++) {
+					BOOST_REQUIRE_EQUAL(pointConcs[n].first,
+							expected[n].first);
+					BOOST_REQUIRE_CLOSE(pointConcs[n].second,
+							expected[n].second, 0.0001);
+				}
+			}
+		}
+	}
+}
+
+/**
+ * Method checking the writing and reading of compressed concentrations
+ * in the case of a 2D grid.
+ */
+BOOST_AUTO_TEST_CASE(checkCompressedConcentrations2D) {
+
+	// Determine where we are in the MPI world.
+	int commRank = -1;
+	int commSize = -1;
+	MPI_Comm_rank(MPI_COMM_WORLD, &commRank);
+	MPI_Comm_size(MPI_COMM_WORLD, &commSize);
+
+	// Each rank owns a block of rows
+	const int nX = 4, nYPerRank = 3;
+	const int baseY = commRank * nYPerRank;
+
+	// The concentrations at each grid point, with values that
+	// can't be written exactly with few mantissa bits.
+	auto concsAt = [](int i, int j) {
+		std::vector<XFile::TimestepGroup::ConcType> ret;
+		for (int n = 0; n < 5; n++) {
+			ret.emplace_back(n, (double) (i + 7 * j + 1) / (double) (n + 3));
+		}
+		return ret;
+	};
+
+	// Create the test HDF5 file.
+	const std::string testFileName = "test_compressed_concs2D.h5";
+	{
+		std::vector<double> grid;
+		for (int i = 0; i < nX + 2; i++)
+			grid.push_back((double) i * 0.5);
+
+		xolotlCore::XFile testFile(testFileName, grid, createTestNetworkComps(),
+		MPI_COMM_WORLD);
+	}
+
+	// Write our part of the concentrations, shuffled, deflated
+	// and keeping 20 bits of mantissa
+	HDF5File::Compression compression;
+	compression.shuffle = true;
+	compression.deflateLevel = 6;
+	compression.lossyBits = 20;
+	{
+		BOOST_TEST_MESSAGE("Adding compressed 2D concentrations");
+
+		xolotlCore::XFile testFile(testFileName,
+		MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadWrite);
+		testFile.setCompression(compression);
+		auto concGroup =
+				testFile.getGroup<xolotlCore::XFile::ConcentrationGroup>();
+		BOOST_REQUIRE(concGroup);
+		auto tsGroup = concGroup->addTimestepGroup(0, 0.0001, 0.00001,
+				0.000001);
+		BOOST_REQUIRE(tsGroup);
+
+		XFile::TimestepGroup::Concs1DType myConcs;
+		for (int j = 0; j < nYPerRank; j++) {
+			for (int i = 0; i < nX; i++) {
+				myConcs.push_back(concsAt(i, baseY + j));
+			}
+		}
+		tsGroup->writeConcentrations(testFile, 0, baseY, nX, nYPerRank,
+				myConcs);
+	}
+
+	// Read everything back
+	{
+		BOOST_TEST_MESSAGE("Checking compressed 2D concentrations");
+
+		xolotlCore::XFile testFile(testFileName,
+		MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadOnly);
+		auto concGroup =
+				testFile.getGroup<xolotlCore::XFile::ConcentrationGroup>();
+		BOOST_REQUIRE(concGroup);
+		auto tsGroup = concGroup->getLastTimestepGroup();
+		BOOST_REQUIRE(tsGroup);
+
+		// The dataset uses both filters
+		hid_t datasetId = H5Dopen(tsGroup->getId(), "concs", H5P_DEFAULT);
+		BOOST_REQUIRE(datasetId >= 0);
+		hid_t plistId = H5Dget_create_plist(datasetId);
+		BOOST_REQUIRE_EQUAL(H5Pget_layout(plistId), H5D_CHUNKED);
+		BOOST_REQUIRE_EQUAL(H5Pget_nfilters(plistId), 2);
+		H5Pclose(plistId);
+		H5Dclose(datasetId);
+
+		// The values are within the rounding error
+		const int numY = nYPerRank * commSize;
+		auto readConcs = tsGroup->readConcentrations(testFile, 0, 0, nX, numY);
+		BOOST_REQUIRE_EQUAL(readConcs.size(), nX * numY);
+		for (int j = 0; j < numY; j++) {
+			for (int i = 0; i < nX; i++) {
+				auto expected = concsAt(i, j);
+				auto const& pointConcs = readConcs[j * nX + i];
+				BOOST_REQUIRE_EQUAL(pointConcs.size(), expected.size());
+				for (int n = 0; n < expected.size(); n++) {
+					BOOST_REQUIRE_EQUAL(pointConcs[n].first,
+							expected[n].first);
+					BOOST_REQUIRE_CLOSE_FRACTION(pointConcs[n].second,
+							expected[n].second, std::ldexp(1.0, -20));
+				}
+			}
+		}
+	}
+
+	// Grid points without any concentration are written without chunks
+	{
+		BOOST_TEST_MESSAGE("Adding empty compressed 2D concentrations");
+
+		xolotlCore::XFile testFile(testFileName,
+		MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadWrite);
+		testFile.setCompression(compression);
+		auto concGroup =
+				testFile.getGroup<xolotlCore::XFile::ConcentrationGroup>();
+		BOOST_REQUIRE(concGroup);
+		auto tsGroup = concGroup->addTimestepGroup(1, 0.0002, 0.0001,
+				0.000001);
+		BOOST_REQUIRE(tsGroup);
+
+		XFile::TimestepGroup::Concs1DType myConcs(nX * nYPerRank);
+		tsGroup->writeConcentrations(testFile, 0, baseY, nX, nYPerRank,
+				myConcs);
+
+		hid_t datasetId = H5Dopen(tsGroup->getId(), "concs", H5P_DEFAULT);
+		BOOST_REQUIRE(datasetId >= 0);
+		hid_t plistId = H5Dget_create_plist(datasetId);
+		BOOST_REQUIRE_EQUAL(H5Pget_layout(plistId), H5D_CONTIGUOUS);
+		H5Pclose(plistId);
+		H5Dclose(datasetId);
+	}
+}
+
+/**
+ * Method checking that the concentrations of a delta checkpoint are
+ * rebuilt from its keyframe.
+ */
+BOOST_AUTO_TEST_CASE(checkDeltaConcentrations) {
+
+	// Determine where we are in the MPI world.
+	int commRank = -1;
+	MPI_Comm_rank(MPI_COMM_WORLD, &commRank);
+
+	const int nGridPointsPerRank = 3;
+	const int baseX = commRank * nGridPointsPerRank;
+
+	// The keyframe concentrations
+	XFile::TimestepGroup::Concs1DType keyConcs(nGridPointsPerRank);
+	for (int i = 0; i < nGridPointsPerRank; i++) {
+		for (int n = 0; n < 4; n++) {
+			keyConcs[i].emplace_back(2 * n, 1.0 + (double) (baseX + i + n));
+		}
+	}
+
+	// The later concentrations: cluster 0 changes a lot, cluster 2
+	// barely, cluster 4 is removed and cluster 5 is added
+	auto concs = keyConcs;
+	for (auto& point : concs) {
+		point[0].second *= 2.0;
+		point[1].second *= 1.0 + 1.0e-6;
+		point.erase(point.begin() + 2);
+		point.emplace(point.begin() + 2, 5, 0.5);
+	}
+
+	// Only the large enough changes are kept
+	auto delta = XFile::TimestepGroup::makeDelta(keyConcs, concs, 1.0e-4);
+	BOOST_REQUIRE_EQUAL(delta.size(), nGridPointsPerRank);
+	for (auto const& point : delta) {
+		BOOST_REQUIRE_EQUAL(point.size(), 3);
+		BOOST_REQUIRE_EQUAL(point[0].first, 0);
+		BOOST_REQUIRE_EQUAL(point[1].first, 4);
+		BOOST_REQUIRE_EQUAL(point[1].second, 0.0);
+		BOOST_REQUIRE_EQUAL(point[2].first, 5);
+	}
+
+	// Write the keyframe and the delta
+	const std::string testFileName = "test_delta.h5";
+	{
+		std::vector<double> grid;
+		for (int i = 0; i < 10; i++)
+			grid.push_back((double) i * 0.5);
+
+		xolotlCore::XFile testFile(testFileName, grid, createTestNetworkComps(),
+		MPI_COMM_WORLD);
+		auto concGroup =
+				testFile.getGroup<xolotlCore::XFile::ConcentrationGroup>();
+		BOOST_REQUIRE(concGroup);
+		auto keyGroup = concGroup->addTimestepGroup(0, 0.001, 0.0, 0.001);
+		keyGroup->writeConcentrations(testFile, baseX, keyConcs);
+		auto deltaGroup = concGroup->addTimestepGroup(1, 0.002, 0.001, 0.001);
+		deltaGroup->writeKeyframe(0);
+		deltaGroup->writeConcentrations(testFile, baseX, delta);
+	}
+
+	// The last group gives the full state
+	{
+		xolotlCore::XFile testFile(testFileName,
+		MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadOnly);
+		auto concGroup =
+				testFile.getGroup<xolotlCore::XFile::ConcentrationGroup>();
+		BOOST_REQUIRE(concGroup);
+		auto tsGroup = concGroup->getLastTimestepGroup();
+		BOOST_REQUIRE(tsGroup);
+		BOOST_REQUIRE_EQUAL(tsGroup->readKeyframe(), 0);
+		BOOST_REQUIRE_EQUAL(concGroup->getTimestepGroup(0)->readKeyframe(), -1);
+
+		auto readConcs = tsGroup->readConcentrations(testFile, baseX,
+				nGridPointsPerRank);
+		BOOST_REQUIRE_EQUAL(readConcs.size(), nGridPointsPerRank);
+		for (int i = 0; i < nGridPointsPerRank; i++) {
+			BOOST_REQUIRE_EQUAL(readConcs[i].size(), concs[i].size());
+			for (int n = 0; n < concs[i].size(); n++) {
+				BOOST_REQUIRE_EQUAL(readConcs[i][n].first, concs[i][n].first);
+				BOOST_REQUIRE_CLOSE(readConcs[i][n].second, concs[i][n].second,
+						0.01);
+			}
+		}
+	}
+}
+
+/**
+ * Method checking that the concentrations are packed with
+ * the absolute and relative thresholds.
+ */
+BOOST_AUTO_TEST_CASE(checkPackConcentrations) {
+
+	// Two grid points of 4 values, the last one being the temperature
+	const int dof = 4;
+	std::vector<double> values = { 1.0, 0.0, -1.0e-3, 1000.0, 1.0e-20, 2.0,
+			1.0e-8, 933.0 };
+	std::vector<int> indexBuffer;
+
+	// Only the values under 1.0e-16 are left out by default
+	auto concs = XFile::TimestepGroup::packConcentrations(values.data(), 2, dof,
+			0.0, indexBuffer, MPI_COMM_WORLD);
+	BOOST_REQUIRE_EQUAL(concs.size(), 2);
+	BOOST_REQUIRE_EQUAL(concs[0].size(), 3);
+	BOOST_REQUIRE_EQUAL(concs[0][0].first, 0);
+	BOOST_REQUIRE_EQUAL(concs[0][1].first, 2);
+	BOOST_REQUIRE_EQUAL(concs[0][1].second, -1.0e-3);
+	BOOST_REQUIRE_EQUAL(concs[0][2].first, 3);
+	BOOST_REQUIRE_EQUAL(concs[1].size(), 3);
+	BOOST_REQUIRE_EQUAL(concs[1][0].first, 1);
+	BOOST_REQUIRE_EQUAL(concs[1][1].first, 2);
+	BOOST_REQUIRE_EQUAL(concs[1][2].first, 3);
+	BOOST_REQUIRE_EQUAL(concs[1][2].second, 933.0);
+	for (auto const& point : concs) {
+		BOOST_REQUIRE_EQUAL(point.capacity(), point.size());
+	}
+
+	// The relative threshold is 1.0e-3 times 2.0, the temperature being
+	// left out of the largest concentration but always kept
+	concs = XFile::TimestepGroup::packConcentrations(values.data(), 2, dof,
+			1.0e-3, indexBuffer, MPI_COMM_WORLD);
+	BOOST_REQUIRE_EQUAL(concs[0].size(), 2);
+	BOOST_REQUIRE_EQUAL(concs[0][0].first, 0);
+	BOOST_REQUIRE_EQUAL(concs[0][1].first, 3);
+	BOOST_REQUIRE_EQUAL(concs[1].size(), 2);
+	BOOST_REQUIRE_EQUAL(concs[1][0].first, 1);
+	BOOST_REQUIRE_EQUAL(concs[1][1].first, 3);
+
+	// The largest concentration is the one of all the processes
+	int commRank = -1;
+	MPI_Comm_rank(MPI_COMM_WORLD, &commRank);
+	std::vector<double> localValues = { 1.0e-3, 1.0 };
+	if (commRank == 0)
+		localValues[0] = 10.0;
+	concs = XFile::TimestepGroup::packConcentrations(localValues.data(), 1, 2,
+			1.0e-3, indexBuffer, MPI_COMM_WORLD);
+	BOOST_REQUIRE_EQUAL(concs[0].size(), (commRank == 0) ? 2 : 1);
+}
+
+/**
+ * Method checking that only the most recent time steps are kept,
+ * with the keyframes they need.
+ */
+BOOST_AUTO_TEST_CASE(checkRetention) {
+
+	// Determine where we are in the MPI world.
+	int commRank = -1;
+	MPI_Comm_rank(MPI_COMM_WORLD, &commRank);
+
+	const int nGridPointsPerRank = 2;
+	const int baseX = commRank * nGridPointsPerRank;
+	XFile::TimestepGroup::Concs1DType concs(nGridPointsPerRank);
+	for (int i = 0; i < nGridPointsPerRank; i++) {
+		concs[i].emplace_back(1, 1.0 + (double) (baseX + i));
+	}
+
+	// Time steps 0 and 3 are keyframes, the others deltas
+	const std::string testFileName = "test_retention.h5";
+	{
+		std::vector<double> grid;
+		for (int i = 0; i < 10; i++)
+			grid.push_back((double) i * 0.5);
+
+		xolotlCore::XFile testFile(testFileName, grid, createTestNetworkComps(),
+		MPI_COMM_WORLD);
+		auto concGroup =
+				testFile.getGroup<xolotlCore::XFile::ConcentrationGroup>();
+		BOOST_REQUIRE(concGroup);
+		for (int timeStep = 0; timeStep < 6; timeStep++) {
+			auto tsGroup = concGroup->addTimestepGroup(timeStep,
+					0.001 * (double) (timeStep + 1), 0.001 * (double) timeStep,
+					0.001);
+			if (timeStep % 3 != 0)
+				tsGroup->writeKeyframe(timeStep - timeStep % 3);
+			tsGroup->writeConcentrations(testFile, baseX, concs);
+		}
+	}
+
+	// Name the run with variable length strings, which have to survive
+	// the compaction
+	{
+		xolotlCore::XFile testFile(testFileName,
+		MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadWrite);
+		HDF5File::ScalarDataSpace nameSpace;
+		HDF5File::Attribute<std::string> nameAttr(testFile, "runName",
+				nameSpace);
+		nameAttr.setTo("retention test");
+	}
+
+	// Remove the time steps that aren't kept in place
+	auto removeOldTimestepGroups = [&testFileName](int nKept) {
+		xolotlCore::XFile testFile(testFileName,
+		MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadWrite);
+		auto concGroup =
+		testFile.getGroup<xolotlCore::XFile::ConcentrationGroup>();
+		BOOST_REQUIRE(concGroup);
+		concGroup->removeOldTimestepGroups(nKept);
+		return concGroup->getTimeSteps();
+	};
+	auto getFileSize = [&testFileName]() {
+		std::ifstream file(testFileName, std::ios::binary | std::ios::ate);
+		return (long) file.tellg();
+	};
+
+	// Keeping 4 time steps also keeps the keyframe of time step 2
+	BOOST_REQUIRE(
+			removeOldTimestepGroups(4) == std::vector<int>( { 0, 2, 3, 4, 5 }));
+
+	// Keeping 2 only needs keyframe 3
+	BOOST_REQUIRE(removeOldTimestepGroups(2) == std::vector<int>( { 3, 4, 5 }));
+
+	// Nothing is removed when keeping all of them
+	BOOST_REQUIRE_EQUAL(removeOldTimestepGroups(0).size(), 3);
+
+	// The compaction gives the space back
+	auto fileSize = getFileSize();
+	xolotlCore::XFile::compact(testFileName, MPI_COMM_WORLD);
+	BOOST_REQUIRE_LT(getFileSize(), fileSize);
+	{
+		xolotlCore::XFile testFile(testFileName,
+		MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadOnly);
+		HDF5File::Attribute<std::string> nameAttr(testFile, "runName");
+		BOOST_REQUIRE_EQUAL(nameAttr.get(), "retention test");
+		auto concGroup =
+				testFile.getGroup<xolotlCore::XFile::ConcentrationGroup>();
+		BOOST_REQUIRE(concGroup);
+		BOOST_REQUIRE(
+				concGroup->getTimeSteps() == std::vector<int>( { 3, 4, 5 }));
+	}
+
+	// The last time step can still be read
+	{
+		xolotlCore::XFile testFile(testFileName,
+		MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadOnly);
+		auto concGroup =
+				testFile.getGroup<xolotlCore::XFile::ConcentrationGroup>();
+		BOOST_REQUIRE(concGroup);
+		BOOST_REQUIRE_EQUAL(concGroup->getLastTimeStep(), 5);
+		auto tsGroup = concGroup->getLastTimestepGroup();
+		BOOST_REQUIRE(tsGroup);
+		auto readConcs = tsGroup->readConcentrations(testFile, baseX,
+				nGridPointsPerRank);
+		BOOST_REQUIRE_EQUAL(readConcs.size(), nGridPointsPerRank);
+		for (int i = 0; i < nGridPointsPerRank; i++) {
+			BOOST_REQUIRE_EQUAL(readConcs[i].size(), 1);
+			BOOST_REQUIRE_EQUAL(readConcs[i][0].first, 1);
+			BOOST_REQUIRE_EQUAL(readConcs[i][0].second, concs[i][0].second);
+		}
+	}
+}
+
+/**
+ * Method checking the conversion of the concentrations stored
+ * one data set per grid point, as in older files.
+ */
+BOOST_AUTO_TEST_CASE(checkConvertGridPoints) {
+
+	// Determine where we are in the MPI world.
+	int commRank = -1, commSize = -1;
+	MPI_Comm_rank(MPI_COMM_WORLD, &commRank);
+	MPI_Comm_size(MPI_COMM_WORLD, &commSize);
+
+	// Point i has i concentrations, point 0 has none.
+	const int nGridPointsPerRank = 5;
+	const int nGridPoints = nGridPointsPerRank * commSize;
+	const int baseX = commRank * nGridPointsPerRank;
+	auto concAt = [](int i, int n) {return 1.0e-3 * (double) (i * 10 + n);};
+
+	const std::string testFileName = "test_convert.h5";
+	{
+		std::vector<double> grid;
+		for (int i = 0; i < nGridPoints + 2; i++)
+			grid.push_back((double) i * 0.5);
+		xolotlCore::XFile testFile(testFileName, grid, createTestNetworkComps(),
+		MPI_COMM_WORLD);
+		auto concGroup =
+				testFile.getGroup<xolotlCore::XFile::ConcentrationGroup>();
+		BOOST_REQUIRE(concGroup);
+		auto tsGroup = concGroup->addTimestepGroup(0, 0.001, 0.0, 0.001);
+
+		// Write the old data sets, all the processes creating all of them
+		for (int i = 1; i < nGridPoints; i++) {
+			std::vector<double> data;
+			for (int n = 0; n < i; n++) {
+				data.push_back((double) (2 * n));
+				data.push_back(concAt(i, n));
+			}
+			hsize_t dims[2] = { (hsize_t) i, 2 };
+			hid_t dataspaceId = H5Screate_simple(2, dims, nullptr);
+			std::string datasetName = "position_" + std::to_string(i)
+					+ "_-1_-1";
+			hid_t datasetId = H5Dcreate2(tsGroup->getId(),
+					datasetName.c_str(), H5T_IEEE_F64LE, dataspaceId,
+					H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+			H5Dwrite(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+					data.data());
+			H5Dclose(datasetId);
+			H5Sclose(dataspaceId);
+		}
+		BOOST_REQUIRE(tsGroup->hasGridPointConcentrations());
+
+		// Convert by batches that do not divide our number of points
+		tsGroup->convertGridPointConcentrations(testFile, baseX,
+				nGridPointsPerRank, 2);
+		BOOST_REQUIRE(not tsGroup->hasGridPointConcentrations());
+	}
+
+	// The converted concentrations are read as the new ones
+	{
+		xolotlCore::XFile testFile(testFileName,
+		MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadOnly);
+		auto concGroup =
+				testFile.getGroup<xolotlCore::XFile::ConcentrationGroup>();
+		BOOST_REQUIRE(concGroup);
+		auto tsGroup = concGroup->getLastTimestepGroup();
+		BOOST_REQUIRE(tsGroup);
+		auto readConcs = tsGroup->readConcentrations(testFile, baseX,
+				nGridPointsPerRank);
+		BOOST_REQUIRE_EQUAL(readConcs.size(), nGridPointsPerRank);
+		for (int i = 0; i < nGridPointsPerRank; i++) {
+			BOOST_REQUIRE_EQUAL(readConcs[i].size(), baseX + i);
+			for (int n = 0; n < baseX + i; n++) {
+				BOOST_REQUIRE_EQUAL(readConcs[i][n].first, 2 * n);
+				BOOST_REQUIRE_EQUAL(readConcs[i][n].second,
+						concAt(baseX + i, n));
+			}
+		}
+	}
+}
+
+/**
+ * Method checking that 2D data sets are read by chunks of rows
+ * in the caller's buffers.
+ */
+BOOST_AUTO_TEST_CASE(checkVisitRows) {
+
+	const hsize_t nRows = 10, nCols = 3;
+	auto valueAt = [](hsize_t i, hsize_t j) {return (double) (i * 100 + j);};
+
+	const std::string testFileName = "test_rows.h5";
+	std::vector<double> grid = { 0.0, 0.5, 1.0 };
+	xolotlCore::XFile testFile(testFileName, grid, createTestNetworkComps(),
+	MPI_COMM_WORLD);
+	auto concGroup = testFile.getGroup<xolotlCore::XFile::ConcentrationGroup>();
+	BOOST_REQUIRE(concGroup);
+	auto tsGroup = concGroup->addTimestepGroup(0, 0.001, 0.0, 0.001);
+
+	// Write the data set, all the processes writing the same values
+	std::vector<double> data;
+	for (hsize_t i = 0; i < nRows; i++) {
+		for (hsize_t j = 0; j < nCols; j++) {
+			data.push_back(valueAt(i, j));
+		}
+	}
+	hsize_t dims[2] = { nRows, nCols };
+	hid_t dataspaceId = H5Screate_simple(2, dims, nullptr);
+	hid_t datasetId = H5Dcreate2(tsGroup->getId(), "rows", H5T_IEEE_F64LE,
+			dataspaceId, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+	H5Dwrite(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+			data.data());
+	H5Dclose(datasetId);
+	H5Sclose(dataspaceId);
+
+	auto readDims = tsGroup->readDataDims("rows");
+	BOOST_REQUIRE_EQUAL(readDims[0], nRows);
+	BOOST_REQUIRE_EQUAL(readDims[1], nCols);
+
+	// Read some rows in our buffer
+	std::vector<double> buffer(2 * nCols);
+	tsGroup->readRows("rows", 3, 2, buffer.data());
+	for (hsize_t i = 0; i < 2; i++) {
+		for (hsize_t j = 0; j < nCols; j++) {
+			BOOST_REQUIRE_EQUAL(buffer[i * nCols + j], valueAt(3 + i, j));
+		}
+	}
+
+	// Stream all of them, the last chunk being smaller
+	std::vector<hsize_t> firstRows;
+	tsGroup->visitRows("rows", 4,
+			[&](hsize_t firstRow, hsize_t chunkRows, hsize_t chunkCols,
+					const double* values) {
+				BOOST_REQUIRE_EQUAL(chunkCols, nCols);
+				BOOST_REQUIRE_EQUAL(chunkRows,
+						std::min<hsize_t>(4, nRows - firstRow));
+				for (hsize_t i = 0; i < chunkRows; i++) {
+					for (hsize_t j = 0; j < nCols; j++) {
+						BOOST_REQUIRE_EQUAL(values[i * nCols + j],
+								valueAt(firstRow + i, j));
+					}
+				}
+				firstRows.push_back(firstRow);
+			});
+	BOOST_REQUIRE(firstRows == std::vector<hsize_t>( { 0, 4, 8 }));
+
+	// The nested accessor gives the same values
+	auto rows = tsGroup->readData3D("rows");
+	BOOST_REQUIRE_EQUAL(rows.size(), nRows);
+	BOOST_REQUIRE_EQUAL(rows[9][2], valueAt(9, 2));
+}
+
 /**
  * Method checking the writing and reading of the surface position specifically
  * in the case of a 3D grid.
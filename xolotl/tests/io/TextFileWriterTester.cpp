@@ -0,0 +1,82 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Regression
+
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdio>
+#include "xolotlCore/io/TextFileWriter.h"
+
+using namespace std;
+using namespace xolotlCore;
+
+/**
+ * Read the whole content of a file.
+ */
+static std::string readFile(const std::string& fileName) {
+	std::ifstream inputFile(fileName);
+	std::stringstream content;
+	content << inputFile.rdbuf();
+	return content.str();
+}
+
+/**
+ * This suite is responsible for testing the TextFileWriter.
+ */
+BOOST_AUTO_TEST_SUITE(TextFileWriter_testSuite)
+
+/**
+ * Method checking that the text is written in order, synchronously
+ * or not.
+ */
+BOOST_AUTO_TEST_CASE(checkOrder) {
+
+	for (bool async : { false, true }) {
+		const std::string fileName = "textFileWriterOrder.txt";
+		std::remove(fileName.c_str());
+
+		TextFileWriter writer(async);
+		std::string expected;
+		for (int i = 0; i < 100; i++) {
+			std::string line = std::to_string(i) + "\n";
+			writer.append(fileName, line);
+			expected += line;
+		}
+		writer.flush();
+
+		BOOST_REQUIRE_EQUAL(readFile(fileName), expected);
+		std::remove(fileName.c_str());
+	}
+}
+
+/**
+ * Method checking that a file is replaced by write and that the
+ * pieces of different files stay in order.
+ */
+BOOST_AUTO_TEST_CASE(checkReplace) {
+
+	const std::string firstName = "textFileWriterFirst.txt";
+	const std::string secondName = "textFileWriterSecond.txt";
+	{
+		std::ofstream oldFile(firstName);
+		oldFile << "old content" << std::endl;
+	}
+
+	{
+		TextFileWriter writer;
+		writer.write(firstName, "a\n");
+		writer.append(secondName, "b\n");
+		writer.append(firstName, "c\n");
+		writer.write(secondName, "d\n");
+		writer.append(secondName, "e\n");
+		// The destruction writes what is left
+	}
+
+	BOOST_REQUIRE_EQUAL(readFile(firstName), "a\nc\n");
+	BOOST_REQUIRE_EQUAL(readFile(secondName), "d\ne\n");
+	std::remove(firstName.c_str());
+	std::remove(secondName.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
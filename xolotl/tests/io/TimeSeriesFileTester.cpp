@@ -0,0 +1,85 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Regression
+
+#include <boost/test/unit_test.hpp>
+#include <mpi.h>
+#include <string>
+#include <vector>
+#include "xolotlCore/io/TimeSeriesFile.h"
+#include "tests/utils/MPIFixture.h"
+
+using namespace std;
+using namespace xolotlCore;
+
+// Initialize MPI before running any tests; finalize it running all tests.
+BOOST_GLOBAL_FIXTURE(MPIFixture);
+
+/**
+ * This suite is responsible for testing the TimeSeriesFile.
+ */
+BOOST_AUTO_TEST_SUITE(TimeSeriesFile_testSuite)
+
+/**
+ * Method checking that the buffered rows of several series are all
+ * written, in order, and can be appended to after reopening the file.
+ */
+BOOST_AUTO_TEST_CASE(checkAppend) {
+
+	// Each process has its own file
+	int commRank = -1;
+	MPI_Comm_rank(MPI_COMM_WORLD, &commRank);
+	const std::string testFileName = "test_time_series_"
+			+ std::to_string(commRank) + ".h5";
+	const std::vector<std::string> surfaceColumns = { "time", "surface" };
+	const std::vector<std::string> retentionColumns = { "fluence", "helium",
+			"deuterium" };
+
+	{
+		// Write every 4 rows, the last ones when the file is closed
+		TimeSeriesFile testFile(testFileName,
+				TimeSeriesFile::AccessMode::CreateOrTruncateIfExists, 4);
+		for (int i = 0; i < 10; i++) {
+			BOOST_REQUIRE_EQUAL(testFile.writesOnAppend("surface"),
+					i % 4 == 3);
+			testFile.append("surface", surfaceColumns,
+					{ 0.1 * i, 2.0 * i });
+			if (i % 3 == 0) {
+				testFile.append("retentionOut", retentionColumns,
+						{ 1.0 * i, 1.0, 2.0 });
+			}
+		}
+
+		// A row must have one value per column
+		BOOST_REQUIRE_THROW(
+				testFile.append("surface", surfaceColumns, { 1.0 }),
+				HDF5Exception);
+	}
+
+	{
+		TimeSeriesFile testFile(testFileName,
+				TimeSeriesFile::AccessMode::OpenReadWrite);
+		testFile.append("surface", surfaceColumns, { 1.0, 20.0 });
+	}
+
+	TimeSeriesFile testFile(testFileName,
+			TimeSeriesFile::AccessMode::OpenReadOnly);
+	auto names = testFile.getSeriesNames();
+	BOOST_REQUIRE_EQUAL(names.size(), 2);
+	BOOST_REQUIRE(testFile.readColumns("surface") == surfaceColumns);
+	BOOST_REQUIRE(testFile.readColumns("retentionOut") == retentionColumns);
+
+	auto rows = testFile.readRows("surface");
+	BOOST_REQUIRE_EQUAL(rows.size(), 11);
+	for (int i = 0; i < 11; i++) {
+		BOOST_REQUIRE_EQUAL(rows[i].size(), 2);
+		BOOST_REQUIRE_CLOSE(rows[i][1], 2.0 * i, 1.0e-12);
+	}
+	rows = testFile.readRows("retentionOut");
+	BOOST_REQUIRE_EQUAL(rows.size(), 4);
+	BOOST_REQUIRE_EQUAL(rows[3][0], 9.0);
+
+	// The rows are written as in the text files of the monitors
+	BOOST_REQUIRE_EQUAL(TimeSeriesFile::toText(rows[3]), "9 1 2\n");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
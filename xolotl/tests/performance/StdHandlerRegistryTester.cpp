@@ -3,6 +3,7 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <map>
 #include <math.h>
 #include <unistd.h>
 #include <boost/test/included/unit_test.hpp>
@@ -211,4 +212,37 @@ BOOST_AUTO_TEST_CASE(aggregateStats) {
 	}
 }
 
+BOOST_AUTO_TEST_CASE(localValues) {
+	xperf::initialize(xperf::IHandlerRegistry::std);
+	std::shared_ptr<xperf::IHandlerRegistry> reg = xperf::getHandlerRegistry();
+
+	// Count some events and time something
+	auto ctr = reg->getEventCounter("localCounter");
+	for (unsigned int i = 0; i < 3; ++i) {
+		ctr->increment();
+	}
+	auto timer = reg->getTimer("localTimer");
+	timer->start();
+	usleep(10000);
+	timer->stop();
+
+	// The values of this process only, read without communicating
+	std::map<std::string, xperf::ITimer::ValType> timerValues;
+	std::map<std::string, xperf::IEventCounter::ValType> counterValues;
+	reg->getLocalValues(timerValues, counterValues);
+	BOOST_REQUIRE_EQUAL(counterValues.count("localCounter"), 1U);
+	BOOST_REQUIRE_EQUAL(counterValues["localCounter"], 3U);
+	BOOST_REQUIRE_EQUAL(timerValues.count("localTimer"), 1U);
+	BOOST_REQUIRE_EQUAL(timerValues["localTimer"], timer->getValue());
+	BOOST_REQUIRE(timerValues["localTimer"] > 0.0);
+
+	// The dummy registry does not keep anything
+	xperf::initialize(xperf::IHandlerRegistry::dummy);
+	reg = xperf::getHandlerRegistry();
+	reg->getEventCounter("localCounter")->increment();
+	reg->getLocalValues(timerValues, counterValues);
+	BOOST_REQUIRE(timerValues.empty());
+	BOOST_REQUIRE(counterValues.empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -11,6 +11,8 @@
 #include <DummyHandlerRegistry.h>
 #include <Constants.h>
 #include <Options.h>
+#include <ObservableWeights.h>
+#include <SizeStatistics.h>
 #include <fstream>
 #include <iostream>
 
@@ -327,6 +329,141 @@ BOOST_AUTO_TEST_CASE(checkGetConcentrations) {
 	return;
 }
 
+/**
+ * This operation checks that the weights of the degrees of freedom give
+ * the same totals as the network, moments of the super clusters included.
+ */
+BOOST_AUTO_TEST_CASE(checkTotalWeights) {
+	// Create the parameter file
+	std::ofstream paramFile("param.txt");
+	paramFile << "netParam=8 0 0 5 0" << std::endl << "grid=100 0.5"
+			<< std::endl;
+	paramFile.close();
+
+	// Create a fake command line to read the options
+	char **argv;
+	argv = new char*[2];
+	std::string parameterFile = "param.txt";
+	argv[0] = new char[parameterFile.length() + 1];
+	strcpy(argv[0], parameterFile.c_str());
+	argv[1] = 0; // null-terminate the array
+
+	// Read the options
+	Options opts;
+	opts.readParams(argv);
+
+	// Create the loader
+	PSIClusterNetworkLoader loader = PSIClusterNetworkLoader(
+			std::make_shared<xolotlPerf::DummyHandlerRegistry>());
+	// Set grouping parameters
+	loader.setVMin(4);
+	loader.setWidth(4, 0);
+	loader.setWidth(1, 3);
+
+	// Generate the network from the options
+	auto network = loader.generate(opts);
+	BOOST_REQUIRE(network->getAll(ReactantType::PSISuper).size() > 0);
+
+	// Set different concentrations everywhere, moments included
+	int dof = network->getDOF();
+	std::vector<double> concentrations(dof);
+	for (int i = 0; i < dof; i++) {
+		concentrations[i] = 1.0e-3 * (double) ((i * 7) % 11 + 1)
+				- 5.0e-4 * (double) (i % 3);
+	}
+	network->updateConcentrationsFromArray(concentrations.data());
+
+	// Check each total
+	auto checkWeights = [&concentrations](const std::vector<double>& weights,
+			double total) {
+		BOOST_REQUIRE_EQUAL(weights.size(), concentrations.size());
+		double weighted = 0.0;
+		for (unsigned int i = 0; i < weights.size(); i++) {
+			weighted += weights[i] * concentrations[i];
+		}
+		BOOST_REQUIRE_CLOSE(total, weighted, 1.0e-8);
+	};
+	checkWeights(network->getTotalAtomWeights(0),
+			network->getTotalAtomConcentration(0));
+	checkWeights(network->getTotalTrappedAtomWeights(0),
+			network->getTotalTrappedAtomConcentration(0));
+	checkWeights(network->getTotalVWeights(),
+			network->getTotalVConcentration());
+	checkWeights(network->getTotalIWeights(),
+			network->getTotalIConcentration());
+
+	// Compute them all together in a single pass
+	ObservableWeights weights( { network->getTotalAtomWeights(0),
+			network->getTotalVWeights(), network->getTotalIWeights() });
+	BOOST_REQUIRE_EQUAL(weights.getNumObservables(), 3);
+	BOOST_REQUIRE(weights.size() < dof);
+	double values[3] = { 1.0, 0.0, 0.0 };
+	weights.accumulate(concentrations.data(), 2.0, values);
+	BOOST_REQUIRE_CLOSE(1.0 + 2.0 * network->getTotalAtomConcentration(0),
+			values[0], 1.0e-8);
+	BOOST_REQUIRE_CLOSE(2.0 * network->getTotalVConcentration(), values[1],
+			1.0e-8);
+	BOOST_REQUIRE_CLOSE(2.0 * network->getTotalIConcentration(), values[2],
+			1.0e-8);
+
+	// The moments of the helium size distribution
+	double clusterConc = 0.0;
+	for (auto const& currMapItem : network->getAll(ReactantType::He)) {
+		clusterConc += currMapItem.second->getConcentration();
+	}
+	for (auto const& currMapItem : network->getAll(ReactantType::PSIMixed)) {
+		clusterConc += currMapItem.second->getConcentration();
+	}
+	for (auto const& currMapItem : network->getAll(ReactantType::PSISuper)) {
+		auto const& cluster =
+				static_cast<PSISuperCluster&>(*(currMapItem.second));
+		clusterConc += cluster.getTotalConcentration();
+	}
+	checkWeights(network->getAtomMomentWeights(0, 0), clusterConc);
+	checkWeights(network->getAtomMomentWeights(1, 0),
+			network->getTotalAtomConcentration(0));
+
+	// Derive the statistics from them
+	ObservableWeights momentWeights( { network->getAtomMomentWeights(0, 0),
+			network->getAtomMomentWeights(1, 0),
+			network->getAtomMomentWeights(2, 0) });
+	std::array<double, SizeStatistics::nMoments> moments { };
+	momentWeights.accumulate(concentrations.data(), 1.0, moments.data());
+	SizeStatistics stats;
+	stats.add(moments.data());
+	BOOST_REQUIRE_CLOSE(stats.getConcentration(), clusterConc, 1.0e-8);
+	BOOST_REQUIRE_CLOSE(stats.getMean(),
+			network->getTotalAtomConcentration(0) / clusterConc, 1.0e-8);
+	BOOST_REQUIRE_CLOSE(stats.getMaxMean(), stats.getMean(), 1.0e-8);
+
+	return;
+}
+
+/**
+ * This operation checks the statistics derived from the sums of the
+ * concentrations, sizes times concentrations, and sizes squared times
+ * concentrations of several regions.
+ */
+BOOST_AUTO_TEST_CASE(checkSizeStatistics) {
+	SizeStatistics stats;
+	BOOST_REQUIRE_EQUAL(stats.getMean(), 0.0);
+	BOOST_REQUIRE_EQUAL(stats.getVariance(), 0.0);
+
+	// A region with clusters of size 2, another with clusters of size 4
+	double firstRegion[3] = { 1.0, 2.0, 4.0 };
+	double secondRegion[3] = { 1.0, 4.0, 16.0 };
+	stats.add(firstRegion);
+	BOOST_REQUIRE_CLOSE(stats.getMean(), 2.0, 1.0e-12);
+	BOOST_REQUIRE_SMALL(stats.getVariance(), 1.0e-12);
+	stats.add(secondRegion);
+	BOOST_REQUIRE_CLOSE(stats.getConcentration(), 2.0, 1.0e-12);
+	BOOST_REQUIRE_CLOSE(stats.getMean(), 3.0, 1.0e-12);
+	BOOST_REQUIRE_CLOSE(stats.getVariance(), 1.0, 1.0e-12);
+	BOOST_REQUIRE_CLOSE(stats.getMaxMean(), 4.0, 1.0e-12);
+
+	return;
+}
+
 /**
  * This operation checks the boundary methods for PSISuperCluster.
  */
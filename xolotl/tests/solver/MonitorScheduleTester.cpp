@@ -0,0 +1,106 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Regression
+
+#include <boost/test/unit_test.hpp>
+#include <string>
+#include <MonitorSchedule.h>
+
+using namespace std;
+using namespace xolotlSolver;
+
+/**
+ * The test suite configuration
+ */
+BOOST_AUTO_TEST_SUITE (MonitorScheduleTester_testSuite)
+
+/**
+ * This operation checks the schedules on the time steps.
+ */
+BOOST_AUTO_TEST_CASE(checkSteps) {
+	// Every step by default
+	MonitorSchedule everyStep;
+	for (int i = 0; i < 5; i++) {
+		BOOST_REQUIRE(everyStep.isDue(i, 0.1 * i, 0.1));
+	}
+
+	// Every third step
+	auto schedule = MonitorSchedule::fromString("steps:3");
+	BOOST_REQUIRE(schedule.isDue(0, 0.0, 0.0));
+	BOOST_REQUIRE(!schedule.isDue(1, 0.1, 0.1));
+	BOOST_REQUIRE(!schedule.isDue(2, 0.2, 0.1));
+	BOOST_REQUIRE(schedule.isDue(3, 0.3, 0.1));
+	BOOST_REQUIRE(!schedule.isDue(4, 0.4, 0.1));
+	BOOST_REQUIRE(schedule.isDue(6, 0.6, 0.1));
+
+	// The first step seen is always due, as after a restart
+	auto restarted = MonitorSchedule::fromString("steps:3");
+	BOOST_REQUIRE(restarted.isDue(4, 0.4, 0.1));
+	BOOST_REQUIRE(!restarted.isDue(5, 0.5, 0.1));
+}
+
+/**
+ * This operation checks the schedules on the simulated time.
+ */
+BOOST_AUTO_TEST_CASE(checkTime) {
+	auto schedule = MonitorSchedule::fromString("time:1.0");
+	BOOST_REQUIRE(schedule.isDue(0, 0.0, 0.0));
+	BOOST_REQUIRE(!schedule.isDue(1, 0.5, 0.5));
+	// Just before the multiple of the interval
+	BOOST_REQUIRE(schedule.isDue(2, 0.99, 0.49));
+	BOOST_REQUIRE(!schedule.isDue(3, 1.5, 0.51));
+	// A long step over several intervals only samples once
+	BOOST_REQUIRE(schedule.isDue(4, 3.5, 2.0));
+	BOOST_REQUIRE(!schedule.isDue(5, 3.7, 0.2));
+	BOOST_REQUIRE(schedule.isDue(6, 4.0, 0.3));
+}
+
+/**
+ * This operation checks the schedules on the log scale of the time.
+ */
+BOOST_AUTO_TEST_CASE(checkLogTime) {
+	// Once per decade
+	auto schedule = MonitorSchedule::fromString("log:1");
+	BOOST_REQUIRE(schedule.isDue(0, 0.0, 0.0));
+	BOOST_REQUIRE(schedule.isDue(1, 1.0e-3, 1.0e-3));
+	BOOST_REQUIRE(!schedule.isDue(2, 5.0e-3, 4.0e-3));
+	BOOST_REQUIRE(schedule.isDue(3, 1.1e-2, 6.0e-3));
+	BOOST_REQUIRE(!schedule.isDue(4, 0.1, 8.9e-2));
+	BOOST_REQUIRE(schedule.isDue(5, 0.2, 0.1));
+}
+
+/**
+ * This operation checks the schedules on the events.
+ */
+BOOST_AUTO_TEST_CASE(checkEvents) {
+	auto schedule = MonitorSchedule::fromString("events");
+	BOOST_REQUIRE(schedule.isDue(0, 0.0, 0.0));
+	BOOST_REQUIRE(!schedule.isDue(1, 0.1, 0.1));
+
+	MonitorSchedule::notifyEvent();
+	BOOST_REQUIRE(schedule.isDue(2, 0.2, 0.1));
+	BOOST_REQUIRE(!schedule.isDue(3, 0.3, 0.1));
+}
+
+/**
+ * This operation checks the schedules on the rejected steps, without any
+ * time stepper rejecting them.
+ */
+BOOST_AUTO_TEST_CASE(checkRejections) {
+	auto schedule = MonitorSchedule::fromString("rejections");
+	BOOST_REQUIRE(schedule.isDue(0, 0.0, 0.0));
+	BOOST_REQUIRE(!schedule.isDue(1, 0.1, 0.1));
+	BOOST_REQUIRE(!schedule.isDue(2, 0.2, 0.1));
+}
+
+/**
+ * This operation checks that the invalid descriptions are rejected.
+ */
+BOOST_AUTO_TEST_CASE(checkInvalid) {
+	BOOST_REQUIRE_THROW(MonitorSchedule::fromString("steps"), std::string);
+	BOOST_REQUIRE_THROW(MonitorSchedule::fromString("time:0"), std::string);
+	BOOST_REQUIRE_THROW(MonitorSchedule::fromString("steps:0.4"), std::string);
+	BOOST_REQUIRE_THROW(MonitorSchedule::fromString("steps:2.5"), std::string);
+	BOOST_REQUIRE_THROW(MonitorSchedule::fromString("daily:1"), std::string);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,101 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Regression
+
+#include <boost/test/included/unit_test.hpp>
+#include <PointReduction.h>
+
+using namespace std;
+using namespace xolotlViz;
+
+/**
+ * This suite is responsible for testing the point reductions.
+ */
+BOOST_AUTO_TEST_SUITE(PointReduction_testSuite)
+
+/**
+ * Method checking that the decimation keeps the extrema of each bin.
+ */
+BOOST_AUTO_TEST_CASE(checkDecimateMinMax) {
+	// Create a series of points
+	vector<Point> points;
+	double values[] = { 1.0, 5.0, 3.0, 2.0, 2.0, 2.0, 0.5 };
+	for (int i = 0; i < 7; i++) {
+		Point aPoint;
+		aPoint.x = (double) i;
+		aPoint.value = values[i];
+		points.push_back(aPoint);
+	}
+
+	// Nothing is removed with bins of one point
+	BOOST_REQUIRE_EQUAL(decimateMinMax(points, 1).size(), 7U);
+
+	// Bins of three points
+	auto reduced = decimateMinMax(points, 3);
+	BOOST_REQUIRE_EQUAL(reduced.size(), 4U);
+	BOOST_REQUIRE_EQUAL(reduced[0].x, 0.0);
+	BOOST_REQUIRE_EQUAL(reduced[1].x, 1.0);
+	// The constant bin gives a single point
+	BOOST_REQUIRE_EQUAL(reduced[2].x, 3.0);
+	BOOST_REQUIRE_EQUAL(reduced[3].value, 0.5);
+
+	return;
+}
+
+/**
+ * Method checking the binning on the logarithm of the size.
+ */
+BOOST_AUTO_TEST_CASE(checkBinLogX) {
+	// Create the size distribution from 1 to 100
+	vector<Point> points;
+	for (int i = 1; i <= 100; i++) {
+		Point aPoint;
+		aPoint.x = (double) i;
+		aPoint.value = 1.0;
+		points.push_back(aPoint);
+	}
+
+	// One bin per decade: [1, 10), [10, 100), and 100
+	auto reduced = binLogX(points, 1);
+	BOOST_REQUIRE_EQUAL(reduced.size(), 3U);
+	BOOST_REQUIRE_CLOSE(reduced[0].x, 5.0, 0.0001);
+	BOOST_REQUIRE_CLOSE(reduced[1].x, 54.5, 0.0001);
+	BOOST_REQUIRE_CLOSE(reduced[2].x, 100.0, 0.0001);
+	BOOST_REQUIRE_CLOSE(reduced[1].value, 1.0, 0.0001);
+
+	// Nothing is binned without bins
+	BOOST_REQUIRE_EQUAL(binLogX(points, 0).size(), 100U);
+
+	return;
+}
+
+/**
+ * Method checking the coarsening of a map.
+ */
+BOOST_AUTO_TEST_CASE(checkCoarsenXY) {
+	// Create a 4 x 3 map, row after row
+	vector<Point> points;
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 4; j++) {
+			Point aPoint;
+			aPoint.x = (double) j;
+			aPoint.y = (double) i;
+			aPoint.value = (double) (j + 4 * i);
+			points.push_back(aPoint);
+		}
+	}
+
+	// Blocks of 2 x 2 cells, the last row being half a block
+	auto reduced = coarsenXY(points, 2);
+	BOOST_REQUIRE_EQUAL(reduced.size(), 4U);
+	BOOST_REQUIRE_CLOSE(reduced[0].x, 0.5, 0.0001);
+	BOOST_REQUIRE_CLOSE(reduced[0].y, 0.5, 0.0001);
+	BOOST_REQUIRE_CLOSE(reduced[0].value, 2.5, 0.0001);
+	BOOST_REQUIRE_CLOSE(reduced[1].x, 2.5, 0.0001);
+	BOOST_REQUIRE_CLOSE(reduced[1].value, 4.5, 0.0001);
+	BOOST_REQUIRE_CLOSE(reduced[2].y, 2.0, 0.0001);
+	BOOST_REQUIRE_CLOSE(reduced[3].value, 10.5, 0.0001);
+
+	return;
+}
+
+BOOST_AUTO_TEST_SUITE_END()
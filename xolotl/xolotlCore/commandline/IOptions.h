@@ -364,6 +364,19 @@ public:
 	 */
 	virtual void setRegularXGrid(bool flag) = 0;
 
+	/**
+	 * Should the grid on the x direction be adapted to the solution
+	 * when restarting?
+	 * @return true if program should adapt the grid, false if not
+	 */
+	virtual bool useAdaptiveXGrid() const = 0;
+
+	/**
+	 * Set the useAdaptiveGridFlag.
+	 * @param flag The value for the useAdaptiveGridFlag.
+	 */
+	virtual void setAdaptiveXGrid(bool flag) = 0;
+
 	/**
 	 * Obtain the physical process map.
 	 *
@@ -668,6 +681,52 @@ public:
 	 */
 	virtual void setBurstingDepth(double depth) = 0;
 
+	/**
+	 * Should the checkpoint concentrations be shuffled before
+	 * being compressed?
+	 *
+	 * @return true if the shuffle filter should be used
+	 */
+	virtual bool useCheckpointShuffle() const = 0;
+
+	/**
+	 * Set the checkpointShuffleFlag.
+	 *
+	 * @param flag The value for the checkpointShuffleFlag
+	 */
+	virtual void setCheckpointShuffle(bool flag) = 0;
+
+	/**
+	 * Obtain the deflate level used to compress the checkpoint
+	 * concentrations, 0 meaning no compression.
+	 *
+	 * @return The level between 0 and 9
+	 */
+	virtual int getCheckpointDeflateLevel() const = 0;
+
+	/**
+	 * Set the deflate level used to compress the checkpoint concentrations.
+	 *
+	 * @param level The level between 0 and 9
+	 */
+	virtual void setCheckpointDeflateLevel(int level) = 0;
+
+	/**
+	 * Obtain the number of mantissa bits kept when writing the
+	 * checkpoint concentrations, 0 meaning they are kept exactly.
+	 *
+	 * @return The number of bits
+	 */
+	virtual int getCheckpointLossyBits() const = 0;
+
+	/**
+	 * Set the number of mantissa bits kept when writing the
+	 * checkpoint concentrations.
+	 *
+	 * @param bits The number of bits
+	 */
+	virtual void setCheckpointLossyBits(int bits) = 0;
+
 	/**
 	 * Set the seed that should be used for initializing the random
 	 * number generator.
@@ -26,6 +26,7 @@
 #include <BurstingDepthOptionHandler.h>
 #include <RNGOptionHandler.h>
 #include <EStoppingPowerOptionHandler.h>
+#include <CompressionOptionHandler.h>
 #include "Options.h"
 
 namespace xolotlCore {
@@ -38,13 +39,15 @@ Options::Options() :
 				0.0), fluxProfileFlag(false), perfRegistryType(
 				xolotlPerf::IHandlerRegistry::std), vizStandardHandlersFlag(
 				false), materialName(""), initialVConcentration(0.0), voidPortion(
-				50.0), dimensionNumber(1), useRegularGridFlag(true), gbList(""), groupingMin(
+				50.0), dimensionNumber(1), useRegularGridFlag(true), useAdaptiveGridFlag(
+				false), gbList(""), groupingMin(
 				std::numeric_limits<int>::max()), groupingWidthA(1), groupingWidthB(
 				1), sputteringYield(0.0), useHDF5Flag(true), usePhaseCutFlag(
 				false), maxImpurity(8), maxD(0), maxT(0), maxV(20), maxI(6), nX(
 				10), nY(0), nZ(0), xStepSize(0.5), yStepSize(0.0), zStepSize(
 				0.0), leftBoundary(1), rightBoundary(1), bottomBoundary(1), topBoundary(
-				1), frontBoundary(1), backBoundary(1), burstingDepth(10.0), rngUseSeed(
+				1), frontBoundary(1), backBoundary(1), burstingDepth(10.0), checkpointShuffleFlag(
+				false), checkpointDeflateLevel(0), checkpointLossyBits(0), rngUseSeed(
 				false), rngSeed(0), rngPrintSeed(false), zeta(0.73) {
 
 	// Create the network option handler
@@ -95,6 +98,8 @@ Options::Options() :
 	auto rngHandler = new RNGOptionHandler();
 	// Create handler for the electronic stopping power options.
 	auto espHandler = new EStoppingPowerOptionHandler();
+	// Create the checkpoint compression option handler
+	auto compressionHandler = new CompressionOptionHandler();
 
 	// Add our notion of which options we support.
 	optionsMap[networkHandler->key] = networkHandler;
@@ -121,6 +126,7 @@ Options::Options() :
 	optionsMap[burstingHandler->key] = burstingHandler;
 	optionsMap[rngHandler->key] = rngHandler;
 	optionsMap[espHandler->key] = espHandler;
+	optionsMap[compressionHandler->key] = compressionHandler;
 }
 
 Options::~Options(void) {
@@ -134,6 +134,11 @@ protected:
 	 */
 	bool useRegularGridFlag;
 
+	/**
+	 * Adapt the grid on the x direction to the solution when restarting?
+	 */
+	bool useAdaptiveGridFlag;
+
 	/**
 	 * The map of physical processes to use in the simulation.
 	 */
@@ -240,6 +245,21 @@ protected:
 	 */
 	double burstingDepth;
 
+	/**
+	 * Shuffle the checkpoint concentrations before compressing them?
+	 */
+	bool checkpointShuffleFlag;
+
+	/**
+	 * Deflate level for the checkpoint concentrations.
+	 */
+	int checkpointDeflateLevel;
+
+	/**
+	 * Number of mantissa bits kept for the checkpoint concentrations.
+	 */
+	int checkpointLossyBits;
+
 	/**
 	 * An explicitly-given value to use to seed the random number generator.
 	 * Only used if rngUseSeed is true.
@@ -654,6 +674,22 @@ public:
 		useRegularGridFlag = flag;
 	}
 
+	/**
+	 * Should the grid on the x direction be adapted to the solution?
+	 * \see IOptions.h
+	 */
+	bool useAdaptiveXGrid() const override {
+		return useAdaptiveGridFlag;
+	}
+
+	/**
+	 * Set the useAdaptiveGridFlag.
+	 * \see IOptions.h
+	 */
+	void setAdaptiveXGrid(bool flag) override {
+		useAdaptiveGridFlag = flag;
+	}
+
 	/**
 	 * Obtain the physical process map.
 	 *
@@ -1022,6 +1058,56 @@ public:
 		burstingDepth = depth;
 	}
 
+	/**
+	 * Should the checkpoint concentrations be shuffled?
+	 * \see IOptions.h
+	 */
+	bool useCheckpointShuffle() const override {
+		return checkpointShuffleFlag;
+	}
+
+	/**
+	 * Set the checkpointShuffleFlag.
+	 * \see IOptions.h
+	 */
+	void setCheckpointShuffle(bool flag) override {
+		checkpointShuffleFlag = flag;
+	}
+
+	/**
+	 * Obtain the deflate level for the checkpoint concentrations.
+	 * \see IOptions.h
+	 */
+	int getCheckpointDeflateLevel() const override {
+		return checkpointDeflateLevel;
+	}
+
+	/**
+	 * Set the deflate level for the checkpoint concentrations.
+	 * \see IOptions.h
+	 */
+	void setCheckpointDeflateLevel(int level) override {
+		checkpointDeflateLevel = level;
+	}
+
+	/**
+	 * Obtain the number of mantissa bits kept for the checkpoint
+	 * concentrations.
+	 * \see IOptions.h
+	 */
+	int getCheckpointLossyBits() const override {
+		return checkpointLossyBits;
+	}
+
+	/**
+	 * Set the number of mantissa bits kept for the checkpoint
+	 * concentrations.
+	 * \see IOptions.h
+	 */
+	void setCheckpointLossyBits(int bits) override {
+		checkpointLossyBits = bits;
+	}
+
 	/**
 	 * Set the seed that should be used for initializing the random
 	 * number generator.
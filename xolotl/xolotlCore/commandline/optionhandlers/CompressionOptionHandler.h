@@ -0,0 +1,103 @@
+#ifndef COMPRESSIONOPTIONHANDLER_H
+#define COMPRESSIONOPTIONHANDLER_H
+
+// Includes
+#include "OptionHandler.h"
+
+namespace xolotlCore {
+
+/**
+ * CompressionOptionHandler handles the compression of the concentrations
+ * written in the checkpoint files.
+ */
+class CompressionOptionHandler: public OptionHandler {
+public:
+
+	/**
+	 * The default constructor
+	 */
+	CompressionOptionHandler() :
+			OptionHandler("compression",
+					"compression <filters>             "
+					"This option allows the compression of the concentrations "
+					"in the checkpoint files with the given list of filters: "
+					"shuffle, deflate [level] (6 by default), lossy [bits] (20 by default).\n"
+					"                                    lossy only keeps the given number of "
+					"mantissa bits and only applies to the analysis files "
+					"(-start_stop_analysis),\n"
+					"                                    the checkpoint files are always "
+					"written without loss to restart from.\n") {
+	}
+
+	/**
+	 * The destructor
+	 */
+	~CompressionOptionHandler() {
+	}
+
+	/**
+	 * This method will set the IOptions checkpoint compression parameters
+	 * to the value given as the argument.
+	 *
+	 * @param opt The pointer to the option that will be modified.
+	 * @param arg The list of compression filters.
+	 */
+	bool handler(IOptions *opt, const std::string& arg) {
+		// Build an input stream from the argument
+		xolotlCore::TokenizedLineReader<std::string> reader;
+		auto argSS = std::make_shared < std::istringstream > (arg);
+		reader.setInputStream(argSS);
+		// Break the string into tokens.
+		auto tokens = reader.loadLine();
+
+		for (int i = 0; i < tokens.size(); i++) {
+			// Is the next token a number?
+			bool hasValue = (i + 1 < tokens.size())
+					&& isdigit(tokens[i + 1][0]);
+
+			if (tokens[i] == "shuffle") {
+				opt->setCheckpointShuffle(true);
+			} else if (tokens[i] == "deflate") {
+				int level = 6;
+				if (hasValue)
+					level = strtol(tokens[++i].c_str(), NULL, 10);
+				if (level < 0 || level > 9) {
+					std::cerr << "Options: the deflate level must be between "
+							"0 and 9, not " << level << std::endl;
+					opt->setShouldRunFlag(false);
+					opt->setExitCode(EXIT_FAILURE);
+					return false;
+				}
+				opt->setCheckpointDeflateLevel(level);
+			} else if (tokens[i] == "lossy") {
+				int bits = 20;
+				if (hasValue)
+					bits = strtol(tokens[++i].c_str(), NULL, 10);
+				if (bits < 1 || bits > 52) {
+					std::cerr << "Options: the number of lossy bits must be "
+							"between 1 and 52, not " << bits << std::endl;
+					opt->setShouldRunFlag(false);
+					opt->setExitCode(EXIT_FAILURE);
+					return false;
+				}
+				opt->setCheckpointLossyBits(bits);
+			} else {
+				std::cerr << "Options: unrecognized argument in the "
+						"compression option handler: " << tokens[i]
+						<< std::endl;
+				opt->showHelp(std::cerr);
+				opt->setShouldRunFlag(false);
+				opt->setExitCode(EXIT_FAILURE);
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+};
+//end class CompressionOptionHandler
+
+} /* namespace xolotlCore */
+
+#endif
@@ -8,7 +8,8 @@ namespace xolotlCore {
 
 /**
  * RegularGridOptionHandler handles the choice for the grid in the x direction.
- * It will be either regular or not.
+ * It will be either regular, not regular, or not regular and adapted to the
+ * solution when restarting.
  */
 class RegularGridOptionHandler: public OptionHandler {
 public:
@@ -18,8 +19,10 @@ public:
 	 */
 	RegularGridOptionHandler() :
 		OptionHandler("regularGrid",
-				"regularGrid {yes,  no}            "
-				"Will the grid be regularly spaced in the x direction?\n") {}
+				"regularGrid {yes,  no, adaptive}  "
+				"Will the grid be regularly spaced in the x direction? "
+				"(adaptive moves the points toward the steep parts "
+				"of the solution when restarting)\n") {}
 
 	/**
 	 * The destructor
@@ -42,6 +45,10 @@ public:
 		else if (arg == "no") {
 			opt->setRegularXGrid(false);
 		}
+		else if (arg == "adaptive") {
+			opt->setRegularXGrid(false);
+			opt->setAdaptiveXGrid(true);
+		}
 		else {
 			std::cerr << "Options: unrecognized argument in the regular grid option handler: "
 					<< arg << std::endl;
@@ -0,0 +1,149 @@
+#include <iostream>
+#include "xolotlCore/io/AsyncWriter.h"
+
+namespace xolotlCore {
+
+AsyncWriter::AsyncWriter(MPI_Comm _comm, bool _async) :
+		comm(MPI_COMM_NULL), async(_async), busy(false), stopping(false) {
+
+	// The tasks don't use MPI
+	if (_comm == MPI_COMM_NULL)
+		return;
+
+	// Collective operations on the I/O thread must not mix with the
+	// ones of the solver.
+	MPI_Comm_dup(_comm, &comm);
+
+	// The I/O thread calls MPI concurrently with the solver
+	if (async) {
+		int provided = MPI_THREAD_SINGLE;
+		MPI_Query_thread(&provided);
+		if (provided < MPI_THREAD_MULTIPLE) {
+			int rank;
+			MPI_Comm_rank(comm, &rank);
+			if (rank == 0) {
+				std::cerr << "AsyncWriter: MPI does not provide "
+						"MPI_THREAD_MULTIPLE, writing synchronously."
+						<< std::endl;
+			}
+			async = false;
+		}
+	}
+}
+
+AsyncWriter::~AsyncWriter(void) {
+
+	if (ioThread.joinable()) {
+		// Let the I/O thread write what is left and stop
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		stateChanged.notify_all();
+		ioThread.join();
+
+		if (error) {
+			try {
+				std::rethrow_exception(error);
+			} catch (const std::exception& e) {
+				std::cerr << "AsyncWriter: " << e.what() << std::endl;
+			} catch (const std::string& e) {
+				std::cerr << "AsyncWriter: " << e << std::endl;
+			} catch (...) {
+				std::cerr << "AsyncWriter: unrecognized exception."
+						<< std::endl;
+			}
+		}
+	}
+
+	if (comm != MPI_COMM_NULL)
+		MPI_Comm_free(&comm);
+}
+
+void AsyncWriter::run(void) {
+
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		// Wait for a task or the end
+		stateChanged.wait(lock, [this]() {return pending || stopping;});
+		if (!pending)
+			break;
+
+		// Take the task, freeing the buffer for the next one
+		Task task;
+		std::swap(task, pending);
+		busy = true;
+		lock.unlock();
+		stateChanged.notify_all();
+
+		// Write without holding the lock
+		try {
+			task(comm);
+		} catch (...) {
+			std::lock_guard<std::mutex> errorLock(mutex);
+			if (!error)
+				error = std::current_exception();
+		}
+
+		lock.lock();
+		busy = false;
+		stateChanged.notify_all();
+	}
+
+	return;
+}
+
+void AsyncWriter::rethrowError(void) {
+
+	if (error) {
+		auto toThrow = error;
+		error = nullptr;
+		std::rethrow_exception(toThrow);
+	}
+
+	return;
+}
+
+void AsyncWriter::submit(Task task) {
+
+	if (!async) {
+		task(comm);
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(mutex);
+	rethrowError();
+
+	// Back-pressure: wait for the previous snapshot to be taken
+	stateChanged.wait(lock, [this]() {return !pending;});
+	pending = std::move(task);
+	if (!ioThread.joinable())
+		ioThread = std::thread(&AsyncWriter::run, this);
+	lock.unlock();
+	stateChanged.notify_all();
+
+	return;
+}
+
+void AsyncWriter::drain(void) {
+
+	if (!async)
+		return;
+
+	std::unique_lock<std::mutex> lock(mutex);
+	stateChanged.wait(lock, [this]() {return !pending && !busy;});
+
+	return;
+}
+
+void AsyncWriter::flush(void) {
+
+	drain();
+
+	std::lock_guard<std::mutex> lock(mutex);
+	rethrowError();
+
+	return;
+}
+
+} // namespace xolotlCore
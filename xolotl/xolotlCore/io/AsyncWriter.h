@@ -0,0 +1,138 @@
+#ifndef XCORE_ASYNCWRITER_H
+#define XCORE_ASYNCWRITER_H
+
+#include <mpi.h>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+namespace xolotlCore {
+
+/**
+ * Runs write tasks (typically HDF5 checkpoint writes) on a dedicated
+ * I/O thread so that the caller can go back to computing as soon as it
+ * has taken a snapshot of the data to write.
+ *
+ * The writer works as a double buffer: one task can be written while
+ * the next one waits.  If a task is submitted while another one is
+ * still waiting, the caller blocks until the waiting task is started
+ * (back-pressure), so that at most two snapshots live in memory.
+ *
+ * The tasks are given a duplicate of the communicator given at
+ * construction, and must do all their MPI communication (including the
+ * one done by parallel HDF5) with it.  Every process must submit the
+ * same sequence of tasks.  Running collective operations from the I/O
+ * thread while the solver uses MPI requires MPI_THREAD_MULTIPLE; without
+ * it, or if not asked to, the tasks are run synchronously in submit().
+ *
+ * Given MPI_COMM_NULL instead, the tasks must not use MPI and the writer
+ * is a plain task queue, which does not need any MPI thread support.
+ * The I/O thread is only started by the first task, so the processes that
+ * never submit any do not have one.
+ *
+ * Note that all HDF5 calls must go through the writer while it can be
+ * running tasks since HDF5 is usually not built thread-safe.
+ */
+class AsyncWriter {
+public:
+	/**
+	 * Concise name for the write tasks.  They are given the
+	 * communicator to use.
+	 */
+	using Task = std::function<void(MPI_Comm)>;
+
+private:
+	//! The communicator given to the tasks.
+	MPI_Comm comm;
+
+	//! Whether the tasks are run on the I/O thread.
+	bool async;
+
+	//! The I/O thread, started by the first task.
+	std::thread ioThread;
+
+	//! Protects the members below.
+	std::mutex mutex;
+
+	//! Signals a change of state of the members below.
+	std::condition_variable stateChanged;
+
+	//! The task waiting to be written, empty if there is none.
+	Task pending;
+
+	//! Whether the I/O thread is running a task.
+	bool busy;
+
+	//! Whether the I/O thread should stop once it is done.
+	bool stopping;
+
+	//! The first error raised by a task, rethrown to the caller.
+	std::exception_ptr error;
+
+	/**
+	 * The loop of the I/O thread.
+	 */
+	void run(void);
+
+	/**
+	 * Rethrow the error raised by a previous task if any.
+	 * Must be called with the mutex locked.
+	 */
+	void rethrowError(void);
+
+protected:
+	/**
+	 * Wait until all the submitted tasks are written, without rethrowing
+	 * their errors, e.g., before destroying something the tasks use.
+	 */
+	void drain(void);
+
+public:
+	/**
+	 * Construct the writer.
+	 * Default and copy constructors explicitly disallowed.
+	 *
+	 * @param _comm The communicator of the processes submitting the tasks,
+	 *        MPI_COMM_NULL if the tasks don't use MPI.
+	 * @param _async Whether the tasks should be run on the I/O thread.
+	 */
+	AsyncWriter(void) = delete;
+	AsyncWriter(const AsyncWriter& other) = delete;
+	AsyncWriter(MPI_Comm _comm, bool _async);
+
+	/**
+	 * Wait for the submitted tasks to be written and stop the I/O thread.
+	 * Must be called before MPI is finalized.
+	 */
+	virtual ~AsyncWriter(void);
+
+	/**
+	 * Submit a task, blocking while a previously submitted task
+	 * is still waiting to be started.
+	 * Rethrows the error raised by a previous task if any.
+	 *
+	 * @param task The task to run.
+	 */
+	void submit(Task task);
+
+	/**
+	 * Wait until all the submitted tasks are written.
+	 * Rethrows the error raised by a previous task if any.
+	 */
+	void flush(void);
+
+	/**
+	 * Whether the tasks are run on the I/O thread.
+	 *
+	 * @return True if submit() returns before the task is written.
+	 */
+	bool isAsync(void) const {
+		return async;
+	}
+};
+
+} // namespace xolotlCore
+
+#endif // XCORE_ASYNCWRITER_H
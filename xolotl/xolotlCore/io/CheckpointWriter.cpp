@@ -0,0 +1,63 @@
+#include "xolotlCore/io/CheckpointWriter.h"
+
+namespace xolotlCore {
+
+// Enough for the metadata of a few hundred time step groups
+const size_t CheckpointWriter::metadataCacheSize = 16 * 1024 * 1024;
+
+CheckpointWriter::CheckpointWriter(MPI_Comm _comm, bool _async) :
+		AsyncWriter(_comm, _async) {
+}
+
+CheckpointWriter::~CheckpointWriter(void) {
+
+	// The tasks use the files, wait for them before closing them.
+	// Their errors are reported when the base class is destroyed.
+	drain();
+	files.clear();
+}
+
+XFile& CheckpointWriter::getFile(MPI_Comm comm, const std::string& fileName) {
+
+	auto& file = files[fileName];
+	if (!file) {
+		// Every process does the same accesses in the same order
+		file.reset(
+				new XFile(fileName, comm, XFile::AccessMode::OpenReadWrite,
+						true));
+		file->setMetadataCacheSize(metadataCacheSize);
+	}
+
+	return *file;
+}
+
+void CheckpointWriter::removeOldTimestepGroups(MPI_Comm comm,
+		const std::string& fileName, int nKept) {
+
+	// Every process removes the same groups from the open file
+	auto& file = getFile(comm, fileName);
+	auto concGroup = file.getGroup<XFile::ConcentrationGroup>();
+	if (!concGroup)
+		return;
+	int nNewlyRemoved = concGroup->removeOldTimestepGroups(nKept);
+	if (nNewlyRemoved == 0)
+		return;
+
+	// Until the removed groups add up to the kept ones, only make sure
+	// the file on the disk doesn't have them anymore
+	auto& nRemoved = nRemovedGroups[fileName];
+	nRemoved += nNewlyRemoved;
+	int nLeft = concGroup->getTimeSteps().size();
+	if (nRemoved < nLeft) {
+		file.flush();
+		return;
+	}
+
+	// Then give their space back, closing the file before it is replaced
+	concGroup.reset();
+	files.erase(fileName);
+	nRemoved = 0;
+	XFile::compact(fileName, comm);
+}
+
+} // namespace xolotlCore
@@ -0,0 +1,81 @@
+#ifndef XCORE_CHECKPOINTWRITER_H
+#define XCORE_CHECKPOINTWRITER_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include "xolotlCore/io/AsyncWriter.h"
+#include "xolotlCore/io/XFile.h"
+
+namespace xolotlCore {
+
+/**
+ * An AsyncWriter for the checkpoint files that keeps them open from
+ * one task to the next.  Reopening a file at each checkpoint costs a
+ * collective open and a reload of the metadata of a file that keeps
+ * growing with the number of time step groups.
+ *
+ * The files are opened with collective metadata accesses, so every
+ * process must access them in the same way, and they must not be opened
+ * anywhere else while the writer is alive.
+ */
+class CheckpointWriter: public AsyncWriter {
+private:
+	//! The initial size of the metadata cache of the file.
+	static const size_t metadataCacheSize;
+
+	//! The open files, by path, only accessed by the tasks.
+	std::map<std::string, std::unique_ptr<XFile> > files;
+
+	//! The number of time step groups removed from each file since it was
+	//! last compacted, by path.
+	std::map<std::string, int> nRemovedGroups;
+
+public:
+	/**
+	 * Construct the writer.
+	 * Default and copy constructors explicitly disallowed.
+	 *
+	 * @param _comm The communicator of the processes submitting the tasks.
+	 * @param _async Whether the tasks should be run on the I/O thread.
+	 */
+	CheckpointWriter(void) = delete;
+	CheckpointWriter(const CheckpointWriter& other) = delete;
+	CheckpointWriter(MPI_Comm _comm, bool _async);
+
+	/**
+	 * Wait for the submitted tasks to be written and close the files.
+	 */
+	~CheckpointWriter(void);
+
+	/**
+	 * Access a checkpoint file, opening it the first time.
+	 * The file must already exist.  Must only be called from the tasks.
+	 *
+	 * @param comm The communicator given to the task.
+	 * @param fileName The path of the file.
+	 * @return The open file.
+	 */
+	XFile& getFile(MPI_Comm comm, const std::string& fileName);
+
+	/**
+	 * Remove the oldest time step groups of a checkpoint file, keeping the
+	 * given number of most recent ones and the keyframes they need.  The
+	 * groups are removed in place, and the file is only compacted once as
+	 * many groups were removed as are kept, so that the copy is rare and
+	 * the file takes at most about twice the space of what is kept.  The
+	 * next getFile then opens the compacted file.
+	 * Must only be called from the tasks.
+	 *
+	 * @param comm The communicator given to the task.
+	 * @param fileName The path of the file.
+	 * @param nKept The number of most recent groups to keep, all of them
+	 *        if it is not positive.
+	 */
+	void removeOldTimestepGroups(MPI_Comm comm, const std::string& fileName,
+			int nKept);
+};
+
+} // namespace xolotlCore
+
+#endif // XCORE_CHECKPOINTWRITER_H
@@ -1,5 +1,6 @@
 #include <sstream>
 #include <array>
+#include <algorithm>
 #include "hdf5.h"
 #include "xolotlCore/io/HDF5File.h"
 #include "xolotlCore/io/HDF5Exception.h"
@@ -84,7 +85,8 @@ HDF5File::BuildHDF5ErrorString(void) {
 void HDF5File::Open(fs::path _path,
                     AccessMode _mode,
                     MPI_Comm _comm,
-                    bool par) {
+                    bool par,
+                    bool collectiveMetadata) {
 
     // Obtain the HDF5 flag that corresponds to requested access mode.
     auto hdf5Mode = toHDF5AccessMode(_mode);
@@ -95,6 +97,15 @@ void HDF5File::Open(fs::path _path,
     if(par) {
         // Use parallel I/O for accessing this file.
         H5Pset_fapl_mpio(plistId, _comm, MPI_INFO_NULL);
+
+#if H5_VERSION_GE(1,10,0)
+        if(collectiveMetadata) {
+            // One process reads the metadata and broadcasts it, and
+            // the metadata is written all at once.
+            H5Pset_all_coll_metadata_ops(plistId, true);
+            H5Pset_coll_metadata_write(plistId, true);
+        }
+#endif
     }
     else {
         // Do not use parallel I/O when accessing this file.
@@ -120,6 +131,33 @@ void HDF5File::Open(fs::path _path,
     }
 }
 
+void
+HDF5File::setMetadataCacheSize(size_t initSize) const {
+
+    H5AC_cache_config_t config;
+    config.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+    if(H5Fget_mdc_config(getId(), &config) < 0) {
+        throw HDF5Exception(BuildHDF5ErrorString());
+    }
+
+    // Let the cache adapt from the given size
+    config.set_initial_size = true;
+    config.initial_size = initSize;
+    config.max_size = std::max(config.max_size, initSize);
+    config.min_size = std::min(config.min_size, initSize);
+    if(H5Fset_mdc_config(getId(), &config) < 0) {
+        throw HDF5Exception(BuildHDF5ErrorString());
+    }
+}
+
+void
+HDF5File::flush(void) const {
+
+    if(H5Fflush(getId(), H5F_SCOPE_GLOBAL) < 0) {
+        throw HDF5Exception(BuildHDF5ErrorString());
+    }
+}
+
 bool
 HDF5File::hasGroup(fs::path path) const {
 
@@ -22,6 +22,37 @@ public:
         CreateOrFailIfExists
     };
 
+    // How the large datasets (e.g., concentrations) are stored.
+    // When any filter is used, the datasets are chunked.
+    struct Compression {
+        /// Whether to reorder the bytes of the values before deflating.
+        bool shuffle;
+
+        /// The deflate (gzip) level, 0 to not deflate.
+        int deflateLevel;
+
+        /// The number of mantissa bits kept in floating point values,
+        /// 0 to keep them all.  Rounding the others gives a relative
+        /// error below 2^-lossyBits and makes the values much more
+        /// compressible.  Only for files that are not used to restart.
+        int lossyBits;
+
+        Compression(void)
+          : shuffle(false),
+            deflateLevel(0),
+            lossyBits(0)
+        { }
+
+        /**
+         * Determine whether the datasets need to be chunked.
+         *
+         * @return True iff a filter is used.
+         */
+        bool useFilters(void) const {
+            return shuffle or (deflateLevel > 0);
+        }
+    };
+
     // An HDF5 property list.
     class PropertyList : public HDF5Object {
     public:
@@ -212,10 +243,11 @@ public:
         DataSetTBase(void) = delete;
         DataSetTBase(const DataSetTBase<T>& other) = delete;
 
-        // Create data set.
+        // Create data set, with the given creation property list.
         DataSetTBase(const HDF5Object& loc,
                         std::string dsetName,
-                        const DataSpace& dspace);
+                        const DataSpace& dspace,
+                        hid_t dcplId = H5P_DEFAULT);
 
         // Open existing data set.
         DataSetTBase(const HDF5Object& loc, std::string dsetName);
@@ -286,9 +318,30 @@ public:
         /// Suffix to add to data set names for starting indices dataset.
         static const std::string startIndicesDatasetNameSuffix;
 
+        /// Suffix to add to data set names for N-D point indices dataset.
+        static const std::string pointIndicesDatasetNameSuffix;
+
         /// The MPI communicator used to access the file.
         MPI_Comm comm;
 
+        /// The largest number of items in a chunk of the flattened data.
+        static const hsize_t maxChunkSize;
+
+        /**
+         * Build the creation property list of the flattened data.
+         * When filters are used, the data is chunked so that
+         * chunks match the average part owned by each process.
+         *
+         * @param _comm The MPI communicator used to access the file.
+         * @param myNumItems The number of items we own.
+         * @param compression How to store the data.
+         * @return The dataset creation property list.
+         */
+        static std::unique_ptr<PropertyList> buildCreationPropertyList(
+                                            MPI_Comm _comm,
+                                            uint32_t myNumItems,
+                                            const Compression& compression);
+
 
         /**
          * Create the data set.
@@ -322,6 +375,13 @@ public:
         /// Concise name for type of flattened data.
         using FlatType = std::vector<T>;
 
+        /// Index of the first X point we own, when writing in parts.
+        int baseX;
+
+        /// Global index of the first item of each X point we own, plus
+        /// one past the last item, when writing in parts.
+        FlatStartingIndicesType pointStartingIndices;
+
         /**
          * Determine the number of values per grid point.
          *
@@ -331,16 +391,16 @@ public:
         static std::vector<uint32_t> findNumItemsByPoint(const Ragged2DType& data);
 
         /**
-         * Build a dataspace for the flattened data representing the given
-         * ragged data.
+         * Build a dataspace for the flattened data representing
+         * ragged data with the given number of values per grid point.
          *
          * @param _comm The MPI communicator used to access the file.
-         * @param data The ragged data to be written.
+         * @param myNumItemsByPoint The number of values of our grid points.
          * @return A DataSpace describing the shape of the flattened dataset.
          */
         static std::unique_ptr<SimpleDataSpace<1>> buildDataSpace(
-                                            MPI_Comm _comm,
-                                            const Ragged2DType& data);
+                                MPI_Comm _comm,
+                                const std::vector<uint32_t>& myNumItemsByPoint);
 
         /**
          * Read our part of the indexing metadata describing our
@@ -359,7 +419,7 @@ public:
          * part of the flattened data set.
          *
          * @param baseIdx Index of the first X point we own.
-         * @param data Our part of the data to write.
+         * @param myNumItemsByPoint The number of values of our grid points.
          * @return Pair (globalBaseIdx, myNumItems) where 
          *              globalBaseIdx is index of our first item
          *              within the global flattened data set, and
@@ -367,7 +427,8 @@ public:
          *              will write) from the flattened data set.
          */
         std::pair<uint32_t, uint32_t>
-        writeStartingIndices(int baseX, const Ragged2DType& data) const;
+        writeStartingIndices(int baseX,
+                    const std::vector<uint32_t>& myNumItemsByPoint) const;
 
 
         /**
@@ -411,12 +472,33 @@ public:
          * @param dsetName The name of the dataset.
          * @param baseX Index of the first X point we own.
          * @param data The data to be written.
+         * @param compression How to store the flattened data.
+         */
+        RaggedDataSet2D(MPI_Comm comm,
+                        const HDF5Object& loc,
+                        std::string dsetName,
+                        int baseX,
+                        const Ragged2DType& data,
+                        const Compression& compression = Compression());
+
+        /**
+         * Create the data set without writing the data, which is then
+         * written in parts with write() so that it never has to be
+         * held in memory at once.
+         *
+         * @param comm The MPI communicator used to access the file.
+         * @param loc The location (e.g., group) that contains our dataset.
+         * @param dsetName The name of the dataset.
+         * @param baseX Index of the first X point we own.
+         * @param myNumItemsByPoint The number of values of each X point we own.
+         * @param compression How to store the flattened data.
          */
         RaggedDataSet2D(MPI_Comm comm,
                         const HDF5Object& loc,
                         std::string dsetName,
                         int baseX,
-                        const Ragged2DType& data);
+                        const std::vector<uint32_t>& myNumItemsByPoint,
+                        const Compression& compression = Compression());
 
         /**
          * Open an existing data set.
@@ -437,6 +519,168 @@ public:
          * @return The data associated with X points in [baseX,baseX+numXs).
          */
         Ragged2DType read(int baseX, int numX) const;
+
+        /**
+         * Write part of the data of a data set created from the number
+         * of values per grid point.  This is a collective operation,
+         * every process must call it the same number of times, with no
+         * data if it has nothing left to write.
+         *
+         * @param firstX Index of the first X point in data, within
+         *              the X points we own.
+         * @param data The data of the X points [firstX, firstX+data.size()),
+         *              with as many values as given at creation.
+         */
+        void write(int firstX, const Ragged2DType& data) const;
+    };
+
+
+    // A DataSet for ragged data on an N-D grid.  (I.e., data where the
+    // number of items for each grid point may vary).
+    // Like RaggedDataSet2D, the items are stored in a flattened 1D dataset,
+    // but because the part of an N-D grid owned by a process is not
+    // contiguous in the global grid, each process writes the items of its
+    // own points contiguously, and an N-D index dataset gives the
+    // starting index and the number of items of each grid point.
+    // Coordinates are given slowest varying first (e.g., (y, x) in 2D),
+    // and the grid points owned by a process are given in the same order.
+    template<typename T, uint32_t N>
+    class RaggedDataSetND : public RaggedDataSetBase, public DataSetTBase<T> {
+    public:
+        /// Concise name for Ragged data type.
+        using Ragged2DType = std::vector<std::vector<T>>;
+
+        /// Concise name for coordinates on the grid.
+        using Coordinates = std::array<int, N>;
+
+    private:
+        /// Concise name for type of flattened data.
+        using FlatType = std::vector<T>;
+
+        /// Concise name for the dataspace of the index dataset.
+        /// The last dimension holds the starting index and number of items.
+        using IndexDataSpace = SimpleDataSpace<N + 1>;
+
+        /**
+         * Build a dataspace for the flattened data representing the given
+         * ragged data.
+         *
+         * @param _comm The MPI communicator used to access the file.
+         * @param data The ragged data to be written.
+         * @return A DataSpace describing the shape of the flattened dataset.
+         */
+        static std::unique_ptr<SimpleDataSpace<1>> buildDataSpace(
+                                            MPI_Comm _comm,
+                                            const Ragged2DType& data);
+
+        /**
+         * Select the part of the index dataset describing the given
+         * block of grid points.
+         *
+         * @param filespace The dataspace of the index dataset.
+         * @param base Coordinates of the first grid point of the block.
+         * @param count Number of grid points of the block in each direction.
+         * @return The dataspace describing the block in memory.
+         */
+        static std::unique_ptr<IndexDataSpace> selectIndices(
+                                            const IndexDataSpace& filespace,
+                                            const Coordinates& base,
+                                            const Coordinates& count);
+
+        /**
+         * Write the indexing metadata describing our part of the
+         * flattened data set.
+         *
+         * @param base Coordinates of the first grid point we own.
+         * @param count Number of grid points we own in each direction.
+         * @param data Our part of the data to write.
+         * @return Pair (globalBaseIdx, myNumItems) where globalBaseIdx
+         *              is index of our first item within the global
+         *              flattened data set, and myNumItems is the number
+         *              of items we own (and will write).
+         */
+        std::pair<uint32_t, uint32_t> writeIndices(const Coordinates& base,
+                                            const Coordinates& count,
+                                            const Ragged2DType& data) const;
+
+        /**
+         * Read the indexing metadata describing the given block of
+         * grid points.
+         *
+         * @param base Coordinates of the first grid point we own.
+         * @param count Number of grid points we own in each direction.
+         * @param collective Whether the read is collective.
+         * @return The starting index and number of items of each grid
+         *              point of the block, interleaved.
+         */
+        std::vector<uint32_t> readIndices(const Coordinates& base,
+                                            const Coordinates& count,
+                                            bool collective) const;
+
+        /**
+         * Read the items of the grid points described by the given
+         * indexing metadata.
+         *
+         * @param indices The starting index and number of items of each
+         *              grid point we own, interleaved.
+         * @param collective Whether the read is collective.
+         * @return The part of the ragged data set that we own.
+         */
+        Ragged2DType readData(const std::vector<uint32_t>& indices,
+                                bool collective) const;
+
+    public:
+        RaggedDataSetND(void) = delete;
+        RaggedDataSetND(const RaggedDataSetND& other) = delete;
+
+        /**
+         * Create and write the data set, as one collective write of the
+         * indexing metadata and one of the flattened data.
+         *
+         * @param comm The MPI communicator used to access the file.
+         * @param loc The location (e.g., group) that contains our dataset.
+         * @param dsetName The name of the dataset.
+         * @param base Coordinates of the first grid point we own.
+         * @param count Number of grid points we own in each direction.
+         * @param data The data to be written, one element per grid
+         *              point we own.
+         * @param compression How to store the flattened data.
+         */
+        RaggedDataSetND(MPI_Comm comm,
+                        const HDF5Object& loc,
+                        std::string dsetName,
+                        const Coordinates& base,
+                        const Coordinates& count,
+                        const Ragged2DType& data,
+                        const Compression& compression = Compression());
+
+        /**
+         * Open an existing data set.
+         *
+         * @param comm The MPI communicator used to access the file.
+         * @param loc The location (e.g., group) that contains our dataset.
+         * @param dsetName The name of the dataset.
+         */
+        RaggedDataSetND(MPI_Comm comm,
+                        const HDF5Object& loc,
+                        std::string dsetName);
+
+        /**
+         * Read the data of a block of grid points from an existing
+         * data set.  The block does not need to match the one
+         * written by any process.
+         *
+         * @param base Coordinates of the first grid point we own.
+         * @param count Number of grid points we own in each direction.
+         * @param collective Whether all the processes of the file's
+         *              communicator read (collective transfer), or only
+         *              this one, e.g., a single grid point (independent
+         *              transfer).
+         * @return The data associated with the grid points of the block.
+         */
+        Ragged2DType read(const Coordinates& base,
+                            const Coordinates& count,
+                            bool collective = true) const;
     };
 
 
@@ -685,6 +929,11 @@ private:
      */
     MPI_Comm comm;
 
+    /**
+     * How the large datasets are stored.
+     */
+    Compression compression;
+
 
 protected:
     /**
@@ -702,6 +951,38 @@ protected:
      */
     MPI_Comm getComm(void) const  { return comm; }
 
+public:
+    /**
+     * Access how the large datasets are stored.
+     *
+     * @return How the large datasets are stored.
+     */
+    const Compression& getCompression(void) const  { return compression; }
+
+    /**
+     * Set the size of the metadata cache, for files that stay open
+     * while growing.
+     *
+     * @param initSize The initial size of the cache in bytes.
+     */
+    void setMetadataCacheSize(size_t initSize) const;
+
+    /**
+     * Write everything that is cached for our file to the disk.
+     */
+    void flush(void) const;
+
+    /**
+     * Choose how the large datasets created from now on are stored.
+     *
+     * @param _compression How the large datasets are stored.
+     */
+    void setCompression(const Compression& _compression) {
+        compression = _compression;
+    }
+
+protected:
+
 	/**
 	 * Close our file.
 	 */
@@ -719,11 +1000,14 @@ protected:
 	 * @param _mode Access mode for creating/opening the file.
 	 * @param _comm Communicator to use for accessing the file.
 	 * @param par Whether to access the file using parallel I/O.
+	 * @param collectiveMetadata Whether all the metadata accesses are
+	 *          done by all the processes at once.
 	 */
 	void Open(fs::path _path,
 				AccessMode _mode,
 				MPI_Comm _comm,
-				bool par);
+				bool par,
+				bool collectiveMetadata = false);
 
 public:
 	/**
@@ -732,15 +1016,20 @@ public:
 	 * @param _path Path of file to create or open.
 	 * @param _mode Access mode for creating/opening the file.
 	 * @param par Whether to access the file with parallel I/O.
+	 * @param collectiveMetadata Whether all the metadata accesses
+	 *          (e.g., opening groups and attributes) are done by all the
+	 *          processes at once, instead of each process reading the
+	 *          file.  Requires every process to do the same accesses.
 	 */
 	HDF5File(fs::path _path,
 				AccessMode _mode,
 				MPI_Comm _comm = MPI_COMM_WORLD,
-				bool par = true )
+				bool par = true,
+				bool collectiveMetadata = false)
 	  : HDF5Object("/"),
 		comm(_comm) {
 
-		Open(_path, _mode, _comm, par);
+		Open(_path, _mode, _comm, par, collectiveMetadata);
 	}
 
 	/**
@@ -1,7 +1,49 @@
+#include <algorithm>
 #include "xolotlCore/io/HDF5File.h"
 
 namespace xolotlCore {
 
 const std::string HDF5File::RaggedDataSetBase::startIndicesDatasetNameSuffix = "_startingIndices";
+const std::string HDF5File::RaggedDataSetBase::pointIndicesDatasetNameSuffix = "_pointIndices";
+
+// HDF5 chunks must be smaller than 4 GB.
+const hsize_t HDF5File::RaggedDataSetBase::maxChunkSize = 1 << 24;
+
+std::unique_ptr<HDF5File::PropertyList>
+HDF5File::RaggedDataSetBase::buildCreationPropertyList(MPI_Comm _comm,
+                                        uint32_t myNumItems,
+                                        const Compression& compression) {
+
+    std::unique_ptr<PropertyList> plist(new PropertyList(H5P_DATASET_CREATE));
+    if(not compression.useFilters()) {
+        // Contiguous, like the default.
+        return plist;
+    }
+
+    // Make the chunks match the average part of each process.
+    uint64_t myNumItems64 = myNumItems;
+    uint64_t totalNumItems;
+    MPI_Allreduce(&myNumItems64, &totalNumItems, 1, MPI_UINT64_T, MPI_SUM,
+                    _comm);
+    if(totalNumItems == 0) {
+        // No chunk fits in an empty data set, keep it contiguous.
+        return plist;
+    }
+    int commSize;
+    MPI_Comm_size(_comm, &commSize);
+    hsize_t chunkSize = (totalNumItems + commSize - 1) / commSize;
+    chunkSize = std::min(chunkSize, maxChunkSize);
+    H5Pset_chunk(plist->getId(), 1, &chunkSize);
+
+    // The shuffle filter must come before deflate to be useful.
+    if(compression.shuffle) {
+        H5Pset_shuffle(plist->getId());
+    }
+    if(compression.deflateLevel > 0) {
+        H5Pset_deflate(plist->getId(), compression.deflateLevel);
+    }
+
+    return plist;
+}
 
 } // namespace xolotlCore
@@ -2,6 +2,8 @@
 #define XCORE_HDF5FILE_DATASET_H
 
 #include <numeric>
+#include <algorithm>
+#include <functional>
 #include "boost/range/counting_range.hpp"
 #include "xolotlCore/DoInOrder.h"
 
@@ -11,7 +13,8 @@ namespace xolotlCore
 template<typename T>
 HDF5File::DataSetTBase<T>::DataSetTBase(const HDF5Object& loc,
                                     std::string dsetName,
-                                    const DataSpace& dspace)
+                                    const DataSpace& dspace,
+                                    hid_t dcplId)
   : DataSetBase(loc, dsetName)
 {
     setId(H5Dcreate(loc.getId(),
@@ -19,7 +22,7 @@ HDF5File::DataSetTBase<T>::DataSetTBase(const HDF5Object& loc,
                         TypeInFile<T>().getId(),
                         dspace.getId(),
                         H5P_DEFAULT,
-                        H5P_DEFAULT,
+                        dcplId,
                         H5P_DEFAULT));
     if(getId() < 0)
     {
@@ -181,10 +184,19 @@ template<typename T>
 HDF5File::RaggedDataSet2D<T>::RaggedDataSet2D(MPI_Comm _comm,
                                     const HDF5Object& loc,
                                     std::string dsetName,
-                                    int baseX,
-                                    const Ragged2DType& data)
+                                    int _baseX,
+                                    const Ragged2DType& data,
+                                    const Compression& compression)
   : RaggedDataSetBase(_comm),
-    DataSetTBase<T>(loc, dsetName, *(buildDataSpace(_comm, data))) {
+    DataSetTBase<T>(loc, dsetName,
+        *(buildDataSpace(_comm, findNumItemsByPoint(data))),
+        buildCreationPropertyList(_comm,
+            std::accumulate(data.begin(), data.end(), 0,
+                [](uint32_t n, const std::vector<T>& items) -> uint32_t {
+                    return n + items.size();
+                }),
+            compression)->getId()),
+    baseX(_baseX) {
 
     // We assume the gridpoint values are indices into the gridpoint array,
     // so non-negative and base 0.
@@ -193,19 +205,60 @@ HDF5File::RaggedDataSet2D<T>::RaggedDataSet2D(MPI_Comm _comm,
     // Write the indexing metadata describing our part of the flattened dataset.
     uint32_t globalBaseIdx;
     uint32_t myNumItems;
-    std::tie(globalBaseIdx, myNumItems) = writeStartingIndices(baseX, data);
+    std::tie(globalBaseIdx, myNumItems) =
+        writeStartingIndices(baseX, findNumItemsByPoint(data));
 
     // Finally, write our part of the data itself.
     writeData(globalBaseIdx, myNumItems, data);
 }
 
 
+template<typename T>
+HDF5File::RaggedDataSet2D<T>::RaggedDataSet2D(MPI_Comm _comm,
+                                    const HDF5Object& loc,
+                                    std::string dsetName,
+                                    int _baseX,
+                                    const std::vector<uint32_t>& myNumItemsByPoint,
+                                    const Compression& compression)
+  : RaggedDataSetBase(_comm),
+    DataSetTBase<T>(loc, dsetName,
+        *(buildDataSpace(_comm, myNumItemsByPoint)),
+        buildCreationPropertyList(_comm,
+            std::accumulate(myNumItemsByPoint.begin(),
+                myNumItemsByPoint.end(), 0),
+            compression)->getId()),
+    baseX(_baseX) {
+
+    // We assume the gridpoint values are indices into the gridpoint array,
+    // so non-negative and base 0.
+    assert(baseX >= 0);
+
+    // Write the indexing metadata describing our part of the flattened
+    // dataset, and keep where the items of each of our points go.
+    uint32_t globalBaseIdx;
+    uint32_t myNumItems;
+    std::tie(globalBaseIdx, myNumItems) =
+        writeStartingIndices(baseX, myNumItemsByPoint);
+    pointStartingIndices.resize(myNumItemsByPoint.size() + 1);
+    pointStartingIndices[0] = globalBaseIdx;
+    std::partial_sum(myNumItemsByPoint.begin(), myNumItemsByPoint.end(),
+                        pointStartingIndices.begin() + 1);
+    std::transform(pointStartingIndices.begin() + 1,
+                    pointStartingIndices.end(),
+                    pointStartingIndices.begin() + 1,
+                    [globalBaseIdx](uint32_t idx) -> uint32_t {
+                        return idx + globalBaseIdx;
+                    });
+}
+
+
 template<typename T>
 HDF5File::RaggedDataSet2D<T>::RaggedDataSet2D(MPI_Comm _comm,
                                     const HDF5Object& loc,
                                     std::string dsetName)
   : RaggedDataSetBase(_comm),
-    DataSetTBase<T>(loc, dsetName) {
+    DataSetTBase<T>(loc, dsetName),
+    baseX(0) {
 
     // Nothing else to do.
 }
@@ -228,7 +281,7 @@ HDF5File::RaggedDataSet2D<T>::findNumItemsByPoint(const Ragged2DType& data) {
 template<typename T>
 std::unique_ptr<HDF5File::SimpleDataSpace<1>>
 HDF5File::RaggedDataSet2D<T>::buildDataSpace(MPI_Comm _comm,
-                                        const Ragged2DType& data) {
+                        const std::vector<uint32_t>& myNumItemsByPoint) {
 
     // Build the data space for the flattened data itself.
     // When a file is opened for parallel access, HDF5 seems to require 
@@ -241,13 +294,6 @@ HDF5File::RaggedDataSet2D<T>::buildDataSpace(MPI_Comm _comm,
     // our own process, so we need to aggregate those values across 
     // all processes.
 
-    // Figure out the number of items associated with each grid point.
-    // TODO is there much benefit to caching this info since we 
-    // also use it when figuring out starting indices?
-    auto myNumItemsByPoint = findNumItemsByPoint(data);
-    auto myNumPoints = data.size();
-    assert(myNumItemsByPoint.size() == myNumPoints);
-
     // Determine the total number of items we own.
     uint32_t myNumItems = 
         std::accumulate(myNumItemsByPoint.begin(), myNumItemsByPoint.end(), 0);
@@ -280,7 +326,7 @@ operator<<(std::ostream& os, const std::pair<int, double>& p) {
 template<typename T>
 std::pair<uint32_t, uint32_t>
 HDF5File::RaggedDataSet2D<T>::writeStartingIndices(int baseX, 
-                                            const Ragged2DType& data) const {
+                    const std::vector<uint32_t>& myNumItemsByPoint) const {
 
     // Determine our position within the MPI communicator used to
     // access the file.
@@ -289,25 +335,9 @@ HDF5File::RaggedDataSet2D<T>::writeStartingIndices(int baseX,
     int commSize;
     MPI_Comm_size(comm, &commSize);
 
-#if READY
-    DoInOrder([baseX, &data]() {
-                    for(auto i = 0; i < data.size(); ++i) {
-                        std::cout << baseX + i << ": ";
-                        for(auto const& p : data[i]) {
-                            std::cout << ' ' << p;
-                        }
-                        std::cout << '\n';
-                    }
-                },
-                comm,
-                "Data");
-#endif // READY
-
     // Determine the local starting indices of the data we own.
     // First, determine the number of items per grid point...
-    auto myNumPoints = data.size();
-    auto myNumItemsByPoint = findNumItemsByPoint(data);
-    assert(myNumItemsByPoint.size() == myNumPoints);
+    auto myNumPoints = myNumItemsByPoint.size();
 
 #if READY
     DoInOrder([commRank, &myNumItemsByPoint]() {
@@ -346,7 +376,8 @@ HDF5File::RaggedDataSet2D<T>::writeStartingIndices(int baseX,
 
     // Convert local starting indices into global starting indices
     // for the gridpoints we own.
-    uint32_t myNumItems = myStartingIndices.back() + myNumItemsByPoint.back();
+    uint32_t myNumItems = std::accumulate(myNumItemsByPoint.begin(),
+                                            myNumItemsByPoint.end(), 0);
     uint32_t globalBaseIdx = 0;
     MPI_Exscan(&myNumItems,
                 &globalBaseIdx,
@@ -520,6 +551,23 @@ HDF5File::RaggedDataSet2D<T>::writeData(uint32_t globalBaseIdx,
 }
 
 
+template<typename T>
+void
+HDF5File::RaggedDataSet2D<T>::write(int firstX,
+                                    const Ragged2DType& data) const {
+
+    // The dataset must have been created from the number of items,
+    // and the data must be within the points we own.
+    assert(firstX >= 0);
+    assert(firstX + data.size() < pointStartingIndices.size());
+
+    // Our items of these points are contiguous in the flattened data.
+    auto globalBaseIdx = pointStartingIndices[firstX];
+    auto numItems = pointStartingIndices[firstX + data.size()] - globalBaseIdx;
+    writeData(globalBaseIdx, numItems, data);
+}
+
+
 template<typename T>
 typename HDF5File::RaggedDataSet2D<T>::Ragged2DType
 HDF5File::RaggedDataSet2D<T>::read(int baseX, int numX) const {
@@ -695,6 +743,367 @@ HDF5File::RaggedDataSet2D<T>::readData(
     return ret;
 }
 
+template<typename T, uint32_t N>
+HDF5File::RaggedDataSetND<T, N>::RaggedDataSetND(MPI_Comm _comm,
+                                    const HDF5Object& loc,
+                                    std::string dsetName,
+                                    const Coordinates& base,
+                                    const Coordinates& count,
+                                    const Ragged2DType& data,
+                                    const Compression& compression)
+  : RaggedDataSetBase(_comm),
+    DataSetTBase<T>(loc, dsetName, *(buildDataSpace(_comm, data)),
+        buildCreationPropertyList(_comm,
+            std::accumulate(data.begin(), data.end(), 0,
+                [](uint32_t n, const std::vector<T>& items) -> uint32_t {
+                    return n + items.size();
+                }),
+            compression)->getId()) {
+
+    // We assume the coordinates are indices into the grid,
+    // so non-negative and base 0.
+    assert(std::all_of(base.begin(), base.end(),
+                        [](int b) { return b >= 0; }));
+    assert(data.size() == std::accumulate(count.begin(), count.end(), 1,
+                                            std::multiplies<int>()));
+
+    // Write the indexing metadata describing our part of the flattened dataset.
+    uint32_t globalBaseIdx;
+    uint32_t myNumItems;
+    std::tie(globalBaseIdx, myNumItems) = writeIndices(base, count, data);
+
+    // Describe our data within the global dataspace.
+    // Our items are contiguous in the flattened data set.
+    SimpleDataSpace<1>::Dimensions dataCounts { myNumItems };
+    SimpleDataSpace<1>::Dimensions dataOffsets { globalBaseIdx };
+    SimpleDataSpace<1> dataMemSpace(dataCounts);
+
+    // Select our hyperslab within the file.
+    SimpleDataSpace<1> dataFileSpace(*this);
+    auto status = H5Sselect_hyperslab(dataFileSpace.getId(),
+                                        H5S_SELECT_SET,
+                                        dataOffsets.data(),
+                                        nullptr,
+                                        dataCounts.data(),
+                                        nullptr);
+    if(status < 0) {
+        std::ostringstream estr;
+        estr << "Failed to select our part of dataset " << this->getName();
+        throw HDF5Exception(estr.str());
+    }
+
+    // Flatten our data.
+    FlatType flatData;
+    flatData.reserve(myNumItems);
+    for(auto const& currItems : data) {
+        std::copy(currItems.begin(), currItems.end(),
+                std::back_inserter(flatData));
+    }
+    assert(flatData.size() == myNumItems);
+
+    // Write the flat data using a collective write.
+    PropertyList plist(H5P_DATASET_XFER);
+    H5Pset_dxpl_mpio(plist.getId(), H5FD_MPIO_COLLECTIVE);
+    TypeInMemory<T> memType;
+    status = H5Dwrite(this->getId(),
+                memType.getId(),
+                dataMemSpace.getId(),
+                dataFileSpace.getId(),
+                plist.getId(),
+                flatData.data());
+    if(status < 0)
+    {
+        std::ostringstream estr;
+        estr << "Failed to write dataset " << this->getName();
+        throw HDF5Exception(estr.str());
+    }
+}
+
+
+template<typename T, uint32_t N>
+HDF5File::RaggedDataSetND<T, N>::RaggedDataSetND(MPI_Comm _comm,
+                                    const HDF5Object& loc,
+                                    std::string dsetName)
+  : RaggedDataSetBase(_comm),
+    DataSetTBase<T>(loc, dsetName) {
+
+    // Nothing else to do.
+}
+
+
+template<typename T, uint32_t N>
+std::unique_ptr<HDF5File::SimpleDataSpace<1>>
+HDF5File::RaggedDataSetND<T, N>::buildDataSpace(MPI_Comm _comm,
+                                        const Ragged2DType& data) {
+
+    // The dataspace of the flattened data is a 1D array with size
+    // equal to the total number of data items across all processes.
+    uint32_t myNumItems = 0;
+    for(auto const& currItems : data) {
+        myNumItems += currItems.size();
+    }
+    uint32_t totalNumItems;
+    MPI_Allreduce(&myNumItems,
+                    &totalNumItems,
+                    1,
+                    MPI_UNSIGNED,
+                    MPI_SUM,
+                    _comm);
+
+    // Define the dataspace for the flattened data.
+    SimpleDataSpace<1>::Dimensions dims { totalNumItems };
+    std::unique_ptr<SimpleDataSpace<1>> dataspace(new SimpleDataSpace<1>(dims));
+    return dataspace;
+}
+
+
+template<typename T, uint32_t N>
+std::unique_ptr<typename HDF5File::RaggedDataSetND<T, N>::IndexDataSpace>
+HDF5File::RaggedDataSetND<T, N>::selectIndices(const IndexDataSpace& filespace,
+                                        const Coordinates& base,
+                                        const Coordinates& count) {
+
+    // The block covers both values of the last dimension.
+    typename IndexDataSpace::Dimensions indexOffsets;
+    typename IndexDataSpace::Dimensions indexCounts;
+    for(auto d = 0; d < N; ++d) {
+        indexOffsets[d] = base[d];
+        indexCounts[d] = count[d];
+    }
+    indexOffsets[N] = 0;
+    indexCounts[N] = 2;
+
+    auto status = H5Sselect_hyperslab(filespace.getId(),
+                                        H5S_SELECT_SET,
+                                        indexOffsets.data(),
+                                        nullptr,
+                                        indexCounts.data(),
+                                        nullptr);
+    if(status < 0) {
+        throw HDF5Exception("Failed to select our part of an index dataset");
+    }
+
+    std::unique_ptr<IndexDataSpace> memspace(new IndexDataSpace(indexCounts));
+    return memspace;
+}
+
+
+template<typename T, uint32_t N>
+std::pair<uint32_t, uint32_t>
+HDF5File::RaggedDataSetND<T, N>::writeIndices(const Coordinates& base,
+                                            const Coordinates& count,
+                                            const Ragged2DType& data) const {
+
+    // Determine the starting index of our items within the
+    // flattened data set.
+    uint32_t myNumItems = 0;
+    for(auto const& currItems : data) {
+        myNumItems += currItems.size();
+    }
+    int commRank;
+    MPI_Comm_rank(comm, &commRank);
+    uint32_t globalBaseIdx = 0;
+    MPI_Exscan(&myNumItems,
+                &globalBaseIdx,
+                1,
+                MPI_UNSIGNED,
+                MPI_SUM,
+                comm);
+    if(commRank == 0) {
+        // Some MPI_Exscan implementations leave rank 0 output undefined.
+        globalBaseIdx = 0;
+    }
+
+    // Build the starting index and number of items of our grid points.
+    std::vector<uint32_t> indices(2 * data.size());
+    uint32_t currIdx = globalBaseIdx;
+    for(auto ptIdx = 0; ptIdx < data.size(); ++ptIdx) {
+        indices[2 * ptIdx] = currIdx;
+        indices[2 * ptIdx + 1] = data[ptIdx].size();
+        currIdx += data[ptIdx].size();
+    }
+
+    // Determine the size of the global grid.
+    Coordinates myEnd;
+    for(auto d = 0; d < N; ++d) {
+        myEnd[d] = base[d] + count[d];
+    }
+    Coordinates globalEnd;
+    MPI_Allreduce(myEnd.data(),
+                    globalEnd.data(),
+                    N,
+                    MPI_INT,
+                    MPI_MAX,
+                    comm);
+
+    // Create the global index dataset.
+    typename IndexDataSpace::Dimensions globalIndexDims;
+    for(auto d = 0; d < N; ++d) {
+        globalIndexDims[d] = globalEnd[d];
+    }
+    globalIndexDims[N] = 2;
+    IndexDataSpace indexDataSpace(globalIndexDims);
+    std::ostringstream indexDatasetNameStr;
+    indexDatasetNameStr << this->getName() << pointIndicesDatasetNameSuffix;
+    DataSet<uint32_t> indexDataset(this->getLocation(),
+                                    indexDatasetNameStr.str(),
+                                    indexDataSpace);
+
+    // Write our block of the index dataset using a collective write.
+    IndexDataSpace indexFilespace(indexDataset);
+    auto indexMemspace = selectIndices(indexFilespace, base, count);
+    PropertyList plist(H5P_DATASET_XFER);
+    H5Pset_dxpl_mpio(plist.getId(), H5FD_MPIO_COLLECTIVE);
+    TypeInMemory<uint32_t> indexMemType;
+    auto status = H5Dwrite(indexDataset.getId(),
+                indexMemType.getId(),
+                indexMemspace->getId(),
+                indexFilespace.getId(),
+                plist.getId(),
+                indices.data());
+    if(status < 0) {
+        std::ostringstream estr;
+        estr << "Failed to write dataset " << indexDatasetNameStr.str();
+        throw HDF5Exception(estr.str());
+    }
+
+    return std::make_pair(globalBaseIdx, myNumItems);
+}
+
+
+template<typename T, uint32_t N>
+typename HDF5File::RaggedDataSetND<T, N>::Ragged2DType
+HDF5File::RaggedDataSetND<T, N>::read(const Coordinates& base,
+                                    const Coordinates& count,
+                                    bool collective) const {
+
+    // Read our part of the indexing metadata, then the data it points to.
+    auto indices = readIndices(base, count, collective);
+    return readData(indices, collective);
+}
+
+
+template<typename T, uint32_t N>
+std::vector<uint32_t>
+HDF5File::RaggedDataSetND<T, N>::readIndices(const Coordinates& base,
+                                        const Coordinates& count,
+                                        bool collective) const {
+
+    // Open our index dataset.
+    std::ostringstream indexDatasetNameStr;
+    indexDatasetNameStr << this->getName() << pointIndicesDatasetNameSuffix;
+    DataSet<uint32_t> indexDataset(this->getLocation(),
+                                    indexDatasetNameStr.str());
+
+    // Read our block, with a collective operation if asked.
+    auto myNumPoints = std::accumulate(count.begin(), count.end(), 1,
+                                        std::multiplies<int>());
+    std::vector<uint32_t> indices(2 * myNumPoints);
+    IndexDataSpace indexFilespace(indexDataset);
+    auto indexMemspace = selectIndices(indexFilespace, base, count);
+    PropertyList plist(H5P_DATASET_XFER);
+    H5Pset_dxpl_mpio(plist.getId(),
+        collective ? H5FD_MPIO_COLLECTIVE : H5FD_MPIO_INDEPENDENT);
+    TypeInMemory<uint32_t> indexMemType;
+    auto status = H5Dread(indexDataset.getId(),
+                indexMemType.getId(),
+                indexMemspace->getId(),
+                indexFilespace.getId(),
+                plist.getId(),
+                indices.data());
+    if(status < 0) {
+        std::ostringstream estr;
+        estr << "Failed to read dataset " << indexDatasetNameStr.str();
+        throw HDF5Exception(estr.str());
+    }
+
+    return indices;
+}
+
+
+template<typename T, uint32_t N>
+typename HDF5File::RaggedDataSetND<T, N>::Ragged2DType
+HDF5File::RaggedDataSetND<T, N>::readData(
+                    const std::vector<uint32_t>& indices,
+                    bool collective) const {
+
+    // HDF5 transfers the elements of a selection in the order of the
+    // file, so sort our grid points by starting index.  When the
+    // decomposition did not change since the write, they already are.
+    auto myNumPoints = indices.size() / 2;
+    std::vector<uint32_t> order(myNumPoints);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+                [&indices](uint32_t a, uint32_t b) -> bool {
+                    return indices[2 * a] < indices[2 * b];
+                });
+
+    // Select the items of our grid points, merging contiguous ranges
+    // so that the selection has as few blocks as possible.
+    SimpleDataSpace<1> dataFilespace(*this);
+    H5Sselect_none(dataFilespace.getId());
+    uint32_t myNumItems = 0;
+    SimpleDataSpace<1>::Dimensions runOffset { 0 };
+    SimpleDataSpace<1>::Dimensions runCount { 0 };
+    auto selectRun = [&dataFilespace, &runOffset, &runCount]() {
+        if(runCount[0] > 0) {
+            H5Sselect_hyperslab(dataFilespace.getId(),
+                                H5S_SELECT_OR,
+                                runOffset.data(),
+                                nullptr,
+                                runCount.data(),
+                                nullptr);
+        }
+    };
+    for(auto ptIdx : order) {
+        auto start = indices[2 * ptIdx];
+        auto numItems = indices[2 * ptIdx + 1];
+        if(numItems == 0) {
+            continue;
+        }
+        if(runOffset[0] + runCount[0] != start) {
+            selectRun();
+            runOffset[0] = start;
+            runCount[0] = 0;
+        }
+        runCount[0] += numItems;
+        myNumItems += numItems;
+    }
+    selectRun();
+
+    // Read the items, with a collective operation if asked.
+    SimpleDataSpace<1>::Dimensions dataCounts { myNumItems };
+    SimpleDataSpace<1> dataMemspace(dataCounts);
+    FlatType flatData(myNumItems);
+    PropertyList plist(H5P_DATASET_XFER);
+    H5Pset_dxpl_mpio(plist.getId(),
+        collective ? H5FD_MPIO_COLLECTIVE : H5FD_MPIO_INDEPENDENT);
+    TypeInMemory<T> dataMemType;
+    auto status = H5Dread(this->getId(),
+                dataMemType.getId(),
+                dataMemspace.getId(),
+                dataFilespace.getId(),
+                plist.getId(),
+                flatData.data());
+    if(status < 0) {
+        std::ostringstream estr;
+        estr << "Failed to read dataset " << this->getName();
+        throw HDF5Exception(estr.str());
+    }
+
+    // Convert from flat representation to ragged 2D representation.
+    Ragged2DType ret(myNumPoints);
+    auto currItem = flatData.begin();
+    for(auto ptIdx : order) {
+        auto numItems = indices[2 * ptIdx + 1];
+        ret[ptIdx].assign(currItem, currItem + numItems);
+        currItem += numItems;
+    }
+
+    return ret;
+}
+
+
 template<typename T>
 template<uint32_t dim0>
 void
@@ -0,0 +1,64 @@
+#include <fstream>
+#include "xolotlCore/io/TextFileWriter.h"
+
+namespace xolotlCore {
+
+TextFileWriter::TextFileWriter(bool _async) :
+		scheduled(false), writer(MPI_COMM_NULL, _async) {
+}
+
+void TextFileWriter::writeChunks(const std::vector<Chunk>& chunks) {
+
+	for (auto const& chunk : chunks) {
+		std::ofstream outputFile;
+		outputFile.open(chunk.fileName,
+				chunk.truncate ? std::ios::trunc : std::ios::app);
+		outputFile << chunk.text;
+		outputFile.close();
+	}
+
+	return;
+}
+
+void TextFileWriter::submit(Chunk chunk) {
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		// Join the consecutive pieces of the same file
+		if (!chunk.truncate && !pending.empty()
+				&& pending.back().fileName == chunk.fileName) {
+			pending.back().text += chunk.text;
+		} else {
+			pending.push_back(std::move(chunk));
+		}
+
+		// The task waiting to start will write it as well
+		if (scheduled)
+			return;
+		scheduled = true;
+	}
+
+	// Only one task waits at once, so this doesn't block
+	writer.submit([this](MPI_Comm) {
+		// Take all the text, the caller keeps buffering the next one
+			std::vector<Chunk> chunks;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				std::swap(chunks, pending);
+				scheduled = false;
+			}
+			writeChunks(chunks);
+		});
+
+	return;
+}
+
+void TextFileWriter::flush(void) {
+
+	writer.flush();
+
+	return;
+}
+
+} // namespace xolotlCore
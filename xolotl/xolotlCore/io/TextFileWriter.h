@@ -0,0 +1,102 @@
+#ifndef XCORE_TEXTFILEWRITER_H
+#define XCORE_TEXTFILEWRITER_H
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include "xolotlCore/io/AsyncWriter.h"
+
+namespace xolotlCore {
+
+/**
+ * Writes text files (typically the diagnostics written by the master
+ * process) on a dedicated thread, so that the caller only formats the
+ * text.  The text given while the thread is writing is buffered and
+ * written at once, the consecutive pieces of the same file being joined.
+ *
+ * The thread is the one of an AsyncWriter without MPI, so it does not
+ * need any MPI thread support, and the processes that never write do not
+ * have one.
+ */
+class TextFileWriter {
+private:
+	/**
+	 * A piece of text to write in a file.
+	 */
+	struct Chunk {
+		//! The path of the file.
+		std::string fileName;
+
+		//! The text.
+		std::string text;
+
+		//! Whether the file is replaced instead of appended to.
+		bool truncate;
+	};
+
+	//! Protects the members below.
+	std::mutex mutex;
+
+	//! The text waiting to be written, in order.
+	std::vector<Chunk> pending;
+
+	//! Whether a task writing the pending text is waiting to start.
+	bool scheduled;
+
+	//! Runs the tasks writing the text, destroyed first so that it
+	//! writes what is left.
+	AsyncWriter writer;
+
+	/**
+	 * Write the given pieces of text in their files.
+	 *
+	 * @param chunks The pieces of text.
+	 */
+	static void writeChunks(const std::vector<Chunk>& chunks);
+
+	/**
+	 * Submit a piece of text.
+	 *
+	 * @param chunk The piece of text.
+	 */
+	void submit(Chunk chunk);
+
+public:
+	/**
+	 * Construct the writer.
+	 * Copy constructor explicitly disallowed.
+	 *
+	 * @param _async Whether the text should be written on the thread.
+	 */
+	TextFileWriter(const TextFileWriter& other) = delete;
+	TextFileWriter(bool _async = true);
+
+	/**
+	 * Append text to a file, creating it if needed.
+	 *
+	 * @param fileName The path of the file.
+	 * @param text The text.
+	 */
+	void append(const std::string& fileName, std::string text) {
+		submit(Chunk { fileName, std::move(text), false });
+	}
+
+	/**
+	 * Replace the content of a file by the given text.
+	 *
+	 * @param fileName The path of the file.
+	 * @param text The text.
+	 */
+	void write(const std::string& fileName, std::string text) {
+		submit(Chunk { fileName, std::move(text), true });
+	}
+
+	/**
+	 * Wait until all the submitted text is written.
+	 */
+	void flush(void);
+};
+
+} // namespace xolotlCore
+
+#endif // XCORE_TEXTFILEWRITER_H
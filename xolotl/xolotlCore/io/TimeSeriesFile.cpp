@@ -0,0 +1,227 @@
+#include <array>
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include "hdf5.h"
+#include "xolotlCore/io/TimeSeriesFile.h"
+#include "xolotlCore/io/HDF5Exception.h"
+
+namespace xolotlCore {
+
+const std::string TimeSeriesFile::columnsAttrName = "columns";
+
+TimeSeriesFile::TimeSeriesFile(fs::path _path, AccessMode _mode,
+		hsize_t _flushRows) :
+		HDF5File(_path, _mode, MPI_COMM_SELF, false), flushRows(
+				std::max(_flushRows, (hsize_t) 1)) {
+}
+
+TimeSeriesFile::~TimeSeriesFile(void) {
+
+	// Nothing can be reported from here, the rows are lost on failure
+	try {
+		writeBufferedRows();
+	} catch (const std::exception& e) {
+		std::cerr << "TimeSeriesFile: " << e.what() << std::endl;
+	}
+}
+
+void TimeSeriesFile::writeRows(const std::string& name,
+		Series& buffered) const {
+
+	hsize_t nColumns = buffered.columns.size();
+	hsize_t nRows = buffered.rows.size() / nColumns;
+	if (nRows == 0)
+		return;
+
+	// Create the dataset the first time
+	if (H5Lexists(getId(), name.c_str(), H5P_DEFAULT) <= 0) {
+		SimpleDataSpace<2>::Dimensions dims { 0, nColumns };
+		SimpleDataSpace<2>::Dimensions maxDims { H5S_UNLIMITED, nColumns };
+		SimpleDataSpace<2> dspace(dims, maxDims);
+
+		// An extendible dataset must be chunked, one chunk per flush
+		PropertyList plist(H5P_DATASET_CREATE);
+		std::array<hsize_t, 2> chunkDims { flushRows, nColumns };
+		H5Pset_chunk(plist.getId(), 2, chunkDims.data());
+		DataSetTBase<double> dataset(*this, name, dspace, plist.getId());
+
+		// Name the columns
+		SimpleDataSpace<1>::Dimensions attrDims { nColumns };
+		SimpleDataSpace<1> attrSpace(attrDims);
+		Attribute<std::vector<std::string> > columnsAttr(dataset,
+				columnsAttrName, attrSpace);
+		columnsAttr.setTo(buffered.columns);
+	}
+
+	// Open the dataset
+	hid_t datasetId = H5Dopen(getId(), name.c_str(), H5P_DEFAULT);
+	if (datasetId < 0) {
+		throw HDF5Exception("Unable to open DataSet " + name);
+	}
+
+	// Extend it...
+	hid_t fileSpaceId = H5Dget_space(datasetId);
+	std::array<hsize_t, 2> dims;
+	H5Sget_simple_extent_dims(fileSpaceId, dims.data(), nullptr);
+	H5Sclose(fileSpaceId);
+	if (dims[1] != nColumns) {
+		H5Dclose(datasetId);
+		throw HDF5Exception(
+				"Wrong number of columns appended to DataSet " + name);
+	}
+	std::array<hsize_t, 2> newDims { dims[0] + nRows, nColumns };
+	auto status = H5Dset_extent(datasetId, newDims.data());
+
+	// ...and write the new rows at its end
+	if (status >= 0) {
+		fileSpaceId = H5Dget_space(datasetId);
+		std::array<hsize_t, 2> offsets { dims[0], 0 };
+		std::array<hsize_t, 2> counts { nRows, nColumns };
+		status = H5Sselect_hyperslab(fileSpaceId, H5S_SELECT_SET,
+				offsets.data(), nullptr, counts.data(), nullptr);
+		if (status >= 0) {
+			hid_t memSpaceId = H5Screate_simple(2, counts.data(), nullptr);
+			status = H5Dwrite(datasetId, H5T_NATIVE_DOUBLE, memSpaceId,
+					fileSpaceId, H5P_DEFAULT, buffered.rows.data());
+			H5Sclose(memSpaceId);
+		}
+		H5Sclose(fileSpaceId);
+	}
+
+	// Close everything
+	H5Dclose(datasetId);
+	if (status < 0) {
+		throw HDF5Exception("Unable to append rows to DataSet " + name);
+	}
+
+	buffered.rows.clear();
+}
+
+void TimeSeriesFile::append(const std::string& name,
+		const std::vector<std::string>& columns,
+		const std::vector<double>& row) {
+
+	if (row.empty() or row.size() != columns.size()) {
+		throw HDF5Exception(
+				"Wrong number of values appended to time series " + name);
+	}
+
+	auto& buffered = series[name];
+	if (buffered.columns.empty()) {
+		buffered.columns = columns;
+		buffered.rows.reserve(flushRows * columns.size());
+	}
+	if (buffered.columns.size() != row.size()) {
+		throw HDF5Exception(
+				"Wrong number of values appended to time series " + name);
+	}
+	buffered.rows.insert(buffered.rows.end(), row.begin(), row.end());
+
+	// Write the rows once there are enough of them
+	if (buffered.rows.size() >= flushRows * buffered.columns.size())
+		writeRows(name, buffered);
+}
+
+bool TimeSeriesFile::writesOnAppend(const std::string& name) const {
+
+	auto iter = series.find(name);
+	if (iter == series.end())
+		return flushRows <= 1;
+
+	auto const& buffered = iter->second;
+	return buffered.rows.size() + buffered.columns.size()
+			>= flushRows * buffered.columns.size();
+}
+
+void TimeSeriesFile::writeBufferedRows(void) {
+
+	for (auto& namedSeries : series) {
+		writeRows(namedSeries.first, namedSeries.second);
+	}
+}
+
+std::vector<std::string> TimeSeriesFile::getSeriesNames(void) const {
+
+	// Look at all the links of the root group
+	H5G_info_t groupInfo;
+	if (H5Gget_info(getId(), &groupInfo) < 0) {
+		throw HDF5Exception("Unable to list the time series");
+	}
+
+	std::vector<std::string> names;
+	for (hsize_t n = 0; n < groupInfo.nlinks; n++) {
+		auto nameSize = H5Lget_name_by_idx(getId(), ".", H5_INDEX_NAME,
+				H5_ITER_INC, n, nullptr, 0, H5P_DEFAULT);
+		if (nameSize < 0) {
+			throw HDF5Exception("Unable to list the time series");
+		}
+		std::vector<char> name(nameSize + 1);
+		H5Lget_name_by_idx(getId(), ".", H5_INDEX_NAME, H5_ITER_INC, n,
+				name.data(), name.size(), H5P_DEFAULT);
+		names.emplace_back(name.data());
+	}
+
+	return names;
+}
+
+std::vector<std::string> TimeSeriesFile::readColumns(
+		const std::string& name) const {
+
+	DataSetTBase<double> dataset(*this, name);
+	Attribute<std::vector<std::string> > columnsAttr(dataset,
+			columnsAttrName);
+	return columnsAttr.get();
+}
+
+std::vector<std::vector<double> > TimeSeriesFile::readRows(
+		const std::string& name) const {
+
+	// Open the dataset
+	hid_t datasetId = H5Dopen(getId(), name.c_str(), H5P_DEFAULT);
+	if (datasetId < 0) {
+		throw HDF5Exception("Unable to open DataSet " + name);
+	}
+
+	// Read all of it at once
+	hid_t fileSpaceId = H5Dget_space(datasetId);
+	std::array<hsize_t, 2> dims;
+	H5Sget_simple_extent_dims(fileSpaceId, dims.data(), nullptr);
+	std::vector<double> values(dims[0] * dims[1]);
+	herr_t status = 0;
+	if (not values.empty()) {
+		status = H5Dread(datasetId, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL,
+				H5P_DEFAULT, values.data());
+	}
+
+	// Close everything
+	H5Sclose(fileSpaceId);
+	H5Dclose(datasetId);
+	if (status < 0) {
+		throw HDF5Exception("Unable to read DataSet " + name);
+	}
+
+	std::vector<std::vector<double> > rows;
+	rows.reserve(dims[0]);
+	for (hsize_t i = 0; i < dims[0]; i++) {
+		rows.emplace_back(values.begin() + i * dims[1],
+				values.begin() + (i + 1) * dims[1]);
+	}
+
+	return rows;
+}
+
+std::string TimeSeriesFile::toText(const std::vector<double>& row) {
+
+	std::ostringstream line;
+	for (size_t i = 0; i < row.size(); i++) {
+		if (i > 0)
+			line << " ";
+		line << row[i];
+	}
+	line << std::endl;
+
+	return line.str();
+}
+
+} // namespace xolotlCore
@@ -0,0 +1,133 @@
+#ifndef XCORE_TIMESERIESFILE_H
+#define XCORE_TIMESERIESFILE_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include "xolotlCore/io/HDF5File.h"
+
+namespace xolotlCore {
+
+/**
+ * An HDF5 file holding time series, like the ones the monitors used to
+ * append line by line to text files (retentionOut.txt, surface.txt, ...).
+ * Each series is an extendible 2D dataset with one row per sample, the
+ * names of its columns being given by an attribute.  The rows are
+ * buffered in memory and appended to the datasets every few rows, instead
+ * of opening, appending to, and closing a text file at every sample.
+ *
+ * The file is only accessed by the process that creates it.
+ */
+class TimeSeriesFile: public HDF5File {
+private:
+	/**
+	 * The rows of a series waiting to be written.
+	 */
+	struct Series {
+		//! The names of the columns.
+		std::vector<std::string> columns;
+
+		//! The rows, one after the other.
+		std::vector<double> rows;
+	};
+
+	//! The number of rows of a series buffered before they are written.
+	hsize_t flushRows;
+
+	//! The series appended to, by name.
+	std::map<std::string, Series> series;
+
+	/**
+	 * Append the buffered rows of a series to its dataset, creating it the
+	 * first time.
+	 *
+	 * @param name The name of the series.
+	 * @param buffered The series.
+	 */
+	void writeRows(const std::string& name, Series& buffered) const;
+
+public:
+	//! The name of the attribute giving the names of the columns.
+	static const std::string columnsAttrName;
+
+	/**
+	 * Create or open a time series file with a single-process access.
+	 * Default and copy constructors explicitly disallowed.
+	 *
+	 * @param _path The path of the file.
+	 * @param _mode The access mode, the series are appended to when an
+	 * existing file is opened.
+	 * @param _flushRows The number of rows of a series buffered before
+	 * they are written.
+	 */
+	TimeSeriesFile(void) = delete;
+	TimeSeriesFile(const TimeSeriesFile& other) = delete;
+	TimeSeriesFile(fs::path _path, AccessMode _mode =
+			AccessMode::CreateOrTruncateIfExists, hsize_t _flushRows = 64);
+
+	/**
+	 * Write the buffered rows and close the file.
+	 */
+	~TimeSeriesFile(void);
+
+	/**
+	 * Append a row to a series, creating it the first time.
+	 *
+	 * @param name The name of the series.
+	 * @param columns The names of the columns.
+	 * @param row The values, one per column.
+	 */
+	void append(const std::string& name,
+			const std::vector<std::string>& columns,
+			const std::vector<double>& row);
+
+	/**
+	 * Whether appending a row to a series writes its buffered rows to the
+	 * file, e.g., to wait until nothing else uses HDF5 before appending.
+	 *
+	 * @param name The name of the series.
+	 * @return True if the next row appended to the series is written.
+	 */
+	bool writesOnAppend(const std::string& name) const;
+
+	/**
+	 * Write all the buffered rows.
+	 */
+	void writeBufferedRows(void);
+
+	/**
+	 * Obtain the names of the series in the file.
+	 *
+	 * @return The names of the series.
+	 */
+	std::vector<std::string> getSeriesNames(void) const;
+
+	/**
+	 * Read the names of the columns of a series.
+	 *
+	 * @param name The name of the series.
+	 * @return The names of the columns.
+	 */
+	std::vector<std::string> readColumns(const std::string& name) const;
+
+	/**
+	 * Read the rows of a series written so far.
+	 *
+	 * @param name The name of the series.
+	 * @return The rows.
+	 */
+	std::vector<std::vector<double> > readRows(const std::string& name) const;
+
+	/**
+	 * Format a row as a line of the text files written by the monitors,
+	 * the values separated by spaces.
+	 *
+	 * @param row The values.
+	 * @return The line, with its end of line.
+	 */
+	static std::string toText(const std::vector<double>& row);
+};
+
+} // namespace xolotlCore
+
+#endif // XCORE_TIMESERIESFILE_H
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <string>
+#include <algorithm>
 #include "boost/program_options.hpp"
 #include "xolotlCore/io/XFile.h"
 
@@ -8,6 +9,17 @@ namespace bpo = boost::program_options;
 namespace xcore = xolotlCore;
 
 
+// Determine the contiguous block of [0, n) owned by the given rank.
+// Blocks are assigned in rank order, as the concentration
+// data sets expect.
+static std::pair<int, int>
+findBlock(int n, int rank, int size) {
+
+    int base = (int)(((long)n * rank) / size);
+    int end = (int)(((long)n * (rank + 1)) / size);
+    return std::make_pair(base, end - base);
+}
+
 
 int
 main(int argc, char* argv[]) {
@@ -20,23 +32,24 @@ main(int argc, char* argv[]) {
         MPI_Init(&argc, &argv);
 
         // Determine our place in the MPI world.
+        // The grid points of each time step are split across
+        // the processes, which read their own points and write
+        // them all at once.
         int cwRank;
         int cwSize;
         MPI_Comm_rank(MPI_COMM_WORLD, &cwRank);
         MPI_Comm_size(MPI_COMM_WORLD, &cwSize);
 
-        // We have to be an MPI program,
-        // but for now we only support a single process.
-        if(cwSize > 1) {
-            throw std::runtime_error("Multiple MPI processes not yet supported.  Run with 1 proc.");
-        }
-
         // Parse the command line options.
         bool shouldRun = true;
         bpo::options_description desc("Supported options");
         desc.add_options()
             ("help", "show this help message")
             ("infile", bpo::value<std::string>(), "input file name")
+            ("all", "convert all the time steps, not only the last one")
+            ("batch", bpo::value<int>()->default_value(0),
+                "number of grid points each process holds in memory at "
+                "once when converting 1D time steps, all of them if 0")
         ;
 
         bpo::variables_map opts;
@@ -44,13 +57,17 @@ main(int argc, char* argv[]) {
         bpo::notify(opts);
 
         if(opts.count("help")) {
-            std::cout << desc << '\n';
+            if(cwRank == 0) {
+                std::cout << desc << '\n';
+            }
             shouldRun = false;
         }
 
         if((opts.count("infile") == 0) or
                 opts["infile"].as<std::string>().empty()) {
-            std::cerr << "input file name must not be empty" << std::endl;
+            if(cwRank == 0) {
+                std::cerr << "input file name must not be empty" << std::endl;
+            }
             shouldRun = false;
             ret = 1;
         }
@@ -58,6 +75,7 @@ main(int argc, char* argv[]) {
         if(shouldRun) {
 
             std::string fname = opts["infile"].as<std::string>();
+            int batchSize = opts["batch"].as<int>();
 
             // Open the file.
             xcore::XFile xfile(fname,
@@ -67,47 +85,70 @@ main(int argc, char* argv[]) {
             // Determine the number of grid points.
             auto headerGroup = xfile.getGroup<xcore::XFile::HeaderGroup>();
             assert(headerGroup);
-            xcore::HDF5File::Attribute<int> nxAttr(*headerGroup, "nx");
-            auto nx = nxAttr.get();
+            int nx, ny, nz;
+            double hx, hy, hz;
+            headerGroup->read(nx, hx, ny, hy, nz, hz);
+            // 0D files have a single grid point.
+            nx = std::max(nx, 1);
 
-            // Determine the last timestep written to the file.
+            // Determine the time steps to convert.
             auto concGroup = xfile.getGroup<xcore::XFile::ConcentrationGroup>();
             assert(concGroup);
-            xcore::HDF5File::Attribute<int> lastTimestepAttr(*concGroup, "lastTimeStep");
-            auto lastTimeStep = lastTimestepAttr.get();
-
-
-            std::cout << "nx: " << nx << '\n'
-                << "last time step: " << lastTimeStep 
-                << std::endl;
-
-            // Open the timestep group associated with the 
-            // last written timestep.
-            auto tsGroup = concGroup->getLastTimestepGroup();
-            assert(tsGroup);
-
-            // Convert the last written timestep's concentrations to 
-            // the new representation.
-            xcore::XFile::TimestepGroup::Concs1DType allConcs(nx);
-            for(auto x = 0; x < nx; ++x) {
-                // Read the concentrations for the current position.
-                std::ostringstream dsNameStr;
-                dsNameStr << "position_" << x << "-1_-1";
-                std::string dsName = dsNameStr.str();
-                std::cout << "Reading conc data for gridpoint " << x << " from dataset " << dsName << std::endl;
-                auto oldData = tsGroup->readGridPoint(x);
-                auto nConcs = oldData.size();
-
-                // Store into our ragged 2D representation.
-                for(auto i = 0; i < nConcs; ++i) {
-                    auto l = oldData[i][0];
-                    auto conc = oldData[i][1];
-                    allConcs[x].emplace_back(l, conc);
-                }
+            auto lastTimeStep = concGroup->getLastTimeStep();
+            std::vector<int> timeSteps { lastTimeStep };
+            if(opts.count("all")) {
+                timeSteps = concGroup->getTimeSteps();
+            }
+
+            if(cwRank == 0) {
+                std::cout << "nx: " << nx << '\n'
+                    << "ny: " << ny << '\n'
+                    << "nz: " << nz << '\n'
+                    << "last time step: " << lastTimeStep
+                    << std::endl;
             }
 
-            // Write the dataset to the file.
-            tsGroup->writeConcentrations(xfile, 0, allConcs);
+            // All processes create the data sets of each time step together.
+            for(auto timeStep : timeSteps) {
+
+                // Open the timestep group associated with the
+                // time step.
+                auto tsGroup = concGroup->getTimestepGroup(timeStep);
+                assert(tsGroup);
+
+                // Skip the time steps already in the new representation.
+                if(not tsGroup->hasGridPointConcentrations()) {
+                    continue;
+                }
+                if(cwRank == 0) {
+                    std::cout << "Converting time step " << timeStep
+                        << std::endl;
+                }
+
+                // Convert the time step's concentrations to
+                // the new representation.
+                if(nz > 0) {
+                    // Split the slowest direction.
+                    auto block = findBlock(nz, cwRank, cwSize);
+                    auto concs = tsGroup->readConcentrations(xfile,
+                            0, 0, block.first, nx, ny, block.second);
+                    tsGroup->writeConcentrations(xfile,
+                            0, 0, block.first, nx, ny, block.second, concs);
+                }
+                else if(ny > 0) {
+                    auto block = findBlock(ny, cwRank, cwSize);
+                    auto concs = tsGroup->readConcentrations(xfile,
+                            0, block.first, nx, block.second);
+                    tsGroup->writeConcentrations(xfile,
+                            0, block.first, nx, block.second, concs);
+                }
+                else {
+                    // Stream our block of grid points.
+                    auto block = findBlock(nx, cwRank, cwSize);
+                    tsGroup->convertGridPointConcentrations(xfile,
+                            block.first, block.second, batchSize);
+                }
+            }
         }
     }
     catch(std::exception& e) {
@@ -124,4 +165,3 @@ main(int argc, char* argv[]) {
 
     return ret;
 }
-
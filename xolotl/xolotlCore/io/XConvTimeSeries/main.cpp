@@ -0,0 +1,105 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "boost/program_options.hpp"
+#include "xolotlCore/io/TimeSeriesFile.h"
+
+
+namespace bpo = boost::program_options;
+namespace xcore = xolotlCore;
+
+
+int
+main(int argc, char* argv[]) {
+
+    int ret = 0;
+
+
+    try {
+
+        MPI_Init(&argc, &argv);
+
+        // The file is small enough for a single process.
+        int cwRank;
+        MPI_Comm_rank(MPI_COMM_WORLD, &cwRank);
+
+        // Parse the command line options.
+        bool shouldRun = (cwRank == 0);
+        bpo::options_description desc("Supported options");
+        desc.add_options()
+            ("help", "show this help message")
+            ("infile", bpo::value<std::string>(), "input time series file name")
+            ("series", bpo::value<std::vector<std::string>>(),
+                "name of a series to convert, all of them if not given")
+            ("outdir", bpo::value<std::string>()->default_value("."),
+                "directory where the <series>.txt files are written")
+        ;
+
+        bpo::variables_map opts;
+        bpo::store(bpo::parse_command_line(argc, argv, desc), opts);
+        bpo::notify(opts);
+
+        if(shouldRun and opts.count("help")) {
+            std::cout << desc << '\n';
+            shouldRun = false;
+        }
+
+        if(shouldRun and ((opts.count("infile") == 0) or
+                opts["infile"].as<std::string>().empty())) {
+            std::cerr << "input file name must not be empty" << std::endl;
+            shouldRun = false;
+            ret = 1;
+        }
+
+        if(shouldRun) {
+
+            std::string fname = opts["infile"].as<std::string>();
+            fs::path outDir = opts["outdir"].as<std::string>();
+
+            // Open the file.
+            xcore::TimeSeriesFile seriesFile(fname,
+                    xcore::TimeSeriesFile::AccessMode::OpenReadOnly);
+
+            // Determine the series to convert.
+            auto names = seriesFile.getSeriesNames();
+            if(opts.count("series")) {
+                names = opts["series"].as<std::vector<std::string>>();
+            }
+
+            // Write each of them as the monitors write their text files.
+            for(auto const& name : names) {
+
+                auto columns = seriesFile.readColumns(name);
+                auto rows = seriesFile.readRows(name);
+                std::cout << "Converting " << name << ": "
+                    << rows.size() << " rows of";
+                for(auto const& column : columns) {
+                    std::cout << ' ' << column;
+                }
+                std::cout << std::endl;
+
+                std::ofstream outputFile((outDir / (name + ".txt")).string());
+                for(auto const& row : rows) {
+                    outputFile << xcore::TimeSeriesFile::toText(row);
+                }
+                if(not outputFile) {
+                    throw std::runtime_error("unable to write " + name + ".txt");
+                }
+            }
+        }
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        ret = 1;
+    }
+    catch(...) {
+        std::cerr << "Unrecognized exception caught." << std::endl;
+        ret = 1;
+    }
+
+    // clean up
+    MPI_Finalize();
+
+    return ret;
+}
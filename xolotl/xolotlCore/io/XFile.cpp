@@ -2,6 +2,9 @@
 #include <sstream>
 #include <iterator>
 #include <array>
+#include <cmath>
+#include <algorithm>
+#include <cstdio>
 #include "hdf5.h"
 #include "mpi.h"
 #include "xolotlCore/io/XFile.h"
@@ -11,6 +14,76 @@
 
 namespace xolotlCore {
 
+namespace {
+
+// Obtain the names of the links of a group.
+std::vector<std::string> getLinkNames(hid_t groupId,
+		const std::string& groupName) {
+
+	H5G_info_t groupInfo;
+	if (H5Gget_info(groupId, &groupInfo) < 0) {
+		throw HDF5Exception("Unable to list the groups in " + groupName);
+	}
+
+	std::vector<std::string> linkNames;
+	for (hsize_t n = 0; n < groupInfo.nlinks; n++) {
+		auto nameSize = H5Lget_name_by_idx(groupId, ".", H5_INDEX_NAME,
+				H5_ITER_INC, n, nullptr, 0, H5P_DEFAULT);
+		if (nameSize < 0) {
+			throw HDF5Exception("Unable to list the groups in " + groupName);
+		}
+		std::vector<char> name(nameSize + 1);
+		H5Lget_name_by_idx(groupId, ".", H5_INDEX_NAME, H5_ITER_INC, n,
+				name.data(), name.size(), H5P_DEFAULT);
+		linkNames.emplace_back(name.data());
+	}
+
+	return linkNames;
+}
+
+// Copy an attribute to the object given as data.
+herr_t copyAttribute(hid_t fromId, const char* name, const H5A_info_t*,
+		void* toId) {
+
+	hid_t attrId = H5Aopen(fromId, name, H5P_DEFAULT);
+	hid_t typeId = H5Aget_type(attrId);
+	hid_t memTypeId = H5Tget_native_type(typeId, H5T_DIR_DEFAULT);
+	hid_t spaceId = H5Aget_space(attrId);
+	std::vector<char> buffer(
+			H5Sget_simple_extent_npoints(spaceId) * H5Tget_size(memTypeId));
+	hid_t copyId = H5Acreate(*(hid_t *) toId, name, typeId, spaceId,
+	H5P_DEFAULT, H5P_DEFAULT);
+	herr_t status = H5Aread(attrId, memTypeId, buffer.data());
+	if (status >= 0) {
+		status = H5Awrite(copyId, memTypeId, buffer.data());
+
+		// Variable length strings and sequences were allocated by the read
+		if (H5Tis_variable_str(memTypeId) > 0
+				or H5Tdetect_class(memTypeId, H5T_VLEN) > 0) {
+			H5Dvlen_reclaim(memTypeId, spaceId, H5P_DEFAULT, buffer.data());
+		}
+	}
+	H5Aclose(copyId);
+	H5Sclose(spaceId);
+	H5Tclose(memTypeId);
+	H5Tclose(typeId);
+	H5Aclose(attrId);
+
+	return status;
+}
+
+// Copy all the attributes of an object to another one.
+void copyAttributes(const HDF5Object& from, const HDF5Object& to) {
+
+	hid_t toId = to.getId();
+	if (H5Aiterate(from.getId(), H5_INDEX_NAME, H5_ITER_INC, nullptr,
+			copyAttribute, &toId) < 0) {
+		throw HDF5Exception("Unable to copy the attributes of " + from.getName());
+	}
+}
+
+} // namespace
+
 HDF5File::AccessMode XFile::EnsureCreateAccessMode(HDF5File::AccessMode mode) {
 
 	bool createMode = ((mode == HDF5File::AccessMode::CreateOrTruncateIfExists)
@@ -46,12 +119,61 @@ XFile::XFile(fs::path _path, const std::vector<double>& grid,
 	ConcentrationGroup concGroup(*this, true);
 }
 
-XFile::XFile(fs::path _path, MPI_Comm _comm, AccessMode _mode) :
-		HDF5File(_path, EnsureOpenAccessMode(_mode), _comm, true) {
+XFile::XFile(fs::path _path, MPI_Comm _comm, AccessMode _mode,
+		bool collectiveMetadata) :
+		HDF5File(_path, EnsureOpenAccessMode(_mode), _comm, true,
+				collectiveMetadata) {
 
 	// Nothing else to do.
 }
 
+void XFile::compact(fs::path path, MPI_Comm comm) {
+
+	int procId;
+	MPI_Comm_rank(comm, &procId);
+
+	// One process copies the file while the others wait for it
+	std::string error;
+	if (procId == 0) {
+		fs::path copyPath = path.string() + ".tmp";
+		try {
+			{
+				XFile file(path, MPI_COMM_SELF);
+				HDF5File copy(copyPath, AccessMode::CreateOrTruncateIfExists,
+				MPI_COMM_SELF, false);
+
+				// Copy the objects with their attributes, only the root
+				// group can't be copied as a whole
+				copyAttributes(file, copy);
+				for (auto const& linkName : getLinkNames(file.getId(),
+						file.getName())) {
+					if (H5Ocopy(file.getId(), linkName.c_str(), copy.getId(),
+							linkName.c_str(), H5P_DEFAULT, H5P_DEFAULT) < 0) {
+						throw HDF5Exception("Unable to copy " + linkName);
+					}
+				}
+			}
+
+			// Replace the file once the copy is closed
+			if (std::rename(copyPath.string().c_str(), path.string().c_str())
+					!= 0) {
+				throw HDF5Exception("Unable to replace " + path.string());
+			}
+		} catch (std::exception& e) {
+			error = e.what();
+		}
+	}
+
+	// Everybody fails if the copy did
+	int failed = !error.empty();
+	MPI_Bcast(&failed, 1, MPI_INT, 0, comm);
+	if (failed) {
+		throw HDF5Exception(
+				"Unable to compact " + path.string()
+						+ (error.empty() ? "" : ": " + error));
+	}
+}
+
 //----------------------------------------------------------------------------
 // HeaderGroup
 //
@@ -59,6 +181,7 @@ const fs::path XFile::HeaderGroup::path = "/headerGroup";
 const std::string XFile::HeaderGroup::netCompsDatasetName = "composition";
 const std::string XFile::HeaderGroup::nxAttrName = "nx";
 const std::string XFile::HeaderGroup::hxAttrName = "hx";
+const std::string XFile::HeaderGroup::hxRightAttrName = "hxRight";
 const std::string XFile::HeaderGroup::nyAttrName = "ny";
 const std::string XFile::HeaderGroup::hyAttrName = "hy";
 const std::string XFile::HeaderGroup::nzAttrName = "nz";
@@ -74,17 +197,8 @@ XFile::HeaderGroup::HeaderGroup(const XFile& file,
 	// Build a dataspace for our scalar attributes.
 	XFile::ScalarDataSpace scalarDSpace;
 
-	// Add an nx attribute.
-	int nx = grid.size() - 2;
-	Attribute<decltype(nx)> nxAttr(*this, nxAttrName, scalarDSpace);
-	nxAttr.setTo(nx);
-
-	// Add an hy attribute.
-	double hx = 0.0;
-	if (grid.size() > 0)
-		hx = grid[1] - grid[0];
-	Attribute<decltype(hx)> hxAttr(*this, hxAttrName, scalarDSpace);
-	hxAttr.setTo(hx);
+	// Add the nx, hx, and hxRight attributes, and the grid dataset.
+	writeXGrid(grid);
 
 	// Add an ny attribute.
 	Attribute<decltype(ny)> nyAttr(*this, nyAttrName, scalarDSpace);
@@ -100,21 +214,6 @@ XFile::HeaderGroup::HeaderGroup(const XFile& file,
 	Attribute<decltype(hz)> hzAttr(*this, hzAttrName, scalarDSpace);
 	hzAttr.setTo(hz);
 
-	if (nx > 0) {
-		// Create, write, and close the grid dataset
-		double gridArray[nx];
-		for (int i = 0; i < nx; i++) {
-			gridArray[i] = grid[i + 1] - grid[1];
-		}
-		std::array<hsize_t, 1> dims { (hsize_t) nx };
-		XFile::SimpleDataSpace<1> gridDSpace(dims);
-		hid_t datasetId = H5Dcreate2(getId(), "grid", H5T_IEEE_F64LE,
-				gridDSpace.getId(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-		auto status = H5Dwrite(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
-		H5P_DEFAULT, &gridArray);
-		status = H5Dclose(datasetId);
-	}
-
 	// Initialize the network composition list.  Done here because
 	// it is a dataset in the header group.
 	initNetworkComps(compVec);
@@ -182,6 +281,100 @@ void XFile::HeaderGroup::read(int &nx, double &hx, int &ny, double &hy, int &nz,
 	hz = hzAttr.get();
 }
 
+void XFile::HeaderGroup::writeXGrid(const std::vector<double>& grid) const {
+
+	// Build a dataspace for our scalar attributes.
+	XFile::ScalarDataSpace scalarDSpace;
+
+	// Create the attribute the first time, then overwrite it
+	auto setAttr = [this, &scalarDSpace](const std::string& name,
+			double value) {
+		if (H5Aexists(getId(), name.c_str()) > 0) {
+			Attribute<double> attr(*this, name);
+			attr.setTo(value);
+		} else {
+			Attribute<double> attr(*this, name, scalarDSpace);
+			attr.setTo(value);
+		}
+	};
+
+	// Set the nx attribute.
+	int nx = grid.size() - 2;
+	if (H5Aexists(getId(), nxAttrName.c_str()) > 0) {
+		Attribute<decltype(nx)> nxAttr(*this, nxAttrName);
+		nxAttr.setTo(nx);
+	} else {
+		Attribute<decltype(nx)> nxAttr(*this, nxAttrName, scalarDSpace);
+		nxAttr.setTo(nx);
+	}
+
+	// Set the hx attribute, the step between the left boundary and the
+	// first point, and the hxRight one, the step between the last point
+	// and the right boundary.
+	double hx = 0.0, hxRight = 0.0;
+	if (grid.size() > 1)
+		hx = grid[1] - grid[0];
+	if (nx > 0)
+		hxRight = grid[nx + 1] - grid[nx];
+	setAttr(hxAttrName, hx);
+	setAttr(hxRightAttrName, hxRight);
+
+	// Replace the grid dataset
+	if (H5Lexists(getId(), "grid", H5P_DEFAULT) > 0) {
+		H5Ldelete(getId(), "grid", H5P_DEFAULT);
+	}
+	if (nx > 0) {
+		// Create, write, and close the grid dataset
+		std::vector<double> gridArray(nx);
+		for (int i = 0; i < nx; i++) {
+			gridArray[i] = grid[i + 1] - grid[1];
+		}
+		std::array<hsize_t, 1> dims { (hsize_t) nx };
+		XFile::SimpleDataSpace<1> gridDSpace(dims);
+		hid_t datasetId = H5Dcreate2(getId(), "grid", H5T_IEEE_F64LE,
+				gridDSpace.getId(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+		auto status = H5Dwrite(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
+		H5P_DEFAULT, gridArray.data());
+		status = H5Dclose(datasetId);
+		if (status < 0) {
+			throw HDF5Exception("Unable to write the grid of the header");
+		}
+	}
+}
+
+std::vector<double> XFile::HeaderGroup::readXGrid(void) const {
+
+	std::vector<double> grid;
+
+	// The grid is only written when there is more than one point, and
+	// older files do not have the step to the right boundary
+	if (H5Lexists(getId(), "grid", H5P_DEFAULT) <= 0
+			or H5Aexists(getId(), hxRightAttrName.c_str()) <= 0)
+		return grid;
+
+	// Open and read the hx attribute, the step between the
+	// left boundary and the first point
+	Attribute<double> hxAttr(*this, hxAttrName);
+	double hx = hxAttr.get();
+
+	// Open and read the grid dataset
+	DataSet<std::vector<double>> dataset(*this, "grid");
+	auto points = dataset.read();
+	int nx = points.size();
+
+	// Rebuild the full grid
+	grid.push_back(0.0);
+	for (int i = 0; i < nx; i++) {
+		grid.push_back(hx + points[i]);
+	}
+	// Open and read the hxRight attribute, the step between the
+	// last point and the right boundary
+	Attribute<double> hxRightAttr(*this, hxRightAttrName);
+	grid.push_back(grid[nx] + hxRightAttr.get());
+
+	return grid;
+}
+
 XFile::HeaderGroup::NetworkCompsType XFile::HeaderGroup::readNetworkComps(
 		void) const {
 
@@ -836,6 +1029,63 @@ std::unique_ptr<XFile::TimestepGroup> XFile::ConcentrationGroup::getLastTimestep
 	return std::move(tsGroup);
 }
 
+std::vector<int> XFile::ConcentrationGroup::getTimeSteps(void) const {
+
+	// Look at all our links, keeping the time step groups
+	std::vector<int> timeSteps;
+	auto const& prefix = TimestepGroup::groupNamePrefix;
+	for (auto const& linkName : getLinkNames(getId(), getName())) {
+		if (linkName.compare(0, prefix.size(), prefix) == 0) {
+			timeSteps.push_back(std::stoi(linkName.substr(prefix.size())));
+		}
+	}
+	std::sort(timeSteps.begin(), timeSteps.end());
+
+	return timeSteps;
+}
+
+std::set<int> XFile::ConcentrationGroup::getKeptTimeSteps(int nKept) const {
+
+	auto timeSteps = getTimeSteps();
+	if (nKept <= 0 || timeSteps.size() <= (size_t) nKept)
+		return std::set<int>(timeSteps.begin(), timeSteps.end());
+
+	// Keep the most recent groups...
+	std::set<int> keptTimeSteps(timeSteps.end() - nKept, timeSteps.end());
+
+	// ...and the keyframes they are built from
+	for (auto timeStep : std::vector<int>(keptTimeSteps.begin(),
+			keptTimeSteps.end())) {
+		TimestepGroup tsGroup(*this, timeStep);
+		auto keyTimeStep = tsGroup.readKeyframe();
+		if (keyTimeStep >= 0)
+			keptTimeSteps.insert(keyTimeStep);
+	}
+
+	return keptTimeSteps;
+}
+
+int XFile::ConcentrationGroup::removeOldTimestepGroups(int nKept) const {
+
+	auto timeSteps = getTimeSteps();
+	auto keptTimeSteps = getKeptTimeSteps(nKept);
+
+	// Every process removes the same links in the same order
+	int nRemoved = 0;
+	for (auto timeStep : timeSteps) {
+		if (keptTimeSteps.count(timeStep))
+			continue;
+		auto linkName = TimestepGroup::groupNamePrefix
+				+ std::to_string(timeStep);
+		if (H5Ldelete(getId(), linkName.c_str(), H5P_DEFAULT) < 0) {
+			throw HDF5Exception("Unable to remove " + linkName);
+		}
+		nRemoved++;
+	}
+
+	return nRemoved;
+}
+
 //----------------------------------------------------------------------------
 // TimestepGroup
 //
@@ -854,6 +1104,8 @@ const std::string XFile::TimestepGroup::nTAttrName = "nTritium";
 const std::string XFile::TimestepGroup::prevTFluxAttrName = "previousTFlux";
 
 const std::string XFile::TimestepGroup::concDatasetName = "concs";
+const std::string XFile::TimestepGroup::keyframeAttrName = "keyframeTimeStep";
+const hsize_t XFile::TimestepGroup::rowChunkSize = 4096;
 
 std::string XFile::TimestepGroup::makeGroupName(
 		const XFile::ConcentrationGroup& concGroup, int timeStep) {
@@ -892,6 +1144,15 @@ XFile::TimestepGroup::TimestepGroup(const XFile::ConcentrationGroup& concGroup,
 	// Base class opened the group, so nothing else to do.
 }
 
+XFile::TimestepGroup::TimestepGroup(const XFile::TimestepGroup& delta,
+		int keyTimeStep) :
+		HDF5File::Group(delta,
+				ConcentrationGroup::path.string() + '/' + groupNamePrefix
+						+ std::to_string(keyTimeStep), false) {
+
+	// Base class opened the group, so nothing else to do.
+}
+
 void XFile::TimestepGroup::writeSurface1D(Surface1DType iSurface,
 		Data1DType nInter, Data1DType previousFlux) const {
 
@@ -1136,36 +1397,21 @@ void XFile::TimestepGroup::writeBottom2D(const Data2DType& nHe,
 	status = H5Dclose(datasetId);
 }
 
-void XFile::TimestepGroup::writeConcentrationDataset(int size,
-		double concArray[][2], bool write, int i, int j, int k) {
-
-	// Set the dataset name
-	std::stringstream datasetName;
-	datasetName << "position_" << i << "_" << j << "_" << k;
-
-	// Create the dataspace for the dataset with dimension dims
-	std::array<hsize_t, 2> dims { (hsize_t) size, (hsize_t) 2 };
-	XFile::SimpleDataSpace<2> concDSpace(dims);
-
-	// Create the dataset of concentrations for this position
-	hid_t datasetId = H5Dcreate2(getId(), datasetName.str().c_str(),
-	H5T_IEEE_F64LE, concDSpace.getId(),
-	H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-
-	// Create property list for independent dataset write.
-	hid_t propertyListId = H5Pcreate(H5P_DATASET_XFER);
-	auto status = H5Pset_dxpl_mpio(propertyListId, H5FD_MPIO_INDEPENDENT);
-
-	if (write) {
-		// Write concArray in the dataset
-		status = H5Dwrite(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
-				propertyListId, concArray);
+auto XFile::TimestepGroup::roundConcentrations(const Concs1DType& concs,
+		int lossyBits) -> Concs1DType {
+
+	// Keep lossyBits bits of the mantissa, rounding to the nearest
+	double scale = std::ldexp(1.0, lossyBits);
+	Concs1DType ret(concs);
+	for (auto& pointConcs : ret) {
+		for (auto& conc : pointConcs) {
+			int exponent = 0;
+			double mantissa = std::frexp(conc.second, &exponent);
+			conc.second = std::ldexp(std::round(mantissa * scale) / scale,
+					exponent);
+		}
 	}
-
-	// Close dataset
-	status = H5Dclose(datasetId);
-
-	return;
+	return ret;
 }
 
 // Caller gives us 2D ragged representation, and we flatten it into
@@ -1175,9 +1421,17 @@ void XFile::TimestepGroup::writeConcentrationDataset(int size,
 void XFile::TimestepGroup::writeConcentrations(const XFile& file, int baseX,
 		const Concs1DType& raggedConcs) const {
 
+	// Round the values first if the file is compressed with losses
+	auto const& compression = file.getCompression();
+	Concs1DType roundedConcs;
+	if (compression.lossyBits > 0)
+		roundedConcs = roundConcentrations(raggedConcs, compression.lossyBits);
+	auto const& concs =
+			(compression.lossyBits > 0) ? roundedConcs : raggedConcs;
+
 	// Create and write the ragged dataset.
 	RaggedDataSet2D<ConcType> dataset(file.getComm(), *this, concDatasetName,
-			baseX, raggedConcs);
+			baseX, concs, compression);
 
 	// Unlike our other DataSet types, there is no need to call a
 	// 'write' on the dataset.  The constructor above
@@ -1189,7 +1443,311 @@ XFile::TimestepGroup::Concs1DType XFile::TimestepGroup::readConcentrations(
 
 	// Open and read the ragged dataset.
 	RaggedDataSet2D<ConcType> dataset(file.getComm(), *this, concDatasetName);
-	return dataset.read(baseX, numX);
+	auto concs = dataset.read(baseX, numX);
+
+	// Rebuild the full state if we only have the changes since a keyframe
+	auto keyTimeStep = readKeyframe();
+	if (keyTimeStep >= 0) {
+		TimestepGroup keyGroup(*this, keyTimeStep);
+		auto keyConcs = keyGroup.readConcentrations(file, baseX, numX);
+		applyDelta(keyConcs, concs);
+		return keyConcs;
+	}
+	return concs;
+}
+
+void XFile::TimestepGroup::writeConcentrations(const XFile& file, int baseX,
+		int baseY, int numX, int numY, const Concs1DType& raggedConcs) const {
+
+	// Round the values first if the file is compressed with losses
+	auto const& compression = file.getCompression();
+	Concs1DType roundedConcs;
+	if (compression.lossyBits > 0)
+		roundedConcs = roundConcentrations(raggedConcs, compression.lossyBits);
+	auto const& concs =
+			(compression.lossyBits > 0) ? roundedConcs : raggedConcs;
+
+	// Create and write the ragged dataset, y being the slowest direction.
+	RaggedDataSetND<ConcType, 2> dataset(file.getComm(), *this,
+			concDatasetName, { baseY, baseX }, { numY, numX }, concs,
+			compression);
+}
+
+void XFile::TimestepGroup::writeConcentrations(const XFile& file, int baseX,
+		int baseY, int baseZ, int numX, int numY, int numZ,
+		const Concs1DType& raggedConcs) const {
+
+	// Round the values first if the file is compressed with losses
+	auto const& compression = file.getCompression();
+	Concs1DType roundedConcs;
+	if (compression.lossyBits > 0)
+		roundedConcs = roundConcentrations(raggedConcs, compression.lossyBits);
+	auto const& concs =
+			(compression.lossyBits > 0) ? roundedConcs : raggedConcs;
+
+	// Create and write the ragged dataset, z being the slowest direction.
+	RaggedDataSetND<ConcType, 3> dataset(file.getComm(), *this,
+			concDatasetName, { baseZ, baseY, baseX }, { numZ, numY, numX },
+			concs, compression);
+}
+
+XFile::TimestepGroup::Concs1DType XFile::TimestepGroup::readConcentrations(
+		const XFile& file, int baseX, int baseY, int numX, int numY) const {
+
+	// Older files have one dataset per grid point
+	if (H5Lexists(getId(), concDatasetName.c_str(), H5P_DEFAULT) <= 0) {
+		Concs1DType ret(numX * numY);
+		for (int j = 0; j < numY; j++) {
+			for (int i = 0; i < numX; i++) {
+				for (auto const& conc : readGridPoint(baseX + i, baseY + j)) {
+					ret[j * numX + i].emplace_back((int) conc[0], conc[1]);
+				}
+			}
+		}
+		return ret;
+	}
+
+	// Open and read our block of the ragged dataset.
+	RaggedDataSetND<ConcType, 2> dataset(file.getComm(), *this,
+			concDatasetName);
+	auto concs = dataset.read( { baseY, baseX }, { numY, numX });
+
+	// Rebuild the full state if we only have the changes since a keyframe
+	auto keyTimeStep = readKeyframe();
+	if (keyTimeStep >= 0) {
+		TimestepGroup keyGroup(*this, keyTimeStep);
+		auto keyConcs = keyGroup.readConcentrations(file, baseX, baseY, numX,
+				numY);
+		applyDelta(keyConcs, concs);
+		return keyConcs;
+	}
+	return concs;
+}
+
+XFile::TimestepGroup::Concs1DType XFile::TimestepGroup::readConcentrations(
+		const XFile& file, int baseX, int baseY, int baseZ, int numX, int numY,
+		int numZ) const {
+
+	// Older files have one dataset per grid point
+	if (H5Lexists(getId(), concDatasetName.c_str(), H5P_DEFAULT) <= 0) {
+		Concs1DType ret(numX * numY * numZ);
+		for (int k = 0; k < numZ; k++) {
+			for (int j = 0; j < numY; j++) {
+				for (int i = 0; i < numX; i++) {
+					for (auto const& conc : readGridPoint(baseX + i, baseY + j,
+							baseZ + k)) {
+						ret[(k * numY + j) * numX + i].emplace_back(
+								(int) conc[0], conc[1]);
+					}
+				}
+			}
+		}
+		return ret;
+	}
+
+	// Open and read our block of the ragged dataset.
+	RaggedDataSetND<ConcType, 3> dataset(file.getComm(), *this,
+			concDatasetName);
+	auto concs = dataset.read( { baseZ, baseY, baseX }, { numZ, numY, numX });
+
+	// Rebuild the full state if we only have the changes since a keyframe
+	auto keyTimeStep = readKeyframe();
+	if (keyTimeStep >= 0) {
+		TimestepGroup keyGroup(*this, keyTimeStep);
+		auto keyConcs = keyGroup.readConcentrations(file, baseX, baseY, baseZ,
+				numX, numY, numZ);
+		applyDelta(keyConcs, concs);
+		return keyConcs;
+	}
+	return concs;
+}
+
+bool XFile::TimestepGroup::hasGridPointConcentrations(void) const {
+
+	return H5Lexists(getId(), concDatasetName.c_str(), H5P_DEFAULT) <= 0;
+}
+
+void XFile::TimestepGroup::convertGridPointConcentrations(const XFile& file,
+		int baseX, int numX, int batchSize) const {
+
+	// Find the number of concentrations of each of our grid points
+	// from the size of its data set, without reading it
+	std::vector<uint32_t> numConcsByPoint(numX, 0);
+	for (int i = 0; i < numX; i++) {
+		std::stringstream datasetName;
+		datasetName << "position_" << baseX + i << "_-1_-1";
+		if (H5Lexists(getId(), datasetName.str().c_str(), H5P_DEFAULT) <= 0)
+			continue;
+
+		hid_t datasetId = H5Dopen(getId(), datasetName.str().c_str(),
+		H5P_DEFAULT);
+		hid_t dataspaceId = H5Dget_space(datasetId);
+		std::array<hsize_t, 2> dims;
+		H5Sget_simple_extent_dims(dataspaceId, dims.data(), nullptr);
+		numConcsByPoint[i] = dims[0];
+		H5Sclose(dataspaceId);
+		H5Dclose(datasetId);
+	}
+
+	// Create the ragged dataset, without its data yet
+	auto const& compression = file.getCompression();
+	RaggedDataSet2D<ConcType> dataset(file.getComm(), *this, concDatasetName,
+			baseX, numConcsByPoint, compression);
+
+	// Every process must write as many batches
+	if (batchSize <= 0)
+		batchSize = std::max(numX, 1);
+	int nBatches = (numX + batchSize - 1) / batchSize, maxNBatches = 0;
+	MPI_Allreduce(&nBatches, &maxNBatches, 1, MPI_INT, MPI_MAX,
+			file.getComm());
+
+	for (int batch = 0; batch < maxNBatches; batch++) {
+		// Read the batch, which is empty once we are done
+		int firstX = std::min(batch * batchSize, numX);
+		int lastX = std::min(firstX + batchSize, numX);
+		Concs1DType concs(lastX - firstX);
+		for (int i = firstX; i < lastX; i++) {
+			for (auto const& conc : readGridPoint(baseX + i)) {
+				concs[i - firstX].emplace_back((int) conc[0], conc[1]);
+			}
+		}
+
+		// Round the values if the file is compressed with losses
+		if (compression.lossyBits > 0)
+			concs = roundConcentrations(concs, compression.lossyBits);
+
+		dataset.write(firstX, concs);
+	}
+}
+
+void XFile::TimestepGroup::writeKeyframe(int keyTimeStep) const {
+
+	// Add the keyframe attribute.
+	XFile::ScalarDataSpace scalarDSpace;
+	Attribute<decltype(keyTimeStep)> keyframeAttr(*this, keyframeAttrName,
+			scalarDSpace);
+	keyframeAttr.setTo(keyTimeStep);
+}
+
+int XFile::TimestepGroup::readKeyframe(void) const {
+
+	// Groups with the full state don't have the attribute
+	if (H5Aexists(getId(), keyframeAttrName.c_str()) <= 0)
+		return -1;
+
+	Attribute<int> keyframeAttr(*this, keyframeAttrName);
+	return keyframeAttr.get();
+}
+
+auto XFile::TimestepGroup::makeDelta(const Concs1DType& keyConcs,
+		const Concs1DType& concs, double tolerance) -> Concs1DType {
+
+	// Walk through both sorted lists of each grid point at once
+	Concs1DType delta(concs.size());
+	for (int i = 0; i < concs.size(); i++) {
+		auto const& keyPoint = keyConcs[i];
+		auto const& point = concs[i];
+		auto keyIt = keyPoint.begin();
+		auto it = point.begin();
+		while (keyIt != keyPoint.end() or it != point.end()) {
+			if (it == point.end()
+					or (keyIt != keyPoint.end() and keyIt->first < it->first)) {
+				// The cluster was removed
+				delta[i].emplace_back(keyIt->first, 0.0);
+				++keyIt;
+			} else if (keyIt == keyPoint.end() or it->first < keyIt->first) {
+				// The cluster was added
+				delta[i].push_back(*it);
+				++it;
+			} else {
+				// Only keep the large enough changes
+				if (std::fabs(it->second - keyIt->second)
+						> tolerance * std::fabs(keyIt->second))
+					delta[i].push_back(*it);
+				++keyIt;
+				++it;
+			}
+		}
+	}
+
+	return delta;
+}
+
+auto XFile::TimestepGroup::packConcentrations(const double* values,
+		int nPoints, int dof, double relTolerance,
+		std::vector<int>& indexBuffer, MPI_Comm comm) -> Concs1DType {
+
+	// The threshold may be relative to the largest concentration of all the
+	// processes, the temperature (the last value) being left out
+	const std::size_t nValues = (std::size_t) nPoints * dof;
+	double threshold = 1.0e-16;
+	if (relTolerance > 0.0) {
+		double localMaxConc = 0.0;
+		for (std::size_t n = 0; n < nValues; n++) {
+			if (n % dof != dof - 1)
+				localMaxConc = std::max(localMaxConc, std::fabs(values[n]));
+		}
+		double maxConc = 0.0;
+		MPI_Allreduce(&localMaxConc, &maxConc, 1, MPI_DOUBLE, MPI_MAX, comm);
+		threshold = std::max(threshold, relTolerance * maxConc);
+	}
+
+	indexBuffer.resize(dof);
+	Concs1DType concs(nPoints);
+	for (int i = 0; i < nPoints; i++) {
+		const double* pointValues = values + (std::size_t) i * dof;
+
+		// Compact the indices of the kept values, always writing
+		// the index but only moving forward when it is kept
+		int nKept = 0;
+		for (int l = 0; l < dof - 1; l++) {
+			indexBuffer[nKept] = l;
+			nKept += (std::fabs(pointValues[l]) > threshold);
+		}
+
+		// The temperature is always kept
+		indexBuffer[nKept++] = dof - 1;
+
+		// Gather the kept values
+		auto& pointConcs = concs[i];
+		pointConcs.reserve(nKept);
+		for (int n = 0; n < nKept; n++) {
+			pointConcs.emplace_back(indexBuffer[n],
+					pointValues[indexBuffer[n]]);
+		}
+	}
+
+	return concs;
+}
+
+void XFile::TimestepGroup::applyDelta(Concs1DType& keyConcs,
+		const Concs1DType& delta) {
+
+	for (int i = 0; i < keyConcs.size(); i++) {
+		// Merge the sorted lists, the changes taking precedence
+		std::vector<ConcType> point;
+		point.reserve(keyConcs[i].size() + delta[i].size());
+		auto keyIt = keyConcs[i].begin();
+		auto it = delta[i].begin();
+		while (keyIt != keyConcs[i].end() or it != delta[i].end()) {
+			if (it == delta[i].end()
+					or (keyIt != keyConcs[i].end()
+							and keyIt->first < it->first)) {
+				point.push_back(*keyIt);
+				++keyIt;
+			} else {
+				if (keyIt != keyConcs[i].end() and keyIt->first == it->first)
+					++keyIt;
+				// A zero means the cluster was removed
+				if (it->second != 0.0)
+					point.push_back(*it);
+				++it;
+			}
+		}
+		keyConcs[i] = std::move(point);
+	}
+
+	return;
 }
 
 std::pair<double, double> XFile::TimestepGroup::readTimes(void) const {
@@ -1276,43 +1834,134 @@ auto XFile::TimestepGroup::readData2D(
 auto XFile::TimestepGroup::readData3D(
 		const std::string& dataName) const -> Data3DType {
 
+	// Fill the vector to return chunk by chunk, so that the whole
+	// data set is never held twice
+	Data3DType toReturn;
+	visitRows(dataName, rowChunkSize,
+			[&toReturn](hsize_t, hsize_t nRows, hsize_t nCols,
+					const Data1DType* values) {
+				for (hsize_t i = 0; i < nRows; i++) {
+					toReturn.emplace_back(values + i * nCols,
+							values + (i + 1) * nCols);
+				}
+			});
+
+	return toReturn;
+}
+
+std::array<hsize_t, 2> XFile::TimestepGroup::readDataDims(
+		const std::string& dataName) const {
+
 	// Open the dataset
 	hid_t datasetId = H5Dopen(getId(), dataName.c_str(), H5P_DEFAULT);
-
-	// Get the dataspace object
-	hid_t dataspaceId = H5Dget_space(datasetId);
+	if (datasetId < 0) {
+		throw HDF5Exception("Unable to open DataSet " + dataName);
+	}
 
 	// Get the dimensions of the dataset
-	std::array<hsize_t, 2> dims;
+	hid_t dataspaceId = H5Dget_space(datasetId);
+	std::array<hsize_t, 2> dims { 0, 0 };
 	auto status = H5Sget_simple_extent_dims(dataspaceId, dims.data(), nullptr);
 
-	// Create the array that will receive the indices
-	Data3DType::value_type quantity(dims[0] * dims[1]);
+	// Close everything
+	H5Sclose(dataspaceId);
+	H5Dclose(datasetId);
+	if (status < 0) {
+		throw HDF5Exception("Unable to read the dimensions of " + dataName);
+	}
 
-	// Read the data set
-	status = H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
-	H5P_DEFAULT, quantity.data());
+	return dims;
+}
 
-	// Loop on the length and fill the vector to return
-	Data3DType toReturn(dims[0]);
-	for (int i = 0; i < dims[0]; i++) {
+void XFile::TimestepGroup::readRows(const std::string& dataName,
+		hsize_t firstRow, hsize_t nRows, Data1DType* values) const {
 
-		toReturn[i].reserve(dims[1]);
-		std::copy(quantity.begin() + i * dims[1],
-				quantity.begin() + (i + 1) * dims[1],
-				std::back_inserter(toReturn[i]));
+	// Open the dataset
+	hid_t datasetId = H5Dopen(getId(), dataName.c_str(), H5P_DEFAULT);
+	if (datasetId < 0) {
+		throw HDF5Exception("Unable to open DataSet " + dataName);
+	}
+
+	// Select the rows in the file...
+	hid_t fileSpaceId = H5Dget_space(datasetId);
+	std::array<hsize_t, 2> dims;
+	H5Sget_simple_extent_dims(fileSpaceId, dims.data(), nullptr);
+	std::array<hsize_t, 2> offsets { firstRow, 0 };
+	std::array<hsize_t, 2> counts { nRows, dims[1] };
+	auto status = H5Sselect_hyperslab(fileSpaceId, H5S_SELECT_SET,
+			offsets.data(), nullptr, counts.data(), nullptr);
+
+	// ...and read them directly in the given buffer
+	if (status >= 0) {
+		hid_t memSpaceId = H5Screate_simple(2, counts.data(), nullptr);
+		status = H5Dread(datasetId, H5T_NATIVE_DOUBLE, memSpaceId,
+				fileSpaceId, H5P_DEFAULT, values);
+		H5Sclose(memSpaceId);
 	}
 
 	// Close everything
-	status = H5Dclose(datasetId);
-	status = H5Sclose(dataspaceId);
+	H5Sclose(fileSpaceId);
+	H5Dclose(datasetId);
+	if (status < 0) {
+		throw HDF5Exception("Unable to read rows of " + dataName);
+	}
+}
 
-	return toReturn;
+void XFile::TimestepGroup::visitRows(const std::string& dataName,
+		hsize_t chunkRows, const RowVisitor& visitor) const {
+
+	auto dims = readDataDims(dataName);
+	if (dims[0] == 0 or dims[1] == 0)
+		return;
+
+	// One buffer for all the chunks
+	chunkRows = std::max<hsize_t>(std::min(chunkRows, dims[0]), 1);
+	std::vector<Data1DType> buffer(chunkRows * dims[1]);
+	for (hsize_t firstRow = 0; firstRow < dims[0]; firstRow += chunkRows) {
+		auto nRows = std::min(chunkRows, dims[0] - firstRow);
+		readRows(dataName, firstRow, nRows, buffer.data());
+		visitor(firstRow, nRows, dims[1], buffer.data());
+	}
 }
 
 auto XFile::TimestepGroup::readGridPoint(int i, int j,
 		int k) const -> Data3DType {
 
+	// Checkpoints written as one ragged dataset, the grid point is read
+	// by this process alone with independent transfers
+	if (H5Lexists(getId(), concDatasetName.c_str(), H5P_DEFAULT) > 0
+			and j >= 0) {
+		TimestepGroup::Concs1DType concs;
+		if (k >= 0) {
+			RaggedDataSetND<ConcType, 3> dataset(MPI_COMM_SELF, *this,
+					concDatasetName);
+			concs = dataset.read( { k, j, i }, { 1, 1, 1 }, false);
+		} else {
+			RaggedDataSetND<ConcType, 2> dataset(MPI_COMM_SELF, *this,
+					concDatasetName);
+			concs = dataset.read( { j, i }, { 1, 1 }, false);
+		}
+
+		// Rebuild the full state if we only have the changes since a keyframe
+		auto keyTimeStep = readKeyframe();
+		if (keyTimeStep >= 0) {
+			TimestepGroup keyGroup(*this, keyTimeStep);
+			Concs1DType keyConcs(1);
+			for (auto const& conc : keyGroup.readGridPoint(i, j, k)) {
+				keyConcs[0].emplace_back((int) conc[0], conc[1]);
+			}
+			applyDelta(keyConcs, concs);
+			concs = std::move(keyConcs);
+		}
+
+		Data3DType toReturn;
+		for (auto const& currConcData : concs[0]) {
+			toReturn.push_back( { (double) currConcData.first,
+					currConcData.second });
+		}
+		return toReturn;
+	}
+
 	// Set the dataset name
 	std::stringstream datasetName;
 	datasetName << "position_" << i << "_" << j << "_" << k;
@@ -1324,38 +1973,7 @@ auto XFile::TimestepGroup::readGridPoint(int i, int j,
 	// If the dataset exists
 	Data3DType toReturn;
 	if (datasetExist) {
-		// Open the dataset
-		hid_t datasetId = H5Dopen(getId(), datasetName.str().c_str(),
-		H5P_DEFAULT);
-
-		// Get the dataspace object
-		hid_t dataspaceId = H5Dget_space(datasetId);
-
-		// Get the dimensions of the dataset
-		std::array<hsize_t, 2> dims;
-		auto status = H5Sget_simple_extent_dims(dataspaceId, dims.data(),
-				nullptr);
-
-		// Create the array that will receive the concentrations
-		Data3DType::value_type conc(dims[0] * dims[1]);
-
-		// Read the data set
-		status = H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
-		H5P_DEFAULT, conc.data());
-
-		// Loop on the length
-		toReturn.resize(dims[0]);
-		for (unsigned int n = 0; n < dims[0]; n++) {
-
-			toReturn[n].reserve(dims[1]);
-			std::copy(conc.begin() + n * dims[1],
-					conc.begin() + (n + 1) * dims[1],
-					std::back_inserter(toReturn[n]));
-		}
-
-		// Close everything
-		status = H5Dclose(datasetId);
-		status = H5Sclose(dataspaceId);
+		toReturn = readData3D(datasetName.str());
 	}
 
 	return toReturn;
@@ -5,6 +5,8 @@
 #include <vector>
 #include <tuple>
 #include <set>
+#include <array>
+#include <functional>
 #include "xolotlCore/io/HDF5File.h"
 #include "xolotlCore/io/HDF5Exception.h"
 #include <IReactionNetwork.h>
@@ -24,6 +26,8 @@ public:
 	// A group with info about a specific time step.
 	class ConcentrationGroup;
 	class TimestepGroup: public HDF5File::Group {
+		friend class ConcentrationGroup;
+
 	private:
 
 		// Prefix to use when constructing group names.
@@ -56,6 +60,12 @@ public:
 		// Name of the concentrations data set.
 		static const std::string concDatasetName;
 
+		// Name of the attribute giving the keyframe of a delta group.
+		static const std::string keyframeAttrName;
+
+		// Number of rows read at once by the nested vector accessors.
+		static const hsize_t rowChunkSize;
+
 		/**
 		 * Construct the group name for the given time step.
 		 *
@@ -67,6 +77,25 @@ public:
 		static std::string makeGroupName(const ConcentrationGroup& concGroup,
 				int timeStep);
 
+		/**
+		 * Update the concentrations of a keyframe with the changes
+		 * written in a delta group.  A zero value removes the cluster.
+		 *
+		 * @param keyConcs The concentrations of the keyframe, updated
+		 * @param delta The changes, for the same grid points
+		 */
+		static void applyDelta(
+				std::vector<std::vector<std::pair<int, double> > >& keyConcs,
+				const std::vector<std::vector<std::pair<int, double> > >& delta);
+
+		/**
+		 * Open the keyframe group of the given delta group.
+		 *
+		 * @param delta The delta group.
+		 * @param keyTimeStep The time step of the keyframe.
+		 */
+		TimestepGroup(const TimestepGroup& delta, int keyTimeStep);
+
 	public:
 		// Concise name for surface representations.
 		using Surface1DType = int;
@@ -85,6 +114,13 @@ public:
 		using ConcType = std::pair<int, double>;
 		using Concs1DType = HDF5File::RaggedDataSet2D<ConcType>::Ragged2DType;
 
+		// Concise name for the function given the successive chunks
+		// of a 2D data set: the index of the first row of the chunk,
+		// the number of rows, the number of columns, and the values
+		// in row-major order, only valid during the call.
+		using RowVisitor = std::function<void(hsize_t firstRow, hsize_t nRows,
+				hsize_t nCols, const Data1DType* values)>;
+
 		/**
 		 * Construct a TimestepGroup.
 		 * Default and copy constructors explicitly disallowed.
@@ -170,20 +206,6 @@ public:
 				const Data2DType& previousDFlux, const Data2DType& nT,
 				const Data2DType& previousTFlux);
 
-		/**
-		 * Add a concentration dataset at a specific grid point.
-		 *
-		 * @param size The size of the dataset to create
-		 * @param concArray The array of concentration at a grid point
-		 * @param write To know if we own the data to write
-		 * @param i The index of the position on the grid on the x direction
-		 * @param j The index of the position on the grid on the y direction
-		 * @param k The index of the position on the grid on the z direction
-		 */
-		// TODO this should go away.
-		void writeConcentrationDataset(int size, double concArray[][2], bool write, int i,
-				int j = -1, int k = -1);
-
 		/**
 		 * Add a concentration dataset for all grid points in a 1D problem.
 		 * Caller gives us a 2D ragged representation, and we flatten
@@ -221,6 +243,168 @@ public:
 		Concs1DType readConcentrations(const XFile& file, int baseX,
 				int numX) const;
 
+		/**
+		 * Add a concentration dataset for all grid points in a 2D problem,
+		 * written as one flattened dataset and a 2D index dataset in a
+		 * single collective write phase.
+		 *
+		 * @param file The HDF5 file that owns our group.  Needed to support
+		 *              parallel file access.
+		 * @param baseX Index of first grid point we own in the x direction.
+		 * @param baseY Index of first grid point we own in the y direction.
+		 * @param numX Number of grid points we own in the x direction.
+		 * @param numY Number of grid points we own in the y direction.
+		 * @param concs Concentrations associated with grid points we own.
+		 *              Element (j * numX + i) contains concentration data
+		 *              for (baseX + i, baseY + j)
+		 */
+		void writeConcentrations(const XFile& file, int baseX, int baseY,
+				int numX, int numY, const Concs1DType& concs) const;
+
+		/**
+		 * Add a concentration dataset for all grid points in a 3D problem,
+		 * written as one flattened dataset and a 3D index dataset in a
+		 * single collective write phase.
+		 *
+		 * @param file The HDF5 file that owns our group.  Needed to support
+		 *              parallel file access.
+		 * @param baseX Index of first grid point we own in the x direction.
+		 * @param baseY Index of first grid point we own in the y direction.
+		 * @param baseZ Index of first grid point we own in the z direction.
+		 * @param numX Number of grid points we own in the x direction.
+		 * @param numY Number of grid points we own in the y direction.
+		 * @param numZ Number of grid points we own in the z direction.
+		 * @param concs Concentrations associated with grid points we own.
+		 *              Element ((k * numY + j) * numX + i) contains
+		 *              concentration data for (baseX + i, baseY + j, baseZ + k)
+		 */
+		void writeConcentrations(const XFile& file, int baseX, int baseY,
+				int baseZ, int numX, int numY, int numZ,
+				const Concs1DType& concs) const;
+
+		/**
+		 * Read the concentrations of the block of grid points we own in a
+		 * 2D problem, with collective hyperslab reads of only the part of
+		 * the file we need.  The decomposition does not need to match the
+		 * one used when writing.
+		 *
+		 * @param file The HDF5 file that owns our group.  Needed to support
+		 *              parallel file access.
+		 * @param baseX Index of first grid point we own in the x direction.
+		 * @param baseY Index of first grid point we own in the y direction.
+		 * @param numX Number of grid points we own in the x direction.
+		 * @param numY Number of grid points we own in the y direction.
+		 * @return Concentrations associated with grid points we own.
+		 *              Element (j * numX + i) contains concentration data
+		 *              for (baseX + i, baseY + j)
+		 */
+		Concs1DType readConcentrations(const XFile& file, int baseX, int baseY,
+				int numX, int numY) const;
+
+		/**
+		 * Read the concentrations of the block of grid points we own in a
+		 * 3D problem, with collective hyperslab reads of only the part of
+		 * the file we need.  The decomposition does not need to match the
+		 * one used when writing.
+		 *
+		 * @param file The HDF5 file that owns our group.  Needed to support
+		 *              parallel file access.
+		 * @param baseX Index of first grid point we own in the x direction.
+		 * @param baseY Index of first grid point we own in the y direction.
+		 * @param baseZ Index of first grid point we own in the z direction.
+		 * @param numX Number of grid points we own in the x direction.
+		 * @param numY Number of grid points we own in the y direction.
+		 * @param numZ Number of grid points we own in the z direction.
+		 * @return Concentrations associated with grid points we own.
+		 *              Element ((k * numY + j) * numX + i) contains
+		 *              concentration data for (baseX + i, baseY + j, baseZ + k)
+		 */
+		Concs1DType readConcentrations(const XFile& file, int baseX, int baseY,
+				int baseZ, int numX, int numY, int numZ) const;
+
+		/**
+		 * Whether our concentrations are stored as in older files,
+		 * with one data set per grid point.
+		 *
+		 * @return True if we do not have the ragged concentration data set.
+		 */
+		bool hasGridPointConcentrations(void) const;
+
+		/**
+		 * Convert the concentrations of our 1D grid points, stored as in
+		 * older files, to the data set written by writeConcentrations.
+		 * Each process converts its own block of grid points in batches,
+		 * so that only one batch of concentrations is held in memory.
+		 * This is a collective operation.
+		 *
+		 * @param file The file containing our group.
+		 * @param baseX Index of the first grid point we own.
+		 * @param numX Number of grid points we own.
+		 * @param batchSize Number of grid points converted at once,
+		 *          all of them if it is not positive.
+		 */
+		void convertGridPointConcentrations(const XFile& file, int baseX,
+				int numX, int batchSize = 0) const;
+
+		/**
+		 * Mark our group as a delta group: its concentrations are only
+		 * the changes since the keyframe at the given time step, and the
+		 * read methods rebuild the full state from both groups.
+		 * Must be called before the concentrations are read.
+		 *
+		 * @param keyTimeStep The time step of the keyframe group.
+		 */
+		void writeKeyframe(int keyTimeStep) const;
+
+		/**
+		 * Read the time step of the keyframe of our group.
+		 *
+		 * @return The time step of the keyframe, or -1 if our group
+		 *          has the full state.
+		 */
+		int readKeyframe(void) const;
+
+		/**
+		 * Build the changes to write in a delta group.  The concentrations
+		 * of each grid point must be sorted by cluster index, as the
+		 * monitors write them.  Clusters that were removed since the
+		 * keyframe are written with a zero value.
+		 *
+		 * @param keyConcs The concentrations of the keyframe
+		 * @param concs The current concentrations, for the same grid points
+		 * @param tolerance The relative change under which a
+		 *          concentration is not written
+		 * @return The changes since the keyframe
+		 */
+		static Concs1DType makeDelta(const Concs1DType& keyConcs,
+				const Concs1DType& concs, double tolerance);
+
+		/**
+		 * Take a snapshot of the concentrations to write, from the
+		 * contiguous solution values of our grid points.  Only the
+		 * concentrations larger than 1.0e-16 in absolute value, and
+		 * than the relative tolerance times the largest of them over all
+		 * the processes, are kept, along with the temperature (the last
+		 * value of each grid point) which is never compared to them.
+		 * The kept indices of each grid point are first compacted without
+		 * branching in the given buffer, so that each grid point is then
+		 * allocated once with its exact size.
+		 * With a relative tolerance, it must be called by all the
+		 * processes of the communicator.
+		 *
+		 * @param values The solution values, grid point after grid point
+		 * @param nPoints The number of grid points
+		 * @param dof The number of values of each grid point
+		 * @param relTolerance The tolerance relative to the largest
+		 *          concentration, 0 to only use the absolute one
+		 * @param indexBuffer The buffer reused from one call to the next
+		 * @param comm The communicator of the processes sharing the grid
+		 * @return The concentrations of each grid point, by cluster index
+		 */
+		static Concs1DType packConcentrations(const double* values,
+				int nPoints, int dof, double relTolerance,
+				std::vector<int>& indexBuffer, MPI_Comm comm);
+
 		/**
 		 * Read the times from our timestep group.
 		 *
@@ -287,6 +471,39 @@ public:
 		 */
 		Data3DType readData3D(const std::string& dataName) const;
 
+		/**
+		 * Read the dimensions of a 2D data set of our group.
+		 *
+		 * @param dataName The name of the data set
+		 * @return The number of rows and columns
+		 */
+		std::array<hsize_t, 2> readDataDims(const std::string& dataName) const;
+
+		/**
+		 * Read rows of a 2D data set of our group into the caller's
+		 * buffer, without any other copy.
+		 *
+		 * @param dataName The name of the data set
+		 * @param firstRow The index of the first row to read
+		 * @param nRows The number of rows to read
+		 * @param values The buffer receiving the values in row-major
+		 *          order, of at least nRows times the number of columns
+		 */
+		void readRows(const std::string& dataName, hsize_t firstRow,
+				hsize_t nRows, Data1DType* values) const;
+
+		/**
+		 * Stream a 2D data set of our group by chunks of rows, so that
+		 * only one chunk is held in memory at once.  The same buffer
+		 * is reused for all the chunks.
+		 *
+		 * @param dataName The name of the data set
+		 * @param chunkRows The maximum number of rows in a chunk
+		 * @param visitor The function given each chunk, in order
+		 */
+		void visitRows(const std::string& dataName, hsize_t chunkRows,
+				const RowVisitor& visitor) const;
+
 		/**
 		 * Read our (i,j,k)-th grid point concentrations.
 		 *
@@ -295,9 +512,21 @@ public:
 		 * @param k The index of the grid point on the z axis
 		 * @return The vector of concentrations
 		 */
-		// TODO remove once have added support for 0D, 2D, and 3D
-		// parallel reads of concentrations.
+		// TODO remove once have added support for 0D parallel reads
+		// of concentrations.
 		Data3DType readGridPoint(int i, int j = -1, int k = -1) const;
+
+	private:
+		/**
+		 * Round the concentration values to the given number of mantissa
+		 * bits, for lossy compression.
+		 *
+		 * @param concs The concentrations to round
+		 * @param lossyBits The number of mantissa bits to keep
+		 * @return The rounded concentrations
+		 */
+		static Concs1DType roundConcentrations(const Concs1DType& concs,
+				int lossyBits);
 	};
 
 	// Our concentrations group.
@@ -358,6 +587,37 @@ public:
 		 *          Empty pointer if we do not yet have any time steps.
 		 */
 		std::unique_ptr<TimestepGroup> getLastTimestepGroup(void) const;
+
+		/**
+		 * Obtain the time steps of all our TimestepGroups.
+		 *
+		 * @return The time steps, in increasing order.
+		 */
+		std::vector<int> getTimeSteps(void) const;
+
+		/**
+		 * Obtain the time steps of the TimestepGroups to keep when only
+		 * keeping the given number of most recent ones, with the keyframes
+		 * they need.
+		 *
+		 * @param nKept The number of most recent groups to keep, all of them
+		 *        if it is not positive.
+		 * @return The time steps to keep.
+		 */
+		std::set<int> getKeptTimeSteps(int nKept) const;
+
+		/**
+		 * Remove the TimestepGroups that aren't kept when only keeping the
+		 * given number of most recent ones, with the keyframes they need.
+		 * Their links are removed in place, which is cheap, but the file
+		 * only gets smaller once it is compacted.  Must be called by every
+		 * process of the file.
+		 *
+		 * @param nKept The number of most recent groups to keep, all of them
+		 *        if it is not positive.
+		 * @return The number of groups removed.
+		 */
+		int removeOldTimestepGroups(int nKept) const;
 	};
 
 	// Our header group.
@@ -374,6 +634,7 @@ public:
 		// Names of grid-specification attributes.
 		static const std::string nxAttrName;
 		static const std::string hxAttrName;
+		static const std::string hxRightAttrName;
 		static const std::string nyAttrName;
 		static const std::string hyAttrName;
 		static const std::string nzAttrName;
@@ -429,6 +690,26 @@ public:
 		void read(int &nx, double &hx, int &ny, double &hy, int &nz,
 				double &hz) const;
 
+		/**
+		 * Write the grid in the x direction (depth), replacing the one
+		 * the header has, e.g., once the grid was adapted.  The grid
+		 * points are kept along with the steps to the two boundaries.
+		 *
+		 * @param grid The grid in the format used by the solver handlers
+		 */
+		void writeXGrid(const std::vector<double>& grid) const;
+
+		/**
+		 * Read the grid in the x direction (depth).
+		 * The file only keeps the grid points, the two boundary ones are
+		 * rebuilt from the steps to them.
+		 *
+		 * @return The grid in the same format as the one used by the
+		 * solver handlers, or an empty vector if the file has no grid or
+		 * does not give the step to the right boundary (older files).
+		 */
+		std::vector<double> readXGrid(void) const;
+
 		/**
 		 * Read our network compositions.
 		 *
@@ -636,9 +917,11 @@ public:
 	 * @param _comm The MPI communicator used to access the file.
 	 * @param mode Access mode for file.  Only HDFFile Open* modes
 	 *              are supported.
+	 * @param collectiveMetadata Whether all the metadata accesses are
+	 *              done by all the processes at once.
 	 */
 	XFile(fs::path path, MPI_Comm _comm = MPI_COMM_WORLD, AccessMode mode =
-			AccessMode::OpenReadOnly);
+			AccessMode::OpenReadOnly, bool collectiveMetadata = false);
 
 	/**
 	 * Check whether we have one of our top-level Groups.
@@ -667,6 +950,18 @@ public:
 		}
 		return std::move(group);
 	}
+
+	/**
+	 * Give back the space of the groups removed from a checkpoint file.
+	 * Everything is copied to a temporary file which then replaces the
+	 * file, so the file is complete if the program stops at any point.
+	 * The copy is done by a single process while the others wait, and
+	 * the file must be closed by every process of the communicator.
+	 *
+	 * @param path Path of the file.
+	 * @param comm The MPI communicator of the processes calling it.
+	 */
+	static void compact(fs::path path, MPI_Comm comm);
 };
 
 } /* namespace xolotlCore */
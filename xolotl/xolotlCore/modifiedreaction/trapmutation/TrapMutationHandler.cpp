@@ -113,69 +113,117 @@ void TrapMutationHandler::initialize(const IReactionNetwork& network,
 	// trap-mutates. Information about desorption is also initialized here.
 	initializeDepthSize(network.getTemperature());
 
+	// The bubbles and indices will have to be found again
+	depthBubbles.clear();
+	indexGrid1D.clear();
+
 	// Update the bubble bursting rate
 	updateTrapMutationRate(network);
 
 	return;
 }
 
+void TrapMutationHandler::findDepthBubbles(const IReactionNetwork& network) {
+	// Clear the previous bubbles
+	depthBubbles.clear();
+
+	// Loop on the depth vector
+	for (int l = 0; l < depthVec.size(); l++) {
+		// The bubble that He_(l+1) trap-mutates into
+		IReactant::Composition comp;
+		comp[toCompIdx(Species::He)] = l + 1;
+		comp[toCompIdx(Species::V)] = sizeVec[l];
+		depthBubbles.push_back(network.get(ReactantType::PSIMixed, comp));
+	}
+
+	return;
+}
+
+IReactant::RefVector TrapMutationHandler::findIndices1D(int xi, int surfacePos,
+		const std::vector<double>& grid) {
+	// Get the depth
+	double depth = grid[xi + 1] - grid[surfacePos + 1];
+	double previousDepth = grid[xi] - grid[surfacePos + 1];
+
+	// Loop on the depth vector
+	IReactant::RefVector indices;
+	for (int l = 0; l < depthVec.size(); l++) {
+		// Check if a helium cluster undergo TM at this depth
+		if (depthBubbles[l]
+				&& (std::fabs(depth - depthVec[l]) < 0.01
+						|| (depthVec[l] - 0.01 < depth
+								&& depthVec[l] - 0.01 > previousDepth))) {
+			// Add the bubble of size l+1 to the indices
+			indices.emplace_back(*depthBubbles[l]);
+		}
+	}
+
+	return indices;
+}
+
 void TrapMutationHandler::initializeIndex1D(int surfacePos,
 		const IReactionNetwork& network,
 		std::vector<IAdvectionHandler *> advectionHandlers,
 		std::vector<double> grid) {
+	// No GB trap mutation handler in 1D for now
+
+	// Find the bubble associated with each depth only once
+	if (depthBubbles.size() != depthVec.size())
+		findDepthBubbles(network);
+
+	// The deepest depth at which a trap-mutation can happen
+	double maxDepth = 0.0;
+	for (int l = 0; l < depthVec.size(); l++) {
+		maxDepth = std::max(maxDepth, depthVec[l] + 0.01);
+	}
+
+	// If the grid didn't change since the last call, only the points
+	// close to the old and new surfaces need to be updated because
+	// everything deeper stays empty
+	int nPoints = grid.size() - 2;
+	if (tmBubbles.size() == 1 && tmBubbles[0].size() == 1
+			&& tmBubbles[0][0].size() == nPoints && grid == indexGrid1D) {
+		auto& temp1DVector = tmBubbles[0][0];
+		int firstPos = std::min(surfacePos, indexSurfacePos1D);
+		int lastPos = std::max(surfacePos, indexSurfacePos1D);
+		for (int i = firstPos + 1; i < nPoints; i++) {
+			// Stop once deeper than the trap-mutation from both surfaces
+			if (grid[i] - grid[lastPos + 1] > maxDepth)
+				break;
+
+			if (i <= surfacePos)
+				temp1DVector[i].clear();
+			else
+				temp1DVector[i] = findIndices1D(i, surfacePos, grid);
+		}
+
+		// Save the surface position
+		indexSurfacePos1D = surfacePos;
+
+		return;
+	}
+
 	// Clear the vector of HeV indices created by He undergoing trap-mutation
 	// at each grid point
 	tmBubbles.clear();
 
-	// No GB trap mutation handler in 1D for now
-
 	// Create the temporary 2D vector
 	ReactantRefVector2D temp2DVector;
 	// Create the temporary 1D vector
 	ReactantRefVector1D temp1DVector;
 
 	// Loop on the grid points in the depth direction
-	for (int i = 0; i < grid.size() - 2; i++) {
-		// If we are on the left side of the surface there is no
+	temp1DVector.reserve(nPoints);
+	for (int i = 0; i < nPoints; i++) {
+		// If we are on the left side of the surface, or too deep, there is no
 		// modified trap-mutation
-		if (i <= surfacePos) {
+		if (i <= surfacePos || grid[i] - grid[surfacePos + 1] > maxDepth) {
 			temp1DVector.emplace_back();
 			continue;
 		}
 
-		// Get the depth
-		double depth = grid[i + 1] - grid[surfacePos + 1];
-		double previousDepth = grid[i] - grid[surfacePos + 1];
-
-		// Loop on the depth vector
-		std::vector<std::reference_wrapper<IReactant> > indices;
-		for (int l = 0; l < depthVec.size(); l++) {
-			// Check if a helium cluster undergo TM at this depth
-			if (std::fabs(depth - depthVec[l]) < 0.01
-					|| (depthVec[l] - 0.01 < depth
-							&& depthVec[l] - 0.01 > previousDepth)) {
-				// Add the bubble of size l+1 to the indices
-				// Loop on the bubbles
-				for (auto const& heVMapItem : network.getAll(
-						ReactantType::PSIMixed)) {
-					// Get the bubble and its composition
-					auto& bubble =
-							static_cast<PSICluster&>(*(heVMapItem.second));
-					auto const& comp = bubble.getComposition();
-					// Get the correct bubble
-					if (comp[toCompIdx(Species::He)] == l + 1
-							&& comp[toCompIdx(Species::V)] == sizeVec[l]
-							&& comp[toCompIdx(Species::D)] == 0
-							&& comp[toCompIdx(Species::T)] == 0) {
-						// Add this bubble to the indices
-						indices.emplace_back(bubble);
-					}
-				}
-			}
-		}
-
 		// Add indices to the index vector
-		temp1DVector.emplace_back(indices);
+		temp1DVector.emplace_back(findIndices1D(i, surfacePos, grid));
 	}
 
 	// Give the 1D vector to the 2D vector
@@ -184,6 +232,10 @@ void TrapMutationHandler::initializeIndex1D(int surfacePos,
 	// Give the 2D vector to the final vector
 	tmBubbles.emplace_back(temp2DVector);
 
+	// Save the grid and surface position used
+	indexGrid1D = grid;
+	indexSurfacePos1D = surfacePos;
+
 	return;
 }
 
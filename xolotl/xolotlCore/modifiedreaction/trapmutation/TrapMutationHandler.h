@@ -66,6 +66,18 @@ protected:
 	using ReactantRefVector3D = std::vector<ReactantRefVector2D>;
 	ReactantRefVector3D tmBubbles;
 
+	/**
+	 * The bubble each helium cluster trap-mutates into, in the same order
+	 * as depthVec, nullptr if it is not in the network
+	 */
+	std::vector<IReactant *> depthBubbles;
+
+	//! The grid used the last time the 1D indices were initialized
+	std::vector<double> indexGrid1D;
+
+	//! The surface position used the last time the 1D indices were initialized
+	int indexSurfacePos1D;
+
 	/**
 	 * The desorption information
 	 */
@@ -85,13 +97,34 @@ protected:
 		return;
 	}
 
+	/**
+	 * This method finds, for each depth of depthVec, the bubble the
+	 * helium cluster trap-mutates into.
+	 *
+	 * @param network The network
+	 */
+	void findDepthBubbles(const IReactionNetwork& network);
+
+	/**
+	 * This method returns the bubbles created by trap-mutation at a
+	 * given grid point in 1D.
+	 *
+	 * @param xi The index of the grid point
+	 * @param surfacePos The index of the position of the surface
+	 * @param grid The grid on the x axis
+	 * @return The bubbles
+	 */
+	IReactant::RefVector findIndices1D(int xi, int surfacePos,
+			const std::vector<double>& grid);
+
 public:
 
 	/**
 	 * The constructor
 	 */
 	TrapMutationHandler() :
-			kMutation(0.0), kDis(1.0), attenuation(true), desorp(0, 0.0) {
+			kMutation(0.0), kDis(1.0), attenuation(true), indexSurfacePos1D(
+					-1), desorp(0, 0.0) {
 	}
 
 	/**
@@ -252,6 +252,56 @@ public:
 	 */
 	virtual double getTotalIConcentration() = 0;
 
+	/**
+	 * Get the weights of the degrees of freedom in the total concentration
+	 * of atoms: the total is the sum of the concentrations of a grid point
+	 * times their weights.  Lets the monitors compute it from the solution
+	 * without updating the network; meant to be computed once.
+	 *
+	 * @param i Index to switch between the different types of atoms
+	 * @return The weight of each degree of freedom
+	 */
+	virtual std::vector<double> getTotalAtomWeights(int i = 0) = 0;
+
+	/**
+	 * Get the weights of the degrees of freedom in the total concentration
+	 * of atoms contained in bubbles.
+	 *
+	 * @param i Index to switch between the different types of atoms
+	 * @return The weight of each degree of freedom
+	 */
+	virtual std::vector<double> getTotalTrappedAtomWeights(int i = 0) = 0;
+
+	/**
+	 * Get the weights of the degrees of freedom in the total concentration
+	 * of vacancies.
+	 *
+	 * @return The weight of each degree of freedom
+	 */
+	virtual std::vector<double> getTotalVWeights() = 0;
+
+	/**
+	 * Get the weights of the degrees of freedom in the total concentration
+	 * of material interstitials.
+	 *
+	 * @return The weight of each degree of freedom
+	 */
+	virtual std::vector<double> getTotalIWeights() = 0;
+
+	/**
+	 * Get the weights of the degrees of freedom in a moment of the size
+	 * distribution of the clusters containing atoms: the sum of their
+	 * concentrations times their number of atoms to the given power.
+	 * The power 0 gives the total concentration of these clusters and
+	 * the power 1 their total concentration of atoms.
+	 *
+	 * @param power The power of the number of atoms
+	 * @param i Index to switch between the different types of atoms
+	 * @return The weight of each degree of freedom
+	 */
+	virtual std::vector<double> getAtomMomentWeights(int power,
+			int i = 0) = 0;
+
 	/**
 	 * Calculate all the rate constants for the reactions and dissociations of the network.
 	 * Need to be called only when the temperature changes.
@@ -0,0 +1,48 @@
+#include <cassert>
+#include "ObservableWeights.h"
+
+namespace xolotlCore {
+
+ObservableWeights::ObservableWeights(
+		const std::vector<std::vector<double> >& denseWeights) :
+		nObservables(denseWeights.size()) {
+
+	if (nObservables == 0)
+		return;
+
+	// Keep the degrees of freedom weighted in one of the quantities
+	int dof = denseWeights[0].size();
+	for (int j = 0; j < dof; j++) {
+		bool isUsed = false;
+		for (auto const& observableWeights : denseWeights) {
+			assert((int) observableWeights.size() == dof);
+			isUsed = isUsed || (observableWeights[j] != 0.0);
+		}
+		if (!isUsed)
+			continue;
+
+		indices.push_back(j);
+		for (auto const& observableWeights : denseWeights) {
+			weights.push_back(observableWeights[j]);
+		}
+	}
+
+	return;
+}
+
+void ObservableWeights::accumulate(const double* concentrations,
+		double factor, double* values) const {
+
+	const double* currWeights = weights.data();
+	for (auto index : indices) {
+		double conc = concentrations[index] * factor;
+		for (int k = 0; k < nObservables; k++) {
+			values[k] += conc * currWeights[k];
+		}
+		currWeights += nObservables;
+	}
+
+	return;
+}
+
+} // namespace xolotlCore
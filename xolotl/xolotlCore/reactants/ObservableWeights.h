@@ -0,0 +1,76 @@
+#ifndef XCORE_OBSERVABLE_WEIGHTS_H
+#define XCORE_OBSERVABLE_WEIGHTS_H
+
+#include <vector>
+
+namespace xolotlCore {
+
+/**
+ * The weights of a set of quantities that are linear in the concentrations
+ * of a grid point, like the total helium or vacancy concentrations.
+ * Only the degrees of freedom contributing to one of the quantities are
+ * kept, with the weights of all the quantities next to each other, so they
+ * are all computed in a single pass over the concentrations without
+ * updating the network.
+ */
+class ObservableWeights {
+private:
+	//! The number of quantities.
+	int nObservables;
+
+	//! The degrees of freedom with a non-zero weight in one of the quantities.
+	std::vector<int> indices;
+
+	//! The weights of the quantities, nObservables by degree of freedom.
+	std::vector<double> weights;
+
+public:
+	/**
+	 * Construct weights without any quantity.
+	 */
+	ObservableWeights(void) :
+			nObservables(0) {
+	}
+
+	/**
+	 * Construct the weights from the weight of each degree of freedom
+	 * in each quantity, as given by the network.
+	 *
+	 * @param denseWeights The weights of each quantity, all of the same size.
+	 */
+	ObservableWeights(const std::vector<std::vector<double> >& denseWeights);
+
+	/**
+	 * Get the number of quantities.
+	 *
+	 * @return The number of quantities
+	 */
+	int getNumObservables(void) const {
+		return nObservables;
+	}
+
+	/**
+	 * Get the number of degrees of freedom contributing to the quantities.
+	 *
+	 * @return The number of degrees of freedom
+	 */
+	int size(void) const {
+		return indices.size();
+	}
+
+	/**
+	 * Compute the quantities at a grid point and add them to the given
+	 * values.
+	 *
+	 * @param concentrations The concentrations at the grid point.
+	 * @param factor The factor applied to the quantities, like the volume
+	 * of the grid point.
+	 * @param values The getNumObservables() values to add the quantities to.
+	 */
+	void accumulate(const double* concentrations, double factor,
+			double* values) const;
+};
+
+} // namespace xolotlCore
+
+#endif // XCORE_OBSERVABLE_WEIGHTS_H
@@ -539,6 +539,77 @@ public:
 		return 0.0;
 	}
 
+	/**
+	 * Get the weights of the degrees of freedom in the total concentration
+	 * of atoms.
+	 *
+	 * Returns null weights here and needs to be implemented by the
+	 * daughter classes.
+	 *
+	 * @param i Index to switch between the different types of atoms
+	 * @return The weight of each degree of freedom
+	 */
+	virtual std::vector<double> getTotalAtomWeights(int i = 0) override {
+		return std::vector<double>(getDOF(), 0.0);
+	}
+
+	/**
+	 * Get the weights of the degrees of freedom in the total concentration
+	 * of atoms contained in bubbles.
+	 *
+	 * Returns null weights here and needs to be implemented by the
+	 * daughter classes.
+	 *
+	 * @param i Index to switch between the different types of atoms
+	 * @return The weight of each degree of freedom
+	 */
+	virtual std::vector<double> getTotalTrappedAtomWeights(int i = 0)
+			override {
+		return std::vector<double>(getDOF(), 0.0);
+	}
+
+	/**
+	 * Get the weights of the degrees of freedom in the total concentration
+	 * of vacancies.
+	 *
+	 * Returns null weights here and needs to be implemented by the
+	 * daughter classes.
+	 *
+	 * @return The weight of each degree of freedom
+	 */
+	virtual std::vector<double> getTotalVWeights() override {
+		return std::vector<double>(getDOF(), 0.0);
+	}
+
+	/**
+	 * Get the weights of the degrees of freedom in the total concentration
+	 * of material interstitials.
+	 *
+	 * Returns null weights here and needs to be implemented by the
+	 * daughter classes.
+	 *
+	 * @return The weight of each degree of freedom
+	 */
+	virtual std::vector<double> getTotalIWeights() override {
+		return std::vector<double>(getDOF(), 0.0);
+	}
+
+	/**
+	 * Get the weights of the degrees of freedom in a moment of the size
+	 * distribution of the clusters containing atoms.
+	 *
+	 * Returns null weights here and needs to be implemented by the
+	 * daughter classes.
+	 *
+	 * @param power The power of the number of atoms
+	 * @param i Index to switch between the different types of atoms
+	 * @return The weight of each degree of freedom
+	 */
+	virtual std::vector<double> getAtomMomentWeights(int power, int i = 0)
+			override {
+		return std::vector<double>(getDOF(), 0.0);
+	}
+
 	/**
 	 * Calculate all the rate constants for the reactions and dissociations of the network.
 	 * Need to be called only when the temperature changes.
@@ -0,0 +1,104 @@
+#ifndef XCORE_SIZE_STATISTICS_H
+#define XCORE_SIZE_STATISTICS_H
+
+#include <array>
+#include <algorithm>
+
+namespace xolotlCore {
+
+/**
+ * The statistics of the size distribution of the clusters over a set of
+ * regions (grid points, depths, ...), kept as running sums of their
+ * concentration, size times concentration, and size squared times
+ * concentration.  These sums are linear in the concentrations, so the
+ * ones of a region are computed in a single pass with ObservableWeights
+ * built from IReactionNetwork::getAtomMomentWeights() for the powers 0, 1,
+ * and 2, and the ones of several regions or processes are simply added.
+ * The mean and variance are only derived from them when they are needed.
+ */
+class SizeStatistics {
+public:
+	//! The number of sums of a region.
+	static constexpr int nMoments = 3;
+
+private:
+	//! The sums of all the regions added.
+	std::array<double, nMoments> sums;
+
+	//! The largest mean size of the regions added.
+	double maxMean;
+
+	/**
+	 * Compute the mean size from the sums.
+	 *
+	 * @param moments The sums
+	 * @return The mean size, 0 without any cluster
+	 */
+	static double mean(const double* moments) {
+		return (moments[0] > 0.0) ? moments[1] / moments[0] : 0.0;
+	}
+
+public:
+	/**
+	 * Construct statistics without any region.
+	 */
+	SizeStatistics(void) :
+			sums { }, maxMean(0.0) {
+	}
+
+	/**
+	 * Add the sums of a region.
+	 *
+	 * @param moments The nMoments sums of the region.
+	 */
+	void add(const double* moments) {
+		for (int k = 0; k < nMoments; k++) {
+			sums[k] += moments[k];
+		}
+		maxMean = std::max(maxMean, mean(moments));
+	}
+
+	/**
+	 * Get the total concentration of the clusters.
+	 *
+	 * @return The concentration
+	 */
+	double getConcentration(void) const {
+		return sums[0];
+	}
+
+	/**
+	 * Get the mean size of the clusters, weighted by their concentration.
+	 *
+	 * @return The mean size
+	 */
+	double getMean(void) const {
+		return mean(sums.data());
+	}
+
+	/**
+	 * Get the variance of the size of the clusters.
+	 *
+	 * @return The variance
+	 */
+	double getVariance(void) const {
+		if (sums[0] <= 0.0)
+			return 0.0;
+		double meanSize = getMean();
+		// Rounding can make it slightly negative for narrow distributions
+		return std::max(sums[2] / sums[0] - meanSize * meanSize, 0.0);
+	}
+
+	/**
+	 * Get the largest mean size of the regions.
+	 *
+	 * @return The largest mean size
+	 */
+	double getMaxMean(void) const {
+		return maxMean;
+	}
+};
+
+} // namespace xolotlCore
+
+#endif // XCORE_SIZE_STATISTICS_H
@@ -6,6 +6,7 @@
 #include <xolotlPerf.h>
 #include <Constants.h>
 #include <MathUtils.h>
+#include <cmath>
 
 namespace xolotlCore {
 
@@ -843,6 +844,120 @@ void FeClusterReactionNetwork::reinitializeNetwork() {
 			return iConc;
 		}
 
+		std::vector<double> FeClusterReactionNetwork::getTotalAtomWeights(
+				int i) {
+			// Initial declarations
+			std::vector<double> weights(getDOF(), 0.0);
+
+			// The He clusters count their size
+			for (auto const& currMapItem : getAll(ReactantType::He)) {
+				auto const& cluster = *(currMapItem.second);
+				weights[cluster.getId() - 1] += (double) cluster.getSize();
+			}
+
+			// The HeV clusters and the super clusters count their helium
+			addTrappedHeliumWeights(weights);
+
+			return weights;
+		}
+
+		std::vector<double> FeClusterReactionNetwork::getAtomMomentWeights(
+				int power, int i) {
+			// Initial declarations
+			std::vector<double> weights(getDOF(), 0.0);
+
+			// The He clusters count their size
+			for (auto const& currMapItem : getAll(ReactantType::He)) {
+				auto const& cluster = *(currMapItem.second);
+				weights[cluster.getId() - 1] += std::pow(
+						(double) cluster.getSize(), power);
+			}
+
+			// The HeV clusters and the super clusters count their helium
+			addTrappedHeliumWeights(weights, power);
+
+			return weights;
+		}
+
+		std::vector<double> FeClusterReactionNetwork::getTotalTrappedAtomWeights(
+				int i) {
+			// Initial declarations
+			std::vector<double> weights(getDOF(), 0.0);
+
+			// The HeV clusters and the super clusters count their helium
+			addTrappedHeliumWeights(weights);
+
+			return weights;
+		}
+
+		void FeClusterReactionNetwork::addTrappedHeliumWeights(
+				std::vector<double>& weights, int power) const {
+
+			// Sum over all HeV clusters.
+			for (auto const& currMapItem : getAll(ReactantType::HeV)) {
+				auto const& cluster = *(currMapItem.second);
+				auto& comp = cluster.getComposition();
+				weights[cluster.getId() - 1] += std::pow(
+						(double) comp[toCompIdx(Species::He)], power);
+			}
+
+			// Sum over all super clusters, on their moments.
+			for (auto const& currMapItem : getAll(ReactantType::FeSuper)) {
+				auto const& cluster =
+						static_cast<FeSuperCluster&>(*(currMapItem.second));
+				auto superWeights = cluster.getTotalHeliumWeights(power);
+				weights[cluster.getId() - 1] += superWeights[0];
+				weights[cluster.getMomentId(0) - 1] += superWeights[1];
+				weights[cluster.getMomentId(1) - 1] += superWeights[2];
+			}
+
+			return;
+		}
+
+		std::vector<double> FeClusterReactionNetwork::getTotalVWeights() {
+			// Initial declarations
+			std::vector<double> weights(getDOF(), 0.0);
+
+			// Sum over all V clusters.
+			for (auto const& currMapItem : getAll(ReactantType::V)) {
+				auto const& cluster = *(currMapItem.second);
+				weights[cluster.getId() - 1] += (double) cluster.getSize();
+			}
+
+			// Sum over all HeV clusters
+			for (auto const& currMapItem : getAll(ReactantType::HeV)) {
+				auto const& cluster = *(currMapItem.second);
+				auto& comp = cluster.getComposition();
+				weights[cluster.getId() - 1] +=
+						(double) comp[toCompIdx(Species::V)];
+			}
+
+			// Sum over all super clusters, on their moments
+			for (auto const& currMapItem : getAll(ReactantType::FeSuper)) {
+				auto const& cluster =
+						static_cast<FeSuperCluster&>(*(currMapItem.second));
+				auto superWeights = cluster.getTotalVacancyWeights();
+				weights[cluster.getId() - 1] += superWeights[0];
+				weights[cluster.getMomentId(0) - 1] += superWeights[1];
+				weights[cluster.getMomentId(1) - 1] += superWeights[2];
+			}
+
+			return weights;
+		}
+
+		std::vector<double> FeClusterReactionNetwork::getTotalIWeights() {
+			// Initial declarations
+			std::vector<double> weights(getDOF(), 0.0);
+
+			// Sum over all I clusters
+			for (auto const& currMapItem : getAll(ReactantType::I)) {
+				auto const& cluster = *(currMapItem.second);
+				weights[cluster.getId() - 1] += (double) cluster.getSize();
+			}
+
+			return weights;
+		}
+
 		void FeClusterReactionNetwork::computeAllFluxes(
 				double *updatedConcOffset, int i) {
 
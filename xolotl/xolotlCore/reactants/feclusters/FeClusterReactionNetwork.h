@@ -54,6 +54,16 @@ private:
 	 */
 	HeVToSuperClusterMap superClusterLookupMap;
 
+	/**
+	 * Add the weights of the degrees of freedom in the total concentration
+	 * of helium contained in bubbles to the given weights.
+	 *
+	 * @param weights The weight of each degree of freedom
+	 * @param power The power of the number of helium in the weights
+	 */
+	void addTrappedHeliumWeights(std::vector<double>& weights,
+			int power = 1) const;
+
 	/**
 	 * Calculate the dissociation constant of the first cluster with respect to
 	 * the single-species cluster of the same type based on the current clusters
@@ -324,6 +334,51 @@ public:
 	 */
 	double getTotalIConcentration() override;
 
+	/**
+	 * Get the weights of the degrees of freedom in the total concentration
+	 * of atoms, helium atoms here.
+	 *
+	 * @param i Index to switch between the different types of atoms
+	 * @return The weight of each degree of freedom
+	 */
+	std::vector<double> getTotalAtomWeights(int i = 0) override;
+
+	/**
+	 * Get the weights of the degrees of freedom in the total concentration
+	 * of atoms contained in bubbles, helium atoms here.
+	 *
+	 * @param i Index to switch between the different types of atoms
+	 * @return The weight of each degree of freedom
+	 */
+	std::vector<double> getTotalTrappedAtomWeights(int i = 0) override;
+
+	/**
+	 * Get the weights of the degrees of freedom in the total concentration
+	 * of vacancies.
+	 *
+	 * @return The weight of each degree of freedom
+	 */
+	std::vector<double> getTotalVWeights() override;
+
+	/**
+	 * Get the weights of the degrees of freedom in the total concentration
+	 * of iron interstitials.
+	 *
+	 * @return The weight of each degree of freedom
+	 */
+	std::vector<double> getTotalIWeights() override;
+
+	/**
+	 * Get the weights of the degrees of freedom in a moment of the size
+	 * distribution of the clusters containing helium, super clusters
+	 * included.
+	 *
+	 * @param power The power of the number of helium
+	 * @param i Index to switch between the different types of atoms
+	 * @return The weight of each degree of freedom
+	 */
+	std::vector<double> getAtomMomentWeights(int power, int i = 0) override;
+
 	/**
 	 * Compute the fluxes generated by all the reactions
 	 * for all the clusters and their momentums.
@@ -2,6 +2,7 @@
 #include "FeSuperCluster.h"
 #include "FeClusterReactionNetwork.h"
 #include <MathUtils.h>
+#include <cmath>
 #include <xolotlPerf.h>
 
 using namespace xolotlCore;
@@ -1240,6 +1241,43 @@ double FeSuperCluster::getTotalVacancyConcentration() const {
 	return conc;
 }
 
+Array<double, 3> FeSuperCluster::getTotalHeliumWeights(int power) const {
+	// Initial declarations
+	Array<double, 3> weights;
+	weights.Init(0.0);
+
+	// Loop on the indices
+	for (auto const& i : heBounds) {
+		double nHelium = std::pow((double) i, power);
+		for (auto const& j : vBounds) {
+			// Same sum as getTotalHeliumConcentration(), by moment
+			weights[0] += nHelium;
+			weights[1] += getHeDistance(i) * nHelium;
+			weights[2] += getVDistance(j) * nHelium;
+		}
+	}
+
+	return weights;
+}
+
+Array<double, 3> FeSuperCluster::getTotalVacancyWeights() const {
+	// Initial declarations
+	Array<double, 3> weights;
+	weights.Init(0.0);
+
+	// Loop on the indices
+	for (auto const& i : heBounds) {
+		for (auto const& j : vBounds) {
+			// Same sum as getTotalVacancyConcentration(), by moment
+			weights[0] += (double) j;
+			weights[1] += getHeDistance(i) * (double) j;
+			weights[2] += getVDistance(j) * (double) j;
+		}
+	}
+
+	return weights;
+}
+
 void FeSuperCluster::resetConnectivities() {
 	// Clear both sets
 	reactionConnectivitySet.clear();
@@ -571,6 +571,27 @@ public:
 	 */
 	double getTotalVacancyConcentration() const;
 
+	/**
+	 * This operation returns the weights of the zeroth moment and of the
+	 * helium and vacancy moments in the total concentration of helium
+	 * in the group, which is linear in them.
+	 * With another power, the concentration of each cluster is weighted by
+	 * its number of helium to that power instead.
+	 *
+	 * @param power The power of the number of helium
+	 * @return The weights
+	 */
+	Array<double, 3> getTotalHeliumWeights(int power = 1) const;
+
+	/**
+	 * This operation returns the weights of the zeroth moment and of the
+	 * helium and vacancy moments in the total concentration of vacancies
+	 * in the group.
+	 *
+	 * @return The weights
+	 */
+	Array<double, 3> getTotalVacancyWeights() const;
+
 	/**
 	 * This operation returns the distance to the mean.
 	 *
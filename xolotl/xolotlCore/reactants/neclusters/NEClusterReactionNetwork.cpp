@@ -1,6 +1,7 @@
 #include "NEClusterReactionNetwork.h"
 #include "NECluster.h"
 #include "NESuperCluster.h"
+#include <cmath>
 #include <xolotlPerf.h>
 #include <iostream>
 #include <sstream>
@@ -318,6 +319,60 @@ double NEClusterReactionNetwork::getTotalAtomConcentration(int i) {
 	return atomConc;
 }
 
+std::vector<double> NEClusterReactionNetwork::getTotalAtomWeights(int i) {
+	// Initial declarations
+	std::vector<double> weights(getDOF(), 0.0);
+
+	// Only work for 0
+	if (i > 0)
+		return weights;
+
+	// The Xe clusters count their size
+	for (auto const& currMapItem : getAll(ReactantType::Xe)) {
+		auto const& cluster = *(currMapItem.second);
+		weights[cluster.getId() - 1] += (double) cluster.getSize();
+	}
+
+	// The super clusters count it through their moments
+	for (auto const& currMapItem : getAll(ReactantType::NESuper)) {
+		auto const& cluster =
+				static_cast<NESuperCluster&>(*(currMapItem.second));
+		auto superWeights = cluster.getTotalXenonWeights();
+		weights[cluster.getId() - 1] += superWeights[0];
+		weights[cluster.getMomentId() - 1] += superWeights[1];
+	}
+
+	return weights;
+}
+
+std::vector<double> NEClusterReactionNetwork::getAtomMomentWeights(int power,
+		int i) {
+	// Initial declarations
+	std::vector<double> weights(getDOF(), 0.0);
+
+	// Only work for 0
+	if (i > 0)
+		return weights;
+
+	// The Xe clusters count their size
+	for (auto const& currMapItem : getAll(ReactantType::Xe)) {
+		auto const& cluster = *(currMapItem.second);
+		weights[cluster.getId() - 1] += std::pow((double) cluster.getSize(),
+				power);
+	}
+
+	// The super clusters count it through their moments
+	for (auto const& currMapItem : getAll(ReactantType::NESuper)) {
+		auto const& cluster =
+				static_cast<NESuperCluster&>(*(currMapItem.second));
+		auto superWeights = cluster.getTotalXenonWeights(power);
+		weights[cluster.getId() - 1] += superWeights[0];
+		weights[cluster.getMomentId() - 1] += superWeights[1];
+	}
+
+	return weights;
+}
+
 void NEClusterReactionNetwork::computeAllFluxes(double *updatedConcOffset,
 		int i) {
 
@@ -191,6 +191,25 @@ public:
 	 */
 	double getTotalAtomConcentration(int i = 0) override;
 
+	/**
+	 * Get the weights of the degrees of freedom in the total concentration
+	 * of atoms, with the same atoms as getTotalAtomConcentration().
+	 *
+	 * @param i Index to switch between the different types of atoms
+	 * @return The weight of each degree of freedom
+	 */
+	std::vector<double> getTotalAtomWeights(int i = 0) override;
+
+	/**
+	 * Get the weights of the degrees of freedom in a moment of the size
+	 * distribution of the xenon clusters, super clusters included.
+	 *
+	 * @param power The power of the number of xenon
+	 * @param i Index to switch between the different types of atoms
+	 * @return The weight of each degree of freedom
+	 */
+	std::vector<double> getAtomMomentWeights(int power, int i = 0) override;
+
 	/**
 	 * This operation sets the fission rate, needed to compute the diffusion coefficient
 	 * in NE.
@@ -3,6 +3,7 @@
 #include "NEClusterReactionNetwork.h"
 #include <Constants.h>
 #include <MathUtils.h>
+#include <cmath>
 
 using namespace xolotlCore;
 
@@ -204,6 +205,41 @@ double NESuperCluster::getTotalXenonConcentration() const {
 	return conc;
 }
 
+Array<double, 2> NESuperCluster::getTotalWeights() const {
+	// Initial declarations
+	int index = 0;
+	Array<double, 2> weights;
+	weights.Init(0.0);
+
+	// Loop on the xenon width
+	for (int k = 0; k < sectionWidth; k++) {
+		// Same sum as getTotalConcentration(), by moment
+		index = (int) (numXe - (double) sectionWidth / 2.0) + k + 1;
+		weights[0] += 1.0;
+		weights[1] += getDistance(index);
+	}
+
+	return weights;
+}
+
+Array<double, 2> NESuperCluster::getTotalXenonWeights(int power) const {
+	// Initial declarations
+	int index = 0;
+	Array<double, 2> weights;
+	weights.Init(0.0);
+
+	// Loop on the xenon width
+	for (int k = 0; k < sectionWidth; k++) {
+		// Same sum as getTotalXenonConcentration(), by moment
+		index = (int) (numXe - (double) sectionWidth / 2.0) + k + 1;
+		double nXenon = std::pow((double) index, power);
+		weights[0] += nXenon;
+		weights[1] += getDistance(index) * nXenon;
+	}
+
+	return weights;
+}
+
 double NESuperCluster::getDistance(int xe) const {
 	if (sectionWidth == 1)
 		return 0.0;
@@ -302,6 +302,26 @@ public:
 	 */
 	double getTotalXenonConcentration() const;
 
+	/**
+	 * This operation returns the weights of the zeroth and first moments
+	 * in the total concentration of clusters in the group, which is linear
+	 * in them.
+	 *
+	 * @return The weights
+	 */
+	Array<double, 2> getTotalWeights() const;
+
+	/**
+	 * This operation returns the weights of the zeroth and first moments
+	 * in the total concentration of xenon in the group.
+	 * With another power, the concentration of each cluster is weighted by
+	 * its number of xenon to that power instead.
+	 *
+	 * @param power The power of the number of xenon
+	 * @return The weights
+	 */
+	Array<double, 2> getTotalXenonWeights(int power = 1) const;
+
 	/**
 	 * This operation returns the distance to the mean.
 	 *
@@ -1,5 +1,6 @@
 #include <cassert>
 #include <iterator>
+#include <cmath>
 #include "PSIClusterReactionNetwork.h"
 #include "PSICluster.h"
 #include "PSISuperCluster.h"
@@ -1722,6 +1723,183 @@ double PSIClusterReactionNetwork::getTotalIConcentration() {
 	return iConc;
 }
 
+void PSIClusterReactionNetwork::addSuperWeights(int axis,
+		std::vector<double>& weights, int power) const {
+
+	// Same degrees of freedom as updateConcentrationsFromArray()
+	for (auto const& currMapItem : getAll(ReactantType::PSISuper)) {
+		auto const& cluster =
+				static_cast<PSISuperCluster&>(*(currMapItem.second));
+		auto superWeights = cluster.getTotalAtomWeights(axis, power);
+
+		weights[cluster.getId() - 1] += superWeights[0];
+		// Loop on the used moments
+		for (int i = 1; i < psDim; i++) {
+			weights[cluster.getMomentId(indexList[i] - 1) - 1] +=
+					superWeights[indexList[i]];
+		}
+	}
+
+	return;
+}
+
+std::vector<double> PSIClusterReactionNetwork::getTotalAtomWeights(int i) {
+	// Initial declarations
+	std::vector<double> weights(getDOF(), 0.0);
+	ReactantType type;
+
+	// Switch on the index
+	switch (i) {
+	case 0:
+		type = ReactantType::He;
+		break;
+	case 1:
+		type = ReactantType::D;
+		break;
+	case 2:
+		type = ReactantType::T;
+		break;
+	default:
+		throw std::string("\nType not defined for getTotalAtomWeights()");
+		break;
+	}
+
+	// The atom clusters count their size
+	for (auto const& currMapItem : getAll(type)) {
+		auto const& cluster = *(currMapItem.second);
+		weights[cluster.getId() - 1] += (double) cluster.getSize();
+	}
+
+	// The mixed clusters count their atom content
+	for (auto const& currMapItem : getAll(ReactantType::PSIMixed)) {
+		auto const& cluster = *(currMapItem.second);
+		auto& comp = cluster.getComposition();
+		weights[cluster.getId() - 1] += (double) comp[toCompIdx(
+				toSpecies(type))];
+	}
+
+	// The super clusters count it through their moments
+	addSuperWeights(i, weights);
+
+	return weights;
+}
+
+std::vector<double> PSIClusterReactionNetwork::getTotalTrappedAtomWeights(
+		int i) {
+	// Initial declarations
+	std::vector<double> weights(getDOF(), 0.0);
+	ReactantType type;
+
+	// Switch on the index
+	switch (i) {
+	case 0:
+		type = ReactantType::He;
+		break;
+	case 1:
+		type = ReactantType::D;
+		break;
+	case 2:
+		type = ReactantType::T;
+		break;
+	default:
+		throw std::string(
+				"\nType not defined for getTotalTrappedAtomWeights()");
+		break;
+	}
+
+	// The mixed clusters count their atom content
+	for (auto const& currMapItem : getAll(ReactantType::PSIMixed)) {
+		auto const& cluster = *(currMapItem.second);
+		auto& comp = cluster.getComposition();
+		weights[cluster.getId() - 1] += (double) comp[toCompIdx(
+				toSpecies(type))];
+	}
+
+	// The super clusters count it through their moments
+	addSuperWeights(i, weights);
+
+	return weights;
+}
+
+std::vector<double> PSIClusterReactionNetwork::getTotalVWeights() {
+	// Initial declarations
+	std::vector<double> weights(getDOF(), 0.0);
+
+	// The V clusters count their size
+	for (auto const& currMapItem : getAll(ReactantType::V)) {
+		auto const& cluster = *(currMapItem.second);
+		weights[cluster.getId() - 1] += (double) cluster.getSize();
+	}
+
+	// The mixed clusters count their V content
+	for (auto const& currMapItem : getAll(ReactantType::PSIMixed)) {
+		auto const& cluster = *(currMapItem.second);
+		auto& comp = cluster.getComposition();
+		weights[cluster.getId() - 1] += (double) comp[toCompIdx(Species::V)];
+	}
+
+	// The super clusters count it through their moments
+	addSuperWeights(3, weights);
+
+	return weights;
+}
+
+std::vector<double> PSIClusterReactionNetwork::getTotalIWeights() {
+	// Initial declarations
+	std::vector<double> weights(getDOF(), 0.0);
+
+	// The I clusters count their size
+	for (auto const& currMapItem : getAll(ReactantType::I)) {
+		auto const& cluster = *(currMapItem.second);
+		weights[cluster.getId() - 1] += (double) cluster.getSize();
+	}
+
+	return weights;
+}
+
+std::vector<double> PSIClusterReactionNetwork::getAtomMomentWeights(int power,
+		int i) {
+	// Initial declarations
+	std::vector<double> weights(getDOF(), 0.0);
+	ReactantType type;
+
+	// Switch on the index
+	switch (i) {
+	case 0:
+		type = ReactantType::He;
+		break;
+	case 1:
+		type = ReactantType::D;
+		break;
+	case 2:
+		type = ReactantType::T;
+		break;
+	default:
+		throw std::string("\nType not defined for getAtomMomentWeights()");
+		break;
+	}
+
+	// The atom clusters count their size
+	for (auto const& currMapItem : getAll(type)) {
+		auto const& cluster = *(currMapItem.second);
+		weights[cluster.getId() - 1] += std::pow((double) cluster.getSize(),
+				power);
+	}
+
+	// The mixed clusters count their atom content
+	for (auto const& currMapItem : getAll(ReactantType::PSIMixed)) {
+		auto const& cluster = *(currMapItem.second);
+		auto& comp = cluster.getComposition();
+		weights[cluster.getId() - 1] += std::pow(
+				(double) comp[toCompIdx(toSpecies(type))], power);
+	}
+
+	// The super clusters count it through their moments
+	addSuperWeights(i, weights, power);
+
+	return weights;
+}
+
 void PSIClusterReactionNetwork::computeAllFluxes(double *updatedConcOffset,
 		int xi) {
 
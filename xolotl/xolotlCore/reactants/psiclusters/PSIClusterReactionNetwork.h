@@ -98,6 +98,18 @@ private:
 			IReactant::SizeType nD, IReactant::SizeType nT,
 			IReactant::SizeType nV) const override;
 
+	/**
+	 * Add the weights of the moments of the super clusters in their total
+	 * concentration of the given atom to the weights of the degrees
+	 * of freedom.
+	 *
+	 * @param axis The given atom, 3 for vacancies
+	 * @param weights The weight of each degree of freedom
+	 * @param power The power of the number of atoms in the weights
+	 */
+	void addSuperWeights(int axis, std::vector<double>& weights,
+			int power = 1) const;
+
 	ProductionReaction& defineReactionBase(IReactant& r1, IReactant& r2,
 			int a[4] = defaultInit, bool secondProduct = false)
 					__attribute__((always_inline)) {
@@ -479,6 +491,53 @@ public:
 	 */
 	double getTotalIConcentration() override;
 
+	/**
+	 * Get the weights of the degrees of freedom in the total concentration
+	 * of atoms, with the same atoms as getTotalAtomConcentration().
+	 *
+	 * @param i Index to switch between the different types of atoms
+	 * @return The weight of each degree of freedom
+	 */
+	std::vector<double> getTotalAtomWeights(int i = 0) override;
+
+	/**
+	 * Get the weights of the degrees of freedom in the total concentration
+	 * of atoms contained in bubbles, with the same atoms as
+	 * getTotalTrappedAtomConcentration().
+	 *
+	 * @param i Index to switch between the different types of atoms
+	 * @return The weight of each degree of freedom
+	 */
+	std::vector<double> getTotalTrappedAtomWeights(int i = 0) override;
+
+	/**
+	 * Get the weights of the degrees of freedom in the total concentration
+	 * of vacancies.
+	 *
+	 * @return The weight of each degree of freedom
+	 */
+	std::vector<double> getTotalVWeights() override;
+
+	/**
+	 * Get the weights of the degrees of freedom in the total concentration
+	 * of tungsten interstitials.
+	 *
+	 * @return The weight of each degree of freedom
+	 */
+	std::vector<double> getTotalIWeights() override;
+
+	/**
+	 * Get the weights of the degrees of freedom in a moment of the size
+	 * distribution of the clusters that can contain the given atoms: the
+	 * atom clusters, the mixed clusters, and the super clusters, with the
+	 * same clusters as the mean size monitors.
+	 *
+	 * @param power The power of the number of atoms
+	 * @param i Index to switch between the different types of atoms
+	 * @return The weight of each degree of freedom
+	 */
+	std::vector<double> getAtomMomentWeights(int power, int i = 0) override;
+
 	/**
 	 * Compute the fluxes generated by all the reactions
 	 * for all the clusters and their momentums.
@@ -1,5 +1,6 @@
 // Includes
 #include <iterator>
+#include <cmath>
 #include "PSISuperCluster.h"
 #include "PSIClusterReactionNetwork.h"
 #include <xolotlPerf.h>
@@ -1044,6 +1045,39 @@ double PSISuperCluster::getTotalVacancyConcentration() const {
 	return getTotalAtomConcHelper<3>();
 }
 
+template<uint32_t Axis>
+Array<double, 5> PSISuperCluster::getTotalAtomWeightsHelper(int power) const {
+
+	// Same sum as getTotalAtomConcHelper(), by moment
+	Array<double, 5> weights;
+	weights.Init(0.0);
+	for (auto const& pair : heVList) {
+		double nAtoms = std::pow((double) std::get<Axis>(pair), power);
+		weights[0] += nAtoms;
+		weights[1] += getDistance(std::get<0>(pair), 0) * nAtoms;
+		weights[2] += getDistance(std::get<1>(pair), 1) * nAtoms;
+		weights[3] += getDistance(std::get<2>(pair), 2) * nAtoms;
+		weights[4] += getDistance(std::get<3>(pair), 3) * nAtoms;
+	}
+	return weights;
+}
+
+Array<double, 5> PSISuperCluster::getTotalAtomWeights(int axis,
+		int power) const {
+
+	assert(axis <= 3);
+
+	switch (axis) {
+	case 0:
+		return getTotalAtomWeightsHelper<0>(power);
+	case 1:
+		return getTotalAtomWeightsHelper<1>(power);
+	case 2:
+		return getTotalAtomWeightsHelper<2>(power);
+	}
+	return getTotalAtomWeightsHelper<3>(power);
+}
+
 double PSISuperCluster::getIntegratedVConcentration(int v) const {
 	// Initial declarations
 	double heDistance = 0.0, dDistance = 0.0, tDistance = 0.0, vDistance = 0.0,
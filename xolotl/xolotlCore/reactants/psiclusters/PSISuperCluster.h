@@ -438,6 +438,18 @@ private:
 	template<uint32_t Axis>
 	double getTotalAtomConcHelper() const;
 
+	/**
+	 * Obtain the weights of the moments in the total concentration
+	 * for desired species type.
+	 *
+	 * @param power The power of the number of atoms in the weights
+	 * @return The weights of the zeroth moment and of the first moments
+	 * of each axis in the total concentration of species indicated by
+	 * Axis template parameter.
+	 */
+	template<uint32_t Axis>
+	Array<double, 5> getTotalAtomWeightsHelper(int power) const;
+
 public:
 
 	/**
@@ -693,6 +705,19 @@ public:
 	 */
 	double getTotalVacancyConcentration() const;
 
+	/**
+	 * This operation returns the weights of the moments in the total
+	 * concentration of given atom in the group, which is linear in them.
+	 * With another power, the concentration of each cluster is weighted by
+	 * its number of atoms to that power instead.
+	 *
+	 * @param axis The given atom, 3 for vacancies
+	 * @param power The power of the number of atoms
+	 * @return The weights of the zeroth moment and of the first moment
+	 * of each axis
+	 */
+	Array<double, 5> getTotalAtomWeights(int axis = 0, int power = 1) const;
+
 	/**
 	 * This operation returns the current concentration for a vacancy number.
 	 *
@@ -3,6 +3,7 @@
 
 // Includes
 #include <string>
+#include <map>
 #include <vector>
 #include <memory>
 #include "ITimer.h"
@@ -52,6 +53,19 @@ public:
 			const std::string& name,
 			const IHardwareCounter::SpecType& ctrSpec) = 0;
 
+	/**
+	 * Obtain the current values of the timers and event counters of this
+	 * process, keyed by name, without any communication so that they can
+	 * be sampled at every time step.  A running timer only counts the time
+	 * until it was last stopped.
+	 *
+	 * @param timerValues Map filled with the value of each timer.
+	 * @param counterValues Map filled with the value of each event counter.
+	 */
+	virtual void getLocalValues(
+			std::map<std::string, ITimer::ValType>& timerValues,
+			std::map<std::string, IEventCounter::ValType>& counterValues) const = 0;
+
 	/**
 	 * Collect statistics about any performance data collected by
 	 * processes of the program.
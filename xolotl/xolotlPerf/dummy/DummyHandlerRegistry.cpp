@@ -30,6 +30,15 @@ std::shared_ptr<IHardwareCounter> DummyHandlerRegistry::getHardwareCounter(
 	return std::make_shared < DummyHardwareCounter > (name, ctrSpec);
 }
 
+void DummyHandlerRegistry::getLocalValues(
+		std::map<std::string, ITimer::ValType>& timerValues,
+		std::map<std::string, IEventCounter::ValType>& counterValues) const {
+	// Nothing is measured
+	timerValues.clear();
+	counterValues.clear();
+	return;
+}
+
 void DummyHandlerRegistry::collectStatistics(
 		PerfObjStatsMap<ITimer::ValType>&,
 		PerfObjStatsMap<IEventCounter::ValType>&,
@@ -34,6 +34,19 @@ public:
 	virtual std::shared_ptr<IHardwareCounter> getHardwareCounter(
 			const std::string& name, const IHardwareCounter::SpecType& ctrSpec);
 
+	/**
+	 * Obtain the current values of the timers and event counters of this
+	 * process.
+	 * This method is a stub, the dummy objects are not kept.
+	 *
+	 * @param timerValues Map of the value of each timer, left empty.
+	 * @param counterValues Map of the value of each event counter, left
+	 * empty.
+	 */
+	virtual void getLocalValues(
+			std::map<std::string, ITimer::ValType>& timerValues,
+			std::map<std::string, IEventCounter::ValType>& counterValues) const;
+
 	/**
 	 * Collect statistics about any performance data collected by
 	 * processes of the program.
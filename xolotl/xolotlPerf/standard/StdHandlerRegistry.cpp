@@ -25,6 +25,23 @@ StdHandlerRegistry::~StdHandlerRegistry(void) {
 	allHWCounterSets.clear();
 }
 
+void StdHandlerRegistry::getLocalValues(
+		std::map<std::string, ITimer::ValType>& timerValues,
+		std::map<std::string, IEventCounter::ValType>& counterValues) const {
+
+	timerValues.clear();
+	for (auto const& timerItem : allTimers) {
+		timerValues[timerItem.first] = timerItem.second->getValue();
+	}
+
+	counterValues.clear();
+	for (auto const& counterItem : allEventCounters) {
+		counterValues[counterItem.first] = counterItem.second->getValue();
+	}
+
+	return;
+}
+
 // We can create the EventCounters, since they don't depend on
 // more specialized functionality from any of our subclasses.
 std::shared_ptr<IEventCounter> StdHandlerRegistry::getEventCounter(
@@ -119,6 +119,17 @@ public:
 	std::shared_ptr<IEventCounter> getEventCounter(
 			const std::string& name) override;
 
+	/**
+	 * Obtain the current values of the timers and event counters of this
+	 * process, keyed by name, without any communication.
+	 *
+	 * @param timerValues Map filled with the value of each timer.
+	 * @param counterValues Map filled with the value of each event counter.
+	 */
+	void getLocalValues(std::map<std::string, ITimer::ValType>& timerValues,
+			std::map<std::string, IEventCounter::ValType>& counterValues) const
+					override;
+
 	/**
 	 * Collect statistics about any performance data collected by
 	 * processes of the program.
@@ -13,6 +13,7 @@
 #include <IReSolutionHandler.h>
 #include <IMaterialFactory.h>
 #include <IReactionNetwork.h>
+#include "xolotlCore/io/HDF5File.h"
 
 namespace xolotlSolver {
 
@@ -163,6 +164,23 @@ public:
 	 */
 	virtual double getTauBursting() const = 0;
 
+	/**
+	 * Get the compression to use for the concentrations written
+	 * in the checkpoint files.
+	 *
+	 * @return The compression parameters
+	 */
+	virtual const xolotlCore::HDF5File::Compression& getCheckpointCompression() const = 0;
+
+	/**
+	 * Get the compression to use for the concentrations written
+	 * in the analysis files, which may be lossy unlike the one of the
+	 * checkpoint files.
+	 *
+	 * @return The compression parameters
+	 */
+	virtual const xolotlCore::HDF5File::Compression& getAnalysisCompression() const = 0;
+
 	/**
 	 * Get the grid left offset.
 	 *
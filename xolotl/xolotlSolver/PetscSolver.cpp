@@ -3,7 +3,10 @@
 #include <PetscSolver.h>
 #include <fstream>
 #include <iostream>
+#include <cmath>
+#include <vector>
 #include "xolotlCore/io/XFile.h"
+#include "xolotlSolver/monitor/Monitor.h"
 
 using namespace xolotlCore;
 
@@ -21,6 +24,66 @@ using namespace xolotlCore;
  -ts_max_steps <maxsteps>                -- maximum number of time-steps to take
  -ts_final_time <time>                   -- maximum time to compute to
  -ts_dt <size>							 -- initial size of the time step
+ -skip_void                              -- don't store the Jacobian blocks of the
+                                            grid points left of the surface
+ -lag_jacobian <lag>                     -- lag the Jacobian and preconditioner,
+                                            refreshing them adaptively
+ -lag_jacobian_temp <dT>                 -- temperature change (K) refreshing
+                                            the lagged Jacobian, 0.1 by default
+ -async_start_stop                       -- write the checkpoint file on a
+                                            background I/O thread
+ -start_stop_keyframe <N>                -- only write the full state in one
+                                            checkpoint every N, the others
+                                            having the changes since
+ -start_stop_delta_tol <tol>             -- relative change under which a
+                                            concentration is not written
+                                            between full checkpoints
+ -start_stop_keep <K>                    -- only keep the last K time steps
+                                            in the checkpoint file
+ -start_stop_analysis <file>             -- also append every checkpoint to
+                                            the given analysis file
+ -start_stop_analysis_bits <n>           -- only keep n mantissa bits of the
+                                            concentrations in the analysis file
+ -start_stop_analysis_no_concs           -- only write the monitored quantities
+                                            in the analysis file
+ -start_stop_rel_tol <tol>               -- do not write the concentrations
+                                            below tol times the largest one
+ -<monitor>_cadence <cadence>            -- how often a monitor (start_stop,
+                                            helium_retention, tridyn, ...)
+                                            samples the solution: steps:N,
+                                            time:dt, log:N (N per decade of
+                                            time), events, or rejections
+                                            (after rejected time steps)
+ -time_series <file>                     -- write the retention, surface, and
+                                            bursting time series in the given
+                                            HDF5 file instead of text files
+                                            (see xseries2txt)
+ -size_statistics                        -- append the total concentration,
+                                            mean size, size variance, and
+                                            largest mean size over depth of
+                                            the bubbles to sizeStatistics (1D,
+                                            the 0D -bubble monitor always does)
+ -tridyn_binary                          -- write the TRIDYN profiles as raw
+                                            binary files TRIDYN_<step>.bin
+                                            instead of HDF5 (1D) or text
+                                            (2D and 3D) files
+ -tridyn_hdf5                            -- write the 2D and 3D TRIDYN profiles
+                                            in HDF5 files TRIDYN_<step>.h5
+                                            instead of text files
+ -viz_log_bins <n>                       -- plot the -plot_1d size distribution
+                                            averaged over n bins per decade
+                                            of size
+ -viz_max_points <n>                     -- plot about n points per cluster in
+                                            -plot_series, keeping the min and
+                                            max of each bin of grid points
+ -viz_coarsen <n>                        -- average the -plot_2d map over
+                                            blocks of n x n clusters
+ -telemetry                              -- append to telemetry the step size,
+                                            the SNES/KSP iterations, rejected
+                                            steps, memory high-water mark, and
+                                            the increase of every timer and
+                                            event counter since the previous
+                                            sample (largest over processes)
 
  */
 
@@ -32,6 +95,37 @@ std::shared_ptr<xolotlPerf::ITimer> RHSFunctionTimer;
 ////Timer for RHSJacobian()
 std::shared_ptr<xolotlPerf::ITimer> RHSJacobianTimer;
 
+//! Counter for the calls to RHSFunction()
+std::shared_ptr<xolotlPerf::IEventCounter> RHSFunctionCounter;
+
+//! Counter for the calls to RHSJacobian()
+std::shared_ptr<xolotlPerf::IEventCounter> RHSJacobianCounter;
+
+//! Counter for the time steps where the Jacobian was refreshed
+std::shared_ptr<xolotlPerf::IEventCounter> jacobianRefreshCounter;
+
+//! Counter for the time steps where the Jacobian was lagged
+std::shared_ptr<xolotlPerf::IEventCounter> jacobianLagCounter;
+
+//! How many Newton iterations a Jacobian is kept for, 1 means no lagging
+PetscInt jacobianLag = 1;
+
+//! The number of SNES iterations in a step above which the Jacobian is refreshed
+PetscInt jacobianLagMaxSNESIts = 4;
+
+//! The number of KSP iterations in a step above which the Jacobian is refreshed
+PetscInt jacobianLagMaxKSPIts = 200;
+
+//! The temperature change (K) above which the Jacobian is refreshed
+PetscReal jacobianLagMaxTemperatureChange = 0.1;
+
+//! The cumulative SNES and KSP iterations at the previous step
+PetscInt previousSNESIts = 0, previousKSPIts = 0;
+
+//! The temperature and surface positions when the Jacobian was last refreshed
+double jacobianTemperature = 0.0;
+std::vector<int> jacobianSurface;
+
 //! Help message
 static char help[] =
 		"Solves C_t =  -D*C_xx + A*C_x + F(C) + R(C) + D(C) from Brian Wirth's SciDAC project.\n";
@@ -70,6 +164,7 @@ void PetscSolver::setupInitialConditions(DM da, Vec C) {
 PetscErrorCode RHSFunction(TS ts, PetscReal ftime, Vec C, Vec F, void *) {
 	// Start the RHSFunction Timer
 	RHSFunctionTimer->start();
+	RHSFunctionCounter->increment();
 
 	PetscErrorCode ierr;
 
@@ -114,6 +209,7 @@ PetscErrorCode RHSJacobian(TS ts, PetscReal ftime, Vec C, Mat A, Mat J,
 		void *) {
 	// Start the RHSJacobian timer
 	RHSJacobianTimer->start();
+	RHSJacobianCounter->increment();
 
 	PetscErrorCode ierr;
 
@@ -168,11 +264,108 @@ PetscErrorCode RHSJacobian(TS ts, PetscReal ftime, Vec C, Mat A, Mat J,
 	PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "monitorJacobianLag")
+/**
+ * This is a monitoring method that decides, after each time step, if the
+ * Jacobian and preconditioner can keep being lagged or have to be rebuilt
+ * at the beginning of the next step. They are rebuilt when the number of
+ * nonlinear or linear iterations of the step grows over its threshold, or
+ * when the temperature or the surface position changed.
+ */
+PetscErrorCode monitorJacobianLag(TS ts, PetscInt timestep, PetscReal time,
+		Vec, void *) {
+	PetscErrorCode ierr;
+
+	PetscFunctionBeginUser;
+
+	// Get the number of iterations done during this step
+	PetscInt snesIts = 0, kspIts = 0;
+	ierr = TSGetSNESIterations(ts, &snesIts);
+	CHKERRQ(ierr);
+	ierr = TSGetKSPIterations(ts, &kspIts);
+	CHKERRQ(ierr);
+	PetscInt stepSNESIts = snesIts - previousSNESIts;
+	PetscInt stepKSPIts = kspIts - previousKSPIts;
+	previousSNESIts = snesIts;
+	previousKSPIts = kspIts;
+
+	// Get the current temperature
+	auto& solverHandler = Solver::getSolverHandler();
+	xolotlCore::Point<3> gridPosition { 0.0, 0.0, 0.0 };
+	double temperature =
+			solverHandler.getTemperatureHandler()->getTemperature(gridPosition,
+					time);
+
+	// Get the current surface positions
+	std::vector<int> surface;
+	int dim = solverHandler.getDimension();
+	if (dim == 1)
+		surface.push_back(solverHandler.getSurfacePosition());
+	else if (dim > 1) {
+		// Get the size of the grid in Y and Z
+		DM da;
+		ierr = TSGetDM(ts, &da);
+		CHKERRQ(ierr);
+		PetscInt My, Mz;
+		ierr = DMDAGetInfo(da, PETSC_IGNORE, PETSC_IGNORE, &My, &Mz,
+		PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
+		PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
+		PETSC_IGNORE);
+		CHKERRQ(ierr);
+		if (dim == 2)
+			Mz = 1;
+		for (PetscInt k = 0; k < Mz; k++) {
+			for (PetscInt j = 0; j < My; j++) {
+				surface.push_back(
+						solverHandler.getSurfacePosition(j,
+								(dim == 3) ? k : -1));
+			}
+		}
+	}
+
+	// Decide if the Jacobian needs to be refreshed
+	bool refresh = (timestep == 0) || (stepSNESIts > jacobianLagMaxSNESIts)
+			|| (stepKSPIts > jacobianLagMaxKSPIts)
+			|| (std::fabs(temperature - jacobianTemperature)
+					> jacobianLagMaxTemperatureChange)
+			|| (surface != jacobianSurface);
+
+	SNES snes;
+	ierr = TSGetSNES(ts, &snes);
+	CHKERRQ(ierr);
+	if (refresh) {
+		// -2 rebuilds them at the next Newton iteration and then never
+		// again until the lag is set back
+		ierr = SNESSetLagJacobian(snes, -2);
+		CHKERRQ(ierr);
+		ierr = SNESSetLagPreconditioner(snes, -2);
+		CHKERRQ(ierr);
+		jacobianTemperature = temperature;
+		jacobianSurface = surface;
+		jacobianRefreshCounter->increment();
+	} else {
+		ierr = SNESSetLagJacobian(snes, jacobianLag);
+		CHKERRQ(ierr);
+		ierr = SNESSetLagPreconditioner(snes, jacobianLag);
+		CHKERRQ(ierr);
+		jacobianLagCounter->increment();
+	}
+
+	PetscFunctionReturn(0);
+}
+
 PetscSolver::PetscSolver(ISolverHandler& _solverHandler,
 		std::shared_ptr<xolotlPerf::IHandlerRegistry> registry) :
 		Solver(_solverHandler, registry) {
 	RHSFunctionTimer = handlerRegistry->getTimer("RHSFunctionTimer");
 	RHSJacobianTimer = handlerRegistry->getTimer("RHSJacobianTimer");
+	RHSFunctionCounter = handlerRegistry->getEventCounter("RHSFunctionCounter");
+	RHSJacobianCounter = handlerRegistry->getEventCounter("RHSJacobianCounter");
+	jacobianRefreshCounter = handlerRegistry->getEventCounter(
+			"jacobianRefreshCounter");
+	jacobianLagCounter = handlerRegistry->getEventCounter(
+			"jacobianLagCounter");
 }
 
 PetscSolver::~PetscSolver() {
@@ -224,7 +417,28 @@ void PetscSolver::solve() {
 	checkPetscError(ierr, "PetscSolver::solve: TSSetProblemType failed.");
 	ierr = TSSetRHSFunction(ts, NULL, RHSFunction, NULL);
 	checkPetscError(ierr, "PetscSolver::solve: TSSetRHSFunction failed.");
-	ierr = TSSetRHSJacobian(ts, NULL, NULL, RHSJacobian, NULL);
+
+	// Check the option -skip_void
+	PetscBool flagVoid;
+	ierr = PetscOptionsHasName(NULL, NULL, "-skip_void", &flagVoid);
+	checkPetscError(ierr,
+			"PetscSolver::solve: PetscOptionsHasName (-skip_void) failed.");
+	Mat J = NULL;
+	if (flagVoid) {
+		// Only preallocate the Jacobian instead of filling its whole block
+		// structure with zeros, the first assembly then drops the blocks of
+		// the grid points in the void left of the surface because they are
+		// never set
+		ierr = DMSetMatrixPreallocateOnly(da, PETSC_TRUE);
+		checkPetscError(ierr,
+				"PetscSolver::solve: DMSetMatrixPreallocateOnly failed.");
+		ierr = DMCreateMatrix(da, &J);
+		checkPetscError(ierr, "PetscSolver::solve: DMCreateMatrix failed.");
+		// The blocks have to come back when the surface moves into the void
+		ierr = MatSetOption(J, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE);
+		checkPetscError(ierr, "PetscSolver::solve: MatSetOption failed.");
+	}
+	ierr = TSSetRHSJacobian(ts, J, J, RHSJacobian, NULL);
 	checkPetscError(ierr, "PetscSolver::solve: TSSetRHSJacobian failed.");
 	ierr = TSSetSolution(ts, C);
 	checkPetscError(ierr, "PetscSolver::solve: TSSetSolution failed.");
@@ -286,6 +500,44 @@ void PetscSolver::solve() {
 				"to set the monitors.");
 	}
 
+	// Check the option -lag_jacobian
+	PetscBool flagLag;
+	ierr = PetscOptionsGetInt(NULL, NULL, "-lag_jacobian", &jacobianLag,
+			&flagLag);
+	checkPetscError(ierr,
+			"PetscSolver::solve: PetscOptionsGetInt (-lag_jacobian) failed.");
+	if (flagLag && jacobianLag > 1) {
+		// Get the optional thresholds on the iterations
+		ierr = PetscOptionsGetInt(NULL, NULL, "-lag_jacobian_snes_its",
+				&jacobianLagMaxSNESIts, NULL);
+		checkPetscError(ierr,
+				"PetscSolver::solve: PetscOptionsGetInt (-lag_jacobian_snes_its) failed.");
+		ierr = PetscOptionsGetInt(NULL, NULL, "-lag_jacobian_ksp_its",
+				&jacobianLagMaxKSPIts, NULL);
+		checkPetscError(ierr,
+				"PetscSolver::solve: PetscOptionsGetInt (-lag_jacobian_ksp_its) failed.");
+		ierr = PetscOptionsGetReal(NULL, NULL, "-lag_jacobian_temp",
+				&jacobianLagMaxTemperatureChange, NULL);
+		checkPetscError(ierr,
+				"PetscSolver::solve: PetscOptionsGetReal (-lag_jacobian_temp) failed.");
+
+		// The lag has to be counted across the nonlinear solves
+		SNES snes;
+		ierr = TSGetSNES(ts, &snes);
+		checkPetscError(ierr, "PetscSolver::solve: TSGetSNES failed.");
+		ierr = SNESSetLagJacobianPersists(snes, PETSC_TRUE);
+		checkPetscError(ierr,
+				"PetscSolver::solve: SNESSetLagJacobianPersists failed.");
+		ierr = SNESSetLagPreconditionerPersists(snes, PETSC_TRUE);
+		checkPetscError(ierr,
+				"PetscSolver::solve: SNESSetLagPreconditionerPersists failed.");
+
+		// Set the monitor deciding when to refresh the Jacobian
+		ierr = TSMonitorSet(ts, monitorJacobianLag, NULL, NULL);
+		checkPetscError(ierr,
+				"PetscSolver::solve: TSMonitorSet (monitorJacobianLag) failed.");
+	}
+
 	/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 	 Set initial conditions
 	 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
@@ -343,6 +595,10 @@ void PetscSolver::solve() {
 	checkPetscError(ierr, "PetscSolver::solve: VecDestroy failed.");
 	ierr = TSDestroy(&ts);
 	checkPetscError(ierr, "PetscSolver::solve: TSDestroy failed.");
+	// The monitors may have written time series until they were destroyed
+	closeTimeSeries();
+	ierr = MatDestroy(&J);
+	checkPetscError(ierr, "PetscSolver::solve: MatDestroy failed.");
 	ierr = DMDestroy(&da);
 	checkPetscError(ierr, "PetscSolver::solve: DMDestroy failed.");
 
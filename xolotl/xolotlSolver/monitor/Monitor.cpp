@@ -11,8 +11,17 @@
 #include <iostream>
 #include <iomanip>
 #include <vector>
+#include <map>
+#include <set>
 #include <memory>
+#include <array>
+#include <algorithm>
+#include <cstdint>
+#include <sys/resource.h>
+#include <NESuperCluster.h>
 #include "xolotlCore/io/XFile.h"
+#include "xolotlCore/io/TimeSeriesFile.h"
+#include "xolotlCore/io/HDF5Exception.h"
 #include "xolotlSolver/monitor/Monitor.h"
 
 namespace xolotlSolver {
@@ -25,6 +34,34 @@ double previousTime = 0.0;
 //! The variable to store the threshold on time step defined by the user.
 double timeStepThreshold = 0.0;
 
+//! The path of the time series file, empty to write the text files.
+std::string timeSeriesFileName;
+//! Whether the option -time_series was read.
+bool timeSeriesOptionRead = false;
+//! The time series file, created by the first row of the master process.
+std::unique_ptr<xolotlCore::TimeSeriesFile> timeSeriesFile;
+
+//! The names of the timers and event counters sampled by the telemetry,
+//! registered on all the processes by startTelemetry.
+std::vector<std::string> telemetryTimerNames, telemetryCounterNames;
+//! The names of the columns of the telemetry.
+std::vector<std::string> telemetryColumns;
+//! The values of the timers and event counters at the previous sample.
+std::vector<double> previousTelemetryValues;
+//! The SNES iterations, KSP iterations, rejected steps, and SNES failures
+//! counted by the time stepper at the previous sample.
+std::array<PetscInt, 4> previousTelemetryStats { };
+
+//! The checkpoint writer of the startStop monitor, NULL if there is none.
+xolotlCore::CheckpointWriter* activeCheckpointWriter = NULL;
+
+//! Whether the options -tridyn_binary and -tridyn_hdf5 were read.
+bool tridynOptionsRead = false;
+//! Whether the TRIDYN profiles are written as raw binary files.
+PetscBool tridynBinary = PETSC_FALSE;
+//! Whether the TRIDYN profiles are written as HDF5 files.
+PetscBool tridynHDF5 = PETSC_FALSE;
+
 #undef __FUNCT__
 #define __FUNCT__ Actual__FUNCT__("xolotlSolver", "checkTimeStep")
 /**
@@ -234,5 +271,547 @@ void writeNetwork(MPI_Comm _comm, std::string srcFileName,
 	}
 }
 
+/**
+ * Read the option -time_series the first time.
+ *
+ * @return The path of the time series file, empty if it is not used.
+ */
+static const std::string& getTimeSeriesFileName(void) {
+
+	if (!timeSeriesOptionRead) {
+		char fileName[PETSC_MAX_PATH_LEN];
+		PetscBool flag;
+		PetscErrorCode ierr = PetscOptionsGetString(NULL, NULL, "-time_series",
+				fileName, PETSC_MAX_PATH_LEN, &flag);
+		checkPetscError(ierr,
+				"getTimeSeriesFileName: PetscOptionsGetString (-time_series) failed.");
+		if (flag)
+			timeSeriesFileName = fileName;
+		timeSeriesOptionRead = true;
+	}
+
+	return timeSeriesFileName;
+}
+
+void clearTimeSeries(const std::string& name,
+		const std::vector<std::string>& columns) {
+
+	// The time series file is created from scratch with its first row
+	if (!getTimeSeriesFileName().empty())
+		return;
+
+	// Only the master process writes the text file
+	int procId;
+	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+	if (procId != 0)
+		return;
+
+	std::ofstream outputFile;
+	outputFile.open(name + ".txt");
+	if (!columns.empty()) {
+		outputFile << "#";
+		for (auto const& column : columns) {
+			outputFile << " " << column;
+		}
+		outputFile << std::endl;
+	}
+	outputFile.close();
+}
+
+void appendTimeSeries(const std::string& name,
+		const std::vector<std::string>& columns,
+		const std::vector<double>& row, xolotlCore::TextFileWriter* writer) {
+
+	auto const& fileName = getTimeSeriesFileName();
+	if (fileName.empty()) {
+		// Append a line to the text file
+		if (writer) {
+			writer->append(name + ".txt",
+					xolotlCore::TimeSeriesFile::toText(row));
+		} else {
+			std::ofstream outputFile;
+			outputFile.open(name + ".txt", std::ios::app);
+			outputFile << xolotlCore::TimeSeriesFile::toText(row);
+			outputFile.close();
+		}
+		return;
+	}
+
+	// Buffer the row in the time series file, waiting for the checkpoint
+	// writer when HDF5 is about to be used
+	if (!timeSeriesFile) {
+		waitForCheckpointWriter();
+		timeSeriesFile.reset(new xolotlCore::TimeSeriesFile(fileName));
+	} else if (timeSeriesFile->writesOnAppend(name)) {
+		waitForCheckpointWriter();
+	}
+	timeSeriesFile->append(name, columns, row);
+}
+
+void closeTimeSeries(void) {
+
+	// The buffered rows are written when the file is closed
+	if (timeSeriesFile)
+		waitForCheckpointWriter();
+	timeSeriesFile.reset();
+}
+
+/**
+ * Gather the names known by any of the processes.
+ *
+ * @param localNames The names known by this process.
+ * @return The sorted names, the same on all the processes.
+ */
+static std::vector<std::string> gatherNames(
+		const std::vector<std::string>& localNames) {
+
+	// Get the process ID and the number of processes
+	int procId, nProcs;
+	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+	MPI_Comm_size(PETSC_COMM_WORLD, &nProcs);
+
+	// Send the names of each process, one per line, to the master process
+	std::string localText;
+	for (auto const& name : localNames) {
+		localText += name + '\n';
+	}
+	int localLength = localText.size();
+	std::vector<int> lengths(nProcs, 0), offsets(nProcs, 0);
+	MPI_Gather(&localLength, 1, MPI_INT, lengths.data(), 1, MPI_INT, 0,
+			PETSC_COMM_WORLD);
+	for (int i = 1; i < nProcs; i++) {
+		offsets[i] = offsets[i - 1] + lengths[i - 1];
+	}
+	std::string text(offsets.back() + lengths.back(), '\0');
+	MPI_Gatherv(&localText[0], localLength, MPI_CHAR, &text[0],
+			lengths.data(), offsets.data(), MPI_CHAR, 0, PETSC_COMM_WORLD);
+
+	// The master process keeps each name once and sends them back
+	if (procId == 0) {
+		std::set<std::string> names;
+		std::istringstream nameStream(text);
+		std::string name;
+		while (std::getline(nameStream, name)) {
+			names.insert(name);
+		}
+		text.clear();
+		for (auto const& name : names) {
+			text += name + '\n';
+		}
+	}
+	int length = text.size();
+	MPI_Bcast(&length, 1, MPI_INT, 0, PETSC_COMM_WORLD);
+	text.resize(length);
+	MPI_Bcast(&text[0], length, MPI_CHAR, 0, PETSC_COMM_WORLD);
+
+	std::vector<std::string> names;
+	std::istringstream nameStream(text);
+	std::string name;
+	while (std::getline(nameStream, name)) {
+		names.push_back(name);
+	}
+
+	return names;
+}
+
+void startTelemetry(void) {
+
+	// Register the timers and event counters that exist on any process,
+	// all of them being created before the solver runs
+	std::map<std::string, xolotlPerf::ITimer::ValType> timerValues;
+	std::map<std::string, xolotlPerf::IEventCounter::ValType> counterValues;
+	xolotlPerf::getHandlerRegistry()->getLocalValues(timerValues,
+			counterValues);
+	std::vector<std::string> localNames;
+	for (auto const& timer : timerValues) {
+		localNames.push_back(timer.first);
+	}
+	telemetryTimerNames = gatherNames(localNames);
+	localNames.clear();
+	for (auto const& counter : counterValues) {
+		localNames.push_back(counter.first);
+	}
+	telemetryCounterNames = gatherNames(localNames);
+	previousTelemetryValues.assign(
+			telemetryTimerNames.size() + telemetryCounterNames.size(), 0.0);
+
+	// Name the columns
+	telemetryColumns = {"timestep", "time", "dt", "nextDt", "snesIterations",
+			"kspIterations", "rejectedSteps", "snesFailures", "maxResidentMB"};
+	for (auto const& name : telemetryTimerNames) {
+		telemetryColumns.push_back("timer:" + name);
+	}
+	for (auto const& name : telemetryCounterNames) {
+		telemetryColumns.push_back("counter:" + name);
+	}
+
+	// Clear the file where the telemetry will be written
+	clearTimeSeries("telemetry", telemetryColumns);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "monitorTelemetry")
+/**
+ * This is a monitoring method that appends to the telemetry time series
+ * what the solver did since the previous sample: the number of nonlinear
+ * and linear iterations, of rejected steps and of nonlinear failures, the
+ * increase of each performance timer and event counter, along with the
+ * size of the last and next time steps and the memory high-water mark.
+ * The performance values are the largest over the processes, so a single
+ * small reduction is done per sample. Throws an error message if a timer
+ * or an event counter was created after startTelemetry registered them.
+ */
+PetscErrorCode monitorTelemetry(TS ts, PetscInt timestep, PetscReal time,
+		Vec, void *) {
+	// To check PETSc errors
+	PetscErrorCode ierr;
+
+	PetscFunctionBeginUser;
+
+	// Get the process ID
+	int procId;
+	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+
+	// Get the values of the performance data of this process
+	std::map<std::string, xolotlPerf::ITimer::ValType> timerValues;
+	std::map<std::string, xolotlPerf::IEventCounter::ValType> counterValues;
+	xolotlPerf::getHandlerRegistry()->getLocalValues(timerValues,
+			counterValues);
+
+	// Compute the increases since the previous sample, followed by the
+	// memory high-water mark in MB
+	std::vector<double> localValues;
+	for (auto const& name : telemetryTimerNames) {
+		auto it = timerValues.find(name);
+		localValues.push_back((it != timerValues.end()) ? it->second : 0.0);
+	}
+	for (auto const& name : telemetryCounterNames) {
+		auto it = counterValues.find(name);
+		localValues.push_back(
+				(it != counterValues.end()) ? (double) it->second : 0.0);
+	}
+	for (size_t i = 0; i < localValues.size(); i++) {
+		double value = localValues[i];
+		localValues[i] -= previousTelemetryValues[i];
+		previousTelemetryValues[i] = value;
+	}
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	localValues.push_back((double) usage.ru_maxrss / 1024.0);
+
+	// Count the values that would be missing from the columns, so that
+	// all the processes fail together
+	std::string unknownName;
+	for (auto const& timer : timerValues) {
+		if (!std::binary_search(telemetryTimerNames.begin(),
+				telemetryTimerNames.end(), timer.first))
+			unknownName = "timer " + timer.first;
+	}
+	for (auto const& counter : counterValues) {
+		if (!std::binary_search(telemetryCounterNames.begin(),
+				telemetryCounterNames.end(), counter.first))
+			unknownName = "event counter " + counter.first;
+	}
+	localValues.push_back(unknownName.empty() ? 0.0 : 1.0);
+
+	// Get the largest values over the processes
+	std::vector<double> values(localValues.size(), 0.0);
+	MPI_Allreduce(localValues.data(), values.data(), localValues.size(),
+			MPI_DOUBLE, MPI_MAX, PETSC_COMM_WORLD);
+	if (values.back() > 0.0) {
+		throw std::string(
+				"monitorTelemetry: Performance data was created after "
+						"startTelemetry"
+						+ (unknownName.empty() ?
+								std::string() : " (" + unknownName + ")"));
+	}
+	values.pop_back();
+
+	// Get the cumulative statistics of the time stepper
+	std::array<PetscInt, 4> stats;
+	ierr = TSGetSNESIterations(ts, &stats[0]);
+	CHKERRQ(ierr);
+	ierr = TSGetKSPIterations(ts, &stats[1]);
+	CHKERRQ(ierr);
+	ierr = TSGetStepRejections(ts, &stats[2]);
+	CHKERRQ(ierr);
+	ierr = TSGetSNESFailures(ts, &stats[3]);
+	CHKERRQ(ierr);
+
+	// Get the size of the last step and of the next one
+	PetscReal prevTime, nextDt;
+	ierr = TSGetPrevTime(ts, &prevTime);
+	CHKERRQ(ierr);
+	ierr = TSGetTimeStep(ts, &nextDt);
+	CHKERRQ(ierr);
+
+	// Master process
+	if (procId == 0) {
+		std::vector<double> row { (double) timestep, time, time - prevTime,
+				nextDt };
+		for (size_t i = 0; i < stats.size(); i++) {
+			row.push_back(stats[i] - previousTelemetryStats[i]);
+		}
+		row.push_back(values.back());
+		for (size_t i = 0; i + 1 < values.size(); i++) {
+			row.push_back(values[i]);
+		}
+
+		appendTimeSeries("telemetry", telemetryColumns, row);
+	}
+	previousTelemetryStats = stats;
+
+	PetscFunctionReturn(0);
+}
+
+TRIDYNFormat getTRIDYNFormat(bool hdf5ByDefault) {
+
+	// Read the options the first time
+	if (!tridynOptionsRead) {
+		PetscErrorCode ierr = PetscOptionsHasName(NULL, NULL, "-tridyn_binary",
+				&tridynBinary);
+		checkPetscError(ierr,
+				"getTRIDYNFormat: PetscOptionsHasName (-tridyn_binary) failed.");
+		ierr = PetscOptionsHasName(NULL, NULL, "-tridyn_hdf5", &tridynHDF5);
+		checkPetscError(ierr,
+				"getTRIDYNFormat: PetscOptionsHasName (-tridyn_hdf5) failed.");
+		tridynOptionsRead = true;
+	}
+
+	if (tridynBinary)
+		return TRIDYNFormat::Binary;
+	if (tridynHDF5 || hdf5ByDefault)
+		return TRIDYNFormat::HDF5;
+	return TRIDYNFormat::Text;
+}
+
+void writeTRIDYNProfile(MPI_Comm _comm, PetscInt timestep,
+		TRIDYNFormat format, hsize_t nRows, hsize_t nColumns, hsize_t firstRow,
+		const std::vector<double>& rows) {
+
+	hsize_t myNumRows = rows.size() / nColumns;
+
+	if (format == TRIDYNFormat::Text) {
+		// Gather the rows on the master process, in order
+		int procId, worldSize;
+		MPI_Comm_rank(_comm, &procId);
+		MPI_Comm_size(_comm, &worldSize);
+		int myNumValues = rows.size();
+		std::vector<int> numValues(worldSize), displs(worldSize);
+		MPI_Gather(&myNumValues, 1, MPI_INT, numValues.data(), 1, MPI_INT, 0,
+				_comm);
+		std::vector<double> allRows;
+		if (procId == 0) {
+			for (int i = 1; i < worldSize; i++)
+				displs[i] = displs[i - 1] + numValues[i - 1];
+			allRows.resize(nRows * nColumns);
+		}
+		MPI_Gatherv(rows.data(), myNumValues, MPI_DOUBLE, allRows.data(),
+				numValues.data(), displs.data(), MPI_DOUBLE, 0, _comm);
+
+		// The master process writes them, one line per row
+		if (procId == 0) {
+			std::ostringstream datFileStr;
+			datFileStr << "TRIDYN_" << timestep << ".dat";
+			std::ofstream outputFile;
+			outputFile.open(datFileStr.str());
+			for (hsize_t i = 0; i < nRows; i++) {
+				outputFile << allRows[i * nColumns];
+				for (hsize_t j = 1; j < nColumns; j++)
+					outputFile << " " << allRows[i * nColumns + j];
+				outputFile << std::endl;
+			}
+			outputFile.close();
+		}
+
+		return;
+	}
+
+	if (format == TRIDYNFormat::Binary) {
+		std::ostringstream binFileStr;
+		binFileStr << "TRIDYN_" << timestep << ".bin";
+
+		// Create the file, dropping what a previous run may have left
+		MPI_File binFile;
+		int err = MPI_File_open(_comm, binFileStr.str().c_str(),
+		MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &binFile);
+		if (err != MPI_SUCCESS) {
+			throw std::string(
+					"writeTRIDYNProfile: Unable to open " + binFileStr.str());
+		}
+		const int64_t header[2] = { (int64_t) nRows, (int64_t) nColumns };
+		const MPI_Offset headerSize = sizeof(header);
+		err = MPI_File_set_size(binFile,
+				headerSize + nRows * nColumns * sizeof(double));
+
+		// The master process writes the header
+		int procId;
+		MPI_Comm_rank(_comm, &procId);
+		if (err == MPI_SUCCESS && procId == 0) {
+			err = MPI_File_write_at(binFile, 0, header, 2, MPI_INT64_T,
+			MPI_STATUS_IGNORE);
+		}
+
+		// Everyone writes its rows at once, if everyone can
+		int failed = (err != MPI_SUCCESS);
+		MPI_Allreduce(MPI_IN_PLACE, &failed, 1, MPI_INT, MPI_MAX, _comm);
+		if (!failed) {
+			err = MPI_File_write_at_all(binFile,
+					headerSize + firstRow * nColumns * sizeof(double),
+					rows.data(), (int) rows.size(), MPI_DOUBLE,
+					MPI_STATUS_IGNORE);
+			failed = (err != MPI_SUCCESS);
+		}
+		MPI_File_close(&binFile);
+		if (failed) {
+			throw std::string(
+					"writeTRIDYNProfile: Unable to write " + binFileStr.str());
+		}
+
+		return;
+	}
+
+	// Create the file for parallel file access
+	std::ostringstream tdFileStr;
+	tdFileStr << "TRIDYN_" << timestep << ".h5";
+	xolotlCore::HDF5File tdFile(tdFileStr.str(),
+			xolotlCore::HDF5File::AccessMode::CreateOrTruncateIfExists, _comm,
+			true);
+
+	// Everyone must create the dataset with the same shape
+	xolotlCore::HDF5File::SimpleDataSpace<2>::Dimensions concsDsetDims = {
+			nRows, nColumns };
+	xolotlCore::HDF5File::SimpleDataSpace<2> concsDsetSpace(concsDsetDims);
+	xolotlCore::HDF5File::DataSet<double> concsDset(tdFile, "concs",
+			concsDsetSpace);
+
+	// Select our block of rows, the processes without any still take part
+	// in the collective write
+	std::array<hsize_t, 2> offsets { firstRow, 0 };
+	std::array<hsize_t, 2> counts { std::max(myNumRows, (hsize_t) 1),
+			nColumns };
+	hid_t fileSpaceId = H5Dget_space(concsDset.getId());
+	hid_t memSpaceId = H5Screate_simple(2, counts.data(), nullptr);
+	herr_t status = 0;
+	if (myNumRows > 0) {
+		counts[0] = myNumRows;
+		status = H5Sselect_hyperslab(fileSpaceId, H5S_SELECT_SET,
+				offsets.data(), nullptr, counts.data(), nullptr);
+	}
+	if (myNumRows == 0 || status < 0) {
+		H5Sselect_none(fileSpaceId);
+		H5Sselect_none(memSpaceId);
+	}
+
+	// Write it with a collective write, that every process enters even
+	// if it could not select its rows
+	xolotlCore::HDF5File::PropertyList plist(H5P_DATASET_XFER);
+	H5Pset_dxpl_mpio(plist.getId(), H5FD_MPIO_COLLECTIVE);
+	herr_t writeStatus = H5Dwrite(concsDset.getId(), H5T_NATIVE_DOUBLE,
+			memSpaceId, fileSpaceId, plist.getId(), rows.data());
+	H5Sclose(memSpaceId);
+	H5Sclose(fileSpaceId);
+
+	// Everyone fails if anyone did
+	int failed = (status < 0 || writeStatus < 0);
+	MPI_Allreduce(MPI_IN_PLACE, &failed, 1, MPI_INT, MPI_MAX, _comm);
+	if (failed) {
+		throw xolotlCore::HDF5Exception(
+				"writeTRIDYNProfile: Unable to write " + tdFileStr.str());
+	}
+
+	return;
+}
+
+xolotlCore::CheckpointWriter* createCheckpointWriter(MPI_Comm _comm) {
+
+	// Check the option -async_start_stop
+	PetscBool flagAsync;
+	PetscErrorCode ierr = PetscOptionsHasName(NULL, NULL, "-async_start_stop",
+			&flagAsync);
+	checkPetscError(ierr, "createCheckpointWriter: PetscOptionsHasName "
+			"(-async_start_stop) failed.");
+
+	activeCheckpointWriter = new xolotlCore::CheckpointWriter(_comm,
+			flagAsync);
+
+	return activeCheckpointWriter;
+}
+
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "destroyCheckpointWriter")
+PetscErrorCode destroyCheckpointWriter(void **ctx) {
+
+	PetscFunctionBeginUser;
+
+	// Waits for the pending writes
+	if (*ctx == activeCheckpointWriter)
+		activeCheckpointWriter = NULL;
+	delete (xolotlCore::CheckpointWriter *) *ctx;
+	*ctx = NULL;
+
+	PetscFunctionReturn(0);
+}
+
+void waitForCheckpointWriter(void) {
+
+	if (activeCheckpointWriter)
+		activeCheckpointWriter->flush();
+}
+
+xolotlCore::ObservableWeights createHeliumRetentionWeights(
+		IReactionNetwork& network) {
+
+	return xolotlCore::ObservableWeights( { network.getTotalAtomWeights(0),
+			network.getTotalAtomWeights(1), network.getTotalAtomWeights(2) });
+}
+
+xolotlCore::ObservableWeights createXenonRetentionWeights(
+		IReactionNetwork& network) {
+
+	// The bubbles are all the xenon clusters
+	std::vector<double> bubbleWeights(network.getDOF(), 0.0);
+	std::vector<double> radiusWeights(network.getDOF(), 0.0);
+	for (auto const& xeMapItem : network.getAll(ReactantType::Xe)) {
+		auto const& cluster = *(xeMapItem.second);
+		int id = cluster.getId() - 1;
+		bubbleWeights[id] += 1.0;
+		radiusWeights[id] += cluster.getReactionRadius();
+	}
+	for (auto const& superMapItem : network.getAll(ReactantType::NESuper)) {
+		auto const& cluster =
+				static_cast<NESuperCluster&>(*(superMapItem.second));
+		auto superWeights = cluster.getTotalWeights();
+		int id = cluster.getId() - 1;
+		int momId = cluster.getMomentId() - 1;
+		bubbleWeights[id] += superWeights[0];
+		bubbleWeights[momId] += superWeights[1];
+		radiusWeights[id] += superWeights[0] * cluster.getReactionRadius();
+		radiusWeights[momId] += superWeights[1] * cluster.getReactionRadius();
+	}
+
+	return xolotlCore::ObservableWeights( { network.getTotalAtomWeights(0),
+			bubbleWeights, radiusWeights });
+}
+
+xolotlCore::ObservableWeights createTRIDYNWeights(IReactionNetwork& network) {
+
+	return xolotlCore::ObservableWeights( { network.getTotalAtomWeights(0),
+			network.getTotalAtomWeights(1), network.getTotalAtomWeights(2),
+			network.getTotalVWeights(), network.getTotalIWeights() });
+}
+
+xolotlCore::ObservableWeights createSizeMomentWeights(
+		IReactionNetwork& network) {
+
+	std::vector<std::vector<double> > momentWeights;
+	for (int power = 0; power < xolotlCore::SizeStatistics::nMoments;
+			power++) {
+		momentWeights.push_back(network.getAtomMomentWeights(power));
+	}
+
+	return xolotlCore::ObservableWeights(momentWeights);
+}
+
 }
 /* end namespace xolotlSolver */
@@ -2,7 +2,12 @@
 #define XSOLVER_MONITOR_H
 
 // Includes
+#include <petscsys.h>
 #include <IReactionNetwork.h>
+#include <ObservableWeights.h>
+#include <SizeStatistics.h>
+#include "xolotlCore/io/CheckpointWriter.h"
+#include "xolotlCore/io/TextFileWriter.h"
 
 namespace xolotlSolver {
 
@@ -22,6 +27,169 @@ namespace xolotlSolver {
 void writeNetwork(MPI_Comm _comm, std::string srcFileName,
 		std::string targetFileName, IReactionNetwork& network);
 
+/**
+ * Create the writer used by the startStop monitors to write the
+ * checkpoint and analysis files, which it keeps open until it is destroyed.
+ * The writes are done in the background if the option
+ * -async_start_stop is used.
+ * It is meant to be the context of the startStop monitor.
+ *
+ * @param _comm The MPI communicator of the checkpoint files.
+ * @return The writer.
+ */
+xolotlCore::CheckpointWriter* createCheckpointWriter(MPI_Comm _comm);
+
+/**
+ * Destroy the checkpoint writer once the pending writes are done,
+ * closing the checkpoint files.
+ * It is meant to be given to TSMonitorSet as the monitor context
+ * destroy function.
+ *
+ * @param ctx The address of the writer.
+ * @return The PETSc error code.
+ */
+PetscErrorCode destroyCheckpointWriter(void **ctx);
+
+/**
+ * Wait until the checkpoint writer, if there is one, is done with the
+ * writes it runs in the background.  HDF5 is usually not built
+ * thread-safe, so it must be called before any HDF5 call done outside of
+ * the writer while the solver runs.
+ */
+void waitForCheckpointWriter(void);
+
+/**
+ * Start one of the time series written by the master process for the
+ * monitors (retentionOut, surface, bursting) from scratch, clearing its
+ * text file <name>.txt unless the time series file is used.  The text
+ * file then starts with the names of the columns if they are given, on a
+ * line starting with #.
+ *
+ * @param name The name of the series.
+ * @param columns The names of the columns to write in the text file.
+ */
+void clearTimeSeries(const std::string& name,
+		const std::vector<std::string>& columns = { });
+
+/**
+ * Append a row to one of the time series written by the master process,
+ * as a line of its text file <name>.txt or, if the option
+ * -time_series <file> is used, in that HDF5 file where the rows are
+ * buffered and appended every few rows, after waiting for the checkpoint
+ * writer.  xseries2txt converts this file back to the text files.
+ *
+ * @param name The name of the series.
+ * @param columns The names of the columns.
+ * @param row The values, one per column.
+ * @param writer The writer of the text file, NULL to write it right away.
+ */
+void appendTimeSeries(const std::string& name,
+		const std::vector<std::string>& columns,
+		const std::vector<double>& row,
+		xolotlCore::TextFileWriter* writer = NULL);
+
+/**
+ * Write the buffered rows of the time series and close their file.
+ * It must be called once the monitors are destroyed.
+ */
+void closeTimeSeries(void);
+
+/**
+ * Register the timers and event counters sampled by monitorTelemetry,
+ * which must all exist by then, and start the telemetry time series.
+ * It has to be called by every process.
+ */
+void startTelemetry(void);
+
+/**
+ * The formats of the TRIDYN depth profiles.
+ */
+enum class TRIDYNFormat {
+	//! TRIDYN_<timestep>.dat, one line of values separated by spaces per row
+	Text,
+	//! The dataset "concs" of TRIDYN_<timestep>.h5
+	HDF5,
+	//! TRIDYN_<timestep>.bin, raw doubles that can be memory-mapped
+	Binary
+};
+
+/**
+ * Obtain the format of the TRIDYN profiles: raw binary with the option
+ * -tridyn_binary, HDF5 with the option -tridyn_hdf5 or if it is the default
+ * of the caller, and text otherwise.  The options are read by the main
+ * thread, so it must be called before writeTRIDYNProfile is submitted to
+ * the checkpoint writer.
+ *
+ * @param hdf5ByDefault Whether the profile is written in HDF5 when no
+ * option is given (1D) instead of text (2D and 3D).
+ * @return The format.
+ */
+TRIDYNFormat getTRIDYNFormat(bool hdf5ByDefault);
+
+/**
+ * Write the TRIDYN depth profile of a time step, each process giving its
+ * own contiguous block of rows, possibly empty, the blocks following the
+ * order of the processes.  The HDF5 and binary files are written
+ * with a single collective write, the binary file starting with the number
+ * of rows and of columns as two 64-bit integers, followed by the rows as
+ * native doubles.  The text file is written by the master process.
+ * It must be called by all the processes of the communicator, while the
+ * checkpoint writer does not use HDF5 (see waitForCheckpointWriter).
+ *
+ * @param _comm The MPI communicator of the file.
+ * @param timestep The time step.
+ * @param format The format of the file.
+ * @param nRows The total number of rows.
+ * @param nColumns The number of values per row.
+ * @param firstRow The index of the first row of this process.
+ * @param rows The rows of this process, one after the other.
+ */
+void writeTRIDYNProfile(MPI_Comm _comm, PetscInt timestep,
+		TRIDYNFormat format, hsize_t nRows, hsize_t nColumns, hsize_t firstRow,
+		const std::vector<double>& rows);
+
+/**
+ * Create the weights of the helium, deuterium, and tritium contents
+ * computed by the helium retention monitors.
+ *
+ * @param network The network.
+ * @return The weights of the three contents.
+ */
+xolotlCore::ObservableWeights createHeliumRetentionWeights(
+		IReactionNetwork& network);
+
+/**
+ * Create the weights of the xenon content, the bubble concentration, and
+ * the bubble radii times their concentration computed by the xenon
+ * retention monitors.
+ *
+ * @param network The network.
+ * @return The weights of the three values.
+ */
+xolotlCore::ObservableWeights createXenonRetentionWeights(
+		IReactionNetwork& network);
+
+/**
+ * Create the weights of the helium, deuterium, tritium, vacancy, and
+ * interstitial contents written for TRIDYN.
+ *
+ * @param network The network.
+ * @return The weights of the five contents.
+ */
+xolotlCore::ObservableWeights createTRIDYNWeights(IReactionNetwork& network);
+
+/**
+ * Create the weights of the sums of the concentrations, sizes times
+ * concentrations, and sizes squared times concentrations of the clusters
+ * containing the first type of atoms (helium or xenon), from which
+ * xolotlCore::SizeStatistics derives the mean and variance of their size.
+ *
+ * @param network The network.
+ * @return The weights of the SizeStatistics::nMoments sums.
+ */
+xolotlCore::ObservableWeights createSizeMomentWeights(
+		IReactionNetwork& network);
+
 } // namespace xolotlSolver
 
 #endif // XSOLVER_MONITOR_H
@@ -23,6 +23,7 @@
 #include <FeClusterReactionNetwork.h>
 #include "xolotlCore/io/XFile.h"
 #include "xolotlSolver/monitor/Monitor.h"
+#include "xolotlSolver/monitor/MonitorSchedule.h"
 
 namespace xolotlSolver {
 
@@ -34,6 +35,8 @@ extern PetscErrorCode computeFluence(TS ts, PetscInt timestep, PetscReal time,
 		Vec solution, void *ictx);
 extern PetscErrorCode monitorPerf(TS ts, PetscInt timestep, PetscReal time,
 		Vec solution, void *ictx);
+extern PetscErrorCode monitorTelemetry(TS ts, PetscInt timestep,
+		PetscReal time, Vec solution, void *ictx);
 
 // Declaration of the variables defined in Monitor.cpp
 extern std::shared_ptr<xolotlViz::IPlot> perfPlot;
@@ -42,19 +45,25 @@ extern double timeStepThreshold;
 
 //! The pointer to the plot used in monitorScatter0D.
 std::shared_ptr<xolotlViz::IPlot> scatterPlot0D;
-//! How often HDF5 file is written
-PetscReal hdf5Stride0D = 0.0;
-//! Previous time for HDF5
-PetscInt hdf5Previous0D = 0;
 //! HDF5 output file name
 std::string hdf5OutputName0D = "xolotlStop.h5";
-// Declare the vector that will store the Id of the helium clusters
-std::vector<int> indices0D;
-// Declare the vector that will store the weight of the helium clusters
-// (their He composition)
-std::vector<int> weights0D;
-// Declare the vector that will store the radii of bubbles
-std::vector<double> radii0D;
+//! Number of time steps kept in the checkpoint file, all of them if not positive
+PetscInt nKeptTimeSteps0D = 0;
+//! Analysis file every checkpoint is appended to, none if empty
+std::string analysisName0D;
+//! Number of mantissa bits of the concentrations in the analysis file
+PetscInt analysisBits0D = 0;
+//! Whether the concentrations are written in the analysis file
+bool analysisConcs0D = true;
+//! Tolerance relative to the largest concentration under which
+//! a concentration is not written in the checkpoints
+PetscReal relTolerance0D = 0.0;
+//! Buffer reused to pack the concentrations of the checkpoints
+std::vector<int> packBuffer0D;
+//! The weights of the xenon content, bubble density, and bubble radii
+xolotlCore::ObservableWeights xeRetentionWeights0D;
+//! The weights of the sums from which the bubble size statistics are derived
+xolotlCore::ObservableWeights sizeMomentWeights0D;
 
 #undef __FUNCT__
 #define __FUNCT__ Actual__FUNCT__("xolotlSolver", "startStop0D")
@@ -62,25 +71,13 @@ std::vector<double> radii0D;
  * This is a monitoring method that update an hdf5 file at each time step.
  */
 PetscErrorCode startStop0D(TS ts, PetscInt timestep, PetscReal time,
-		Vec solution, void *) {
+		Vec solution, void *ictx) {
 	// Initial declaration
 	PetscErrorCode ierr;
-	const double **solutionArray, *gridPointSolution;
+	const double **solutionArray;
 
 	PetscFunctionBeginUser;
 
-	// Compute the dt
-	double dt = time - previousTime;
-
-	// Don't do anything if it is not on the stride
-	if (((int) ((time + dt / 10.0) / hdf5Stride0D) <= hdf5Previous0D)
-			&& timestep > 0)
-		PetscFunctionReturn(0);
-
-	// Update the previous time
-	if ((int) ((time + dt / 10.0) / hdf5Stride0D) > hdf5Previous0D)
-		hdf5Previous0D++;
-
 	// Get the da from ts
 	DM da;
 	ierr = TSGetDM(ts, &da);
@@ -97,49 +94,79 @@ PetscErrorCode startStop0D(TS ts, PetscInt timestep, PetscReal time,
 	auto& network = solverHandler.getNetwork();
 	const int dof = network.getDOF();
 
-	// Create an array for the concentration
-	double concArray[dof][2];
-
-	// Open the existing HDF5 file
-	xolotlCore::XFile checkpointFile(hdf5OutputName0D, PETSC_COMM_WORLD,
-			xolotlCore::XFile::AccessMode::OpenReadWrite);
-
 	// Get the current time step
 	double currentTimeStep;
 	ierr = TSGetTimeStep(ts, &currentTimeStep);
 	CHKERRQ(ierr);
 
-	// Add a concentration time step group for the current time step.
-	auto concGroup = checkpointFile.getGroup<
-			xolotlCore::XFile::ConcentrationGroup>();
-	assert(concGroup);
-	auto tsGroup = concGroup->addTimestepGroup(timestep, time, previousTime,
-			currentTimeStep);
-
-	// Determine the concentration values we will write.
-	// We only examine and collect the grid points we own.
-	// TODO measure impact of us building the flattened representation
-	// rather than a ragged 2D representation.
-	XFile::TimestepGroup::Concs1DType concs(1);
-
-	// Access the solution data for the current grid point.
-	gridPointSolution = solutionArray[0];
-
-	for (auto l = 0; l < dof; ++l) {
-		if (std::fabs(gridPointSolution[l]) > 1.0e-16) {
-			concs[0].emplace_back(l, gridPointSolution[l]);
-		}
-	}
-
-	// Write our concentration data to the current timestep group
-	// in the HDF5 file.
-	// We only write the data for the grid points we own.
-	tsGroup->writeConcentrations(checkpointFile, 0, concs);
+	// Take a snapshot of the concentration values we will write.
+	auto concs = std::make_shared<XFile::TimestepGroup::Concs1DType>(
+			XFile::TimestepGroup::packConcentrations(solutionArray[0], 1, dof,
+					relTolerance0D, packBuffer0D, PETSC_COMM_WORLD));
 
 	// Restore the solutionArray
 	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
 
+	// Copy everything else the writer needs
+	auto prevTime = previousTime;
+	auto compression = solverHandler.getCheckpointCompression();
+	auto checkpointName = hdf5OutputName0D;
+	auto nKept = nKeptTimeSteps0D;
+	auto analysisName = analysisName0D;
+	auto analysisCompression = solverHandler.getAnalysisCompression();
+	if (analysisBits0D > 0)
+		analysisCompression.lossyBits = analysisBits0D;
+	bool analysisConcs = analysisConcs0D;
+
+	// Write the snapshot to the checkpoint file
+	auto checkpointWriter = (xolotlCore::CheckpointWriter *) ictx;
+	checkpointWriter->submit(
+			[=](MPI_Comm comm) {
+				// Add a concentration time step group for the current time step
+				// to the given file, with everything but the concentrations
+				auto addTimestepGroup = [&](xolotlCore::XFile& file)
+				-> std::unique_ptr<xolotlCore::XFile::TimestepGroup> {
+					auto concGroup = file.getGroup<
+					xolotlCore::XFile::ConcentrationGroup>();
+					assert(concGroup);
+					auto tsGroup = concGroup->addTimestepGroup(timestep, time,
+							prevTime, currentTimeStep);
+					return tsGroup;
+				};
+
+				// Use the checkpoint file the writer keeps open
+				auto& checkpointFile = checkpointWriter->getFile(comm,
+						checkpointName);
+				checkpointFile.setCompression(compression);
+				auto tsGroup = addTimestepGroup(checkpointFile);
+
+				// Write our concentration data to the current timestep group
+				// in the HDF5 file.
+				tsGroup->writeConcentrations(checkpointFile, 0, *concs);
+
+				// Make sure the checkpoint is on the disk
+				checkpointFile.flush();
+
+				// Only then forget the oldest time steps, the file being
+				// compacted from time to time
+				if (nKept > 0)
+					checkpointWriter->removeOldTimestepGroups(comm, checkpointName,
+							nKept);
+
+				// Append the time step to the analysis file
+				if (!analysisName.empty()) {
+					auto& analysisFile = checkpointWriter->getFile(comm,
+							analysisName);
+					analysisFile.setCompression(analysisCompression);
+					auto analysisTsGroup = addTimestepGroup(analysisFile);
+					if (analysisConcs)
+						analysisTsGroup->writeConcentrations(analysisFile,
+							0, *concs);
+					analysisFile.flush();
+				}
+			});
+
 	PetscFunctionReturn(0);
 }
 
@@ -166,43 +193,23 @@ PetscErrorCode computeXenonRetention0D(TS ts, PetscInt, PetscReal time,
 	ierr = TSGetDM(ts, &da);
 	CHKERRQ(ierr);
 
-	// Get the network
-	auto& network = solverHandler.getNetwork();
-
 	// Get the array of concentration
 	PetscReal **solutionArray;
 	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
 
-	// Store the concentration and other values over the grid
-	double xeConcentration = 0.0, bubbleConcentration = 0.0, radii = 0.0;
-
 	// Declare the pointer for the concentrations at a specific grid point
 	PetscReal *gridPointSolution;
 
 	// Get the pointer to the beginning of the solution data for this grid point
 	gridPointSolution = solutionArray[0];
 
-	// Update the concentration in the network
-	network.updateConcentrationsFromArray(gridPointSolution);
-
-	// Loop on all the indices
-	for (unsigned int i = 0; i < indices0D.size(); i++) {
-		// Add the current concentration times the number of xenon in the cluster
-		// (from the weight vector)
-		xeConcentration += gridPointSolution[indices0D[i]] * weights0D[i];
-		bubbleConcentration += gridPointSolution[indices0D[i]];
-		radii += gridPointSolution[indices0D[i]] * radii0D[i];
-	}
-
-	// Loop on all the super clusters
-	for (auto const& superMapItem : network.getAll(ReactantType::NESuper)) {
-		auto const& cluster =
-				static_cast<NESuperCluster&>(*(superMapItem.second));
-		xeConcentration += cluster.getTotalXenonConcentration();
-		bubbleConcentration += cluster.getTotalConcentration();
-		radii += cluster.getTotalConcentration() * cluster.getReactionRadius();
-	}
+	// Compute the xenon concentration, bubble concentration, and radii
+	std::array<double, 3> concData { };
+	xeRetentionWeights0D.accumulate(gridPointSolution, 1.0, concData.data());
+	double xeConcentration = concData[0];
+	double bubbleConcentration = concData[1];
+	double radii = concData[2];
 
 	// Get the fluence
 	double fluence = fluxHandler->getFluence();
@@ -215,12 +222,10 @@ PetscErrorCode computeXenonRetention0D(TS ts, PetscInt, PetscReal time,
 			<< std::endl;
 
 	// Uncomment to write the retention and the fluence in a file
-	std::ofstream outputFile;
-	outputFile.open("retentionOut.txt", ios::app);
-	outputFile << time << " " << 100.0 * (xeConcentration / fluence) << " "
-			<< xeConcentration << " " << fluence - xeConcentration << " "
-			<< radii / bubbleConcentration << std::endl;
-	outputFile.close();
+	appendTimeSeries("retentionOut",
+			{ "time", "retention", "xenon", "xenonReleased", "meanRadius" },
+			{ time, 100.0 * (xeConcentration / fluence), xeConcentration,
+					fluence - xeConcentration, radii / bubbleConcentration });
 
 	// Restore the solutionArray
 	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
@@ -243,10 +248,6 @@ PetscErrorCode monitorScatter0D(TS ts, PetscInt timestep, PetscReal time,
 
 	PetscFunctionBeginUser;
 
-	// Don't do anything if it is not on the stride
-	if (timestep % 10 != 0)
-		PetscFunctionReturn(0);
-
 	// Get the da from ts
 	DM da;
 	ierr = TSGetDM(ts, &da);
@@ -345,7 +346,8 @@ PetscErrorCode monitorScatter0D(TS ts, PetscInt timestep, PetscReal time,
 #define __FUNCT__ Actual__FUNCT__("xolotlSolver", "monitorBubble0D")
 /**
  * This is a monitoring method that will create files with the mean
- * concentration of each bubble at each time step.
+ * concentration of each bubble at each time step, and append the
+ * statistics of their size to the sizeStatistics time series.
  */
 PetscErrorCode monitorBubble0D(TS ts, PetscInt timestep, PetscReal time,
 		Vec solution, void *ictx) {
@@ -373,7 +375,6 @@ PetscErrorCode monitorBubble0D(TS ts, PetscInt timestep, PetscReal time,
 
 	// Get the network
 	auto& network = solverHandler.getNetwork();
-	int dof = network.getDOF();
 
 	// Create the output file
 	std::ofstream outputFile;
@@ -384,12 +385,6 @@ PetscErrorCode monitorBubble0D(TS ts, PetscInt timestep, PetscReal time,
 	// Get the pointer to the beginning of the solution data for this grid point
 	gridPointSolution = solutionArray[0];
 
-	// Update the concentration in the network
-	network.updateConcentrationsFromArray(gridPointSolution);
-
-	// Initialize the total helium and concentration before looping
-	double concTot = 0.0, heliumTot = 0.0;
-
 	// Consider each super cluster.
 	for (auto const& superMapItem : network.getAll(ReactantType::FeSuper)) {
 		// Get the super cluster
@@ -398,10 +393,8 @@ PetscErrorCode monitorBubble0D(TS ts, PetscInt timestep, PetscReal time,
 		// Get its boundaries
 		auto const& heBounds = superCluster.getHeBounds();
 		auto const& vBounds = superCluster.getVBounds();
-		// Get its diameter
-		double diam = 2.0 * superCluster.getReactionRadius();
-		// Get its concentration
-		double conc = superCluster.getConcentration(0.0, 0.0);
+		// Get its mean concentration, its zeroth moment
+		double conc = gridPointSolution[superCluster.getId() - 1];
 
 		// For compatibility with previous versions, we output
 		// the value of a closed upper bound of the He and V intervals.
@@ -413,6 +406,16 @@ PetscErrorCode monitorBubble0D(TS ts, PetscInt timestep, PetscReal time,
 	// Close the file
 	outputFile.close();
 
+	// Compute the statistics of the bubble size from the solution directly
+	std::array<double, xolotlCore::SizeStatistics::nMoments> moments { };
+	sizeMomentWeights0D.accumulate(gridPointSolution, 1.0, moments.data());
+	xolotlCore::SizeStatistics stats;
+	stats.add(moments.data());
+	appendTimeSeries("sizeStatistics",
+			{ "time", "concentration", "meanSize", "variance", "maxMeanSize" },
+			{ time, stats.getConcentration(), stats.getMean(),
+					stats.getVariance(), stats.getMaxMean() });
+
 	// Restore the solutionArray
 	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
@@ -434,7 +437,7 @@ PetscErrorCode setupPetsc0DMonitor(TS ts) {
 
 	// Flags to launch the monitors or not
 	PetscBool flagCheck, flag1DPlot, flagBubble, flagPerf, flagStatus,
-			flagXeRetention;
+			flagXeRetention, flagTelemetry;
 
 	// Check the option -check_collapse
 	ierr = PetscOptionsHasName(NULL, NULL, "-check_collapse", &flagCheck);
@@ -446,6 +449,11 @@ PetscErrorCode setupPetsc0DMonitor(TS ts) {
 	checkPetscError(ierr,
 			"setupPetsc0DMonitor: PetscOptionsHasName (-plot_perf) failed.");
 
+	// Check the option -telemetry
+	ierr = PetscOptionsHasName(NULL, NULL, "-telemetry", &flagTelemetry);
+	checkPetscError(ierr,
+			"setupPetsc0DMonitor: PetscOptionsHasName (-telemetry) failed.");
+
 	// Check the option -plot_1d
 	ierr = PetscOptionsHasName(NULL, NULL, "-plot_1d", &flag1DPlot);
 	checkPetscError(ierr,
@@ -510,23 +518,53 @@ PetscErrorCode setupPetsc0DMonitor(TS ts) {
 	// Set the monitor to save the status of the simulation in hdf5 file
 	if (flagStatus) {
 		// Find the stride to know how often the HDF5 file has to be written
+		PetscReal hdf5Stride = 0.0;
 		PetscBool flag;
-		ierr = PetscOptionsGetReal(NULL, NULL, "-start_stop", &hdf5Stride0D,
+		ierr = PetscOptionsGetReal(NULL, NULL, "-start_stop", &hdf5Stride,
 				&flag);
 		checkPetscError(ierr,
 				"setupPetsc0DMonitor: PetscOptionsGetInt (-start_stop) failed.");
 		if (!flag)
-			hdf5Stride0D = 1.0;
+			hdf5Stride = 1.0;
+
+		// Find how many time steps are kept in the checkpoint file
+		ierr = PetscOptionsGetInt(NULL, NULL, "-start_stop_keep",
+				&nKeptTimeSteps0D, NULL);
+		checkPetscError(ierr,
+				"setupPetsc0DMonitor: PetscOptionsGetInt (-start_stop_keep) failed.");
+
+		// Find the analysis file and what is written in it
+		char analysisName[PETSC_MAX_PATH_LEN];
+		PetscBool flagAnalysis, flagNoConcs;
+		ierr = PetscOptionsGetString(NULL, NULL, "-start_stop_analysis",
+				analysisName, PETSC_MAX_PATH_LEN, &flagAnalysis);
+		checkPetscError(ierr,
+				"setupPetsc0DMonitor: PetscOptionsGetString (-start_stop_analysis) failed.");
+		if (flagAnalysis)
+			analysisName0D = analysisName;
+		ierr = PetscOptionsGetInt(NULL, NULL, "-start_stop_analysis_bits",
+				&analysisBits0D, NULL);
+		checkPetscError(ierr,
+				"setupPetsc0DMonitor: PetscOptionsGetInt (-start_stop_analysis_bits) failed.");
+		ierr = PetscOptionsHasName(NULL, NULL, "-start_stop_analysis_no_concs",
+				&flagNoConcs);
+		checkPetscError(ierr,
+				"setupPetsc0DMonitor: PetscOptionsHasName (-start_stop_analysis_no_concs) failed.");
+		analysisConcs0D = !flagNoConcs;
 
-		// Compute the correct hdf5Previous0D for a restart
-		// Get the last time step written in the HDF5 file
+		// Find the relative tolerance of the concentrations to write
+		ierr = PetscOptionsGetReal(NULL, NULL, "-start_stop_rel_tol",
+				&relTolerance0D, NULL);
+		checkPetscError(ierr,
+				"setupPetsc0DMonitor: PetscOptionsGetReal (-start_stop_rel_tol) failed.");
+
+		// Get the previous time if concentrations were stored
 		if (hasConcentrations) {
 
 			assert(lastTsGroup);
 
 			// Get the previous time from the HDF5 file
 			previousTime = lastTsGroup->readPreviousTime();
-			hdf5Previous0D = (int) (previousTime / hdf5Stride0D);
 		}
 
 		// Don't do anything if both files have the same name
@@ -578,10 +616,19 @@ PetscErrorCode setupPetsc0DMonitor(TS ts) {
 					hdf5OutputName0D, network);
 		}
 
-		// startStop0D will be called at each timestep
-		ierr = TSMonitorSet(ts, startStop0D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc0DMonitor: TSMonitorSet (startStop0D) failed.");
+		// Create the analysis file, it does not need the network
+		// as it is not meant to restart from
+		if (!analysisName0D.empty()) {
+			xolotlCore::XFile analysisFile(analysisName0D,
+					solverHandler.getXGrid(), network.getCompositionList(),
+					PETSC_COMM_WORLD);
+		}
+
+		// startStop0D will be called on the stride
+		setScheduledMonitor(ts, "start_stop", startStop0D,
+				createCheckpointWriter(PETSC_COMM_WORLD),
+				destroyCheckpointWriter,
+				MonitorSchedule(MonitorSchedule::Cadence::Time, hdf5Stride));
 	}
 
 	// Set the monitor to save 1D plot of xenon distribution
@@ -608,10 +655,9 @@ PetscErrorCode setupPetsc0DMonitor(TS ts) {
 		// Give it to the plot
 		scatterPlot0D->setDataProvider(dataProvider);
 
-		// monitorScatter0D will be called at each timestep
-		ierr = TSMonitorSet(ts, monitorScatter0D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc0DMonitor: TSMonitorSet (monitorScatter0D) failed.");
+		// monitorScatter0D will be called on its schedule
+		setScheduledMonitor(ts, "plot_1d", monitorScatter0D, NULL, NULL,
+				MonitorSchedule(MonitorSchedule::Cadence::Steps, 10));
 	}
 
 	// Set the monitor to save performance plots (has to be in parallel)
@@ -636,34 +682,25 @@ PetscErrorCode setupPetsc0DMonitor(TS ts) {
 		// Give it to the plot
 		perfPlot->setDataProvider(dataProvider);
 
-		// monitorPerf will be called at each timestep
-		ierr = TSMonitorSet(ts, monitorPerf, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc0DMonitor: TSMonitorSet (monitorPerf) failed.");
+		// monitorPerf will be called on its schedule
+		setScheduledMonitor(ts, "plot_perf", monitorPerf, NULL, NULL);
 	}
 
 	// Set the monitor to save text file of the mean concentration of bubbles
 	if (flagBubble) {
-		// monitorBubble0D will be called at each timestep
-		ierr = TSMonitorSet(ts, monitorBubble0D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc0DMonitor: TSMonitorSet (monitorBubble0D) failed.");
+		// Compute the size statistics from the solution directly
+		sizeMomentWeights0D = createSizeMomentWeights(network);
+		clearTimeSeries("sizeStatistics");
+
+		// monitorBubble0D will be called on its schedule
+		setScheduledMonitor(ts, "bubble", monitorBubble0D, NULL, NULL);
 	}
 
 	// Set the monitor to compute the xenon fluence and the retention
 	// for the retention calculation
 	if (flagXeRetention) {
-		// Loop on the xenon clusters
-		for (auto const& xeMapItem : network.getAll(ReactantType::Xe)) {
-			auto const& cluster = *(xeMapItem.second);
-
-			int id = cluster.getId() - 1;
-			// Add the Id to the vector
-			indices0D.push_back(id);
-			// Add the number of xenon of this cluster to the weight
-			weights0D.push_back(cluster.getSize());
-			radii0D.push_back(cluster.getReactionRadius());
-		}
+		// Compute the retention from the solution directly
+		xeRetentionWeights0D = createXenonRetentionWeights(network);
 
 		// Get the previous time if concentrations were stored and initialize the fluence
 		if (hasConcentrations) {
@@ -688,15 +725,22 @@ PetscErrorCode setupPetsc0DMonitor(TS ts) {
 		checkPetscError(ierr,
 				"setupPetsc0DMonitor: TSMonitorSet (computeFluence) failed.");
 
-		// computeXenonRetention0D will be called at each timestep
-		ierr = TSMonitorSet(ts, computeXenonRetention0D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc0DMonitor: TSMonitorSet (computeXenonRetention0D) failed.");
+		// computeXenonRetention0D will be called on its schedule
+		setScheduledMonitor(ts, "xenon_retention", computeXenonRetention0D,
+				NULL, NULL);
 
 		// Uncomment to clear the file where the retention will be written
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt");
-		outputFile.close();
+		clearTimeSeries("retentionOut");
+	}
+
+	// Set the monitor to write what the solver did since the previous sample
+	if (flagTelemetry) {
+		// Register what is sampled and clear the file where the
+		// telemetry will be written
+		startTelemetry();
+
+		// monitorTelemetry will be called at each timestep by default
+		setScheduledMonitor(ts, "telemetry", monitorTelemetry, NULL, NULL);
 	}
 
 	// Set the monitor to simply change the previous time to the new time
@@ -6,6 +6,7 @@
 #include <CvsXDataProvider.h>
 #include <CvsXYDataProvider.h>
 #include <LabelProvider.h>
+#include <PointReduction.h>
 #include <Constants.h>
 #include <petscts.h>
 #include <petscsys.h>
@@ -15,6 +16,7 @@
 #include <iomanip>
 #include <vector>
 #include <memory>
+#include <algorithm>
 #include <NESuperCluster.h>
 #include <PSISuperCluster.h>
 #include <FeSuperCluster.h>
@@ -25,6 +27,8 @@
 #include "RandomNumberGenerator.h"
 #include "xolotlCore/io/XFile.h"
 #include "xolotlSolver/monitor/Monitor.h"
+#include "xolotlSolver/monitor/MonitorSweep.h"
+#include "xolotlSolver/monitor/MonitorSchedule.h"
 
 namespace xperf = xolotlPerf;
 
@@ -38,6 +42,8 @@ extern PetscErrorCode computeFluence(TS ts, PetscInt timestep, PetscReal time,
 		Vec solution, void *ictx);
 extern PetscErrorCode monitorPerf(TS ts, PetscInt timestep, PetscReal time,
 		Vec solution, void *ictx);
+extern PetscErrorCode monitorTelemetry(TS ts, PetscInt timestep,
+		PetscReal time, Vec solution, void *ictx);
 
 // Declaration of the variables defined in Monitor.cpp
 extern std::shared_ptr<xolotlViz::IPlot> perfPlot;
@@ -50,6 +56,15 @@ std::shared_ptr<xolotlViz::IPlot> scatterPlot1D;
 std::shared_ptr<xolotlViz::IPlot> seriesPlot1D;
 //! The pointer to the 2D plot used in MonitorSurface.
 std::shared_ptr<xolotlViz::IPlot> surfacePlot1D;
+//! The number of bins per decade of size of the plot of monitorScatter1D,
+//! 0 to plot every cluster.
+PetscInt vizLogBins1D = 0;
+//! The largest number of points of each cluster in the plot of
+//! monitorSeries1D, 0 to plot every grid point.
+PetscInt vizMaxPoints1D = 0;
+//! The number of cells merged in each direction in the plot of
+//! monitorSurface1D.
+PetscInt vizCoarsen1D = 1;
 //! The variable to store the interstitial flux at the previous time step.
 double previousIFlux1D = 0.0;
 //! The variable to store the total number of interstitials going through the surface.
@@ -58,6 +73,11 @@ double nInterstitial1D = 0.0;
 double previousHeFlux1D = 0.0;
 //! The variable to store the total number of helium going through the bottom.
 double nHelium1D = 0.0;
+//! The time the helium, deuterium, and tritium fluxes at the bottom were
+//! computed at.
+double bottomFluxTime1D = 0.0;
+//! The sweep computing the retention, NULL if it isn't monitored.
+MonitorSweep *sweep1D = NULL;
 //! The variable to store the xenon flux at the previous time step.
 double previousXeFlux1D = 0.0;
 //! The variable to store the total number of xenon going through the GB.
@@ -72,23 +92,49 @@ double previousTFlux1D = 0.0;
 double nTritium1D = 0.0;
 //! The variable to store the sputtering yield at the surface.
 double sputteringYield1D = 0.0;
-//! How often HDF5 file is written
-PetscReal hdf5Stride1D = 0.0;
-//! Previous time for HDF5
-PetscInt hdf5Previous1D = 0;
-//! How often negative concentrations are checked
-PetscReal negStride1D = 0.0;
-//! Previous time for negative concentration
-PetscInt negPrevious1D = 0;
 //! HDF5 output file name
 std::string hdf5OutputName1D = "xolotlStop.h5";
+//! How often a full checkpoint (keyframe) is written, the ones
+//! in between only having the changes since the last keyframe
+PetscInt keyframeStride1D = 1;
+//! Relative change under which a concentration is not written in a delta
+PetscReal deltaTolerance1D = 0.0;
+//! Number of delta checkpoints written since the last keyframe
+PetscInt nDeltas1D = 0;
+//! Time step of the last keyframe
+PetscInt keyframeTimeStep1D = -1;
+//! Concentrations written in the last keyframe
+std::shared_ptr<XFile::TimestepGroup::Concs1DType> keyframeConcs1D;
+//! Number of time steps kept in the checkpoint file, all of them if not positive
+PetscInt nKeptTimeSteps1D = 0;
+//! The grid to write in the header of the checkpoint file restarted from,
+//! empty if its header already has the grid of the solver
+std::vector<double> headerGrid1D;
+//! Analysis file every checkpoint is appended to, none if empty
+std::string analysisName1D;
+//! Number of mantissa bits of the concentrations in the analysis file
+PetscInt analysisBits1D = 0;
+//! Whether the concentrations are written in the analysis file
+bool analysisConcs1D = true;
+//! Tolerance relative to the largest concentration under which
+//! a concentration is not written in the checkpoints
+PetscReal relTolerance1D = 0.0;
+//! Buffer reused to pack the concentrations of the checkpoints
+std::vector<int> packBuffer1D;
 // Declare the vector that will store the Id of the helium clusters
 std::vector<int> indices1D;
 // Declare the vector that will store the weight of the helium clusters
 // (their He composition)
 std::vector<int> weights1D;
-// Declare the vector that will store the radii of bubbles
-std::vector<double> radii1D;
+//! The weights of the helium, deuterium, and tritium contents
+xolotlCore::ObservableWeights heRetentionWeights1D;
+//! The weights of the xenon content, bubble density, and bubble radii
+xolotlCore::ObservableWeights xeRetentionWeights1D;
+//! The weights of the helium, deuterium, tritium, vacancy, and
+//! interstitial contents written for TRIDYN
+xolotlCore::ObservableWeights tridynWeights1D;
+//! The weights of the sums from which the bubble size statistics are derived
+xolotlCore::ObservableWeights sizeMomentWeights1D;
 // Variable to indicate whether or not the fact that the concentration of the biggest
 // cluster in the network is higher than 1.0e-16 should be printed.
 // Becomes false once it is printed.
@@ -98,113 +144,106 @@ std::vector<int> depthPositions1D;
 
 // Timers
 std::shared_ptr<xperf::ITimer> initTimer;
-std::shared_ptr<xperf::ITimer> checkNegativeTimer;
 std::shared_ptr<xperf::ITimer> tridynTimer;
 std::shared_ptr<xperf::ITimer> startStopTimer;
-std::shared_ptr<xperf::ITimer> heRetentionTimer;
-std::shared_ptr<xperf::ITimer> xeRetentionTimer;
-std::shared_ptr<xperf::ITimer> heConcTimer;
-std::shared_ptr<xperf::ITimer> cumHeTimer;
+std::shared_ptr<xperf::ITimer> sweepTimer;
 std::shared_ptr<xperf::ITimer> scatterTimer;
 std::shared_ptr<xperf::ITimer> seriesTimer;
 std::shared_ptr<xperf::ITimer> surfaceTimer;
-std::shared_ptr<xperf::ITimer> meanSizeTimer;
-std::shared_ptr<xperf::ITimer> maxClusterConcTimer;
 std::shared_ptr<xperf::ITimer> eventFuncTimer;
 std::shared_ptr<xperf::ITimer> postEventFuncTimer;
+//! Counters for the bursting depths and the surface moves, for the telemetry
+std::shared_ptr<xperf::IEventCounter> burstingCounter;
+std::shared_ptr<xperf::IEventCounter> surfaceMoveCounter;
 
-#undef __FUNCT__
-#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "checkNegative1D")
 /**
- * This is a monitoring method that looks at if there are negative concentrations at each time step.
+ * The check of the negative concentrations done by the monitor sweep.
+ * Each process stops scanning its grid points at the first negative
+ * concentration it finds, which it prints, and only sends a flag so the
+ * master process tells how many processes found one.
  */
-PetscErrorCode checkNegative1D(TS ts, PetscInt timestep, PetscReal time,
-		Vec solution, void *) {
-
-	xperf::ScopedTimer myTimer(checkNegativeTimer);
-
-	// Initial declaration
-	PetscErrorCode ierr;
-	const double **solutionArray, *gridPointSolution;
-	PetscInt xs, xm, Mx;
-
-	PetscFunctionBeginUser;
-
-	// Compute the dt
-	double dt = time - previousTime;
-
-	// Don't do anything if it is not on the stride
-	if ((int) ((time + dt / 10.0) / negStride1D) <= negPrevious1D
-			&& negStride1D > 0.0)
-		PetscFunctionReturn(0);
-
-	// Update the previous time
-	negPrevious1D++;
-
-	// Get the number of processes
-	int worldSize;
-	MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
+class NegativeCheck1D: public SweepObservable {
+private:
+	//! The number of clusters.
+	int nClusters;
+
+	//! Whether a negative concentration was found during this sweep.
+	bool found;
+
+public:
+	//! The concentration under which it is considered negative.
+	static constexpr double threshold = -1.0e-14;
+
+	//! The number of concentrations compared before checking the result.
+	static constexpr int blockSize = 32;
+
+	/**
+	 * The constructor.
+	 *
+	 * @param network The network
+	 */
+	NegativeCheck1D(IReactionNetwork& network) :
+			nClusters(network.size()), found(false) {
+	}
 
-	// Gets the process ID (important when it is running in parallel)
-	int procId;
-	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+	int start(PetscInt, PetscInt, PetscInt) override {
+		found = false;
+		return 1;
+	}
 
-	// Get the da from ts
-	DM da;
-	ierr = TSGetDM(ts, &da);
-	CHKERRQ(ierr);
+	void accumulate(PetscInt xi, const double* concs, double* values)
+			override {
+		// Nothing else to look for once one is found
+		if (found)
+			return;
+
+		for (int first = 0; first < nClusters; first += blockSize) {
+			int last = std::min(first + blockSize, nClusters);
+			// Count without branching so that the comparisons are vectorized
+			int nNegative = 0;
+			for (int l = first; l < last; l++) {
+				nNegative += (concs[l] < threshold);
+			}
+			if (nNegative == 0)
+				continue;
 
-	// Get the solutionArray
-	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
+			// Print the first one of the block
+			int l = first;
+			while (concs[l] >= threshold)
+				l++;
+			std::cout << "Negative concentration: " << concs[l] << " at xi: "
+					<< xi << ", cluster ID: " << l + 1 << std::endl;
+			values[0] = 1.0;
+			found = true;
+			return;
+		}
+	}
 
-	// Get the corners of the grid
-	ierr = DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL);
-	CHKERRQ(ierr);
-	// Get the size of the total grid
-	ierr = DMDAGetInfo(da, PETSC_IGNORE, &Mx, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE);
-	CHKERRQ(ierr);
+	PetscErrorCode finish(PetscInt timestep, PetscReal time,
+			const double* sums, xolotlCore::TextFileWriter&) override {
+		PetscFunctionBeginUser;
 
-	// Get the solver handler
-	auto& solverHandler = PetscSolver::getSolverHandler();
+		// Get the current process ID
+		int procId;
+		MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
 
-	// Get the network and dof
-	auto& network = solverHandler.getNetwork();
-	const int nClusters = network.size();
-
-	// Loop on the full grid
-	for (PetscInt i = 0; i < Mx; i++) {
-
-		// If it is the locally owned part of the grid
-		if (i >= xs && i < xs + xm) {
-			// Get the pointer to the beginning of the solution data for this grid point
-			gridPointSolution = solutionArray[i];
-
-			// Loop on the concentrations
-			for (int l = 0; l < nClusters; l++) {
-				if (gridPointSolution[l] < -1.0e-14) {
-					std::cout << "Negative concentration: "
-							<< gridPointSolution[l] << " at xi: " << i
-							<< ", cluster ID: " << l + 1 << std::endl;
-				}
-			}
+		// Main process
+		if (procId == 0 && sums[0] > 0.0) {
+			std::cout << "At time step: " << timestep << " and time: " << time
+					<< " negative concentrations were found on " << sums[0]
+					<< " process(es)." << std::endl;
 		}
-	}
-
-	// Restore the solutionArray
-	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
 
-	PetscFunctionReturn(0);
-}
+		PetscFunctionReturn(0);
+	}
+};
 
 #undef __FUNCT__
 #define __FUNCT__ Actual__FUNCT__("xolotlSolver", "computeTRIDYN1D")
 /**
- * This is a monitoring method that will compute the data to send to TRIDYN
+ * This is a monitoring method that will compute the data to send to TRIDYN.
+ * The profile is written by the checkpoint writer given as context if any,
+ * since HDF5 must not be used while it writes.
  */
 PetscErrorCode computeTRIDYN1D(TS ts, PetscInt timestep, PetscReal time,
 		Vec solution, void *ictx) {
@@ -260,67 +299,55 @@ PetscErrorCode computeTRIDYN1D(TS ts, PetscInt timestep, PetscReal time,
 	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
 
-	// Save current concentrations as an HDF5 file.
-	//
-	// First create the file for parallel file access.
-	std::ostringstream tdFileStr;
-	tdFileStr << "TRIDYN_" << timestep << ".h5";
-	xolotlCore::HDF5File tdFile(tdFileStr.str(),
-			xolotlCore::HDF5File::AccessMode::CreateOrTruncateIfExists,
-			PETSC_COMM_WORLD, true);
-
-	// Define a dataset for concentrations.
-	// Everyone must create the dataset with the same shape.
+	// Only the grid points right of the surface are written, each process
+	// writing its own ones
 	constexpr auto numConcSpecies = 5;
 	constexpr auto numValsPerGridpoint = numConcSpecies + 2;
 	const auto firstIdxToWrite = (surfacePos + 1);
 	const auto numGridpointsWithConcs = (Mx - firstIdxToWrite);
-	xolotlCore::HDF5File::SimpleDataSpace<2>::Dimensions concsDsetDims = {
-			(hsize_t) numGridpointsWithConcs, numValsPerGridpoint };
-	xolotlCore::HDF5File::SimpleDataSpace<2> concsDsetSpace(concsDsetDims);
-
-	const std::string concsDsetName = "concs";
-	xolotlCore::HDF5File::DataSet<double> concsDset(tdFile, concsDsetName,
-			concsDsetSpace);
-
-	// Specify the concentrations we will write.
-	// We only consider our own grid points.
 	const auto myFirstIdxToWrite = std::max(xs, firstIdxToWrite);
 	auto myEndIdx = (xs + xm);  // "end" in the C++ sense; i.e., one-past-last
 	auto myNumPointsToWrite =
 			(myEndIdx > myFirstIdxToWrite) ? (myEndIdx - myFirstIdxToWrite) : 0;
-	xolotlCore::HDF5File::DataSet<double>::DataType2D<numValsPerGridpoint> myConcs(
-			myNumPointsToWrite);
+	std::vector<double> myConcs(myNumPointsToWrite * numValsPerGridpoint, 0.0);
 
 	for (auto xi = myFirstIdxToWrite; xi < myEndIdx; ++xi) {
 
-		if (xi >= firstIdxToWrite) {
-
-			// Determine current gridpoint value.
-			double x = grid[xi + 1] - grid[1];
-
-			// Access the solution data for this grid point.
-			auto gridPointSolution = solutionArray[xi];
+		// Determine current gridpoint value.
+		double x = grid[xi + 1] - grid[1];
 
-			// Update the concentration in the network
-			network.updateConcentrationsFromArray(gridPointSolution);
+		// Access the solution data for this grid point.
+		auto gridPointSolution = solutionArray[xi];
 
-			// Get the total concentrations at this grid point
-			auto currIdx = xi - myFirstIdxToWrite;
-			myConcs[currIdx][0] = (x - (grid[surfacePos + 1] - grid[1]));
-			myConcs[currIdx][1] = network.getTotalAtomConcentration(0);
-			myConcs[currIdx][2] = network.getTotalAtomConcentration(1);
-			myConcs[currIdx][3] = network.getTotalAtomConcentration(2);
-			myConcs[currIdx][4] = network.getTotalVConcentration();
-			myConcs[currIdx][5] = network.getTotalIConcentration();
-			myConcs[currIdx][6] = gridPointSolution[dof - 1];
-		}
+		// Get the total concentrations at this grid point
+		auto currConcs = &myConcs[(xi - myFirstIdxToWrite)
+				* numValsPerGridpoint];
+		currConcs[0] = (x - (grid[surfacePos + 1] - grid[1]));
+		tridynWeights1D.accumulate(gridPointSolution, 1.0, &currConcs[1]);
+		currConcs[6] = gridPointSolution[dof - 1];
 	}
 
-	// Write the concs dataset in parallel.
-	// (We write only our part.)
-	concsDset.parWrite2D<numValsPerGridpoint>(PETSC_COMM_WORLD,
-			myFirstIdxToWrite - firstIdxToWrite, myConcs);
+	// Write our part of the profile
+	hsize_t myFirstRow =
+			(myNumPointsToWrite > 0) ? myFirstIdxToWrite - firstIdxToWrite : 0;
+	auto format = getTRIDYNFormat(true);
+	auto checkpointWriter = (xolotlCore::CheckpointWriter *) ictx;
+	if (checkpointWriter) {
+		// With the checkpoint it was given, on the writer's thread
+		checkpointWriter->submit(
+				[=](MPI_Comm comm) {
+					writeTRIDYNProfile(comm, timestep, format,
+							numGridpointsWithConcs, numValsPerGridpoint,
+							myFirstRow, myConcs);
+				});
+	} else {
+		// Once the checkpoint writer is done with HDF5
+		if (format == TRIDYNFormat::HDF5)
+			waitForCheckpointWriter();
+		writeTRIDYNProfile(PETSC_COMM_WORLD, timestep, format,
+				numGridpointsWithConcs, numValsPerGridpoint, myFirstRow,
+				myConcs);
+	}
 
 	// Restore the solutionArray
 	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
@@ -335,7 +362,7 @@ PetscErrorCode computeTRIDYN1D(TS ts, PetscInt timestep, PetscReal time,
  * This is a monitoring method that update an hdf5 file at each time step.
  */
 PetscErrorCode startStop1D(TS ts, PetscInt timestep, PetscReal time,
-		Vec solution, void *) {
+		Vec solution, void *ictx) {
 
 	xperf::ScopedTimer myTimer(startStopTimer);
 
@@ -346,27 +373,6 @@ PetscErrorCode startStop1D(TS ts, PetscInt timestep, PetscReal time,
 
 	PetscFunctionBeginUser;
 
-	// Compute the dt
-	double dt = time - previousTime;
-
-	// Don't do anything if it is not on the stride
-	if (((int) ((time + dt / 10.0) / hdf5Stride1D) <= hdf5Previous1D)
-			&& timestep > 0) {
-		PetscFunctionReturn(0);
-	}
-
-	// Update the previous time
-	if ((int) ((time + dt / 10.0) / hdf5Stride1D) > hdf5Previous1D)
-		hdf5Previous1D++;
-
-	// Get the number of processes
-	int worldSize;
-	MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
-
-	// Gets the process ID (important when it is running in parallel)
-	int procId;
-	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
-
 	// Get the da from ts
 	DM da;
 	ierr = TSGetDM(ts, &da);
@@ -393,767 +399,841 @@ PetscErrorCode startStop1D(TS ts, PetscInt timestep, PetscReal time,
 	auto& network = solverHandler.getNetwork();
 	const int dof = network.getDOF();
 
-	// Create an array for the concentration
-	double concArray[dof][2];
-
 	// Get the position of the surface
 	int surfacePos = solverHandler.getSurfacePosition();
 
-	// Open the existing HDF5 file
-	xolotlCore::XFile checkpointFile(hdf5OutputName1D, PETSC_COMM_WORLD,
-			xolotlCore::XFile::AccessMode::OpenReadWrite);
-
 	// Get the current time step
 	double currentTimeStep;
 	ierr = TSGetTimeStep(ts, &currentTimeStep);
 	CHKERRQ(ierr);
 
-	// Add a concentration time step group for the current time step.
-	auto concGroup = checkpointFile.getGroup<
-			xolotlCore::XFile::ConcentrationGroup>();
-	assert(concGroup);
-	auto tsGroup = concGroup->addTimestepGroup(timestep, time, previousTime,
-			currentTimeStep);
-
-	if (solverHandler.moveSurface()) {
-		// Write the surface positions and the associated interstitial quantities
-		// in the concentration sub group
-		tsGroup->writeSurface1D(surfacePos, nInterstitial1D, previousIFlux1D);
-	}
-
-	// Write the bottom impurity information if the bottom is a free surface
-	if (solverHandler.getRightOffset() == 1)
-		tsGroup->writeBottom1D(nHelium1D, previousHeFlux1D, nDeuterium1D,
-				previousDFlux1D, nTritium1D, previousTFlux1D);
+	// Take a snapshot of the concentration values we will write.
+	// We only examine and collect the grid points we own, which
+	// are contiguous in the solution.
+	auto concs = std::make_shared<XFile::TimestepGroup::Concs1DType>(
+			XFile::TimestepGroup::packConcentrations(solutionArray[xs], xm,
+					dof, relTolerance1D, packBuffer1D, PETSC_COMM_WORLD));
 
-	// Determine the concentration values we will write.
-	// We only examine and collect the grid points we own.
-	// TODO measure impact of us building the flattened representation
-	// rather than a ragged 2D representation.
-	XFile::TimestepGroup::Concs1DType concs(xm);
-	for (auto i = 0; i < xm; ++i) {
+	// Restore the solutionArray
+	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
+	CHKERRQ(ierr);
 
-		// Access the solution data for the current grid point.
-		auto gridPointSolution = solutionArray[xs + i];
+	// The analysis file always has the full concentrations
+	auto fullConcs = concs;
+
+	// In between keyframes, only write what changed since the last one
+	int keyTimeStep = -1;
+	if (keyframeConcs1D && nDeltas1D < keyframeStride1D - 1
+			&& keyframeConcs1D->size() == concs->size()) {
+		concs = std::make_shared<XFile::TimestepGroup::Concs1DType>(
+				XFile::TimestepGroup::makeDelta(*keyframeConcs1D, *concs,
+						deltaTolerance1D));
+		keyTimeStep = keyframeTimeStep1D;
+		nDeltas1D++;
+	} else if (keyframeStride1D > 1) {
+		keyframeConcs1D = concs;
+		keyframeTimeStep1D = timestep;
+		nDeltas1D = 0;
+	}
 
-		for (auto l = 0; l < dof; ++l) {
-			if (std::fabs(gridPointSolution[l]) > 1.0e-16) {
-				concs[i].emplace_back(l, gridPointSolution[l]);
-			}
-		}
+	// The sweep monitor runs after this one, complete its reduction of the
+	// previous time step so the retention goes up to the previous time
+	if (sweep1D) {
+		ierr = sweep1D->complete();
+		CHKERRQ(ierr);
 	}
 
-	// Write our concentration data to the current timestep group
-	// in the HDF5 file.
-	// We only write the data for the grid points we own.
-	tsGroup->writeConcentrations(checkpointFile, xs, concs);
+	// Copy everything else the writer needs, the monitors
+	// will change the globals while it writes
+	auto prevTime = previousTime;
+	auto compression = solverHandler.getCheckpointCompression();
+	auto checkpointName = hdf5OutputName1D;
+	auto headerGrid = std::move(headerGrid1D);
+	headerGrid1D.clear();
+	auto nKept = nKeptTimeSteps1D;
+	auto analysisName = analysisName1D;
+	auto analysisCompression = solverHandler.getAnalysisCompression();
+	if (analysisBits1D > 0)
+		analysisCompression.lossyBits = analysisBits1D;
+	bool analysisConcs = analysisConcs1D;
+	bool writeSurface = solverHandler.moveSurface();
+	bool writeBottom = (solverHandler.getRightOffset() == 1);
+	auto nInter = nInterstitial1D, prevIFlux = previousIFlux1D;
+	// The fluxes at the bottom can be older than the previous time depending
+	// on the schedule of the retention, add what went in the bulk since then
+	// because a restart computes the next contents from the previous time
+	double fluxDt = prevTime - bottomFluxTime1D;
+	auto nHe = nHelium1D + previousHeFlux1D * fluxDt, prevHeFlux =
+			previousHeFlux1D;
+	auto nD = nDeuterium1D + previousDFlux1D * fluxDt, prevDFlux =
+			previousDFlux1D;
+	auto nT = nTritium1D + previousTFlux1D * fluxDt, prevTFlux =
+			previousTFlux1D;
+
+	// Write the snapshot to the checkpoint file, in the background
+	// if the writer is asynchronous
+	auto checkpointWriter = (xolotlCore::CheckpointWriter *) ictx;
+	checkpointWriter->submit(
+			[=](MPI_Comm comm) {
+				// Add a concentration time step group for the current time step
+				// to the given file, with everything but the concentrations
+				auto addTimestepGroup = [&](xolotlCore::XFile& file)
+				-> std::unique_ptr<xolotlCore::XFile::TimestepGroup> {
+					auto concGroup = file.getGroup<
+					xolotlCore::XFile::ConcentrationGroup>();
+					assert(concGroup);
+					auto tsGroup = concGroup->addTimestepGroup(timestep, time,
+							prevTime, currentTimeStep);
+
+					if (writeSurface) {
+						// Write the surface positions and the associated interstitial quantities
+						// in the concentration sub group
+						tsGroup->writeSurface1D(surfacePos, nInter, prevIFlux);
+					}
 
-	// Restore the solutionArray
-	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
+					// Write the bottom impurity information if the bottom is a free surface
+					if (writeBottom)
+						tsGroup->writeBottom1D(nHe, prevHeFlux, nD, prevDFlux, nT,
+								prevTFlux);
+
+					return tsGroup;
+				};
+
+				// Use the checkpoint file the writer keeps open
+				auto& checkpointFile = checkpointWriter->getFile(comm,
+						checkpointName);
+				checkpointFile.setCompression(compression);
+
+				// Update the grid of the header if it changed since the
+				// file was written, e.g., when it was adapted
+				if (!headerGrid.empty()) {
+					auto headerGroup = checkpointFile.getGroup<
+					xolotlCore::XFile::HeaderGroup>();
+					assert(headerGroup);
+					headerGroup->writeXGrid(headerGrid);
+				}
+
+				auto tsGroup = addTimestepGroup(checkpointFile);
+
+				// Point to the keyframe if we only have the changes
+				if (keyTimeStep >= 0)
+					tsGroup->writeKeyframe(keyTimeStep);
+
+				// Write our concentration data to the current timestep group
+				// in the HDF5 file.
+				// We only write the data for the grid points we own.
+				tsGroup->writeConcentrations(checkpointFile, xs, *concs);
+
+				// Make sure the checkpoint is on the disk
+				checkpointFile.flush();
+
+				// Only then forget the oldest time steps, the file being
+				// compacted from time to time
+				if (nKept > 0)
+					checkpointWriter->removeOldTimestepGroups(comm, checkpointName,
+							nKept);
+
+				// Append the time step to the analysis file
+				if (!analysisName.empty()) {
+					auto& analysisFile = checkpointWriter->getFile(comm,
+							analysisName);
+					analysisFile.setCompression(analysisCompression);
+					auto analysisTsGroup = addTimestepGroup(analysisFile);
+					if (analysisConcs)
+						analysisTsGroup->writeConcentrations(analysisFile,
+							xs, *fullConcs);
+					analysisFile.flush();
+				}
+			});
 
-	ierr = computeTRIDYN1D(ts, timestep, time, solution, NULL);
+	// The TRIDYN profile is written by the checkpoint writer as well
+	ierr = computeTRIDYN1D(ts, timestep, time, solution, checkpointWriter);
 	CHKERRQ(ierr);
 
 	PetscFunctionReturn(0);
 }
 
-#undef __FUNCT__
-#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "computeHeliumRetention1D")
 /**
- * This is a monitoring method that will compute the helium retention
+ * The helium, deuterium, and tritium contents computed by the monitor sweep
+ * for the retention, with the fluxes going in the bulk if the bottom is a
+ * free surface.
  */
-PetscErrorCode computeHeliumRetention1D(TS ts, PetscInt, PetscReal time,
-		Vec solution, void *) {
-
-	xperf::ScopedTimer myTimer(heRetentionTimer);
-
-	// Initial declarations
-	PetscErrorCode ierr;
-	PetscInt xs, xm;
-
-	PetscFunctionBeginUser;
+class HeliumRetention1D: public SweepObservable {
+private:
+	//! The first local grid point.
+	PetscInt xs;
 
-	// Get the solver handler
-	auto& solverHandler = PetscSolver::getSolverHandler();
-
-	// Get the flux handler that will be used to know the fluence
-	auto fluxHandler = solverHandler.getFluxHandler();
-
-	// Get the da from ts
-	DM da;
-	ierr = TSGetDM(ts, &da);
-	CHKERRQ(ierr);
-
-	// Get the corners of the grid
-	ierr = DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL);
-	CHKERRQ(ierr);
-
-	// Get the total size of the grid
+	//! The total number of grid points.
 	PetscInt Mx;
-	ierr = DMDAGetInfo(da, PETSC_IGNORE, &Mx, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE);
-	CHKERRQ(ierr);
 
-	// Get the physical grid
-	auto grid = solverHandler.getXGrid();
-	// Get the position of the surface
-	int surfacePos = solverHandler.getSurfacePosition();
+	//! The position of the surface.
+	int surfacePos;
 
-	// Get the network
-	auto& network = solverHandler.getNetwork();
+	//! Whether the bottom is a free surface.
+	bool freeBottom;
 
-	// Get the array of concentration
-	PetscReal **solutionArray;
-	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
+	//! The physical grid.
+	std::vector<double> grid;
 
-	// Store the concentration over the grid
-	double heConcentration = 0.0, dConcentration = 0.0, tConcentration = 0.0;
+	//! The fluence when the contents were computed.
+	double fluence;
 
-	// Declare the pointer for the concentrations at a specific grid point
-	PetscReal *gridPointSolution;
+public:
+	/**
+	 * The constructor, after the previous time is read on a restart.
+	 */
+	HeliumRetention1D() {
+		bottomFluxTime1D = previousTime;
+	}
 
-	// Loop on the grid
-	for (PetscInt xi = xs; xi < xs + xm; xi++) {
+	int start(PetscInt _xs, PetscInt, PetscInt _Mx) override {
+		auto& solverHandler = PetscSolver::getSolverHandler();
+		xs = _xs;
+		Mx = _Mx;
+		surfacePos = solverHandler.getSurfacePosition();
+		freeBottom = (solverHandler.getRightOffset() == 1);
+		grid = solverHandler.getXGrid();
+		fluence = solverHandler.getFluxHandler()->getFluence();
+
+		// He, D, T contents, then their fluxes in the bulk
+		return freeBottom ? 6 : 3;
+	}
+
+	bool needsAllProcesses() const override {
+		// The fluxes in the bulk are written by every process in the checkpoints
+		return freeBottom;
+	}
 
+	void accumulate(PetscInt xi, const double* concs, double* values)
+			override {
 		// Boundary conditions
 		if (xi < surfacePos || xi == Mx - 1)
-			continue;
+			return;
+
+		// Get the total atoms concentrations at this grid point
+		heRetentionWeights1D.accumulate(concs, grid[xi + 1] - grid[xi],
+				values);
+
+		// Compute the fluxes going in the bulk at the bottom surface position
+		if (!freeBottom || xi != Mx - 2)
+			return;
+
+		// Factor for finite difference
+		double hxLeft = grid[xi + 1] - grid[xi];
+		double hxRight = grid[xi + 2] - grid[xi + 1];
+		double factor = 2.0 / (hxRight * (hxLeft + hxRight));
+
+		// Consider each helium, deuterium, and tritium cluster.
+		auto& network = PetscSolver::getSolverHandler().getNetwork();
+		const ReactantType types[3] =
+				{ ReactantType::He, ReactantType::D, ReactantType::T };
+		for (int k = 0; k < 3; k++) {
+			for (auto const& mapItem : network.getAll(types[k])) {
+				// Get the cluster
+				auto const& cluster = *(mapItem.second);
+				// Get its id and concentration
+				int id = cluster.getId() - 1;
+				double conc = concs[id];
+				// Get its size and diffusion coefficient
+				int size = cluster.getSize();
+				double coef = cluster.getDiffusionCoefficient(xi - xs);
+				// Compute the flux going to the right
+				values[3 + k] += (double) size * factor * coef * conc * hxRight;
+			}
+		}
+	}
 
-		// Get the pointer to the beginning of the solution data for this grid point
-		gridPointSolution = solutionArray[xi];
+	PetscErrorCode finish(PetscInt, PetscReal time, const double* sums,
+			xolotlCore::TextFileWriter& writer) override {
+		PetscFunctionBeginUser;
 
-		// Update the concentration in the network
-		network.updateConcentrationsFromArray(gridPointSolution);
+		// Look at the fluxes going in the bulk if the bottom is a free surface
+		if (freeBottom) {
+			// Get the delta time since the fluxes were computed, which can
+			// be several time steps depending on the schedule
+			double dt = time - bottomFluxTime1D;
+			// Compute the total number of impurities that went in the bulk
+			nHelium1D += previousHeFlux1D * dt;
+			nDeuterium1D += previousDFlux1D * dt;
+			nTritium1D += previousTFlux1D * dt;
+			// Update the fluxes, the same on every process
+			previousHeFlux1D = sums[3];
+			previousDFlux1D = sums[4];
+			previousTFlux1D = sums[5];
+		}
+		bottomFluxTime1D = time;
 
-		// Get the total atoms concentration at this grid point
-		heConcentration += network.getTotalAtomConcentration(0)
-				* (grid[xi + 1] - grid[xi]);
-		dConcentration += network.getTotalAtomConcentration(1)
-				* (grid[xi + 1] - grid[xi]);
-		tConcentration += network.getTotalAtomConcentration(2)
-				* (grid[xi + 1] - grid[xi]);
+		// Get the current process ID
+		int procId;
+		MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+
+		// Master process
+		if (procId == 0) {
+			// Extract total He, D, T concentrations.
+			double totalHeConcentration = sums[0];
+			double totalDConcentration = sums[1];
+			double totalTConcentration = sums[2];
+
+			// Print the result
+			std::cout << "\nTime: " << time << std::endl;
+			std::cout << "Helium content = " << totalHeConcentration
+					<< std::endl;
+			std::cout << "Deuterium content = " << totalDConcentration
+					<< std::endl;
+			std::cout << "Tritium content = " << totalTConcentration
+					<< std::endl;
+			std::cout << "Fluence = " << fluence << "\n" << std::endl;
+
+			// Uncomment to write the retention and the fluence in a file
+			appendTimeSeries("retentionOut",
+					{ "fluence", "helium", "deuterium", "tritium", "heliumBulk",
+							"deuteriumBulk", "tritiumBulk" },
+					{ fluence, totalHeConcentration, totalDConcentration,
+							totalTConcentration, nHelium1D, nDeuterium1D,
+							nTritium1D }, &writer);
+		}
+
+		PetscFunctionReturn(0);
 	}
+};
 
-	// Get the current process ID
-	int procId;
-	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+/**
+ * The xenon content, bubble concentration, and bubble radii computed by
+ * the monitor sweep for the xenon retention, with the flux of xenon going
+ * to the grain boundaries.
+ */
+class XenonRetention1D: public SweepObservable {
+private:
+	//! The first local grid point.
+	PetscInt xs;
 
-	// Determine total concentrations for He, D, T.
-	std::array<double, 3> myConcData { heConcentration, dConcentration,
-			tConcentration };
-	std::array<double, 3> totalConcData;
+	//! The total number of grid points.
+	PetscInt Mx;
 
-	MPI_Reduce(myConcData.data(), totalConcData.data(), myConcData.size(),
-	MPI_DOUBLE,
-	MPI_SUM, 0, PETSC_COMM_WORLD);
+	//! The physical grid.
+	std::vector<double> grid;
 
-	// Extract total He, D, T concentrations.  Values are valid only on rank 0.
-	double totalHeConcentration = totalConcData[0];
-	double totalDConcentration = totalConcData[1];
-	double totalTConcentration = totalConcData[2];
+	//! The grain boundaries.
+	std::vector<std::tuple<int, int, int> > gbVector;
 
-	// Look at the fluxes going in the bulk if the bottom is a free surface
-	if (solverHandler.getRightOffset() == 1) {
-		// Set the bottom surface position
-		int xi = Mx - 2;
+	//! The time the flux was computed at.
+	double lastTime;
 
-		// Value to know on which processor is the bottom
-		int bottomProc = 0;
+	//! The fluence when the contents were computed.
+	double fluence;
 
-		// Check we are on the right proc
-		if (xi >= xs && xi < xs + xm) {
-			// Get the delta time from the previous timestep to this timestep
-			double dt = time - previousTime;
-			// Compute the total number of impurities that went in the bulk
-			nHelium1D += previousHeFlux1D * dt;
-			nDeuterium1D += previousDFlux1D * dt;
-			nTritium1D += previousTFlux1D * dt;
+	/**
+	 * Add the flux of xenon from a grid point next to a grain boundary.
+	 */
+	double getGBFlux(PetscInt xi, const double* concs, double hxLeft,
+			double hxRight) const {
+		double flux = 0.0;
+		// Consider each xenon cluster.
+		auto& network = PetscSolver::getSolverHandler().getNetwork();
+		for (auto const& xeMapItem : network.getAll(ReactantType::Xe)) {
+			// Get the cluster
+			auto const& cluster = *(xeMapItem.second);
+			// Get its id
+			int id = cluster.getId() - 1;
+			// Get its size and diffusion coefficient
+			int size = cluster.getSize();
+			// Compute the flux coming from the grid point
+			flux += (double) size * concs[id]
+					* cluster.getDiffusionCoefficient(xi + 1 - xs) * 2.0
+					/ (hxLeft + hxRight);
+		}
+		return flux;
+	}
 
-			// Get the pointer to the beginning of the solution data for this grid point
-			gridPointSolution = solutionArray[xi];
+public:
+	/**
+	 * The constructor, after the previous time is read on a restart.
+	 */
+	XenonRetention1D() :
+			lastTime(previousTime) {
+	}
 
-			// Factor for finite difference
-			double hxLeft = grid[xi + 1] - grid[xi];
-			double hxRight = grid[xi + 2] - grid[xi + 1];
-			double factor = 2.0 / (hxRight * (hxLeft + hxRight));
+	int start(PetscInt _xs, PetscInt, PetscInt _Mx) override {
+		auto& solverHandler = PetscSolver::getSolverHandler();
+		xs = _xs;
+		Mx = _Mx;
+		grid = solverHandler.getXGrid();
+		gbVector = solverHandler.getGBVector();
 
-			// Initialize the value for the flux
-			double newFlux = 0.0;
-			// Consider each helium cluster.
-			for (auto const& heMapItem : network.getAll(ReactantType::He)) {
-				// Get the cluster
-				auto const& cluster = *(heMapItem.second);
-				// Get its id and concentration
-				int id = cluster.getId() - 1;
-				double conc = gridPointSolution[id];
-				// Get its size and diffusion coefficient
-				int size = cluster.getSize();
-				double coef = cluster.getDiffusionCoefficient(xi - xs);
-				// Compute the flux going to the right
-				newFlux += (double) size * factor * coef * conc * hxRight;
-			}
-			// Update the helium flux
-			previousHeFlux1D = newFlux;
+		// Get the fluence (Multiply by the size of the grid)
+		fluence = solverHandler.getFluxHandler()->getFluence()
+				* (grid[Mx - 1] - grid[1]);
 
-			// Initialize the value for the flux
-			newFlux = 0.0;
-			// Consider each deuterium cluster.
-			for (auto const& dMapItem : network.getAll(ReactantType::D)) {
-				// Get the cluster
-				auto const& cluster = *(dMapItem.second);
-				// Get its id and concentration
-				int id = cluster.getId() - 1;
-				double conc = gridPointSolution[id];
-				// Get its size and diffusion coefficient
-				int size = cluster.getSize();
-				double coef = cluster.getDiffusionCoefficient(xi - xs);
-				// Compute the flux going to the right
-				newFlux += (double) size * factor * coef * conc * hxRight;
-			}
-			// Update the deuterium flux
-			previousDFlux1D = newFlux;
+		// Xe content, bubble concentration, radii, then the flux to the GB
+		return 4;
+	}
 
-			// Initialize the value for the flux
-			newFlux = 0.0;
-			// Consider each tritium cluster.
-			for (auto const& tMapItem : network.getAll(ReactantType::T)) {
-				// Get the cluster
-				auto const& cluster = *(tMapItem.second);
-				// Get its id and concentration
-				int id = cluster.getId() - 1;
-				double conc = gridPointSolution[id];
-				// Get its size and diffusion coefficient
-				int size = cluster.getSize();
-				double coef = cluster.getDiffusionCoefficient(xi - xs);
-				// Compute the flux going to the right
-				newFlux += (double) size * factor * coef * conc * hxRight;
+	void accumulate(PetscInt xi, const double* concs, double* values)
+			override {
+		// Add the values of all the clusters at this grid point
+		xeRetentionWeights1D.accumulate(concs, grid[xi + 1] - grid[xi],
+				values);
+
+		// Loop on the GB
+		for (auto const& pair : gbVector) {
+			// Left
+			if (xi == std::get<0>(pair) - 1) {
+				values[3] += getGBFlux(xi, concs, grid[xi + 2] - grid[xi + 1],
+						grid[xi + 3] - grid[xi + 2]);
+			}
+			// Right
+			if (xi == std::get<0>(pair) + 1) {
+				values[3] += getGBFlux(xi, concs, grid[xi] - grid[xi - 1],
+						grid[xi + 1] - grid[xi]);
 			}
-			// Update the tritium flux
-			previousTFlux1D = newFlux;
-
-			// Set the bottom processor
-			bottomProc = procId;
 		}
+	}
 
-		// Get which processor will send the information
-		// TODO do we need to do this allreduce just to figure out
-		// who owns the data?
-		// And is it supposed to be a sum?   Why not a min?
-		int bottomId = 0;
-		MPI_Allreduce(&bottomProc, &bottomId, 1, MPI_INT, MPI_SUM,
-				PETSC_COMM_WORLD);
+	PetscErrorCode finish(PetscInt, PetscReal time, const double* sums,
+			xolotlCore::TextFileWriter& writer) override {
+		PetscFunctionBeginUser;
 
-		// Send the information about impurities
-		// to the other processes
-		std::array<double, 6> countFluxData { nHelium1D, previousHeFlux1D,
-				nDeuterium1D, previousDFlux1D, nTritium1D, previousTFlux1D };
-		MPI_Bcast(countFluxData.data(), countFluxData.size(), MPI_DOUBLE,
-				bottomId, PETSC_COMM_WORLD);
+		// Get the current process ID
+		int procId;
+		MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
 
-		// Extract inpurity data from broadcast buffer.
-		nHelium1D = countFluxData[0];
-		previousHeFlux1D = countFluxData[1];
-		nDeuterium1D = countFluxData[2];
-		previousDFlux1D = countFluxData[3];
-		nTritium1D = countFluxData[4];
-		previousTFlux1D = countFluxData[5];
-	}
+		// Master process
+		if (procId == 0) {
+			double totalXeConcentration = sums[0];
+			double totalBubbleConcentration = sums[1];
+			double totalRadii = sums[2];
+
+			// GB
+			// Get the delta time since the flux was computed
+			double dt = time - lastTime;
+			// Compute the total number of Xe that went to the GB
+			nXenon1D += previousXeFlux1D * dt;
+			// Update the xenon flux
+			previousXeFlux1D = sums[3];
+			lastTime = time;
+
+			// Print the result
+			std::cout << "\nTime: " << time << std::endl;
+			std::cout << "Xenon retention = "
+					<< 100.0 * (totalXeConcentration) / fluence << " %"
+					<< std::endl;
+			std::cout << "Xenon concentration = " << totalXeConcentration
+					<< std::endl;
+			std::cout << "Xenon GB = " << nXenon1D << std::endl << std::endl;
+
+			// Uncomment to write the retention and the fluence in a file
+			appendTimeSeries("retentionOut",
+					{ "time", "retention", "xenon", "xenonReleased", "meanRadius",
+							"xenonGB" },
+					{ time, 100.0 * (totalXeConcentration / fluence),
+							totalXeConcentration, fluence - totalXeConcentration,
+							totalRadii / totalBubbleConcentration, nXenon1D },
+					&writer);
+		}
 
-	// Master process
-	if (procId == 0) {
-		// Get the fluence
-		double fluence = fluxHandler->getFluence();
-
-		// Print the result
-		std::cout << "\nTime: " << time << std::endl;
-		std::cout << "Helium content = " << totalHeConcentration << std::endl;
-		std::cout << "Deuterium content = " << totalDConcentration << std::endl;
-		std::cout << "Tritium content = " << totalTConcentration << std::endl;
-		std::cout << "Fluence = " << fluence << "\n" << std::endl;
-
-		// Uncomment to write the retention and the fluence in a file
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt", ios::app);
-		outputFile << fluence << " " << totalHeConcentration << " "
-				<< totalDConcentration << " " << totalTConcentration << " "
-				<< nHelium1D << " " << nDeuterium1D << " " << nTritium1D
-				<< std::endl;
-		outputFile.close();
+		PetscFunctionReturn(0);
 	}
+};
 
-	// Restore the solutionArray
-	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
-
-	PetscFunctionReturn(0);
-}
-
-#undef __FUNCT__
-#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "computeXenonRetention1D")
 /**
- * This is a monitoring method that will compute the xenon retention
+ * The helium concentrations as a function of depth and helium size
+ * computed by the monitor sweep.
  */
-PetscErrorCode computeXenonRetention1D(TS ts, PetscInt, PetscReal time,
-		Vec solution, void *) {
+class HeliumConc1D: public SweepObservable {
+private:
+	//! The number of helium sizes.
+	static constexpr int maxSize = 1001;
 
-	xperf::ScopedTimer myTimer(xeRetentionTimer);
+	//! The total number of grid points.
+	PetscInt Mx;
 
-	// Initial declarations
-	PetscErrorCode ierr;
-	PetscInt xs, xm;
+	//! The position of the surface.
+	int surfacePos;
 
-	PetscFunctionBeginUser;
+	//! The physical grid.
+	std::vector<double> grid;
 
-	// Get the solver handler
-	auto& solverHandler = PetscSolver::getSolverHandler();
+public:
+	int start(PetscInt, PetscInt, PetscInt _Mx) override {
+		auto& solverHandler = PetscSolver::getSolverHandler();
+		Mx = _Mx;
+		surfacePos = solverHandler.getSurfacePosition();
+		grid = solverHandler.getXGrid();
 
-	// Get the flux handler that will be used to get the fluence
-	auto fluxHandler = solverHandler.getFluxHandler();
-
-	// Get the da from ts
-	DM da;
-	ierr = TSGetDM(ts, &da);
-	CHKERRQ(ierr);
-
-	// Get the corners of the grid
-	ierr = DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL);
-	CHKERRQ(ierr);
-
-	// Get the total size of the grid
-	PetscInt Mx;
-	ierr = DMDAGetInfo(da, PETSC_IGNORE, &Mx, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE);
-	CHKERRQ(ierr);
-
-	// Get the physical grid
-	auto grid = solverHandler.getXGrid();
-
-	// Get the network
-	auto& network = solverHandler.getNetwork();
-
-	// Get the array of concentration
-	PetscReal **solutionArray;
-	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
-
-	// Store the concentration and other values over the grid
-	double xeConcentration = 0.0, bubbleConcentration = 0.0, radii = 0.0;
-
-	// Declare the pointer for the concentrations at a specific grid point
-	PetscReal *gridPointSolution;
+		// The concentrations of each size at each grid point
+		return Mx * maxSize;
+	}
 
-	// Loop on the grid
-	for (PetscInt xi = xs; xi < xs + xm; xi++) {
+	bool usesNetwork() const override {
+		// The super clusters give the concentration of each size
+		return true;
+	}
 
-		// Get the pointer to the beginning of the solution data for this grid point
-		gridPointSolution = solutionArray[xi];
+	void accumulate(PetscInt xi, const double* concs, double* values)
+			override {
+		if (xi <= surfacePos)
+			return;
 
-		// Update the concentration in the network
-		network.updateConcentrationsFromArray(gridPointSolution);
+		// The concentrations at this grid point
+		double* heConcLocal = values + xi * maxSize;
+		double hx = grid[xi + 1] - grid[xi];
 
 		// Loop on all the indices
-		for (unsigned int i = 0; i < indices1D.size(); i++) {
-			// Add the current concentration times the number of xenon in the cluster
-			// (from the weight vector)
-			xeConcentration += gridPointSolution[indices1D[i]] * weights1D[i]
-					* (grid[xi + 1] - grid[xi]);
-			bubbleConcentration += gridPointSolution[indices1D[i]]
-					* (grid[xi + 1] - grid[xi]);
-			radii += gridPointSolution[indices1D[i]] * radii1D[i]
-					* (grid[xi + 1] - grid[xi]);
+		for (int l = 0; l < indices1D.size(); l++) {
+			// Add the current concentration
+			heConcLocal[weights1D[l]] += concs[indices1D[l]] * hx;
 		}
 
-		// Loop on all the super clusters
-		for (auto const& superMapItem : network.getAll(ReactantType::NESuper)) {
-			auto const& cluster =
-					static_cast<NESuperCluster&>(*(superMapItem.second));
-			xeConcentration += cluster.getTotalXenonConcentration()
-					* (grid[xi + 1] - grid[xi]);
-			bubbleConcentration += cluster.getTotalConcentration()
-					* (grid[xi + 1] - grid[xi]);
-			radii += cluster.getTotalConcentration()
-					* cluster.getReactionRadius() * (grid[xi + 1] - grid[xi]);
+		// Loop on the super clusters
+		auto& network = PetscSolver::getSolverHandler().getNetwork();
+		for (auto const& currMapItem : network.getAll(ReactantType::PSISuper)) {
+
+			// Get the super cluster
+			auto const& superCluster =
+					static_cast<PSISuperCluster&>(*(currMapItem.second));
+			// Loop on its boundaries
+			for (auto const& i : superCluster.getBounds(0)) {
+				for (auto const& j : superCluster.getBounds(3)) {
+					if (!superCluster.isIn(i, 0, 0, j))
+						continue;
+					heConcLocal[i] += superCluster.getConcentration(
+							superCluster.getDistance(i, 0), 0, 0,
+							superCluster.getDistance(j, 3)) * hx;
+				}
+			}
 		}
 	}
 
-	// Get the current process ID
-	int procId;
-	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+	PetscErrorCode finish(PetscInt timestep, PetscReal, const double* sums,
+			xolotlCore::TextFileWriter& writer) override {
+		PetscFunctionBeginUser;
 
-	// Sum all the concentrations through MPI reduce
-	double totalXeConcentration = 0.0;
-	MPI_Reduce(&xeConcentration, &totalXeConcentration, 1, MPI_DOUBLE,
-	MPI_SUM, 0, PETSC_COMM_WORLD);
-	double totalBubbleConcentration = 0.0;
-	MPI_Reduce(&bubbleConcentration, &totalBubbleConcentration, 1,
-	MPI_DOUBLE,
-	MPI_SUM, 0, MPI_COMM_WORLD);
-	double totalRadii = 0.0;
-	MPI_Reduce(&radii, &totalRadii, 1, MPI_DOUBLE, MPI_SUM, 0,
-	MPI_COMM_WORLD);
-
-	// GB
-	// Get the delta time from the previous timestep to this timestep
-	double dt = time - previousTime;
-	// Compute the total number of Xe that went to the GB
-	nXenon1D += previousXeFlux1D * dt;
-	// Get the vector from the solver handler
-	auto gbVector = solverHandler.getGBVector();
-	// Initialize the value for the flux
-	double newFlux = 0.0;
-	// Loop on the GB
-	for (auto const& pair : gbVector) {
-		// Left
-		int xi = std::get<0>(pair) - 1;
-
-		// Check we are on the right proc
-		if (xi >= xs && xi < xs + xm) {
+		// Gets the process ID
+		int procId;
+		MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
 
-			// Factor for finite difference
-			double hxLeft = grid[xi + 2] - grid[xi + 1];
-			double hxRight = grid[xi + 3] - grid[xi + 2];
-			// Consider each xenon cluster.
-			for (auto const& xeMapItem : network.getAll(ReactantType::Xe)) {
-				// Get the cluster
-				auto const& cluster = *(xeMapItem.second);
-				// Get its id
-				int id = cluster.getId() - 1;
-				// Get its size and diffusion coefficient
-				int size = cluster.getSize();
-				// Compute the flux coming from the left
-				newFlux += (double) size * solutionArray[xi][id]
-						* cluster.getDiffusionCoefficient(xi + 1 - xs) * 2.0
-						/ (hxLeft + hxRight);
+		// Print it from the main proc
+		if (procId == 0) {
+			std::stringstream name;
+			name << "heliumConc_" << timestep << ".dat";
+			std::stringstream outputFile;
+
+			// Loop on the full grid
+			for (PetscInt xi = surfacePos + 1; xi < Mx; xi++) {
+				// Set x
+				double x = grid[xi + 1] - grid[1];
+
+				const double* heConcentrations = sums + xi * maxSize;
+				for (int i = 0; i < maxSize; i++) {
+					if (heConcentrations[i] > 1.0e-16) {
+						outputFile << x << " " << i << " "
+								<< heConcentrations[i] << std::endl;
+					}
+				}
 			}
-		}
 
-		// Right
-		xi = std::get<0>(pair) + 1;
-
-		// Check we are on the right proc
-		if (xi >= xs && xi < xs + xm) {
-
-			// Factor for finite difference
-			double hxLeft = grid[xi] - grid[xi - 1];
-			double hxRight = grid[xi + 1] - grid[xi];
-			// Consider each xenon cluster.
-			for (auto const& xeMapItem : network.getAll(ReactantType::Xe)) {
-				// Get the cluster
-				auto const& cluster = *(xeMapItem.second);
-				// Get its id
-				int id = cluster.getId() - 1;
-				// Get its size and diffusion coefficient
-				int size = cluster.getSize();
-				// Compute the flux coming from the left
-				newFlux += (double) size * solutionArray[xi][id]
-						* cluster.getDiffusionCoefficient(xi + 1 - xs) * 2.0
-						/ (hxLeft + hxRight);
-			}
+			// Write the file
+			writer.write(name.str(), outputFile.str());
 		}
-	}
-	// Update the helium flux
-	previousXeFlux1D = newFlux;
 
-	// Master process
-	if (procId == 0) {
-		// Get the fluence (Multiply by the size of the grid)
-		double fluence = fluxHandler->getFluence() * (grid[Mx - 1] - grid[1]);
-
-		// Print the result
-		std::cout << "\nTime: " << time << std::endl;
-		std::cout << "Xenon retention = "
-				<< 100.0 * (totalXeConcentration) / fluence << " %"
-				<< std::endl;
-		std::cout << "Xenon concentration = " << totalXeConcentration
-				<< std::endl;
-		std::cout << "Xenon GB = " << nXenon1D << std::endl << std::endl;
-
-		// Uncomment to write the retention and the fluence in a file
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt", ios::app);
-		outputFile << time << " " << 100.0 * (totalXeConcentration / fluence)
-				<< " " << totalXeConcentration << " "
-				<< fluence - totalXeConcentration << " "
-				<< totalRadii / totalBubbleConcentration << " " << nXenon1D
-				<< std::endl;
-		outputFile.close();
+		PetscFunctionReturn(0);
 	}
+};
 
-	// Restore the solutionArray
-	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
-
-	PetscFunctionReturn(0);
-}
-
-#undef __FUNCT__
-#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "computeHeliumConc1D")
 /**
- * This is a monitoring method that will compute the helium concentrations
+ * The cumulative distribution of helium as a function of depth computed
+ * by the monitor sweep.
  */
-PetscErrorCode computeHeliumConc1D(TS ts, PetscInt timestep, PetscReal time,
-		Vec solution, void *ictx) {
-
-	xperf::ScopedTimer myTimer(heConcTimer);
-
-	// Initial declarations
-	PetscErrorCode ierr;
-	PetscInt xs, xm;
+class CumulativeHelium1D: public SweepObservable {
+private:
+	//! The total number of grid points.
+	PetscInt Mx;
 
-	PetscFunctionBeginUser;
+	//! The position of the surface.
+	int surfacePos;
 
-	// Get the number of processes
-	int worldSize;
-	MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
+	//! The physical grid.
+	std::vector<double> grid;
 
-	// Gets the process ID
-	int procId;
-	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+public:
+	int start(PetscInt, PetscInt, PetscInt _Mx) override {
+		auto& solverHandler = PetscSolver::getSolverHandler();
+		Mx = _Mx;
+		surfacePos = solverHandler.getSurfacePosition();
+		grid = solverHandler.getXGrid();
 
-	// Get the solver handler
-	auto& solverHandler = PetscSolver::getSolverHandler();
+		// The helium concentration at each grid point
+		return Mx;
+	}
 
-	// Get the da from ts
-	DM da;
-	ierr = TSGetDM(ts, &da);
-	CHKERRQ(ierr);
+	bool usesNetwork() const override {
+		return true;
+	}
 
-	// Get the corners of the grid
-	ierr = DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL);
-	CHKERRQ(ierr);
+	void accumulate(PetscInt xi, const double*, double* values) override {
+		if (xi <= surfacePos)
+			return;
 
-	// Get the physical grid in the x direction
-	auto grid = solverHandler.getXGrid();
+		// Get the total helium concentration at this grid point
+		auto& network = PetscSolver::getSolverHandler().getNetwork();
+		values[xi] += network.getTotalAtomConcentration()
+				* (grid[xi + 1] - grid[xi]);
+	}
 
-	// Get the network
-	auto& network = solverHandler.getNetwork();
+	PetscErrorCode finish(PetscInt timestep, PetscReal, const double* sums,
+			xolotlCore::TextFileWriter& writer) override {
+		PetscFunctionBeginUser;
 
-	// Get the position of the surface
-	int surfacePos = solverHandler.getSurfacePosition();
+		// Gets the process ID
+		int procId;
+		MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
 
-	// Get the total size of the grid
-	PetscInt Mx;
-	ierr = DMDAGetInfo(da, PETSC_IGNORE, &Mx, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE);
-	CHKERRQ(ierr);
+		// The master process computes the cumulative value and writes in the file
+		if (procId == 0) {
+			std::stringstream name;
+			name << "heliumCumul_" << timestep << ".dat";
+			std::stringstream outputFile;
+
+			// Loop on the entire grid
+			double heConcentration = 0.0;
+			for (int xi = surfacePos + 1; xi < Mx; xi++) {
+				// Set x
+				double x = grid[xi + 1] - grid[1];
+
+				heConcentration += sums[xi];
+				outputFile << x - (grid[surfacePos + 1] - grid[1]) << " "
+						<< heConcentration << std::endl;
+			}
 
-	// Get the array of concentration
-	double **solutionArray, *gridPointSolution;
-	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
+			// Write the file
+			writer.write(name.str(), outputFile.str());
+		}
 
-	// Create the vectors that will hold the concentrations
-	// as a function of helium size
-	std::vector<double> heConcLocal;
-	std::vector<double> heConcentrations;
-	int maxSize = 1001;
-	// Initialize
-	for (int i = 0; i < maxSize; i++) {
-		heConcLocal.push_back(0.0);
-		heConcentrations.push_back(0.0);
+		PetscFunctionReturn(0);
 	}
+};
 
-	// Open the file
-	std::ofstream outputFile;
-	if (procId == 0) {
-		std::stringstream name;
-		name << "heliumConc_" << timestep << ".dat";
-		outputFile.open(name.str());
-	}
+/**
+ * The sums of the concentrations, sizes times concentrations, and sizes
+ * squared times concentrations of the bubbles at each depth computed by
+ * the monitor sweep, from which the statistics of their size are derived.
+ */
+class SizeMoments1D: public SweepObservable {
+protected:
+	//! The total number of grid points.
+	PetscInt Mx;
 
-	// Loop on the full grid
-	for (PetscInt xi = surfacePos + 1; xi < Mx; xi++) {
-		// Set x
-		double x = grid[xi + 1] - grid[1];
+	//! The physical grid.
+	std::vector<double> grid;
 
-		// If we are on the right process
-		if (xi >= xs && xi < xs + xm) {
-			// Get the pointer to the beginning of the solution data for this grid point
-			gridPointSolution = solutionArray[xi];
+public:
+	int start(PetscInt, PetscInt, PetscInt _Mx) override {
+		Mx = _Mx;
+		grid = PetscSolver::getSolverHandler().getXGrid();
 
-			// Update the concentration in the network
-			network.updateConcentrationsFromArray(gridPointSolution);
+		// The sums at each grid point
+		return Mx * xolotlCore::SizeStatistics::nMoments;
+	}
 
-			// Loop on all the indices
-			for (int l = 0; l < indices1D.size(); l++) {
-				// Add the current concentration
-				heConcLocal[weights1D[l]] += gridPointSolution[indices1D[l]]
-						* (grid[xi + 1] - grid[xi]);
-			}
+	void accumulate(PetscInt xi, const double* concs, double* values)
+			override {
+		// Integrate the sums over the width of the grid point, which
+		// leaves the mean size at this depth unchanged
+		sizeMomentWeights1D.accumulate(concs, grid[xi + 1] - grid[xi],
+				&values[xi * xolotlCore::SizeStatistics::nMoments]);
+	}
+};
 
-			// Loop on the super clusters
-			for (auto const& currMapItem : network.getAll(
-					ReactantType::PSISuper)) {
-
-				// Get the super cluster
-				auto const& superCluster =
-						static_cast<PSISuperCluster&>(*(currMapItem.second));
-				// Loop on its boundaries
-				for (auto const& i : superCluster.getBounds(0)) {
-					for (auto const& j : superCluster.getBounds(3)) {
-						if (!superCluster.isIn(i, 0, 0, j))
-							continue;
-						heConcLocal[i] += superCluster.getConcentration(
-								superCluster.getDistance(i, 0), 0, 0,
-								superCluster.getDistance(j, 3))
-								* (grid[xi + 1] - grid[xi]);
-					}
-				}
-			}
-		}
+/**
+ * The mean helium size as a function of depth computed by the monitor
+ * sweep.
+ */
+class MeanSize1D: public SizeMoments1D {
+public:
+	PetscErrorCode finish(PetscInt timestep, PetscReal, const double* sums,
+			xolotlCore::TextFileWriter& writer) override {
+		PetscFunctionBeginUser;
 
-		// Gather all the data
-		MPI_Reduce(&heConcLocal[0], &heConcentrations[0], maxSize, MPI_DOUBLE,
-		MPI_SUM, 0, PETSC_COMM_WORLD);
+		// Gets the process ID
+		int procId;
+		MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
 
-		// Print it from the main proc
+		// The master process writes in the file
 		if (procId == 0) {
-			for (int i = 0; i < maxSize; i++) {
-				if (heConcentrations[i] > 1.0e-16) {
-					outputFile << x << " " << i << " " << heConcentrations[i]
-							<< std::endl;
-				}
+			std::stringstream name;
+			name << "heliumSizeMean_" << timestep << ".dat";
+			std::stringstream outputFile;
+
+			// Loop on the full grid
+			for (PetscInt xi = 0; xi < Mx; xi++) {
+				xolotlCore::SizeStatistics stats;
+				stats.add(&sums[xi * xolotlCore::SizeStatistics::nMoments]);
+				outputFile << grid[xi + 1] - grid[1] << " " << stats.getMean()
+						<< std::endl;
 			}
-		}
 
-		// Reinitialize the concentrations
-		for (int i = 0; i < maxSize; i++) {
-			heConcLocal[i] = 0.0;
-			heConcentrations[i] = 0.0;
+			// Write the file
+			writer.write(name.str(), outputFile.str());
 		}
-	}
-
-	// Close the file
-	outputFile.close();
-
-	// Restore the solutionArray
-	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
 
-	PetscFunctionReturn(0);
-}
+		PetscFunctionReturn(0);
+	}
+};
 
-#undef __FUNCT__
-#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "computeCumulativeHelium1D")
 /**
- * This is a monitoring method that will compute the cumulative distribution of helium
+ * The statistics of the bubble size over the whole grid computed by the
+ * monitor sweep, appended to the sizeStatistics time series: the total
+ * bubble concentration, their mean size and its variance, and the largest
+ * mean size at any depth.
  */
-PetscErrorCode computeCumulativeHelium1D(TS ts, PetscInt timestep,
-		PetscReal time, Vec solution, void *ictx) {
-
-	xperf::ScopedTimer myTimer(cumHeTimer);
-
-	// Initial declarations
-	PetscErrorCode ierr;
-	PetscInt xs, xm;
-
-	PetscFunctionBeginUser;
-
-	// Get the number of processes
-	int worldSize;
-	MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
+class SizeStatistics1D: public SizeMoments1D {
+public:
+	PetscErrorCode finish(PetscInt, PetscReal time, const double* sums,
+			xolotlCore::TextFileWriter& writer) override {
+		PetscFunctionBeginUser;
 
-	// Gets the process ID
-	int procId;
-	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+		// Gets the process ID
+		int procId;
+		MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
 
-	// Get the solver handler
-	auto& solverHandler = PetscSolver::getSolverHandler();
-
-	// Get the network
-	auto& network = solverHandler.getNetwork();
+		// The master process adds up the depths and writes the statistics
+		if (procId == 0) {
+			xolotlCore::SizeStatistics stats;
+			for (PetscInt xi = 0; xi < Mx; xi++) {
+				stats.add(&sums[xi * xolotlCore::SizeStatistics::nMoments]);
+			}
 
-	// Get the position of the surface
-	int surfacePos = solverHandler.getSurfacePosition();
+			appendTimeSeries("sizeStatistics",
+					{ "time", "concentration", "meanSize", "variance",
+							"maxMeanSize" },
+					{ time, stats.getConcentration(), stats.getMean(),
+							stats.getVariance(), stats.getMaxMean() },
+					&writer);
+		}
 
-	// Get the da from ts
-	DM da;
-	ierr = TSGetDM(ts, &da);
-	CHKERRQ(ierr);
+		PetscFunctionReturn(0);
+	}
+};
 
-	// Get the corners of the grid
-	ierr = DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL);
-	CHKERRQ(ierr);
+/**
+ * The check of the concentration of the biggest cluster in the network
+ * done by the monitor sweep, until it reaches a non-negligible value.
+ */
+class MaxClusterConc1D: public SweepObservable {
+private:
+	//! The biggest cluster.
+	IReactant* maxCluster;
+
+public:
+	/**
+	 * The constructor finding the biggest cluster.
+	 *
+	 * @param network The network
+	 */
+	MaxClusterConc1D(IReactionNetwork& network) {
+		// Get the maximum size of HeV clusters
+		auto const& psiNetwork =
+				dynamic_cast<PSIClusterReactionNetwork const&>(network);
+		IReactant::SizeType maxHeVClusterSize = psiNetwork.getMaxClusterSize(
+				ReactantType::PSIMixed);
+		// Get the maximum size of V clusters
+		IReactant::SizeType maxVClusterSize = psiNetwork.getMaxClusterSize(
+				ReactantType::V);
+		// Get the number of He in the max HeV cluster
+		IReactant::SizeType maxHeSize = (maxHeVClusterSize - maxVClusterSize);
+		// Get the maximum stable HeV cluster
+		IReactant::Composition testComp;
+		testComp[toCompIdx(Species::He)] = maxHeSize;
+		testComp[toCompIdx(Species::V)] = maxVClusterSize;
+		maxCluster = network.get(ReactantType::PSIMixed, testComp);
+		if (!maxCluster) {
+			// Get the maximum size of Xe clusters
+			auto const& neNetwork =
+					dynamic_cast<NEClusterReactionNetwork const&>(network);
+			int maxXeClusterSize = neNetwork.getMaxClusterSize(
+					ReactantType::Xe);
+			maxCluster = network.get(Species::Xe, maxXeClusterSize);
+		}
+	}
 
-	// Get the total size of the grid
-	PetscInt Mx;
-	ierr = DMDAGetInfo(da, PETSC_IGNORE, &Mx, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE);
-	CHKERRQ(ierr);
+	int start(PetscInt, PetscInt, PetscInt) override {
+		// Don't do anything if it was already printed
+		return printMaxClusterConc1D ? 1 : 0;
+	}
 
-	// Get the physical grid
-	auto grid = solverHandler.getXGrid();
+	bool needsAllProcesses() const override {
+		// Every process stops checking once it is printed
+		return true;
+	}
 
-	// Get the array of concentration
-	PetscReal **solutionArray;
-	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
+	void accumulate(PetscInt, const double* concs, double* values) override {
+		// Count the grid points where the concentration is too big
+		if (concs[maxCluster->getId() - 1] > 1.0e-16)
+			values[0] += 1.0;
+	}
 
-	// Store the concentration over the grid
-	double heConcentration = 0.0;
+	PetscErrorCode finish(PetscInt timestep, PetscReal time,
+			const double* sums, xolotlCore::TextFileWriter&) override {
+		PetscFunctionBeginUser;
+
+		// Is the concentration too big on any process?
+		if (sums[0] > 0.0) {
+			// Get the current process ID
+			int procId;
+			MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+
+			// Main process
+			if (procId == 0) {
+				std::cout << std::endl;
+				std::cout << "At time step: " << timestep << " and time: "
+						<< time << " the biggest cluster: "
+						<< maxCluster->getName()
+						<< " reached a concentration above 1.0e-16 at at least one grid point."
+						<< std::endl << std::endl;
+			}
 
-	// Declare the pointer for the concentrations at a specific grid point
-	PetscReal *gridPointSolution;
+			// Don't print anymore
+			printMaxClusterConc1D = false;
+		}
 
-	// Create the output file
-	std::ofstream outputFile;
-	if (procId == 0) {
-		std::stringstream name;
-		name << "heliumCumul_" << timestep << ".dat";
-		outputFile.open(name.str());
+		PetscFunctionReturn(0);
 	}
+};
 
-	// Loop on the entire grid
-	for (int xi = surfacePos + 1; xi < Mx; xi++) {
-		// Set x
-		double x = grid[xi + 1] - grid[1];
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "monitorSweep1D")
+/**
+ * This is a monitoring method that computes all the observables of the
+ * sweep given as its context from a single pass over the grid.
+ */
+PetscErrorCode monitorSweep1D(TS ts, PetscInt timestep, PetscReal time,
+		Vec solution, void *ictx) {
 
-		// Initialize the helium concentration at this grid point
-		double heLocalConc = 0.0;
+	xperf::ScopedTimer myTimer(sweepTimer);
 
-		// Check if this process is in charge of xi
-		if (xi >= xs && xi < xs + xm) {
-			// Get the pointer to the beginning of the solution data for this grid point
-			gridPointSolution = solutionArray[xi];
+	PetscErrorCode ierr;
 
-			// Update the concentration in the network
-			network.updateConcentrationsFromArray(gridPointSolution);
+	PetscFunctionBeginUser;
 
-			// Get the total helium concentration at this grid point
-			heLocalConc += network.getTotalAtomConcentration()
-					* (grid[xi + 1] - grid[xi]);
-		}
+	auto sweep = (MonitorSweep *) ictx;
+	ierr = sweep->run(ts, timestep, time, solution);
+	CHKERRQ(ierr);
 
-		// Get the value on procId = 0
-		double heConc = 0.0;
-		MPI_Reduce(&heLocalConc, &heConc, 1, MPI_DOUBLE,
-		MPI_SUM, 0, PETSC_COMM_WORLD);
+	PetscFunctionReturn(0);
+}
 
-		// The master process computes the cumulative value and writes in the file
-		if (procId == 0) {
-			heConcentration += heConc;
-			outputFile << x - (grid[surfacePos + 1] - grid[1]) << " "
-					<< heConcentration << std::endl;
-		}
-	}
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "destroyMonitorSweep1D")
+/**
+ * This method destroys the sweep of monitorSweep1D, which startStop1D
+ * can't use anymore.
+ */
+PetscErrorCode destroyMonitorSweep1D(void **ctx) {
 
-	// Close the file
-	if (procId == 0) {
-		outputFile.close();
-	}
+	PetscFunctionBeginUser;
 
-	// Restore the solutionArray
-	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
+	sweep1D = NULL;
+	PetscErrorCode ierr = destroyMonitorSweep(ctx);
 	CHKERRQ(ierr);
 
 	PetscFunctionReturn(0);
@@ -1177,10 +1257,6 @@ PetscErrorCode monitorScatter1D(TS ts, PetscInt timestep, PetscReal time,
 
 	PetscFunctionBeginUser;
 
-	// Don't do anything if it is not on the stride
-	if (timestep % 200 != 0)
-		PetscFunctionReturn(0);
-
 	// Get the number of processes
 	int worldSize;
 	MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
@@ -1220,97 +1296,91 @@ PetscErrorCode monitorScatter1D(TS ts, PetscInt timestep, PetscReal time,
 	// Get the index of the middle of the grid
 	PetscInt ix = Mx / 2;
 
-	if (procId == 0) {
-		// Create a Point vector to store the data to give to the data provider
-		// for the visualization
-		auto myPoints = std::make_shared<std::vector<xolotlViz::Point> >();
-
-		// If the middle is on this process
-		if (ix >= xs && ix < xs + xm) {
-			// Get the pointer to the beginning of the solution data for this grid point
-			gridPointSolution = solutionArray[ix];
+	// The process owning the middle of the grid creates the points
+	bool isOwner = (ix >= xs && ix < xs + xm);
+	std::vector<xolotlViz::Point> localPoints;
+	if (isOwner) {
+		// Get the pointer to the beginning of the solution data for this grid point
+		gridPointSolution = solutionArray[ix];
 
-			// Update the concentration in the network
-			network.updateConcentrationsFromArray(gridPointSolution);
+		// Update the concentration in the network
+		network.updateConcentrationsFromArray(gridPointSolution);
 
-			for (int i = 0; i < networkSize - superClusters.size(); i++) {
-				// Create a Point with the concentration[i] as the value
-				// and add it to myPoints
-				xolotlViz::Point aPoint;
-				aPoint.value = gridPointSolution[i];
-				aPoint.t = time;
-				aPoint.x = (double) i + 1.0;
-				myPoints->push_back(aPoint);
-			}
+		for (int i = 0; i < networkSize - superClusters.size(); i++) {
+			// Create a Point with the concentration[i] as the value
+			// and add it to localPoints
+			xolotlViz::Point aPoint;
+			aPoint.value = gridPointSolution[i];
+			aPoint.t = time;
+			aPoint.x = (double) i + 1.0;
+			localPoints.push_back(aPoint);
+		}
 
-			// Loop on the super clusters
-			auto& allReactants = network.getAll();
-			std::for_each(allReactants.begin(), allReactants.end(),
-					[&time,&myPoints](IReactant& currReactant) {
-
-						if (currReactant.getType() == ReactantType::NESuper) {
-							auto& cluster = static_cast<NESuperCluster&>(currReactant);
-							// Get the width and average
-							int width = cluster.getSectionWidth();
-							double nXe = cluster.getAverage();
-							// Loop on the width
-							for (int k = nXe + 1.0 - (double) width / 2.0;
-									k < nXe + (double) width / 2.0; k++) {
-								// Compute the distance
-								double dist = cluster.getDistance(k);
-								// Create a Point with the concentration[i] as the value
-								// and add it to myPoints
-								xolotlViz::Point aPoint;
-								aPoint.value = cluster.getConcentration(dist);
-								aPoint.t = time;
-								aPoint.x = (double) k;
-								myPoints->push_back(aPoint);
-							}
+		// Loop on the super clusters
+		auto& allReactants = network.getAll();
+		std::for_each(allReactants.begin(), allReactants.end(),
+				[&time,&localPoints](IReactant& currReactant) {
+
+					if (currReactant.getType() == ReactantType::NESuper) {
+						auto& cluster = static_cast<NESuperCluster&>(currReactant);
+						// Get the width and average
+						int width = cluster.getSectionWidth();
+						double nXe = cluster.getAverage();
+						// Loop on the width
+						for (int k = nXe + 1.0 - (double) width / 2.0;
+								k < nXe + (double) width / 2.0; k++) {
+							// Compute the distance
+							double dist = cluster.getDistance(k);
+							// Create a Point with the concentration[i] as the value
+							// and add it to localPoints
+							xolotlViz::Point aPoint;
+							aPoint.value = cluster.getConcentration(dist);
+							aPoint.t = time;
+							aPoint.x = (double) k;
+							localPoints.push_back(aPoint);
 						}
-					});
+					}
+				});
+
+		// Bin the sizes before the points leave this process
+		localPoints = xolotlViz::binLogX(localPoints, vizLogBins1D);
+
+		// Send them to the master process in a single message
+		if (procId != 0) {
+			std::vector<double> buffer;
+			for (auto const& aPoint : localPoints) {
+				buffer.push_back(aPoint.x);
+				buffer.push_back(aPoint.value);
+			}
+			MPI_Send(buffer.data(), buffer.size(), MPI_DOUBLE, 0, 10,
+					MPI_COMM_WORLD);
 		}
+	}
 
-		// else receive the values from another process
-		else {
-			for (int i = 0; i < networkSize - superClusters.size(); i++) {
-				double conc = 0.0;
-				MPI_Recv(&conc, 1, MPI_DOUBLE, MPI_ANY_SOURCE, 10,
-						MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+	if (procId == 0) {
+		// Create a Point vector to store the data to give to the data provider
+		// for the visualization
+		auto myPoints = std::make_shared<std::vector<xolotlViz::Point> >(
+				localPoints);
+
+		// Receive the points from the process owning the middle of the grid
+		if (!isOwner) {
+			MPI_Status status;
+			MPI_Probe(MPI_ANY_SOURCE, 10, MPI_COMM_WORLD, &status);
+			int bufferSize = 0;
+			MPI_Get_count(&status, MPI_DOUBLE, &bufferSize);
+			std::vector<double> buffer(bufferSize);
+			MPI_Recv(buffer.data(), bufferSize, MPI_DOUBLE, status.MPI_SOURCE,
+					10, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+			for (int i = 0; i < bufferSize; i += 2) {
 				// Create a Point with conc as the value
 				// and add it to myPoints
 				xolotlViz::Point aPoint;
-				aPoint.value = conc;
+				aPoint.x = buffer[i];
+				aPoint.value = buffer[i + 1];
 				aPoint.t = time;
-				aPoint.x = (double) i + 1.0;
 				myPoints->push_back(aPoint);
 			}
-
-			// Loop on the super clusters
-			auto& allReactants = network.getAll();
-			std::for_each(allReactants.begin(), allReactants.end(),
-					[&time,&myPoints](IReactant& currReactant) {
-
-						if (currReactant.getType() == ReactantType::NESuper) {
-							auto& cluster = static_cast<NESuperCluster&>(currReactant);
-							// Get the width and average
-							int width = cluster.getSectionWidth();
-							double nXe = cluster.getAverage();
-							// Loop on the width
-							for (int k = nXe + 1.0 - (double) width / 2.0;
-									k < nXe + (double) width / 2.0; k++) {
-								double conc = 0.0;
-								MPI_Recv(&conc, 1, MPI_DOUBLE, MPI_ANY_SOURCE, 11,
-										MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-								// Create a Point with conc as the value
-								// and add it to myPoints
-								xolotlViz::Point aPoint;
-								aPoint.value = conc;
-								aPoint.t = time;
-								aPoint.x = (double) k;
-								myPoints->push_back(aPoint);
-							}
-						}
-					});
 		}
 
 		// Get the data provider and give it the points
@@ -1341,41 +1411,6 @@ PetscErrorCode monitorScatter1D(TS ts, PetscInt timestep, PetscReal time,
 		scatterPlot1D->write(fileName.str());
 	}
 
-	else {
-		// If the middle is on this process
-		if (ix >= xs && ix < xs + xm) {
-			// Get the pointer to the beginning of the solution data for this grid point
-			gridPointSolution = solutionArray[ix];
-
-			for (int i = 0; i < networkSize - superClusters.size(); i++) {
-				// Send the value of each concentration to the master process
-				MPI_Send(&gridPointSolution[i], 1, MPI_DOUBLE, 0, 10,
-						MPI_COMM_WORLD);
-			}
-
-			// Loop on the super clusters
-			auto& allReactants = network.getAll();
-			std::for_each(allReactants.begin(), allReactants.end(),
-					[](IReactant& currReactant) {
-
-						if (currReactant.getType() == ReactantType::NESuper) {
-							auto& cluster = static_cast<NESuperCluster&>(currReactant);
-							// Get the width and average
-							int width = cluster.getSectionWidth();
-							double nXe = cluster.getAverage();
-							// Loop on the width
-							for (int k = nXe + 1.0 - (double) width / 2.0; k < nXe + (double) width / 2.0; k++) {
-								// Compute the distance
-								double dist = cluster.getDistance(k);
-								double conc = cluster.getConcentration(dist);
-								// Send the value of each concentration to the master process
-								MPI_Send(&conc, 1, MPI_DOUBLE, 0, 11, MPI_COMM_WORLD);
-							}
-						}
-					});
-		}
-	}
-
 	// Restore the solutionArray
 	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
@@ -1396,15 +1431,10 @@ PetscErrorCode monitorSeries1D(TS ts, PetscInt timestep, PetscReal time,
 	// Initial declarations
 	PetscErrorCode ierr;
 	const double **solutionArray, *gridPointSolution;
-	PetscInt xs, xm, xi;
-	double x = 0.0;
+	PetscInt xs, xm, xi, Mx;
 
 	PetscFunctionBeginUser;
 
-	// Don't do anything if it is not on the stride
-	if (timestep % 10 != 0)
-		PetscFunctionReturn(0);
-
 	// Get the number of processes
 	int worldSize;
 	MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
@@ -1426,6 +1456,13 @@ PetscErrorCode monitorSeries1D(TS ts, PetscInt timestep, PetscReal time,
 	ierr = DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL);
 	CHKERRQ(ierr);
 
+	// Get the size of the total grid
+	ierr = DMDAGetInfo(da, PETSC_IGNORE, &Mx, PETSC_IGNORE, PETSC_IGNORE,
+	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
+	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
+	PETSC_IGNORE);
+	CHKERRQ(ierr);
+
 	// Get the solver handler
 	auto& solverHandler = PetscSolver::getSolverHandler();
 
@@ -1439,52 +1476,55 @@ PetscErrorCode monitorSeries1D(TS ts, PetscInt timestep, PetscReal time,
 	// To plot a maximum of 18 clusters of the whole benchmark
 	const int loopSize = std::min(18, networkSize);
 
-	if (procId == 0) {
-		// Create a Point vector to store the data to give to the data provider
-		// for the visualization
-		std::vector<std::vector<xolotlViz::Point> > myPoints(loopSize);
+	// Create a Point vector for each cluster to store the data to give to
+	// the data providers for the visualization
+	std::vector<std::vector<xolotlViz::Point> > myPoints(loopSize);
 
-		// Loop on the grid
-		for (xi = xs; xi < xs + xm; xi++) {
-			// Get the pointer to the beginning of the solution data for this grid point
-			gridPointSolution = solutionArray[xi];
+	// Loop on the grid
+	for (xi = xs; xi < xs + xm; xi++) {
+		// Get the pointer to the beginning of the solution data for this grid point
+		gridPointSolution = solutionArray[xi];
 
-			for (int i = 0; i < loopSize; i++) {
-				// Create a Point with the concentration[i] as the value
-				// and add it to myPoints
-				xolotlViz::Point aPoint;
-				aPoint.value = gridPointSolution[i];
-				aPoint.t = time;
-				aPoint.x = grid[xi + 1] - grid[1];
-				myPoints[i].push_back(aPoint);
-			}
+		for (int i = 0; i < loopSize; i++) {
+			// Create a Point with the concentration[i] as the value
+			// and add it to myPoints
+			xolotlViz::Point aPoint;
+			aPoint.value = gridPointSolution[i];
+			aPoint.t = time;
+			aPoint.x = grid[xi + 1] - grid[1];
+			myPoints[i].push_back(aPoint);
 		}
+	}
+
+	// Decimate the points before they leave this process, two points being
+	// kept per bin
+	int binSize =
+			(vizMaxPoints1D > 0) ?
+					(2 * Mx + vizMaxPoints1D - 1) / vizMaxPoints1D : 1;
+	for (int i = 0; i < loopSize; i++) {
+		myPoints[i] = xolotlViz::decimateMinMax(myPoints[i], binSize);
+	}
 
+	if (procId == 0) {
 		// Loop on the other processes
 		for (int i = 1; i < worldSize; i++) {
-			// Get the size of the local grid of that process
-			int localSize = 0;
-			MPI_Recv(&localSize, 1, MPI_INT, i, 20, PETSC_COMM_WORLD,
-					MPI_STATUS_IGNORE);
-
-			// Loop on their grid
-			for (int k = 0; k < localSize; k++) {
-				// Get the position
-				MPI_Recv(&x, 1, MPI_DOUBLE, i, 21, PETSC_COMM_WORLD,
-						MPI_STATUS_IGNORE);
-
-				for (int j = 0; j < loopSize; j++) {
-					// and the concentrations
-					double conc = 0.0;
-					MPI_Recv(&conc, 1, MPI_DOUBLE, i, 22, PETSC_COMM_WORLD,
-							MPI_STATUS_IGNORE);
-
+			for (int j = 0; j < loopSize; j++) {
+				// Get the positions and concentrations of this cluster
+				MPI_Status status;
+				MPI_Probe(i, 20, PETSC_COMM_WORLD, &status);
+				int bufferSize = 0;
+				MPI_Get_count(&status, MPI_DOUBLE, &bufferSize);
+				std::vector<double> buffer(bufferSize);
+				MPI_Recv(buffer.data(), bufferSize, MPI_DOUBLE, i, 20,
+						PETSC_COMM_WORLD, MPI_STATUS_IGNORE);
+
+				for (int k = 0; k < bufferSize; k += 2) {
 					// Create a Point with the concentration[i] as the value
 					// and add it to myPoints
 					xolotlViz::Point aPoint;
-					aPoint.value = conc;						// He
+					aPoint.x = buffer[k];
+					aPoint.value = buffer[k + 1];
 					aPoint.t = time;
-					aPoint.x = x;
 					myPoints[j].push_back(aPoint);
 				}
 			}
@@ -1527,25 +1567,16 @@ PetscErrorCode monitorSeries1D(TS ts, PetscInt timestep, PetscReal time,
 	}
 
 	else {
-		// Send the value of the local grid size to the master process
-		MPI_Send(&xm, 1, MPI_DOUBLE, 0, 20, PETSC_COMM_WORLD);
-
-		// Loop on the grid
-		for (xi = xs; xi < xs + xm; xi++) {
-			// Dump x
-			x = grid[xi + 1] - grid[1];
-
-			// Get the pointer to the beginning of the solution data for this grid point
-			gridPointSolution = solutionArray[xi];
-
-			// Send the value of the local position to the master process
-			MPI_Send(&x, 1, MPI_DOUBLE, 0, 21, PETSC_COMM_WORLD);
-
-			for (int i = 0; i < loopSize; i++) {
-				// Send the value of the concentrations to the master process
-				MPI_Send(&gridPointSolution[i], 1, MPI_DOUBLE, 0, 22,
-						PETSC_COMM_WORLD);
+		for (int i = 0; i < loopSize; i++) {
+			// Send the positions and concentrations of this cluster to the
+			// master process in a single message
+			std::vector<double> buffer;
+			for (auto const& aPoint : myPoints[i]) {
+				buffer.push_back(aPoint.x);
+				buffer.push_back(aPoint.value);
 			}
+			MPI_Send(buffer.data(), buffer.size(), MPI_DOUBLE, 0, 20,
+					PETSC_COMM_WORLD);
 		}
 	}
 
@@ -1574,10 +1605,6 @@ PetscErrorCode monitorSurface1D(TS ts, PetscInt timestep, PetscReal time,
 
 	PetscFunctionBeginUser;
 
-	// Don't do anything if it is not on the stride
-	if (timestep % 10 != 0)
-		PetscFunctionReturn(0);
-
 	// Get the da from ts
 	DM da;
 	ierr = TSGetDM(ts, &da);
@@ -1690,6 +1717,9 @@ PetscErrorCode monitorSurface1D(TS ts, PetscInt timestep, PetscReal time,
 			}
 		}
 
+		// Merge the blocks of cells
+		*myPoints = xolotlViz::coarsenXY(*myPoints, vizCoarsen1D);
+
 		// Get the data provider and give it the points
 		surfacePlot1D->getDataProvider()->setPoints(myPoints);
 		surfacePlot1D->getDataProvider()->setDataName("brian");
@@ -1725,244 +1755,6 @@ PetscErrorCode monitorSurface1D(TS ts, PetscInt timestep, PetscReal time,
 	PetscFunctionReturn(0);
 }
 
-#undef __FUNCT__
-#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "monitorMeanSize1D")
-/**
- * This is a monitoring method that will create files with the mean
- * helium size as a function of depth at each time step.
- */
-PetscErrorCode monitorMeanSize1D(TS ts, PetscInt timestep, PetscReal time,
-		Vec solution, void *ictx) {
-
-	xperf::ScopedTimer myTimer(meanSizeTimer);
-
-	// Initial declaration
-	PetscErrorCode ierr;
-	const double **solutionArray, *gridPointSolution;
-	PetscInt xs, xm, xi, Mx;
-	double x = 0.0;
-
-	PetscFunctionBeginUser;
-
-	// Get the number of processes
-	int worldSize;
-	MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
-
-	// Gets the process ID
-	int procId;
-	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
-
-	// Get the da from ts
-	DM da;
-	ierr = TSGetDM(ts, &da);
-	CHKERRQ(ierr);
-
-	// Get the solutionArray
-	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
-
-	// Get the corners of the grid
-	ierr = DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL);
-	CHKERRQ(ierr);
-
-	// Get the size of the total grid
-	ierr = DMDAGetInfo(da, PETSC_IGNORE, &Mx, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE);
-	CHKERRQ(ierr);
-
-	// Get the solver handler
-	auto& solverHandler = PetscSolver::getSolverHandler();
-
-	// Get the network
-	auto& network = solverHandler.getNetwork();
-
-	// Get the physical grid
-	auto grid = solverHandler.getXGrid();
-
-	// Create the output file
-	std::ofstream outputFile;
-	if (procId == 0) {
-		std::stringstream name;
-		name << "heliumSizeMean_" << timestep << ".dat";
-		outputFile.open(name.str());
-	}
-
-	// Loop on the full grid
-	for (xi = 0; xi < Mx; xi++) {
-		// Get the x position
-		x = grid[xi + 1] - grid[1];
-
-		// Initialize the values to write in the file
-		double heliumMean = 0.0;
-
-		// If this is the locally owned part of the grid
-		if (xi >= xs && xi < xs + xm) {
-			// Compute the mean and standard deviation of helium cluster size
-
-			// Get the pointer to the beginning of the solution data for this grid point
-			gridPointSolution = solutionArray[xi];
-
-			// Initialize the total helium and concentration before looping
-			double concTot = 0.0, heliumTot = 0.0;
-
-			// Loop on all the indices to compute the mean
-			for (int i = 0; i < indices1D.size(); i++) {
-				concTot += gridPointSolution[indices1D[i]];
-				heliumTot += gridPointSolution[indices1D[i]] * weights1D[i];
-			}
-
-			// Loop on all the super clusters
-			for (auto const& superMapItem : network.getAll(
-					ReactantType::PSISuper)) {
-				auto const& cluster =
-						static_cast<PSISuperCluster&>(*(superMapItem.second));
-				concTot += cluster.getTotalConcentration();
-				heliumTot += cluster.getTotalAtomConcentration();
-			}
-
-			// Compute the mean size of helium at this depth
-			heliumMean = heliumTot / concTot;
-		}
-
-		// Get the mean on procId = 0 through MPI reduce
-		double heliumMeanTot = 0.0;
-		MPI_Reduce(&heliumMean, &heliumMeanTot, 1, MPI_DOUBLE, MPI_SUM, 0,
-				PETSC_COMM_WORLD);
-
-		// The master process writes in the file
-		if (procId == 0) {
-			outputFile << x << " " << heliumMeanTot << std::endl;
-		}
-	}
-
-	// Close the file
-	if (procId == 0) {
-		outputFile.close();
-	}
-
-	// Restore the solutionArray
-	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
-
-	PetscFunctionReturn(0);
-}
-
-#undef __FUNCT__
-#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "monitorMaxClusterConc1D")
-/**
- * This is a monitoring method that will print a message when the biggest cluster
- * in the network reaches a non-negligible concentration value.
- */
-PetscErrorCode monitorMaxClusterConc1D(TS ts, PetscInt timestep, PetscReal time,
-		Vec solution, void *) {
-
-	xperf::ScopedTimer myTimer(maxClusterConcTimer);
-
-	// Initial declarations
-	PetscErrorCode ierr;
-	const double **solutionArray, *gridPointSolution;
-	PetscInt xs, xm, xi;
-
-	PetscFunctionBeginUser;
-
-	// Don't do anything if it was already printed
-	if (!printMaxClusterConc1D)
-		PetscFunctionReturn(0);
-
-	// Get the da from ts
-	DM da;
-	ierr = TSGetDM(ts, &da);
-	CHKERRQ(ierr);
-
-	// Get the solutionArray
-	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
-
-	// Get the corners of the grid
-	ierr = DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL);
-	CHKERRQ(ierr);
-
-	// Get the solver handler
-	auto& solverHandler = PetscSolver::getSolverHandler();
-
-	// Get the network
-	auto& network = solverHandler.getNetwork();
-
-	// Get the maximum size of HeV clusters
-	auto const& psiNetwork =
-			dynamic_cast<PSIClusterReactionNetwork const&>(network);
-	IReactant::SizeType maxHeVClusterSize = psiNetwork.getMaxClusterSize(
-			ReactantType::PSIMixed);
-	// Get the maximum size of V clusters
-	IReactant::SizeType maxVClusterSize = psiNetwork.getMaxClusterSize(
-			ReactantType::V);
-	// Get the number of He in the max HeV cluster
-	IReactant::SizeType maxHeSize = (maxHeVClusterSize - maxVClusterSize);
-	// Get the maximum stable HeV cluster
-	IReactant * maxCluster;
-	IReactant::Composition testComp;
-	testComp[toCompIdx(Species::He)] = maxHeSize;
-	testComp[toCompIdx(Species::V)] = maxVClusterSize;
-	maxCluster = network.get(ReactantType::PSIMixed, testComp);
-	if (!maxCluster) {
-		// Get the maximum size of Xe clusters
-		auto const& neNetwork =
-				dynamic_cast<NEClusterReactionNetwork const&>(network);
-		int maxXeClusterSize = neNetwork.getMaxClusterSize(ReactantType::Xe);
-		maxCluster = network.get(Species::Xe, maxXeClusterSize);
-	}
-
-	// Boolean to know if the concentration is too big
-	bool maxClusterTooBig = false;
-
-	// Check the concentration of the biggest cluster at each grid point
-	for (xi = xs; xi < xs + xm; xi++) {
-		// Get the pointer to the beginning of the solution data for this grid point
-		gridPointSolution = solutionArray[xi];
-
-		// Get the concentration of the maximum HeV cluster
-		auto maxClusterConc = gridPointSolution[maxCluster->getId() - 1];
-
-		if (maxClusterConc > 1.0e-16)
-			maxClusterTooBig = true;
-	}
-
-	// Get the current process ID
-	int procId;
-	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
-
-	// Is the concentration too big on any process?
-	bool tooBig = false;
-	MPI_Reduce(&maxClusterTooBig, &tooBig, 1, MPI_C_BOOL, MPI_LOR, 0,
-			PETSC_COMM_WORLD);
-
-	// Main process
-	if (procId == 0) {
-		// Print if tooBig is true
-		if (tooBig) {
-			std::cout << std::endl;
-			std::cout << "At time step: " << timestep << " and time: " << time
-					<< " the biggest cluster: " << maxCluster->getName()
-					<< " reached a concentration above 1.0e-16 at at least one grid point."
-					<< std::endl << std::endl;
-
-			// Don't print anymore
-			printMaxClusterConc1D = false;
-		}
-	}
-
-	// Broadcast the information about printMaxClusterConc1D to the other processes
-	MPI_Bcast(&printMaxClusterConc1D, 1, MPI_C_BOOL, 0, PETSC_COMM_WORLD);
-
-	// Restore the solutionArray
-	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
-
-	PetscFunctionReturn(0);
-}
-
 #undef __FUNCT__
 #define __FUNCT__ Actual__FUNCT__("xolotlSolver", "eventFunction1D")
 /**
@@ -2030,11 +1822,8 @@ PetscErrorCode eventFunction1D(TS ts, PetscReal time, Vec solution,
 	if (solverHandler.moveSurface()) {
 		// Write the initial surface position
 		if (procId == 0 && xolotlCore::equal(time, 0.0)) {
-			std::ofstream outputFile;
-			outputFile.open("surface.txt", ios::app);
-			outputFile << time << " " << grid[surfacePos + 1] - grid[1]
-					<< std::endl;
-			outputFile.close();
+			appendTimeSeries("surface", { "time", "surface" },
+					{ time, grid[surfacePos + 1] - grid[1] });
 		}
 
 		// Value to know on which processor is the location of the surface,
@@ -2212,6 +2001,9 @@ PetscErrorCode postEventFunction1D(TS ts, PetscInt nevents,
 		PetscFunctionReturn(0);
 	}
 
+	// The monitors sampling the events are due at the next time step
+	MonitorSchedule::notifyEvent();
+
 	// Check if both events happened
 	if (nevents == 3)
 		throw std::string(
@@ -2249,6 +2041,7 @@ PetscErrorCode postEventFunction1D(TS ts, PetscInt nevents,
 	auto grid = solverHandler.getXGrid();
 
 	// Take care of bursting
+	std::vector<double> burstDistances;
 
 	// Loop on each bursting depth
 	for (int i = 0; i < depthPositions1D.size(); i++) {
@@ -2260,11 +2053,9 @@ PetscErrorCode postEventFunction1D(TS ts, PetscInt nevents,
 		// Get the distance from the surface
 		double distance = grid[depthPositions1D[i] + 1] - grid[surfacePos + 1];
 
-		// Write the bursting information
-		std::ofstream outputFile;
-		outputFile.open("bursting.txt", ios::app);
-		outputFile << time << " " << distance << std::endl;
-		outputFile.close();
+		// Keep the bursting information
+		burstDistances.push_back(distance);
+		burstingCounter->increment();
 
 		// Pinhole case
 		// Consider each He to reset their concentration at this grid point
@@ -2335,6 +2126,27 @@ PetscErrorCode postEventFunction1D(TS ts, PetscInt nevents,
 		}
 	}
 
+	// Gather the bursting information on the master process
+	int nLocalBursts = burstDistances.size(), nProcs;
+	MPI_Comm_size(PETSC_COMM_WORLD, &nProcs);
+	std::vector<int> nBursts(nProcs, 0), burstOffsets(nProcs + 1, 0);
+	MPI_Gather(&nLocalBursts, 1, MPI_INT, nBursts.data(), 1, MPI_INT, 0,
+			PETSC_COMM_WORLD);
+	for (int i = 0; i < nProcs; i++)
+		burstOffsets[i + 1] = burstOffsets[i] + nBursts[i];
+	std::vector<double> allBurstDistances(burstOffsets[nProcs]);
+	MPI_Gatherv(burstDistances.data(), nLocalBursts, MPI_DOUBLE,
+			allBurstDistances.data(), nBursts.data(), burstOffsets.data(),
+			MPI_DOUBLE, 0, PETSC_COMM_WORLD);
+
+	// Write it
+	if (procId == 0) {
+		for (auto distance : allBurstDistances) {
+			appendTimeSeries("bursting", { "time", "distance" },
+					{ time, distance });
+		}
+	}
+
 	// Now takes care of moving surface
 	bool moving = false;
 	bool movingUp = false;
@@ -2353,6 +2165,7 @@ PetscErrorCode postEventFunction1D(TS ts, PetscInt nevents,
 
 		PetscFunctionReturn(0);
 	}
+	surfaceMoveCounter->increment();
 
 	// Set the surface position
 	xi = surfacePos + 1;
@@ -2498,11 +2311,8 @@ PetscErrorCode postEventFunction1D(TS ts, PetscInt nevents,
 
 	// Write the updated surface position
 	if (procId == 0) {
-		std::ofstream outputFile;
-		outputFile.open("surface.txt", ios::app);
-		outputFile << time << " " << grid[surfacePos + 1] - grid[1]
-				<< std::endl;
-		outputFile.close();
+		appendTimeSeries("surface", { "time", "surface" },
+				{ time, grid[surfacePos + 1] - grid[1] });
 	}
 
 	// Restore the solutionArray
@@ -2526,20 +2336,17 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 	// Initialize the timers, including the one for this function.
 	initTimer = handlerRegistry->getTimer("monitor1D:init");
 	xperf::ScopedTimer myTimer(initTimer);
-	checkNegativeTimer = handlerRegistry->getTimer("monitor1D:checkNeg");
 	tridynTimer = handlerRegistry->getTimer("monitor1D:tridyn");
 	startStopTimer = handlerRegistry->getTimer("monitor1D:startStop");
-	heRetentionTimer = handlerRegistry->getTimer("monitor1D:heRet");
-	xeRetentionTimer = handlerRegistry->getTimer("monitor1D:xeRet");
-	heConcTimer = handlerRegistry->getTimer("monitor1D:heConc");
-	cumHeTimer = handlerRegistry->getTimer("monitor1D:cumHe");
+	sweepTimer = handlerRegistry->getTimer("monitor1D:sweep");
 	scatterTimer = handlerRegistry->getTimer("monitor1D:scatter");
 	seriesTimer = handlerRegistry->getTimer("monitor1D:series");
 	surfaceTimer = handlerRegistry->getTimer("monitor1D:surface");
-	meanSizeTimer = handlerRegistry->getTimer("monitor1D:meanSize");
-	maxClusterConcTimer = handlerRegistry->getTimer("monitor1D:maxClusterConc");
 	eventFuncTimer = handlerRegistry->getTimer("monitor1D:event");
 	postEventFuncTimer = handlerRegistry->getTimer("monitor1D:postEvent");
+	burstingCounter = handlerRegistry->getEventCounter("monitor1D:bursting");
+	surfaceMoveCounter = handlerRegistry->getEventCounter(
+			"monitor1D:surfaceMove");
 
 	// Get the process ID
 	int procId;
@@ -2551,7 +2358,8 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 	// Flags to launch the monitors or not
 	PetscBool flagNeg, flagCollapse, flag2DPlot, flag1DPlot, flagSeries,
 			flagPerf, flagHeRetention, flagStatus, flagMaxClusterConc,
-			flagCumul, flagMeanSize, flagConc, flagXeRetention, flagTRIDYN;
+			flagCumul, flagMeanSize, flagConc, flagXeRetention, flagTRIDYN,
+			flagSizeStats, flagTelemetry;
 
 	// Check the option -check_negative
 	ierr = PetscOptionsHasName(NULL, NULL, "-check_negative", &flagNeg);
@@ -2568,6 +2376,11 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 	checkPetscError(ierr,
 			"setupPetsc1DMonitor: PetscOptionsHasName (-plot_perf) failed.");
 
+	// Check the option -telemetry
+	ierr = PetscOptionsHasName(NULL, NULL, "-telemetry", &flagTelemetry);
+	checkPetscError(ierr,
+			"setupPetsc1DMonitor: PetscOptionsHasName (-telemetry) failed.");
+
 	// Check the option -plot_series
 	ierr = PetscOptionsHasName(NULL, NULL, "-plot_series", &flagSeries);
 	checkPetscError(ierr,
@@ -2621,6 +2434,11 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 	checkPetscError(ierr,
 			"setupPetsc1DMonitor: PetscOptionsHasName (-mean_size) failed.");
 
+	// Check the option -size_statistics
+	ierr = PetscOptionsHasName(NULL, NULL, "-size_statistics", &flagSizeStats);
+	checkPetscError(ierr,
+			"setupPetsc1DMonitor: PetscOptionsHasName (-size_statistics) failed.");
+
 	// Check the option -tridyn
 	ierr = PetscOptionsHasName(NULL, NULL, "-tridyn", &flagTRIDYN);
 	checkPetscError(ierr,
@@ -2633,6 +2451,9 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 	auto& network = solverHandler.getNetwork();
 	const int networkSize = network.size();
 
+	// The observables computed from a single pass over the grid
+	std::unique_ptr<MonitorSweep> sweep(new MonitorSweep());
+
 	// Determine if we have an existing restart file,
 	// and if so, it it has had timesteps written to it.
 	std::unique_ptr<xolotlCore::XFile> networkFile;
@@ -2669,51 +2490,96 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 	// Set the monitor to check the negative concentrations
 	if (flagNeg) {
 		// Find the stride to know how often we want to check
+		PetscReal negStride = 0.0;
 		PetscBool flag;
-		ierr = PetscOptionsGetReal(NULL, NULL, "-check_negative", &negStride1D,
+		ierr = PetscOptionsGetReal(NULL, NULL, "-check_negative", &negStride,
 				&flag);
 		checkPetscError(ierr,
 				"setupPetsc1DMonitor: PetscOptionsGetInt (-check_negative) failed.");
-		if (!flag)
-			negStride1D = -1.0;
 
-		// Compute the correct negPrevious1D for a restart
-		// Get the last time step written in the HDF5 file
+		// Get the previous time if concentrations were stored
 		if (hasConcentrations) {
 
 			assert(lastTsGroup);
 
 			// Get the previous time from the HDF5 file
 			previousTime = lastTsGroup->readPreviousTime();
-			negPrevious1D = (int) (previousTime / negPrevious1D);
 		}
 
-		// checkNegative1D will be called at each timestep
-		ierr = TSMonitorSet(ts, checkNegative1D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc1DMonitor: TSMonitorSet (checkNegative1D) failed.");
+		// The concentrations will be checked by the sweep on the stride,
+		// or at each timestep
+		sweep->add(
+				std::unique_ptr<SweepObservable>(
+						new NegativeCheck1D(network)),
+				getMonitorSchedule("check_negative",
+						(flag && negStride > 0.0) ?
+								MonitorSchedule(
+										MonitorSchedule::Cadence::Time,
+										negStride) :
+								MonitorSchedule()));
 	}
 
 	// Set the monitor to save the status of the simulation in hdf5 file
 	if (flagStatus) {
 		// Find the stride to know how often the HDF5 file has to be written
+		PetscReal hdf5Stride = 0.0;
 		PetscBool flag;
-		ierr = PetscOptionsGetReal(NULL, NULL, "-start_stop", &hdf5Stride1D,
+		ierr = PetscOptionsGetReal(NULL, NULL, "-start_stop", &hdf5Stride,
 				&flag);
 		checkPetscError(ierr,
 				"setupPetsc1DMonitor: PetscOptionsGetInt (-start_stop) failed.");
 		if (!flag)
-			hdf5Stride1D = 1.0;
+			hdf5Stride = 1.0;
+
+		// Find how often a full checkpoint is written, and the
+		// relative change to write in the ones in between
+		ierr = PetscOptionsGetInt(NULL, NULL, "-start_stop_keyframe",
+				&keyframeStride1D, NULL);
+		checkPetscError(ierr,
+				"setupPetsc1DMonitor: PetscOptionsGetInt (-start_stop_keyframe) failed.");
+		ierr = PetscOptionsGetReal(NULL, NULL, "-start_stop_delta_tol",
+				&deltaTolerance1D, NULL);
+		checkPetscError(ierr,
+				"setupPetsc1DMonitor: PetscOptionsGetReal (-start_stop_delta_tol) failed.");
+
+		// Find how many time steps are kept in the checkpoint file
+		ierr = PetscOptionsGetInt(NULL, NULL, "-start_stop_keep",
+				&nKeptTimeSteps1D, NULL);
+		checkPetscError(ierr,
+				"setupPetsc1DMonitor: PetscOptionsGetInt (-start_stop_keep) failed.");
+
+		// Find the analysis file and what is written in it
+		char analysisName[PETSC_MAX_PATH_LEN];
+		PetscBool flagAnalysis, flagNoConcs;
+		ierr = PetscOptionsGetString(NULL, NULL, "-start_stop_analysis",
+				analysisName, PETSC_MAX_PATH_LEN, &flagAnalysis);
+		checkPetscError(ierr,
+				"setupPetsc1DMonitor: PetscOptionsGetString (-start_stop_analysis) failed.");
+		if (flagAnalysis)
+			analysisName1D = analysisName;
+		ierr = PetscOptionsGetInt(NULL, NULL, "-start_stop_analysis_bits",
+				&analysisBits1D, NULL);
+		checkPetscError(ierr,
+				"setupPetsc1DMonitor: PetscOptionsGetInt (-start_stop_analysis_bits) failed.");
+		ierr = PetscOptionsHasName(NULL, NULL, "-start_stop_analysis_no_concs",
+				&flagNoConcs);
+		checkPetscError(ierr,
+				"setupPetsc1DMonitor: PetscOptionsHasName (-start_stop_analysis_no_concs) failed.");
+		analysisConcs1D = !flagNoConcs;
+
+		// Find the relative tolerance of the concentrations to write
+		ierr = PetscOptionsGetReal(NULL, NULL, "-start_stop_rel_tol",
+				&relTolerance1D, NULL);
+		checkPetscError(ierr,
+				"setupPetsc1DMonitor: PetscOptionsGetReal (-start_stop_rel_tol) failed.");
 
-		// Compute the correct hdf5Previous1D for a restart
-		// Get the last time step written in the HDF5 file
+		// Get the previous time if concentrations were stored
 		if (hasConcentrations) {
 
 			assert(lastTsGroup);
 
 			// Get the previous time from the HDF5 file
 			previousTime = lastTsGroup->readPreviousTime();
-			hdf5Previous1D = (int) (previousTime / hdf5Stride1D);
 		}
 
 		// Don't do anything if both files have the same name
@@ -2762,12 +2628,30 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 			// The checkpoint file must be closed before doing this.
 			writeNetwork(PETSC_COMM_WORLD, solverHandler.getNetworkName(),
 					hdf5OutputName1D, network);
+		} else if (networkFile) {
+			// The checkpoints are appended to the file we restart from, the
+			// first one updates its header if the grid changed (it may have
+			// been adapted), the grid read back being compared exactly
+			auto headerGroup = networkFile->getGroup<
+					xolotlCore::XFile::HeaderGroup>();
+			auto grid = solverHandler.getXGrid();
+			if (headerGroup and headerGroup->readXGrid() != grid)
+				headerGrid1D = grid;
 		}
 
-		// startStop1D will be called at each timestep
-		ierr = TSMonitorSet(ts, startStop1D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc1DMonitor: TSMonitorSet (startStop1D) failed.");
+		// Create the analysis file, it does not need the network
+		// as it is not meant to restart from
+		if (!analysisName1D.empty()) {
+			xolotlCore::XFile analysisFile(analysisName1D,
+					solverHandler.getXGrid(), network.getCompositionList(),
+					PETSC_COMM_WORLD);
+		}
+
+		// startStop1D will be called on the stride
+		setScheduledMonitor(ts, "start_stop", startStop1D,
+				createCheckpointWriter(PETSC_COMM_WORLD),
+				destroyCheckpointWriter,
+				MonitorSchedule(MonitorSchedule::Cadence::Time, hdf5Stride));
 	}
 
 // If the user wants the surface to be able to move or bursting
@@ -2793,9 +2677,7 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 			sputteringYield1D = solverHandler.getSputteringYield();
 
 			// Clear the file where the surface will be written
-			std::ofstream outputFile;
-			outputFile.open("surface.txt");
-			outputFile.close();
+			clearTimeSeries("surface");
 		}
 
 		// Bursting
@@ -2817,9 +2699,7 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 				"setupPetsc1DMonitor: TSSetEventHandler (eventFunction1D) failed.");
 
 		// Uncomment to clear the file where the bursting info will be written
-		std::ofstream outputFile;
-		outputFile.open("bursting.txt");
-		outputFile.close();
+		clearTimeSeries("bursting");
 	}
 
 // Set the monitor to save 1D plot of xenon distribution
@@ -2849,10 +2729,16 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 			scatterPlot1D->setDataProvider(dataProvider);
 		}
 
-		// monitorScatter1D will be called at each timestep
-		ierr = TSMonitorSet(ts, monitorScatter1D, NULL, NULL);
+		// Get the number of bins per decade of size, if any
+		PetscBool flag;
+		ierr = PetscOptionsGetInt(NULL, NULL, "-viz_log_bins", &vizLogBins1D,
+				&flag);
 		checkPetscError(ierr,
-				"setupPetsc1DMonitor: TSMonitorSet (monitorScatter1D) failed.");
+				"setupPetsc1DMonitor: PetscOptionsGetInt (-viz_log_bins) failed.");
+
+		// monitorScatter1D will be called on its schedule
+		setScheduledMonitor(ts, "plot_1d", monitorScatter1D, NULL, NULL,
+				MonitorSchedule(MonitorSchedule::Cadence::Steps, 200));
 	}
 
 // Set the monitor to save 1D plot of many concentrations
@@ -2893,10 +2779,16 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 			}
 		}
 
-		// monitorSeries1D will be called at each timestep
-		ierr = TSMonitorSet(ts, monitorSeries1D, NULL, NULL);
+		// Get the largest number of points per cluster, if any
+		PetscBool flag;
+		ierr = PetscOptionsGetInt(NULL, NULL, "-viz_max_points",
+				&vizMaxPoints1D, &flag);
 		checkPetscError(ierr,
-				"setupPetsc1DMonitor: TSMonitorSet (monitorSeries1D) failed.");
+				"setupPetsc1DMonitor: PetscOptionsGetInt (-viz_max_points) failed.");
+
+		// monitorSeries1D will be called on its schedule
+		setScheduledMonitor(ts, "plot_series", monitorSeries1D, NULL, NULL,
+				MonitorSchedule(MonitorSchedule::Cadence::Steps, 10));
 	}
 
 // Set the monitor to save surface plots of clusters concentration
@@ -2923,10 +2815,16 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 		// Give it to the plot
 		surfacePlot1D->setDataProvider(dataProvider);
 
-		// monitorSurface1D will be called at each timestep
-		ierr = TSMonitorSet(ts, monitorSurface1D, NULL, NULL);
+		// Get the number of cells to merge, if any
+		PetscBool flag;
+		ierr = PetscOptionsGetInt(NULL, NULL, "-viz_coarsen", &vizCoarsen1D,
+				&flag);
 		checkPetscError(ierr,
-				"setupPetsc1DMonitor: TSMonitorSet (monitorSurface1D) failed.");
+				"setupPetsc1DMonitor: PetscOptionsGetInt (-viz_coarsen) failed.");
+
+		// monitorSurface1D will be called on its schedule
+		setScheduledMonitor(ts, "plot_2d", monitorSurface1D, NULL, NULL,
+				MonitorSchedule(MonitorSchedule::Cadence::Steps, 10));
 	}
 
 // Set the monitor to save performance plots (has to be in parallel)
@@ -2954,15 +2852,13 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 			perfPlot->setDataProvider(dataProvider);
 		}
 
-		// monitorPerf will be called at each timestep
-		ierr = TSMonitorSet(ts, monitorPerf, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc1DMonitor: TSMonitorSet (monitorPerf) failed.");
+		// monitorPerf will be called on its schedule
+		setScheduledMonitor(ts, "plot_perf", monitorPerf, NULL, NULL);
 	}
 
 // Initialize indices1D and weights1D if we want to compute the
 // retention or the cumulative value and others
-	if (flagMeanSize || flagConc || flagHeRetention) {
+	if (flagConc || flagHeRetention) {
 		// Loop on the helium clusters
 		for (auto const& heMapItem : network.getAll(ReactantType::He)) {
 			auto const& cluster = *(heMapItem.second);
@@ -2972,7 +2868,6 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 			indices1D.push_back(id);
 			// Add the number of heliums of this cluster to the weight
 			weights1D.push_back(cluster.getSize());
-			radii1D.push_back(cluster.getReactionRadius());
 		}
 
 		// Loop on the helium-vacancy clusters
@@ -2985,13 +2880,14 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 			// Add the number of heliums of this cluster to the weight
 			auto& comp = cluster.getComposition();
 			weights1D.push_back(comp[toCompIdx(Species::He)]);
-			radii1D.push_back(cluster.getReactionRadius());
 		}
 	}
 
 // Set the monitor to compute the helium fluence and the retention
 // for the retention calculation
 	if (flagHeRetention) {
+		// Compute the contents from the solution directly
+		heRetentionWeights1D = createHeliumRetentionWeights(network);
 
 		// Get the previous time if concentrations were stored and initialize the fluence
 		if (hasConcentrations) {
@@ -3027,15 +2923,12 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 		checkPetscError(ierr,
 				"setupPetsc1DMonitor: TSMonitorSet (computeFluence) failed.");
 
-		// computeHeliumRetention1D will be called at each timestep
-		ierr = TSMonitorSet(ts, computeHeliumRetention1D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc1DMonitor: TSMonitorSet (computeHeliumRetention1D) failed.");
+		// The retention will be computed by the sweep on its schedule
+		sweep->add(std::unique_ptr<SweepObservable>(new HeliumRetention1D()),
+				getMonitorSchedule("helium_retention"));
 
 		// Uncomment to clear the file where the retention will be written
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt");
-		outputFile.close();
+		clearTimeSeries("retentionOut");
 	}
 
 // Set the monitor to compute the xenon fluence and the retention
@@ -3050,9 +2943,11 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 			indices1D.push_back(id);
 			// Add the number of xenon of this cluster to the weight
 			weights1D.push_back(cluster.getSize());
-			radii1D.push_back(cluster.getReactionRadius());
 		}
 
+		// Compute the retention from the solution directly
+		xeRetentionWeights1D = createXenonRetentionWeights(network);
+
 		// Get the previous time if concentrations were stored and initialize the fluence
 		if (hasConcentrations) {
 
@@ -3076,57 +2971,90 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 		checkPetscError(ierr,
 				"setupPetsc1DMonitor: TSMonitorSet (computeFluence) failed.");
 
-		// computeXenonRetention1D will be called at each timestep
-		ierr = TSMonitorSet(ts, computeXenonRetention1D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc1DMonitor: TSMonitorSet (computeXenonRetention1D) failed.");
+		// The retention will be computed by the sweep on its schedule
+		sweep->add(std::unique_ptr<SweepObservable>(new XenonRetention1D()),
+				getMonitorSchedule("xenon_retention"));
 
 		// Uncomment to clear the file where the retention will be written
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt");
-		outputFile.close();
+		clearTimeSeries("retentionOut");
 	}
 
 // Set the monitor to compute the cumulative helium concentration
 	if (flagCumul) {
 
-		// computeCumulativeHelium1D will be called at each timestep
-		ierr = TSMonitorSet(ts, computeCumulativeHelium1D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc1DMonitor: TSMonitorSet (computeCumulativeHelium1D) failed.");
+		// The cumulative value will be computed by the sweep on its schedule
+		sweep->add(std::unique_ptr<SweepObservable>(new CumulativeHelium1D()),
+				getMonitorSchedule("helium_cumul"));
+	}
+
+// Compute the size sums from the solution directly
+	if (flagMeanSize || flagSizeStats) {
+		sizeMomentWeights1D = createSizeMomentWeights(network);
 	}
 
 // Set the monitor to save text file of the mean helium size
 	if (flagMeanSize) {
-		// monitorMeanSize1D will be called at each timestep
-		ierr = TSMonitorSet(ts, monitorMeanSize1D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc1DMonitor: TSMonitorSet (monitorMeanSize1D) failed.");
+		// The mean size will be computed by the sweep on its schedule
+		sweep->add(std::unique_ptr<SweepObservable>(new MeanSize1D()),
+				getMonitorSchedule("mean_size"));
+	}
+
+// Set the monitor to write the statistics of the bubble size
+	if (flagSizeStats) {
+		// The statistics will be computed by the sweep on its schedule
+		sweep->add(std::unique_ptr<SweepObservable>(new SizeStatistics1D()),
+				getMonitorSchedule("size_statistics"));
+
+		// Clear the file where the statistics will be written
+		clearTimeSeries("sizeStatistics");
 	}
 
 // Set the monitor to output information about when the maximum stable
 // cluster in the network first becomes greater than 1.0e-16
 	if (flagMaxClusterConc) {
-		// monitorMaxClusterConc1D will be called at each timestep
-		ierr = TSMonitorSet(ts, monitorMaxClusterConc1D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc1DMonitor: TSMonitorSet (monitorMaxClusterConc1D) failed.");
+		// The concentration will be checked by the sweep on its schedule
+		sweep->add(
+				std::unique_ptr<SweepObservable>(
+						new MaxClusterConc1D(network)),
+				getMonitorSchedule("max_cluster_conc"));
 	}
 
 // Set the monitor to compute the helium concentrations
 	if (flagConc) {
-		// computeHeliumConc1D will be called at each timestep
-		ierr = TSMonitorSet(ts, computeHeliumConc1D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc1DMonitor: TSMonitorSet (computeHeliumConc1D) failed.");
+		// The concentrations will be computed by the sweep on its schedule
+		sweep->add(std::unique_ptr<SweepObservable>(new HeliumConc1D()),
+				getMonitorSchedule("helium_conc"));
 	}
 
 // Set the monitor to output data for TRIDYN
 	if (flagTRIDYN) {
-		// computeTRIDYN1D will be called at each timestep
-		ierr = TSMonitorSet(ts, computeTRIDYN1D, NULL, NULL);
+		// Compute the contents from the solution directly
+		tridynWeights1D = createTRIDYNWeights(network);
+
+		// computeTRIDYN1D will be called on its schedule
+		setScheduledMonitor(ts, "tridyn", computeTRIDYN1D, NULL, NULL);
+	}
+
+// Set the monitor computing all the observables of the sweep from a
+// single pass over the grid, after the fluence is updated
+	if (!sweep->empty()) {
+		// monitorSweep1D will be called at each timestep, computing
+		// the observables that are due
+		sweep1D = sweep.get();
+		ierr = TSMonitorSet(ts, monitorSweep1D, sweep.release(),
+				destroyMonitorSweep1D);
 		checkPetscError(ierr,
-				"setupPetsc1DMonitor: TSMonitorSet (computeTRIDYN1D) failed.");
+				"setupPetsc1DMonitor: TSMonitorSet (monitorSweep1D) failed.");
+	}
+
+// Set the monitor to write what the solver did since the previous sample
+	if (flagTelemetry) {
+		// Register what is sampled and clear the file where the
+		// telemetry will be written
+		startTelemetry();
+
+		// monitorTelemetry will be called at each timestep by default
+		setScheduledMonitor(ts, "telemetry", monitorTelemetry, NULL, NULL);
 	}
 
 // Set the monitor to simply change the previous time to the new time
@@ -21,6 +21,7 @@
 #include "RandomNumberGenerator.h"
 #include "xolotlCore/io/XFile.h"
 #include "xolotlSolver/monitor/Monitor.h"
+#include "xolotlSolver/monitor/MonitorSchedule.h"
 
 namespace xolotlSolver {
 
@@ -32,18 +33,40 @@ extern PetscErrorCode computeFluence(TS ts, PetscInt timestep, PetscReal time,
 		Vec solution, void *ictx);
 extern PetscErrorCode monitorPerf(TS ts, PetscInt timestep, PetscReal time,
 		Vec solution, void *ictx);
+extern PetscErrorCode monitorTelemetry(TS ts, PetscInt timestep,
+		PetscReal time, Vec solution, void *ictx);
 
 // Declaration of the variables defined in Monitor.cpp
 extern std::shared_ptr<xolotlViz::IPlot> perfPlot;
 extern double previousTime;
 extern double timeStepThreshold;
 
-//! How often HDF5 file is written
-PetscReal hdf5Stride2D = 0.0;
-//! Previous time for HDF5
-PetscInt hdf5Previous2D = 0;
 //! HDF5 output file name
 std::string hdf5OutputName2D = "xolotlStop.h5";
+//! How often a full checkpoint (keyframe) is written, the ones
+//! in between only having the changes since the last keyframe
+PetscInt keyframeStride2D = 1;
+//! Relative change under which a concentration is not written in a delta
+PetscReal deltaTolerance2D = 0.0;
+//! Number of delta checkpoints written since the last keyframe
+PetscInt nDeltas2D = 0;
+//! Time step of the last keyframe
+PetscInt keyframeTimeStep2D = -1;
+//! Concentrations written in the last keyframe
+std::shared_ptr<XFile::TimestepGroup::Concs1DType> keyframeConcs2D;
+//! Number of time steps kept in the checkpoint file, all of them if not positive
+PetscInt nKeptTimeSteps2D = 0;
+//! Analysis file every checkpoint is appended to, none if empty
+std::string analysisName2D;
+//! Number of mantissa bits of the concentrations in the analysis file
+PetscInt analysisBits2D = 0;
+//! Whether the concentrations are written in the analysis file
+bool analysisConcs2D = true;
+//! Tolerance relative to the largest concentration under which
+//! a concentration is not written in the checkpoints
+PetscReal relTolerance2D = 0.0;
+//! Buffer reused to pack the concentrations of the checkpoints
+std::vector<int> packBuffer2D;
 //! The pointer to the 2D plot used in MonitorSurface.
 std::shared_ptr<xolotlViz::IPlot> surfacePlot2D;
 //! The variable to store the interstitial flux at the previous time step.
@@ -54,10 +77,15 @@ std::vector<double> nInterstitial2D;
 std::vector<double> previousHeFlux2D;
 //! The variable to store the total number of helium going through the bottom.
 std::vector<double> nHelium2D;
+//! The time the helium, deuterium, and tritium fluxes at the bottom were
+//! computed at.
+double bottomFluxTime2D = 0.0;
 //! The variable to store the xenon flux at the previous time step.
 double previousXeFlux2D = 0.0;
 //! The variable to store the total number of xenon going through the GB.
 double nXenon2D = 0.0;
+//! The time the xenon flux to the GB was computed at.
+double gbFluxTime2D = 0.0;
 //! The variable to store the deuterium flux at the previous time step.
 std::vector<double> previousDFlux2D;
 //! The variable to store the total number of deuterium going through the bottom.
@@ -70,13 +98,13 @@ std::vector<double> nTritium2D;
 double sputteringYield2D = 0.0;
 // The vector of depths at which bursting happens
 std::vector<std::pair<int, int> > depthPositions2D;
-// Declare the vector that will store the Id of the clusters
-std::vector<int> indices2D;
-// Declare the vector that will store the weight of the clusters
-// (their He composition)
-std::vector<int> weights2D;
-// Declare the vector that will store the radii of bubbles
-std::vector<double> radii2D;
+//! The weights of the helium, deuterium, and tritium contents
+xolotlCore::ObservableWeights heRetentionWeights2D;
+//! The weights of the xenon content, bubble density, and bubble radii
+xolotlCore::ObservableWeights xeRetentionWeights2D;
+//! The weights of the helium, deuterium, tritium, vacancy, and
+//! interstitial contents written for TRIDYN
+xolotlCore::ObservableWeights tridynWeights2D;
 
 #undef __FUNCT__
 #define __FUNCT__ Actual__FUNCT__("xolotlSolver", "startStop2D")
@@ -84,34 +112,14 @@ std::vector<double> radii2D;
  * This is a monitoring method that will update an hdf5 file at each time step.
  */
 PetscErrorCode startStop2D(TS ts, PetscInt timestep, PetscReal time,
-		Vec solution, void *) {
+		Vec solution, void *ictx) {
 	// Initial declaration
 	PetscErrorCode ierr;
-	const double ***solutionArray, *gridPointSolution;
+	const double ***solutionArray;
 	PetscInt xs, xm, Mx, ys, ym, My;
 
 	PetscFunctionBeginUser;
 
-	// Compute the dt
-	double dt = time - previousTime;
-
-	// Don't do anything if it is not on the stride
-	if (((int) ((time + dt / 10.0) / hdf5Stride2D) <= hdf5Previous2D)
-			&& timestep > 0)
-		PetscFunctionReturn(0);
-
-	// Update the previous time
-	if ((int) ((time + dt / 10.0) / hdf5Stride2D) > hdf5Previous2D)
-		hdf5Previous2D++;
-
-	// Get the number of processes
-	int worldSize;
-	MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
-
-	// Gets the process ID (important when it is running in parallel)
-	int procId;
-	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
-
 	// Get the da from ts
 	DM da;
 	ierr = TSGetDM(ts, &da);
@@ -139,100 +147,140 @@ PetscErrorCode startStop2D(TS ts, PetscInt timestep, PetscReal time,
 	// Network size
 	const int dof = network.getDOF();
 
-	// Create an array for the concentration
-	double concArray[dof][2];
-
 	// Get the vector of positions of the surface
 	std::vector<int> surfaceIndices;
 	for (PetscInt i = 0; i < My; i++) {
 		surfaceIndices.push_back(solverHandler.getSurfacePosition(i));
 	}
 
-	// Open the existing checkpoint file.
-	xolotlCore::XFile checkpointFile(hdf5OutputName2D, PETSC_COMM_WORLD,
-			xolotlCore::XFile::AccessMode::OpenReadWrite);
-
 	// Get the current time step
 	double currentTimeStep;
 	ierr = TSGetTimeStep(ts, &currentTimeStep);
 	CHKERRQ(ierr);
 
-	// Add a concentration sub group
-	auto concGroup = checkpointFile.getGroup<
-			xolotlCore::XFile::ConcentrationGroup>();
-	assert(concGroup);
-	auto tsGroup = concGroup->addTimestepGroup(timestep, time, previousTime,
-			currentTimeStep);
-
-	if (solverHandler.moveSurface()) {
-		// Write the surface positions and the associated interstitial quantities
-		// in the concentration sub group
-		tsGroup->writeSurface2D(surfaceIndices, nInterstitial2D,
-				previousIFlux2D);
-	}
+	// Take a snapshot of the concentration values we will write.
+	// We only examine and collect the grid points we own.
+	// They are contiguous in the solution, x varying the fastest.
+	auto concs = std::make_shared<
+			xolotlCore::XFile::TimestepGroup::Concs1DType>(
+			xolotlCore::XFile::TimestepGroup::packConcentrations(
+					solutionArray[ys][xs], xm * ym, dof, relTolerance2D,
+					packBuffer2D, PETSC_COMM_WORLD));
 
-	// Write the bottom impurity information if the bottom is a free surface
-	if (solverHandler.getRightOffset() == 1)
-		tsGroup->writeBottom2D(nHelium2D, previousHeFlux2D, nDeuterium2D,
-				previousDFlux2D, nTritium2D, previousTFlux2D);
-
-	// Loop on the full grid
-	for (PetscInt j = 0; j < My; j++) {
-		for (PetscInt i = 0; i < Mx; i++) {
-			// Wait for all the processes
-			MPI_Barrier(PETSC_COMM_WORLD);
+	// Restore the solutionArray
+	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
+	CHKERRQ(ierr);
 
-			// Size of the concentration that will be stored
-			int concSize = -1;
-			// To save which proc has the information
-			int concId = 0;
-			// To know which process should write
-			bool write = false;
+	// The analysis file always has the full concentrations
+	auto fullConcs = concs;
+
+	// In between keyframes, only write what changed since the last one
+	int keyTimeStep = -1;
+	if (keyframeConcs2D && nDeltas2D < keyframeStride2D - 1
+			&& keyframeConcs2D->size() == concs->size()) {
+		concs = std::make_shared<XFile::TimestepGroup::Concs1DType>(
+				XFile::TimestepGroup::makeDelta(*keyframeConcs2D, *concs,
+						deltaTolerance2D));
+		keyTimeStep = keyframeTimeStep2D;
+		nDeltas2D++;
+	} else if (keyframeStride2D > 1) {
+		keyframeConcs2D = concs;
+		keyframeTimeStep2D = timestep;
+		nDeltas2D = 0;
+	}
 
-			// If it is the locally owned part of the grid
-			if (i >= xs && i < xs + xm && j >= ys && j < ys + ym) {
-				write = true;
-				// Get the pointer to the beginning of the solution data for this grid point
-				gridPointSolution = solutionArray[j][i];
+	// Copy everything else the writer needs, the monitors
+	// will change the globals while it writes
+	auto prevTime = previousTime;
+	auto compression = solverHandler.getCheckpointCompression();
+	auto checkpointName = hdf5OutputName2D;
+	auto nKept = nKeptTimeSteps2D;
+	auto analysisName = analysisName2D;
+	auto analysisCompression = solverHandler.getAnalysisCompression();
+	if (analysisBits2D > 0)
+		analysisCompression.lossyBits = analysisBits2D;
+	bool analysisConcs = analysisConcs2D;
+	bool writeSurface = solverHandler.moveSurface();
+	bool writeBottom = (solverHandler.getRightOffset() == 1);
+	auto nInter = nInterstitial2D, prevIFlux = previousIFlux2D;
+	auto nHe = nHelium2D, prevHeFlux = previousHeFlux2D;
+	auto nD = nDeuterium2D, prevDFlux = previousDFlux2D;
+	auto nT = nTritium2D, prevTFlux = previousTFlux2D;
+	// The fluxes at the bottom can be older than the previous time depending
+	// on the schedule of the retention, add what went in the bulk since then
+	// because a restart computes the next contents from the previous time
+	double fluxDt = prevTime - bottomFluxTime2D;
+	for (int j = 0; j < nHe.size(); j++) {
+		nHe[j] += prevHeFlux[j] * fluxDt;
+		nD[j] += prevDFlux[j] * fluxDt;
+		nT[j] += prevTFlux[j] * fluxDt;
+	}
 
-				// Loop on the concentrations
-				for (int l = 0; l < dof; l++) {
-					if (std::fabs(gridPointSolution[l]) > 1.0e-16) {
-						// Increase concSize
-						concSize++;
-						// Fill the concArray
-						concArray[concSize][0] = (double) l;
-						concArray[concSize][1] = gridPointSolution[l];
+	// Write the snapshot to the checkpoint file, in the background
+	// if the writer is asynchronous
+	auto checkpointWriter = (xolotlCore::CheckpointWriter *) ictx;
+	checkpointWriter->submit(
+			[=](MPI_Comm comm) {
+				// Add a concentration time step group for the current time step
+				// to the given file, with everything but the concentrations
+				auto addTimestepGroup = [&](xolotlCore::XFile& file)
+				-> std::unique_ptr<xolotlCore::XFile::TimestepGroup> {
+					auto concGroup = file.getGroup<
+					xolotlCore::XFile::ConcentrationGroup>();
+					assert(concGroup);
+					auto tsGroup = concGroup->addTimestepGroup(timestep, time,
+							prevTime, currentTimeStep);
+
+					if (writeSurface) {
+						// Write the surface positions and the associated interstitial quantities
+						// in the concentration sub group
+						tsGroup->writeSurface2D(surfaceIndices, nInter, prevIFlux);
 					}
-				}
-
-				// Increase concSize one last time
-				concSize++;
-
-				// Save the procId
-				concId = procId;
-			}
-
-			// Get which processor will send the information
-			int concProc = 0;
-			MPI_Allreduce(&concId, &concProc, 1, MPI_INT, MPI_SUM,
-					PETSC_COMM_WORLD);
 
-			// Broadcast the size
-			MPI_Bcast(&concSize, 1, MPI_INT, concProc, PETSC_COMM_WORLD);
-
-			// Skip the grid point if the size is 0
-			if (concSize == 0)
-				continue;
-
-			// All processes create the dataset and fill it
-			tsGroup->writeConcentrationDataset(concSize, concArray, write, i, j);
-		}
-	}
-
-	// Restore the solutionArray
-	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
+					// Write the bottom impurity information if the bottom is a free surface
+					if (writeBottom)
+						tsGroup->writeBottom2D(nHe, prevHeFlux, nD, prevDFlux, nT,
+								prevTFlux);
+
+					return tsGroup;
+				};
+
+				// Use the checkpoint file the writer keeps open
+				auto& checkpointFile = checkpointWriter->getFile(comm,
+						checkpointName);
+				checkpointFile.setCompression(compression);
+				auto tsGroup = addTimestepGroup(checkpointFile);
+
+				// Point to the keyframe if we only have the changes
+				if (keyTimeStep >= 0)
+					tsGroup->writeKeyframe(keyTimeStep);
+
+				// Write our concentration data to the current timestep group
+				// in the HDF5 file, all the processes writing at once.
+				tsGroup->writeConcentrations(checkpointFile, xs, ys, xm, ym,
+						*concs);
+
+				// Make sure the checkpoint is on the disk
+				checkpointFile.flush();
+
+				// Only then forget the oldest time steps, the file being
+				// compacted from time to time
+				if (nKept > 0)
+					checkpointWriter->removeOldTimestepGroups(comm, checkpointName,
+							nKept);
+
+				// Append the time step to the analysis file
+				if (!analysisName.empty()) {
+					auto& analysisFile = checkpointWriter->getFile(comm,
+							analysisName);
+					analysisFile.setCompression(analysisCompression);
+					auto analysisTsGroup = addTimestepGroup(analysisFile);
+					if (analysisConcs)
+						analysisTsGroup->writeConcentrations(analysisFile,
+							xs, ys, xm, ym, *fullConcs);
+					analysisFile.flush();
+				}
+			});
 
 	PetscFunctionReturn(0);
 }
@@ -284,8 +332,8 @@ PetscErrorCode computeHeliumRetention2D(TS ts, PetscInt, PetscReal time,
 	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
 
-	// Store the concentration over the grid
-	double heConcentration = 0.0, dConcentration = 0.0, tConcentration = 0.0;
+	// Store the He, D, T concentrations over the grid
+	std::array<double, 3> myConcData { };
 
 	// Loop on the grid
 	for (PetscInt yj = ys; yj < ys + ym; yj++) {
@@ -301,16 +349,9 @@ PetscErrorCode computeHeliumRetention2D(TS ts, PetscInt, PetscReal time,
 			// Get the pointer to the beginning of the solution data for this grid point
 			gridPointSolution = solutionArray[yj][xi];
 
-			// Update the concentration in the network
-			network.updateConcentrationsFromArray(gridPointSolution);
-
 			// Get the total atom concentrations at this grid point
-			heConcentration += network.getTotalAtomConcentration(0)
-					* (grid[xi + 1] - grid[xi]) * hy;
-			dConcentration += network.getTotalAtomConcentration(1)
-					* (grid[xi + 1] - grid[xi]) * hy;
-			tConcentration += network.getTotalAtomConcentration(2)
-					* (grid[xi + 1] - grid[xi]) * hy;
+			heRetentionWeights2D.accumulate(gridPointSolution,
+					(grid[xi + 1] - grid[xi]) * hy, myConcData.data());
 		}
 	}
 
@@ -319,15 +360,12 @@ PetscErrorCode computeHeliumRetention2D(TS ts, PetscInt, PetscReal time,
 	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
 
 	// Sum all the concentrations through MPI reduce
-	double totalHeConcentration = 0.0;
-	MPI_Reduce(&heConcentration, &totalHeConcentration, 1, MPI_DOUBLE, MPI_SUM,
-			0, PETSC_COMM_WORLD);
-	double totalDConcentration = 0.0;
-	MPI_Reduce(&dConcentration, &totalDConcentration, 1, MPI_DOUBLE, MPI_SUM, 0,
-			PETSC_COMM_WORLD);
-	double totalTConcentration = 0.0;
-	MPI_Reduce(&tConcentration, &totalTConcentration, 1, MPI_DOUBLE, MPI_SUM, 0,
-			PETSC_COMM_WORLD);
+	std::array<double, 3> totalConcData;
+	MPI_Reduce(myConcData.data(), totalConcData.data(), myConcData.size(),
+	MPI_DOUBLE, MPI_SUM, 0, PETSC_COMM_WORLD);
+	double totalHeConcentration = totalConcData[0];
+	double totalDConcentration = totalConcData[1];
+	double totalTConcentration = totalConcData[2];
 
 	// Get the total size of the grid
 	ierr = DMDAGetInfo(da, PETSC_IGNORE, &Mx, &My, PETSC_IGNORE,
@@ -349,8 +387,9 @@ PetscErrorCode computeHeliumRetention2D(TS ts, PetscInt, PetscReal time,
 
 			// Check we are on the right proc
 			if (xi >= xs && xi < xs + xm && j >= ys && j < ys + ym) {
-				// Get the delta time from the previous timestep to this timestep
-				double dt = time - previousTime;
+				// Get the delta time since the fluxes were computed, which can
+				// be several time steps depending on the schedule
+				double dt = time - bottomFluxTime2D;
 				// Compute the total number of impurities that went in the bulk
 				nHelium2D[j] += previousHeFlux2D[j] * dt;
 				nDeuterium2D[j] += previousDFlux2D[j] * dt;
@@ -442,6 +481,7 @@ PetscErrorCode computeHeliumRetention2D(TS ts, PetscInt, PetscReal time,
 					PETSC_COMM_WORLD);
 		}
 	}
+	bottomFluxTime2D = time;
 
 	// Master process
 	if (procId == 0) {
@@ -476,13 +516,11 @@ PetscErrorCode computeHeliumRetention2D(TS ts, PetscInt, PetscReal time,
 		std::cout << "Fluence = " << fluence << "\n" << std::endl;
 
 		// Uncomment to write the retention and the fluence in a file
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt", ios::app);
-		outputFile << fluence << " " << totalHeConcentration << " "
-				<< totalDConcentration << " " << totalTConcentration << " "
-				<< totalHeBulk << " " << totalDBulk << " " << totalTBulk
-				<< std::endl;
-		outputFile.close();
+		appendTimeSeries("retentionOut",
+				{ "fluence", "helium", "deuterium", "tritium", "heliumBulk",
+						"deuteriumBulk", "tritiumBulk" },
+				{ fluence, totalHeConcentration, totalDConcentration,
+						totalTConcentration, totalHeBulk, totalDBulk, totalTBulk });
 	}
 
 	// Restore the solutionArray
@@ -543,8 +581,9 @@ PetscErrorCode computeXenonRetention2D(TS ts, PetscInt timestep, PetscReal time,
 	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
 
-	// Store the concentration and other values over the grid
-	double xeConcentration = 0.0, bubbleConcentration = 0.0, radii = 0.0;
+	// Store the xenon concentration, bubble concentration, and radii
+	// over the grid
+	std::array<double, 3> myConcData { };
 
 	// Loop on the grid
 	for (PetscInt yj = ys; yj < ys + ym; yj++) {
@@ -553,34 +592,9 @@ PetscErrorCode computeXenonRetention2D(TS ts, PetscInt timestep, PetscReal time,
 			// Get the pointer to the beginning of the solution data for this grid point
 			gridPointSolution = solutionArray[yj][xi];
 
-			// Update the concentration in the network
-			network.updateConcentrationsFromArray(gridPointSolution);
-
-			// Loop on all the indices
-			for (unsigned int i = 0; i < indices2D.size(); i++) {
-				// Add the current concentration times the number of xenon in the cluster
-				// (from the weight vector)
-				xeConcentration += gridPointSolution[indices2D[i]]
-						* weights2D[i] * (grid[xi + 1] - grid[xi]) * hy;
-				bubbleConcentration += gridPointSolution[indices2D[i]]
-						* (grid[xi + 1] - grid[xi]) * hy;
-				radii += gridPointSolution[indices2D[i]] * radii2D[i]
-						* (grid[xi + 1] - grid[xi]) * hy;
-			}
-
-			// Loop on all the super clusters
-			for (auto const& superMapItem : network.getAll(
-					ReactantType::NESuper)) {
-				auto const& cluster =
-						static_cast<NESuperCluster&>(*(superMapItem.second));
-				xeConcentration += cluster.getTotalXenonConcentration()
-						* (grid[xi + 1] - grid[xi]) * hy;
-				bubbleConcentration += cluster.getTotalConcentration()
-						* (grid[xi + 1] - grid[xi]) * hy;
-				radii += cluster.getTotalConcentration()
-						* cluster.getReactionRadius()
-						* (grid[xi + 1] - grid[xi]) * hy;
-			}
+			// Add the values of all the clusters at this grid point
+			xeRetentionWeights2D.accumulate(gridPointSolution,
+					(grid[xi + 1] - grid[xi]) * hy, myConcData.data());
 		}
 	}
 
@@ -589,20 +603,17 @@ PetscErrorCode computeXenonRetention2D(TS ts, PetscInt timestep, PetscReal time,
 	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
 
 	// Sum all the concentrations through MPI reduce
-	double totalXeConcentration = 0.0;
-	MPI_Reduce(&xeConcentration, &totalXeConcentration, 1, MPI_DOUBLE,
-	MPI_SUM, 0, PETSC_COMM_WORLD);
-	double totalBubbleConcentration = 0.0;
-	MPI_Reduce(&bubbleConcentration, &totalBubbleConcentration, 1,
-	MPI_DOUBLE,
-	MPI_SUM, 0, MPI_COMM_WORLD);
-	double totalRadii = 0.0;
-	MPI_Reduce(&radii, &totalRadii, 1, MPI_DOUBLE, MPI_SUM, 0,
-	MPI_COMM_WORLD);
+	std::array<double, 3> totalConcData;
+	MPI_Reduce(myConcData.data(), totalConcData.data(), myConcData.size(),
+	MPI_DOUBLE, MPI_SUM, 0, PETSC_COMM_WORLD);
+	double totalXeConcentration = totalConcData[0];
+	double totalBubbleConcentration = totalConcData[1];
+	double totalRadii = totalConcData[2];
 
 	// GB
-	// Get the delta time from the previous timestep to this timestep
-	double dt = time - previousTime;
+	// Get the delta time since the flux was computed, which can be several
+	// time steps depending on the schedule
+	double dt = time - gbFluxTime2D;
 	// Compute the total number of Xe that went to the GB
 	nXenon2D += previousXeFlux2D * dt;
 	// Get the vector from the solver handler
@@ -723,6 +734,7 @@ PetscErrorCode computeXenonRetention2D(TS ts, PetscInt timestep, PetscReal time,
 	}
 	// Update the xenon flux
 	previousXeFlux2D = newFlux;
+	gbFluxTime2D = time;
 
 	// Master process
 	if (procId == 0) {
@@ -743,14 +755,12 @@ PetscErrorCode computeXenonRetention2D(TS ts, PetscInt timestep, PetscReal time,
 		std::cout << "Xenon GB = " << nXenon2D / surface << std::endl << std::endl;
 
 		// Uncomment to write the retention and the fluence in a file
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt", ios::app);
-		outputFile << time << " "
-				<< 100.0 * (totalXeConcentration / (fluence)) << " "
-				<< totalXeConcentration << " " << fluence - totalXeConcentration
-				<< " " << totalRadii / totalBubbleConcentration << " "
-				<< nXenon2D / surface << std::endl;
-		outputFile.close();
+		appendTimeSeries("retentionOut",
+				{ "time", "retention", "xenon", "xenonReleased", "meanRadius",
+						"xenonGB" },
+				{ time, 100.0 * (totalXeConcentration / (fluence)),
+						totalXeConcentration, fluence - totalXeConcentration,
+						totalRadii / totalBubbleConcentration, nXenon2D / surface });
 	}
 
 	// Restore the solutionArray
@@ -773,10 +783,6 @@ PetscErrorCode computeTRIDYN2D(TS ts, PetscInt timestep, PetscReal time,
 
 	PetscFunctionBeginUser;
 
-	// Get the number of processes
-	int worldSize;
-	MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
-
 	// Gets the process ID
 	int procId;
 	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
@@ -784,9 +790,6 @@ PetscErrorCode computeTRIDYN2D(TS ts, PetscInt timestep, PetscReal time,
 	// Get the solver handler
 	auto& solverHandler = PetscSolver::getSolverHandler();
 
-	// Get the network
-	auto& network = solverHandler.getNetwork();
-
 	// Get the da from ts
 	DM da;
 	ierr = TSGetDM(ts, &da);
@@ -811,75 +814,57 @@ PetscErrorCode computeTRIDYN2D(TS ts, PetscInt timestep, PetscReal time,
 	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
 
-	// Create the output file
-	std::ofstream outputFile;
-	if (procId == 0) {
-		std::stringstream name;
-		name << "TRIDYN_" << timestep << ".dat";
-		outputFile.open(name.str());
-	}
-
-	// Loop on the entire grid
-	for (int xi = 0; xi < Mx; xi++) {
-		// Set x
-		double x = grid[xi + 1] - grid[1];
-
-		// Initialize the concentrations at this grid point
-		double heLocalConc = 0.0, dLocalConc = 0.0, tLocalConc = 0.0,
-				vLocalConc = 0.0, iLocalConc = 0.0;
-
-		// Loop on the y
-		for (PetscInt yj = ys; yj < ys + ym; yj++) {
-			// Get the surface position
-			int surfacePos = solverHandler.getSurfacePosition(yj);
-			// Boundary conditions
-			if (xi < surfacePos)
-				continue;
-
-			// If it is the locally owned part of the grid
-			if (xi >= xs && xi < xs + xm) {
-				// Get the pointer to the beginning of the solution data for this grid point
-				gridPointSolution = solutionArray[yj][xi];
+	// The He, D, T, V, I concentrations summed over the local grid points
+	// at each of our depths
+	constexpr auto numConcSpecies = 5;
+	constexpr auto numValsPerRow = numConcSpecies + 1;
+	std::vector<double> localConcs(xm * numConcSpecies, 0.0);
 
-				// Update the concentration in the network
-				network.updateConcentrationsFromArray(gridPointSolution);
+	// Loop on the locally owned part of the grid
+	for (PetscInt yj = ys; yj < ys + ym; yj++) {
+		// Get the surface position
+		int surfacePos = solverHandler.getSurfacePosition(yj);
+		for (PetscInt xi = std::max(xs, (PetscInt) surfacePos); xi < xs + xm;
+				xi++) {
+			// Get the pointer to the beginning of the solution data for this grid point
+			gridPointSolution = solutionArray[yj][xi];
 
-				// Get the total helium concentration at this grid point
-				heLocalConc += network.getTotalAtomConcentration(0);
-				dLocalConc += network.getTotalAtomConcentration(1);
-				tLocalConc += network.getTotalAtomConcentration(2);
-				vLocalConc += network.getTotalVConcentration();
-				iLocalConc += network.getTotalIConcentration();
-			}
+			// Get the total concentrations at this grid point
+			tridynWeights2D.accumulate(gridPointSolution, 1.0,
+					&localConcs[(xi - xs) * numConcSpecies]);
 		}
+	}
 
-		double heConc = 0.0, dConc = 0.0, tConc = 0.0, vConc = 0.0, iConc = 0.0;
-		MPI_Reduce(&heLocalConc, &heConc, 1, MPI_DOUBLE, MPI_SUM, 0,
-				PETSC_COMM_WORLD);
-		MPI_Reduce(&dLocalConc, &dConc, 1, MPI_DOUBLE, MPI_SUM, 0,
-				PETSC_COMM_WORLD);
-		MPI_Reduce(&tLocalConc, &tConc, 1, MPI_DOUBLE, MPI_SUM, 0,
-				PETSC_COMM_WORLD);
-		MPI_Reduce(&vLocalConc, &vConc, 1, MPI_DOUBLE, MPI_SUM, 0,
-				PETSC_COMM_WORLD);
-		MPI_Reduce(&iLocalConc, &iConc, 1, MPI_DOUBLE, MPI_SUM, 0,
-				PETSC_COMM_WORLD);
-
-		// The master process writes computes the cumulative value and writes in the file
-		if (procId == 0) {
-			outputFile
-					<< x
-							- (grid[solverHandler.getSurfacePosition(0) + 1]
-									- grid[1]) << " " << heConc / My << " "
-					<< dConc / My << " " << tConc / My << " " << vConc / My
-					<< " " << iConc / My << std::endl;
+	// Sum them over the processes sharing our depths, the first of them
+	// writing the rows
+	MPI_Comm depthComm;
+	MPI_Comm_split(PETSC_COMM_WORLD, xs, procId, &depthComm);
+	int depthId;
+	MPI_Comm_rank(depthComm, &depthId);
+	std::vector<double> concs((depthId == 0) ? localConcs.size() : 0);
+	MPI_Reduce(localConcs.data(), concs.data(), localConcs.size(), MPI_DOUBLE,
+	MPI_SUM, 0, depthComm);
+	MPI_Comm_free(&depthComm);
+
+	// Compute our rows: the depth and the average concentrations
+	const PetscInt myNumRows = (depthId == 0) ? xm : 0;
+	const double surfaceDepth = grid[solverHandler.getSurfacePosition(0) + 1]
+			- grid[1];
+	std::vector<double> myRows(myNumRows * numValsPerRow);
+	for (PetscInt i = 0; i < myNumRows; i++) {
+		auto row = &myRows[i * numValsPerRow];
+		row[0] = grid[xs + i + 1] - grid[1] - surfaceDepth;
+		for (int n = 0; n < numConcSpecies; n++) {
+			row[n + 1] = concs[i * numConcSpecies + n] / My;
 		}
 	}
 
-	// Close the file
-	if (procId == 0) {
-		outputFile.close();
-	}
+	// Write the profile, once the checkpoint writer is done with HDF5
+	auto format = getTRIDYNFormat(false);
+	if (format == TRIDYNFormat::HDF5)
+		waitForCheckpointWriter();
+	writeTRIDYNProfile(PETSC_COMM_WORLD, timestep, format, Mx, numValsPerRow,
+			xs, myRows);
 
 	// Restore the solutionArray
 	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
@@ -904,10 +889,6 @@ PetscErrorCode monitorSurface2D(TS ts, PetscInt timestep, PetscReal time,
 
 	PetscFunctionBeginUser;
 
-	// Don't do anything if it is not on the stride
-	if (timestep % 10 != 0)
-		PetscFunctionReturn(0);
-
 	// Gets the process ID
 	int procId;
 	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
@@ -1114,18 +1095,17 @@ PetscErrorCode eventFunction2D(TS ts, PetscReal time, Vec solution,
 	if (solverHandler.moveSurface()) {
 		// Write the initial surface positions
 		if (procId == 0 && xolotlCore::equal(time, 0.0)) {
-			std::ofstream outputFile;
-			outputFile.open("surface.txt", ios::app);
-			outputFile << time << " ";
+			std::vector<std::string> columns = { "time" };
+			std::vector<double> row = { time };
 
 			// Loop on the possible yj
 			for (yj = 0; yj < My; yj++) {
 				// Get the position of the surface at yj
 				int surfacePos = solverHandler.getSurfacePosition(yj);
-				outputFile << grid[surfacePos + 1] - grid[1] << " ";
+				columns.push_back("surface_" + std::to_string(yj));
+				row.push_back(grid[surfacePos + 1] - grid[1]);
 			}
-			outputFile << std::endl;
-			outputFile.close();
+			appendTimeSeries("surface", columns, row);
 		}
 
 		// Get the initial vacancy concentration
@@ -1366,6 +1346,9 @@ PetscErrorCode postEventFunction2D(TS ts, PetscInt nevents,
 	if (nevents == 0)
 		PetscFunctionReturn(0);
 
+	// The monitors sampling the events are due at the next time step
+	MonitorSchedule::notifyEvent();
+
 	// Gets the process ID
 	int procId;
 	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
@@ -1649,18 +1632,17 @@ PetscErrorCode postEventFunction2D(TS ts, PetscInt nevents,
 
 	// Write the surface positions
 	if (procId == 0) {
-		std::ofstream outputFile;
-		outputFile.open("surface.txt", ios::app);
-		outputFile << time << " ";
+		std::vector<std::string> columns = { "time" };
+		std::vector<double> row = { time };
 
 		// Loop on the possible yj
 		for (yj = 0; yj < My; yj++) {
 			// Get the position of the surface at yj
 			int surfacePos = solverHandler.getSurfacePosition(yj);
-			outputFile << grid[surfacePos + 1] - grid[1] << " ";
+			columns.push_back("surface_" + std::to_string(yj));
+			row.push_back(grid[surfacePos + 1] - grid[1]);
 		}
-		outputFile << std::endl;
-		outputFile.close();
+		appendTimeSeries("surface", columns, row);
 	}
 
 	// Restore the solutionArray
@@ -1688,7 +1670,7 @@ PetscErrorCode setupPetsc2DMonitor(TS ts) {
 
 	// Flags to launch the monitors or not
 	PetscBool flagCheck, flagPerf, flagHeRetention, flagXeRetention, flagStatus,
-			flag2DPlot, flagTRIDYN;
+			flag2DPlot, flagTRIDYN, flagTelemetry;
 
 	// Check the option -check_collapse
 	ierr = PetscOptionsHasName(NULL, NULL, "-check_collapse", &flagCheck);
@@ -1700,6 +1682,11 @@ PetscErrorCode setupPetsc2DMonitor(TS ts) {
 	checkPetscError(ierr,
 			"setupPetsc2DMonitor: PetscOptionsHasName (-plot_perf) failed.");
 
+	// Check the option -telemetry
+	ierr = PetscOptionsHasName(NULL, NULL, "-telemetry", &flagTelemetry);
+	checkPetscError(ierr,
+			"setupPetsc2DMonitor: PetscOptionsHasName (-telemetry) failed.");
+
 	// Check the option -plot_2d
 	ierr = PetscOptionsHasName(NULL, NULL, "-plot_2d", &flag2DPlot);
 	checkPetscError(ierr,
@@ -1783,18 +1770,60 @@ PetscErrorCode setupPetsc2DMonitor(TS ts) {
 	// Set the monitor to save the status of the simulation in hdf5 file
 	if (flagStatus) {
 		// Find the stride to know how often the HDF5 file has to be written
+		PetscReal hdf5Stride = 0.0;
 		PetscBool flag;
-		ierr = PetscOptionsGetReal(NULL, NULL, "-start_stop", &hdf5Stride2D,
+		ierr = PetscOptionsGetReal(NULL, NULL, "-start_stop", &hdf5Stride,
 				&flag);
 		checkPetscError(ierr,
 				"setupPetsc2DMonitor: PetscOptionsGetInt (-start_stop) failed.");
 		if (!flag)
-			hdf5Stride2D = 1.0;
+			hdf5Stride = 1.0;
+
+		// Find how often a full checkpoint is written, and the
+		// relative change to write in the ones in between
+		ierr = PetscOptionsGetInt(NULL, NULL, "-start_stop_keyframe",
+				&keyframeStride2D, NULL);
+		checkPetscError(ierr,
+				"setupPetsc2DMonitor: PetscOptionsGetInt (-start_stop_keyframe) failed.");
+		ierr = PetscOptionsGetReal(NULL, NULL, "-start_stop_delta_tol",
+				&deltaTolerance2D, NULL);
+		checkPetscError(ierr,
+				"setupPetsc2DMonitor: PetscOptionsGetReal (-start_stop_delta_tol) failed.");
+
+		// Find how many time steps are kept in the checkpoint file
+		ierr = PetscOptionsGetInt(NULL, NULL, "-start_stop_keep",
+				&nKeptTimeSteps2D, NULL);
+		checkPetscError(ierr,
+				"setupPetsc2DMonitor: PetscOptionsGetInt (-start_stop_keep) failed.");
+
+		// Find the analysis file and what is written in it
+		char analysisName[PETSC_MAX_PATH_LEN];
+		PetscBool flagAnalysis, flagNoConcs;
+		ierr = PetscOptionsGetString(NULL, NULL, "-start_stop_analysis",
+				analysisName, PETSC_MAX_PATH_LEN, &flagAnalysis);
+		checkPetscError(ierr,
+				"setupPetsc2DMonitor: PetscOptionsGetString (-start_stop_analysis) failed.");
+		if (flagAnalysis)
+			analysisName2D = analysisName;
+		ierr = PetscOptionsGetInt(NULL, NULL, "-start_stop_analysis_bits",
+				&analysisBits2D, NULL);
+		checkPetscError(ierr,
+				"setupPetsc2DMonitor: PetscOptionsGetInt (-start_stop_analysis_bits) failed.");
+		ierr = PetscOptionsHasName(NULL, NULL, "-start_stop_analysis_no_concs",
+				&flagNoConcs);
+		checkPetscError(ierr,
+				"setupPetsc2DMonitor: PetscOptionsHasName (-start_stop_analysis_no_concs) failed.");
+		analysisConcs2D = !flagNoConcs;
+
+		// Find the relative tolerance of the concentrations to write
+		ierr = PetscOptionsGetReal(NULL, NULL, "-start_stop_rel_tol",
+				&relTolerance2D, NULL);
+		checkPetscError(ierr,
+				"setupPetsc2DMonitor: PetscOptionsGetReal (-start_stop_rel_tol) failed.");
 
 		if (hasConcentrations) {
 			// Get the previous time from the HDF5 file
 			previousTime = lastTsGroup->readPreviousTime();
-			hdf5Previous2D = (int) (previousTime / hdf5Stride2D);
 		}
 
 		// Don't do anything if both files have the same name
@@ -1833,10 +1862,20 @@ PetscErrorCode setupPetsc2DMonitor(TS ts) {
 					hdf5OutputName2D, network);
 		}
 
-		// startStop2D will be called at each timestep
-		ierr = TSMonitorSet(ts, startStop2D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc2DMonitor: TSMonitorSet (startStop2D) failed.");
+		// Create the analysis file, it does not need the network
+		// as it is not meant to restart from
+		if (!analysisName2D.empty()) {
+			xolotlCore::XFile analysisFile(analysisName2D,
+					solverHandler.getXGrid(), network.getCompositionList(),
+					PETSC_COMM_WORLD, My,
+					solverHandler.getStepSizeY());
+		}
+
+		// startStop2D will be called on the stride
+		setScheduledMonitor(ts, "start_stop", startStop2D,
+				createCheckpointWriter(PETSC_COMM_WORLD),
+				destroyCheckpointWriter,
+				MonitorSchedule(MonitorSchedule::Cadence::Time, hdf5Stride));
 	}
 
 	// If the user wants the surface to be able to move or bursting
@@ -1867,9 +1906,7 @@ PetscErrorCode setupPetsc2DMonitor(TS ts) {
 			sputteringYield2D = solverHandler.getSputteringYield();
 
 			// Clear the file where the surface will be written
-			std::ofstream outputFile;
-			outputFile.open("surface.txt");
-			outputFile.close();
+			clearTimeSeries("surface");
 		}
 
 		// Bursting
@@ -1915,14 +1952,15 @@ PetscErrorCode setupPetsc2DMonitor(TS ts) {
 			perfPlot->setDataProvider(dataProvider);
 		}
 
-		// monitorPerf will be called at each timestep
-		ierr = TSMonitorSet(ts, monitorPerf, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc2DMonitor: TSMonitorSet (monitorPerf) failed.");
+		// monitorPerf will be called on its schedule
+		setScheduledMonitor(ts, "plot_perf", monitorPerf, NULL, NULL);
 	}
 
 	// Set the monitor to compute the helium fluence for the retention calculation
 	if (flagHeRetention) {
+		// Compute the contents from the solution directly
+		heRetentionWeights2D = createHeliumRetentionWeights(network);
+
 		// Check if we have a free surface at the bottom
 		if (solverHandler.getRightOffset() == 1) {
 			// Initialize n2D and previousFlux2D before monitoring the fluxes
@@ -1970,31 +2008,21 @@ PetscErrorCode setupPetsc2DMonitor(TS ts) {
 		checkPetscError(ierr,
 				"setupPetsc2DMonitor: TSMonitorSet (computeFluence) failed.");
 
-		// computeHeliumRetention2D will be called at each timestep
-		ierr = TSMonitorSet(ts, computeHeliumRetention2D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc2DMonitor: TSMonitorSet (computeHeliumRetention2D) failed.");
+		// computeHeliumRetention2D will be called on its schedule, the
+		// fluxes at the bottom being computed from the previous time
+		bottomFluxTime2D = previousTime;
+		setScheduledMonitor(ts, "helium_retention", computeHeliumRetention2D,
+				NULL, NULL);
 
 		// Uncomment to clear the file where the retention will be written
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt");
-		outputFile.close();
+		clearTimeSeries("retentionOut");
 	}
 
 	// Set the monitor to compute the xenon fluence and the retention
 	// for the retention calculation
 	if (flagXeRetention) {
-		// Loop on the xenon clusters
-		for (auto const& xeMapItem : network.getAll(ReactantType::Xe)) {
-			auto const& cluster = *(xeMapItem.second);
-
-			int id = cluster.getId() - 1;
-			// Add the Id to the vector
-			indices2D.push_back(id);
-			// Add the number of xenon of this cluster to the weight
-			weights2D.push_back(cluster.getSize());
-			radii2D.push_back(cluster.getReactionRadius());
-		}
+		// Compute the retention from the solution directly
+		xeRetentionWeights2D = createXenonRetentionWeights(network);
 
 		// Get the previous time if concentrations were stored and initialize the fluence
 		if (hasConcentrations) {
@@ -2019,15 +2047,14 @@ PetscErrorCode setupPetsc2DMonitor(TS ts) {
 		checkPetscError(ierr,
 				"setupPetsc2DMonitor: TSMonitorSet (computeFluence) failed.");
 
-		// computeXenonRetention2D will be called at each timestep
-		ierr = TSMonitorSet(ts, computeXenonRetention2D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc2DMonitor: TSMonitorSet (computeXenonRetention2D) failed.");
+		// computeXenonRetention2D will be called on its schedule, the flux
+		// to the GB being computed from the previous time
+		gbFluxTime2D = previousTime;
+		setScheduledMonitor(ts, "xenon_retention", computeXenonRetention2D,
+				NULL, NULL);
 
 		// Uncomment to clear the file where the retention will be written
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt");
-		outputFile.close();
+		clearTimeSeries("retentionOut");
 	}
 
 	// Set the monitor to save surface plots of clusters concentration
@@ -2056,18 +2083,28 @@ PetscErrorCode setupPetsc2DMonitor(TS ts) {
 			surfacePlot2D->setDataProvider(dataProvider);
 		}
 
-		// monitorSurface2D will be called at each timestep
-		ierr = TSMonitorSet(ts, monitorSurface2D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc2DMonitor: TSMonitorSet (monitorSurface2D) failed.");
+		// monitorSurface2D will be called on its schedule
+		setScheduledMonitor(ts, "plot_2d", monitorSurface2D, NULL, NULL,
+				MonitorSchedule(MonitorSchedule::Cadence::Steps, 10));
 	}
 
 	// Set the monitor to output data for TRIDYN
 	if (flagTRIDYN) {
-		// computeTRIDYN2D will be called at each timestep
-		ierr = TSMonitorSet(ts, computeTRIDYN2D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc2DMonitor: TSMonitorSet (computeTRIDYN2D) failed.");
+		// Compute the contents from the solution directly
+		tridynWeights2D = createTRIDYNWeights(network);
+
+		// computeTRIDYN2D will be called on its schedule
+		setScheduledMonitor(ts, "tridyn", computeTRIDYN2D, NULL, NULL);
+	}
+
+	// Set the monitor to write what the solver did since the previous sample
+	if (flagTelemetry) {
+		// Register what is sampled and clear the file where the
+		// telemetry will be written
+		startTelemetry();
+
+		// monitorTelemetry will be called at each timestep by default
+		setScheduledMonitor(ts, "telemetry", monitorTelemetry, NULL, NULL);
 	}
 
 	// Set the monitor to simply change the previous time to the new time
@@ -21,6 +21,7 @@
 #include "RandomNumberGenerator.h"
 #include "xolotlCore/io/XFile.h"
 #include "xolotlSolver/monitor/Monitor.h"
+#include "xolotlSolver/monitor/MonitorSchedule.h"
 
 namespace xolotlSolver {
 
@@ -32,18 +33,40 @@ extern PetscErrorCode computeFluence(TS ts, PetscInt timestep, PetscReal time,
 		Vec solution, void *ictx);
 extern PetscErrorCode monitorPerf(TS ts, PetscInt timestep, PetscReal time,
 		Vec solution, void *ictx);
+extern PetscErrorCode monitorTelemetry(TS ts, PetscInt timestep,
+		PetscReal time, Vec solution, void *ictx);
 
 // Declaration of the variables defined in Monitor.cpp
 extern std::shared_ptr<xolotlViz::IPlot> perfPlot;
 extern double previousTime;
 extern double timeStepThreshold;
 
-//! How often HDF5 file is written
-PetscReal hdf5Stride3D = 0.0;
-//! Previous time for HDF5
-PetscInt hdf5Previous3D = 0;
 //! HDF5 output file name
 std::string hdf5OutputName3D = "xolotlStop.h5";
+//! How often a full checkpoint (keyframe) is written, the ones
+//! in between only having the changes since the last keyframe
+PetscInt keyframeStride3D = 1;
+//! Relative change under which a concentration is not written in a delta
+PetscReal deltaTolerance3D = 0.0;
+//! Number of delta checkpoints written since the last keyframe
+PetscInt nDeltas3D = 0;
+//! Time step of the last keyframe
+PetscInt keyframeTimeStep3D = -1;
+//! Concentrations written in the last keyframe
+std::shared_ptr<XFile::TimestepGroup::Concs1DType> keyframeConcs3D;
+//! Number of time steps kept in the checkpoint file, all of them if not positive
+PetscInt nKeptTimeSteps3D = 0;
+//! Analysis file every checkpoint is appended to, none if empty
+std::string analysisName3D;
+//! Number of mantissa bits of the concentrations in the analysis file
+PetscInt analysisBits3D = 0;
+//! Whether the concentrations are written in the analysis file
+bool analysisConcs3D = true;
+//! Tolerance relative to the largest concentration under which
+//! a concentration is not written in the checkpoints
+PetscReal relTolerance3D = 0.0;
+//! Buffer reused to pack the concentrations of the checkpoints
+std::vector<int> packBuffer3D;
 //! The pointer to the 2D plot used in MonitorSurfaceXY3D.
 std::shared_ptr<xolotlViz::IPlot> surfacePlotXY3D;
 //! The pointer to the 2D plot used in MonitorSurfaceXZ3D.
@@ -56,17 +79,19 @@ std::vector<std::vector<double> > nInterstitial3D;
 double previousXeFlux3D = 0.0;
 //! The variable to store the total number of xenon going through the GB.
 double nXenon3D = 0.0;
+//! The time the xenon flux to the GB was computed at.
+double gbFluxTime3D = 0.0;
 //! The variable to store the sputtering yield at the surface.
 double sputteringYield3D = 0.0;
 // The vector of depths at which bursting happens
 std::vector<std::tuple<int, int, int> > depthPositions3D;
-// Declare the vector that will store the Id of the clusters
-std::vector<int> indices3D;
-// Declare the vector that will store the weight of the clusters
-// (their He composition)
-std::vector<int> weights3D;
-// Declare the vector that will store the radii of bubbles
-std::vector<double> radii3D;
+//! The weights of the helium, deuterium, and tritium contents
+xolotlCore::ObservableWeights heRetentionWeights3D;
+//! The weights of the xenon content, bubble density, and bubble radii
+xolotlCore::ObservableWeights xeRetentionWeights3D;
+//! The weights of the helium, deuterium, tritium, vacancy, and
+//! interstitial contents written for TRIDYN
+xolotlCore::ObservableWeights tridynWeights3D;
 
 #undef __FUNCT__
 #define __FUNCT__ Actual__FUNCT__("xolotlSolver", "startStop3D")
@@ -74,34 +99,14 @@ std::vector<double> radii3D;
  * This is a monitoring method that will update an hdf5 file at each time step.
  */
 PetscErrorCode startStop3D(TS ts, PetscInt timestep, PetscReal time,
-		Vec solution, void *) {
+		Vec solution, void *ictx) {
 	// Initial declarations
 	PetscErrorCode ierr;
-	const double ****solutionArray, *gridPointSolution;
+	const double ****solutionArray;
 	PetscInt xs, xm, Mx, ys, ym, My, zs, zm, Mz;
 
 	PetscFunctionBeginUser;
 
-	// Compute the dt
-	double dt = time - previousTime;
-
-	// Don't do anything if it is not on the stride
-	if (((int) ((time + dt / 10.0) / hdf5Stride3D) <= hdf5Previous3D)
-			&& timestep > 0)
-		PetscFunctionReturn(0);
-
-	// Update the previous time
-	if ((int) ((time + dt / 10.0) / hdf5Stride3D) > hdf5Previous3D)
-		hdf5Previous3D++;
-
-	// Get the number of processes
-	int worldSize;
-	MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
-
-	// Gets the process ID (important when it is running in parallel)
-	int procId;
-	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
-
 	// Get the da from ts
 	DM da;
 	ierr = TSGetDM(ts, &da);
@@ -129,9 +134,6 @@ PetscErrorCode startStop3D(TS ts, PetscInt timestep, PetscReal time,
 	// Network size
 	const int dof = network.getDOF();
 
-	// Create an array for the concentration
-	double concArray[dof][2];
-
 	// Get the vector of positions of the surface
 	std::vector<std::vector<int> > surfaceIndices;
 	for (PetscInt i = 0; i < My; i++) {
@@ -144,89 +146,115 @@ PetscErrorCode startStop3D(TS ts, PetscInt timestep, PetscReal time,
 		surfaceIndices.push_back(temp);
 	}
 
-	// Open the existing HDF5 file.
-	xolotlCore::XFile checkpointFile(hdf5OutputName3D, PETSC_COMM_WORLD,
-			xolotlCore::XFile::AccessMode::OpenReadWrite);
-
 	// Get the current time step
 	double currentTimeStep;
 	ierr = TSGetTimeStep(ts, &currentTimeStep);
 	CHKERRQ(ierr);
 
-	// Add a concentration sub group
-	auto concGroup = checkpointFile.getGroup<
-			xolotlCore::XFile::ConcentrationGroup>();
-	assert(concGroup);
-	auto tsGroup = concGroup->addTimestepGroup(timestep, time, previousTime,
-			currentTimeStep);
+	// Take a snapshot of the concentration values we will write.
+	// We only examine and collect the grid points we own.
+	// They are contiguous in the solution, x varying the fastest.
+	auto concs = std::make_shared<
+			xolotlCore::XFile::TimestepGroup::Concs1DType>(
+			xolotlCore::XFile::TimestepGroup::packConcentrations(
+					solutionArray[zs][ys][xs], xm * ym * zm, dof,
+					relTolerance3D, packBuffer3D, PETSC_COMM_WORLD));
 
-	if (solverHandler.moveSurface()) {
-		// Write the surface positions in the concentration sub group
-		tsGroup->writeSurface3D(surfaceIndices, nInterstitial3D,
-				previousIFlux3D);
-	}
-
-	// Loop on the full grid
-	for (PetscInt k = 0; k < Mz; k++) {
-		for (PetscInt j = 0; j < My; j++) {
-			for (PetscInt i = 0; i < Mx; i++) {
-				// Wait for all the processes
-				MPI_Barrier(PETSC_COMM_WORLD);
-
-				// Size of the concentration that will be stored
-				int concSize = -1;
-				// To save which proc has the information
-				int concId = 0;
-				// To know which process should write
-				bool write = false;
+	// Restore the solutionArray
+	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
+	CHKERRQ(ierr);
 
-				// If it is the locally owned part of the grid
-				if (i >= xs && i < xs + xm && j >= ys && j < ys + ym && k >= zs
-						&& k < zs + zm) {
-					write = true;
-					// Get the pointer to the beginning of the solution data for this grid point
-					gridPointSolution = solutionArray[k][j][i];
+	// The analysis file always has the full concentrations
+	auto fullConcs = concs;
+
+	// In between keyframes, only write what changed since the last one
+	int keyTimeStep = -1;
+	if (keyframeConcs3D && nDeltas3D < keyframeStride3D - 1
+			&& keyframeConcs3D->size() == concs->size()) {
+		concs = std::make_shared<XFile::TimestepGroup::Concs1DType>(
+				XFile::TimestepGroup::makeDelta(*keyframeConcs3D, *concs,
+						deltaTolerance3D));
+		keyTimeStep = keyframeTimeStep3D;
+		nDeltas3D++;
+	} else if (keyframeStride3D > 1) {
+		keyframeConcs3D = concs;
+		keyframeTimeStep3D = timestep;
+		nDeltas3D = 0;
+	}
 
-					// Loop on the concentrations
-					for (int l = 0; l < dof; l++) {
-						if (std::fabs(gridPointSolution[l]) > 1.0e-16) {
-							// Increase concSize
-							concSize++;
-							// Fill the concArray
-							concArray[concSize][0] = (double) l;
-							concArray[concSize][1] = gridPointSolution[l];
-						}
+	// Copy everything else the writer needs, the monitors
+	// will change the globals while it writes
+	auto prevTime = previousTime;
+	auto compression = solverHandler.getCheckpointCompression();
+	auto checkpointName = hdf5OutputName3D;
+	auto nKept = nKeptTimeSteps3D;
+	auto analysisName = analysisName3D;
+	auto analysisCompression = solverHandler.getAnalysisCompression();
+	if (analysisBits3D > 0)
+		analysisCompression.lossyBits = analysisBits3D;
+	bool analysisConcs = analysisConcs3D;
+	bool writeSurface = solverHandler.moveSurface();
+	auto nInter = nInterstitial3D, prevIFlux = previousIFlux3D;
+
+	// Write the snapshot to the checkpoint file, in the background
+	// if the writer is asynchronous
+	auto checkpointWriter = (xolotlCore::CheckpointWriter *) ictx;
+	checkpointWriter->submit(
+			[=](MPI_Comm comm) {
+				// Add a concentration time step group for the current time step
+				// to the given file, with everything but the concentrations
+				auto addTimestepGroup = [&](xolotlCore::XFile& file)
+				-> std::unique_ptr<xolotlCore::XFile::TimestepGroup> {
+					auto concGroup = file.getGroup<
+					xolotlCore::XFile::ConcentrationGroup>();
+					assert(concGroup);
+					auto tsGroup = concGroup->addTimestepGroup(timestep, time,
+							prevTime, currentTimeStep);
+
+					if (writeSurface) {
+						// Write the surface positions in the concentration sub group
+						tsGroup->writeSurface3D(surfaceIndices, nInter, prevIFlux);
 					}
 
-					// Increase concSize one last time
-					concSize++;
-
-					// Save the procId
-					concId = procId;
+					return tsGroup;
+				};
+
+				// Use the checkpoint file the writer keeps open
+				auto& checkpointFile = checkpointWriter->getFile(comm,
+						checkpointName);
+				checkpointFile.setCompression(compression);
+				auto tsGroup = addTimestepGroup(checkpointFile);
+
+				// Point to the keyframe if we only have the changes
+				if (keyTimeStep >= 0)
+					tsGroup->writeKeyframe(keyTimeStep);
+
+				// Write our concentration data to the current timestep group
+				// in the HDF5 file, all the processes writing at once.
+				tsGroup->writeConcentrations(checkpointFile, xs, ys, zs, xm, ym,
+						zm, *concs);
+
+				// Make sure the checkpoint is on the disk
+				checkpointFile.flush();
+
+				// Only then forget the oldest time steps, the file being
+				// compacted from time to time
+				if (nKept > 0)
+					checkpointWriter->removeOldTimestepGroups(comm, checkpointName,
+							nKept);
+
+				// Append the time step to the analysis file
+				if (!analysisName.empty()) {
+					auto& analysisFile = checkpointWriter->getFile(comm,
+							analysisName);
+					analysisFile.setCompression(analysisCompression);
+					auto analysisTsGroup = addTimestepGroup(analysisFile);
+					if (analysisConcs)
+						analysisTsGroup->writeConcentrations(analysisFile,
+							xs, ys, zs, xm, ym, zm, *fullConcs);
+					analysisFile.flush();
 				}
-
-				// Get which processor will send the information
-				int concProc = 0;
-				MPI_Allreduce(&concId, &concProc, 1, MPI_INT, MPI_SUM,
-						PETSC_COMM_WORLD);
-
-				// Broadcast the size
-				MPI_Bcast(&concSize, 1, MPI_INT, concProc, PETSC_COMM_WORLD);
-
-				// Skip the grid point if the size is 0
-				if (concSize == 0)
-					continue;
-
-				// All processes create the dataset and fill it
-				tsGroup->writeConcentrationDataset(concSize, concArray, write, i, j,
-						k);
-			}
-		}
-	}
-
-	// Restore the solutionArray
-	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
+			});
 
 	PetscFunctionReturn(0);
 }
@@ -267,9 +295,6 @@ PetscErrorCode computeHeliumRetention3D(TS ts, PetscInt, PetscReal time,
 	// Get the physical grid in the x direction
 	auto grid = solverHandler.getXGrid();
 
-	// Get the network
-	auto& network = solverHandler.getNetwork();
-
 	// Setup step size variables
 	double hy = solverHandler.getStepSizeY();
 	double hz = solverHandler.getStepSizeZ();
@@ -279,8 +304,8 @@ PetscErrorCode computeHeliumRetention3D(TS ts, PetscInt, PetscReal time,
 	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
 
-	// Store the concentration over the grid
-	double heConcentration = 0.0, dConcentration = 0.0, tConcentration = 0.0;
+	// Store the He, D, T concentrations over the grid
+	std::array<double, 3> myConcData { };
 
 	// Loop on the grid
 	for (PetscInt zk = zs; zk < zs + zm; zk++) {
@@ -299,16 +324,9 @@ PetscErrorCode computeHeliumRetention3D(TS ts, PetscInt, PetscReal time,
 				// this grid point
 				gridPointSolution = solutionArray[zk][yj][xi];
 
-				// Update the concentration in the network
-				network.updateConcentrationsFromArray(gridPointSolution);
-
-				// Get the total helium concentration at this grid point
-				heConcentration += network.getTotalAtomConcentration(0)
-						* (grid[xi + 1] - grid[xi]) * hy * hz;
-				dConcentration += network.getTotalAtomConcentration(1)
-						* (grid[xi + 1] - grid[xi]) * hy * hz;
-				tConcentration += network.getTotalAtomConcentration(2)
-						* (grid[xi + 1] - grid[xi]) * hy * hz;
+				// Get the total atom concentrations at this grid point
+				heRetentionWeights3D.accumulate(gridPointSolution,
+						(grid[xi + 1] - grid[xi]) * hy * hz, myConcData.data());
 			}
 		}
 	}
@@ -318,15 +336,12 @@ PetscErrorCode computeHeliumRetention3D(TS ts, PetscInt, PetscReal time,
 	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
 
 	// Sum all the concentrations through MPI reduce
-	double totalHeConcentration = 0.0;
-	MPI_Reduce(&heConcentration, &totalHeConcentration, 1, MPI_DOUBLE, MPI_SUM,
-			0, PETSC_COMM_WORLD);
-	double totalDConcentration = 0.0;
-	MPI_Reduce(&dConcentration, &totalDConcentration, 1, MPI_DOUBLE, MPI_SUM, 0,
-			PETSC_COMM_WORLD);
-	double totalTConcentration = 0.0;
-	MPI_Reduce(&tConcentration, &totalTConcentration, 1, MPI_DOUBLE, MPI_SUM, 0,
-			PETSC_COMM_WORLD);
+	std::array<double, 3> totalConcData;
+	MPI_Reduce(myConcData.data(), totalConcData.data(), myConcData.size(),
+	MPI_DOUBLE, MPI_SUM, 0, PETSC_COMM_WORLD);
+	double totalHeConcentration = totalConcData[0];
+	double totalDConcentration = totalConcData[1];
+	double totalTConcentration = totalConcData[2];
 
 	// Master process
 	if (procId == 0) {
@@ -357,12 +372,10 @@ PetscErrorCode computeHeliumRetention3D(TS ts, PetscInt, PetscReal time,
 		std::cout << "Fluence = " << fluence << "\n" << std::endl;
 
 		// Uncomment to write the retention and the fluence in a file
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt", ios::app);
-		outputFile << fluence << " " << totalHeConcentration << " "
-				<< totalDConcentration << " " << totalTConcentration
-				<< std::endl;
-		outputFile.close();
+		appendTimeSeries("retentionOut",
+				{ "fluence", "helium", "deuterium", "tritium" },
+				{ fluence, totalHeConcentration, totalDConcentration,
+						totalTConcentration });
 	}
 
 	// Restore the solutionArray
@@ -424,8 +437,9 @@ PetscErrorCode computeXenonRetention3D(TS ts, PetscInt timestep, PetscReal time,
 	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
 
-	// Store the concentration and other values over the grid
-	double xeConcentration = 0.0, bubbleConcentration = 0.0, radii = 0.0;
+	// Store the xenon concentration, bubble concentration, and radii
+	// over the grid
+	std::array<double, 3> myConcData { };
 
 	// Loop on the grid
 	for (PetscInt zk = zs; zk < zs + zm; zk++) {
@@ -435,35 +449,9 @@ PetscErrorCode computeXenonRetention3D(TS ts, PetscInt timestep, PetscReal time,
 				// Get the pointer to the beginning of the solution data for this grid point
 				gridPointSolution = solutionArray[zk][yj][xi];
 
-				// Update the concentration in the network
-				network.updateConcentrationsFromArray(gridPointSolution);
-
-				// Loop on all the indices
-				for (unsigned int i = 0; i < indices3D.size(); i++) {
-					// Add the current concentration times the number of xenon in the cluster
-					// (from the weight vector)
-					xeConcentration += gridPointSolution[indices3D[i]]
-							* weights3D[i] * (grid[xi + 1] - grid[xi]) * hy
-							* hz;
-					bubbleConcentration += gridPointSolution[indices3D[i]]
-							* (grid[xi + 1] - grid[xi]) * hy * hz;
-					radii += gridPointSolution[indices3D[i]] * radii3D[i]
-							* (grid[xi + 1] - grid[xi]) * hy * hz;
-				}
-
-				// Loop on all the super clusters
-				for (auto const& superMapItem : network.getAll(
-						ReactantType::NESuper)) {
-					auto const& cluster =
-							static_cast<NESuperCluster&>(*(superMapItem.second));
-					xeConcentration += cluster.getTotalXenonConcentration()
-							* (grid[xi + 1] - grid[xi]) * hy * hz;
-					bubbleConcentration += cluster.getTotalConcentration()
-							* (grid[xi + 1] - grid[xi]) * hy * hz;
-					radii += cluster.getTotalConcentration()
-							* cluster.getReactionRadius()
-							* (grid[xi + 1] - grid[xi]) * hy * hz;
-				}
+				// Add the values of all the clusters at this grid point
+				xeRetentionWeights3D.accumulate(gridPointSolution,
+						(grid[xi + 1] - grid[xi]) * hy * hz, myConcData.data());
 			}
 		}
 	}
@@ -473,20 +461,17 @@ PetscErrorCode computeXenonRetention3D(TS ts, PetscInt timestep, PetscReal time,
 	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
 
 	// Sum all the concentrations through MPI reduce
-	double totalXeConcentration = 0.0;
-	MPI_Reduce(&xeConcentration, &totalXeConcentration, 1, MPI_DOUBLE,
-	MPI_SUM, 0, PETSC_COMM_WORLD);
-	double totalBubbleConcentration = 0.0;
-	MPI_Reduce(&bubbleConcentration, &totalBubbleConcentration, 1,
-	MPI_DOUBLE,
-	MPI_SUM, 0, MPI_COMM_WORLD);
-	double totalRadii = 0.0;
-	MPI_Reduce(&radii, &totalRadii, 1, MPI_DOUBLE, MPI_SUM, 0,
-	MPI_COMM_WORLD);
+	std::array<double, 3> totalConcData;
+	MPI_Reduce(myConcData.data(), totalConcData.data(), myConcData.size(),
+	MPI_DOUBLE, MPI_SUM, 0, PETSC_COMM_WORLD);
+	double totalXeConcentration = totalConcData[0];
+	double totalBubbleConcentration = totalConcData[1];
+	double totalRadii = totalConcData[2];
 
 	// GB
-	// Get the delta time from the previous timestep to this timestep
-	double dt = time - previousTime;
+	// Get the delta time since the flux was computed, which can be several
+	// time steps depending on the schedule
+	double dt = time - gbFluxTime3D;
 	// Compute the total number of Xe that went to the GB
 	nXenon3D += previousXeFlux3D * dt;
 
@@ -551,6 +536,7 @@ PetscErrorCode computeXenonRetention3D(TS ts, PetscInt timestep, PetscReal time,
 	}
 	// Update the xenon flux
 	previousXeFlux3D = newFlux;
+	gbFluxTime3D = time;
 
 	// Master process
 	if (procId == 0) {
@@ -572,14 +558,12 @@ PetscErrorCode computeXenonRetention3D(TS ts, PetscInt timestep, PetscReal time,
 				<< std::endl;
 
 		// Uncomment to write the retention and the fluence in a file
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt", ios::app);
-		outputFile << time << " " << 100.0 * (totalXeConcentration / (fluence))
-				<< " " << totalXeConcentration << " "
-				<< fluence - totalXeConcentration << " "
-				<< totalRadii / totalBubbleConcentration << " "
-				<< nXenon3D / surface << std::endl;
-		outputFile.close();
+		appendTimeSeries("retentionOut",
+				{ "time", "retention", "xenon", "xenonReleased", "meanRadius",
+						"xenonGB" },
+				{ time, 100.0 * (totalXeConcentration / (fluence)),
+						totalXeConcentration, fluence - totalXeConcentration,
+						totalRadii / totalBubbleConcentration, nXenon3D / surface });
 	}
 
 	// Restore the solutionArray
@@ -602,10 +586,6 @@ PetscErrorCode computeTRIDYN3D(TS ts, PetscInt timestep, PetscReal time,
 
 	PetscFunctionBeginUser;
 
-	// Get the number of processes
-	int worldSize;
-	MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
-
 	// Gets the process ID
 	int procId;
 	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
@@ -613,9 +593,6 @@ PetscErrorCode computeTRIDYN3D(TS ts, PetscInt timestep, PetscReal time,
 	// Get the solver handler
 	auto& solverHandler = PetscSolver::getSolverHandler();
 
-	// Get the network
-	auto& network = solverHandler.getNetwork();
-
 	// Get the da from ts
 	DM da;
 	ierr = TSGetDM(ts, &da);
@@ -640,79 +617,59 @@ PetscErrorCode computeTRIDYN3D(TS ts, PetscInt timestep, PetscReal time,
 	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
 
-	// Create the output file
-	std::ofstream outputFile;
-	if (procId == 0) {
-		std::stringstream name;
-		name << "TRIDYN_" << timestep << ".dat";
-		outputFile.open(name.str());
-	}
-
-	// Loop on the entire grid
-	for (int xi = 0; xi < Mx; xi++) {
-		// Set x
-		double x = grid[xi + 1] - grid[1];
+	// The He, D, T, V, I concentrations summed over the local grid points
+	// at each of our depths
+	constexpr auto numConcSpecies = 5;
+	constexpr auto numValsPerRow = numConcSpecies + 1;
+	std::vector<double> localConcs(xm * numConcSpecies, 0.0);
 
-		// Initialize the concentrations at this grid point
-		double heLocalConc = 0.0, dLocalConc = 0.0, tLocalConc = 0.0,
-				vLocalConc = 0.0, iLocalConc = 0.0;
-
-		// Loop on the y
+	// Loop on the locally owned part of the grid
+	for (PetscInt zk = zs; zk < zs + zm; zk++) {
 		for (PetscInt yj = ys; yj < ys + ym; yj++) {
-			// Loop on the z
-			for (PetscInt zk = zs; zk < zs + zm; zk++) {
-				// Get the surface position
-				int surfacePos = solverHandler.getSurfacePosition(yj, zk);
-				// Boundary conditions
-				if (xi < surfacePos)
-					continue;
-
-				// If it is the locally owned part of the grid
-				if (xi >= xs && xi < xs + xm) {
-					// Get the pointer to the beginning of the solution data for this grid point
-					gridPointSolution = solutionArray[zk][yj][xi];
-
-					// Update the concentration in the network
-					network.updateConcentrationsFromArray(gridPointSolution);
+			// Get the surface position
+			int surfacePos = solverHandler.getSurfacePosition(yj, zk);
+			for (PetscInt xi = std::max(xs, (PetscInt) surfacePos);
+					xi < xs + xm; xi++) {
+				// Get the pointer to the beginning of the solution data for this grid point
+				gridPointSolution = solutionArray[zk][yj][xi];
 
-					// Get the total helium concentration at this grid point
-					heLocalConc += gridPointSolution[0];
-					dLocalConc += gridPointSolution[1];
-					tLocalConc += network.getTotalAtomConcentration(2);
-					vLocalConc += network.getTotalVConcentration();
-					iLocalConc += network.getTotalIConcentration();
-				}
+				// Get the total concentrations at this grid point
+				tridynWeights3D.accumulate(gridPointSolution, 1.0,
+						&localConcs[(xi - xs) * numConcSpecies]);
 			}
 		}
+	}
 
-		double heConc = 0.0, dConc = 0.0, tConc = 0.0, vConc = 0.0, iConc = 0.0;
-		MPI_Reduce(&heLocalConc, &heConc, 1, MPI_DOUBLE, MPI_SUM, 0,
-				PETSC_COMM_WORLD);
-		MPI_Reduce(&dLocalConc, &dConc, 1, MPI_DOUBLE, MPI_SUM, 0,
-				PETSC_COMM_WORLD);
-		MPI_Reduce(&tLocalConc, &tConc, 1, MPI_DOUBLE, MPI_SUM, 0,
-				PETSC_COMM_WORLD);
-		MPI_Reduce(&vLocalConc, &vConc, 1, MPI_DOUBLE, MPI_SUM, 0,
-				PETSC_COMM_WORLD);
-		MPI_Reduce(&iLocalConc, &iConc, 1, MPI_DOUBLE, MPI_SUM, 0,
-				PETSC_COMM_WORLD);
-
-		// The master process writes computes the cumulative value and writes in the file
-		if (procId == 0) {
-			outputFile
-					<< x
-							- (grid[solverHandler.getSurfacePosition(0, 0) + 1]
-									- grid[1]) << " " << heConc / (My * Mz)
-					<< " " << dConc / (My * Mz) << " " << tConc / (My * Mz)
-					<< " " << vConc / (My * Mz) << " " << iConc / (My * Mz)
-					<< std::endl;
+	// Sum them over the processes sharing our depths, the first of them
+	// writing the rows
+	MPI_Comm depthComm;
+	MPI_Comm_split(PETSC_COMM_WORLD, xs, procId, &depthComm);
+	int depthId;
+	MPI_Comm_rank(depthComm, &depthId);
+	std::vector<double> concs((depthId == 0) ? localConcs.size() : 0);
+	MPI_Reduce(localConcs.data(), concs.data(), localConcs.size(), MPI_DOUBLE,
+	MPI_SUM, 0, depthComm);
+	MPI_Comm_free(&depthComm);
+
+	// Compute our rows: the depth and the average concentrations
+	const PetscInt myNumRows = (depthId == 0) ? xm : 0;
+	const double surfaceDepth = grid[solverHandler.getSurfacePosition(0, 0)
+			+ 1] - grid[1];
+	std::vector<double> myRows(myNumRows * numValsPerRow);
+	for (PetscInt i = 0; i < myNumRows; i++) {
+		auto row = &myRows[i * numValsPerRow];
+		row[0] = grid[xs + i + 1] - grid[1] - surfaceDepth;
+		for (int n = 0; n < numConcSpecies; n++) {
+			row[n + 1] = concs[i * numConcSpecies + n] / (My * Mz);
 		}
 	}
 
-	// Close the file
-	if (procId == 0) {
-		outputFile.close();
-	}
+	// Write the profile, once the checkpoint writer is done with HDF5
+	auto format = getTRIDYNFormat(false);
+	if (format == TRIDYNFormat::HDF5)
+		waitForCheckpointWriter();
+	writeTRIDYNProfile(PETSC_COMM_WORLD, timestep, format, Mx, numValsPerRow,
+			xs, myRows);
 
 	// Restore the solutionArray
 	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
@@ -737,10 +694,6 @@ PetscErrorCode monitorSurfaceXY3D(TS ts, PetscInt timestep, PetscReal time,
 
 	PetscFunctionBeginUser;
 
-	// Don't do anything if it is not on the stride
-	if (timestep % 10 != 0)
-		PetscFunctionReturn(0);
-
 	// Gets the process ID
 	int procId;
 	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
@@ -882,10 +835,6 @@ PetscErrorCode monitorSurfaceXZ3D(TS ts, PetscInt timestep, PetscReal time,
 
 	PetscFunctionBeginUser;
 
-	// Don't do anything if it is not on the stride
-	if (timestep % 10 != 0)
-		PetscFunctionReturn(0);
-
 	// Gets the process ID
 	int procId;
 	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
@@ -1071,21 +1020,23 @@ PetscErrorCode eventFunction3D(TS ts, PetscReal time, Vec solution,
 	if (solverHandler.moveSurface()) {
 		// Write the initial surface positions
 		if (procId == 0 && xolotlCore::equal(time, 0.0)) {
-			std::ofstream outputFile;
-			outputFile.open("surface.txt", ios::app);
-			outputFile << time << " ";
+			std::vector<std::string> columns = { "time" };
+			std::vector<double> row = { time };
 
 			// Loop on the possible yj
 			for (yj = 0; yj < My; yj++) {
 				for (zk = 0; zk < Mz; zk++) {
 					// Get the position of the surface at yj, zk
 					int surfacePos = solverHandler.getSurfacePosition(yj, zk);
-					outputFile << (double) yj * hy << " " << (double) zk * hz
-							<< " " << grid[surfacePos + 1] - grid[1] << " ";
+					std::string suffix = "_" + std::to_string(yj) + "_"
+							+ std::to_string(zk);
+					columns.insert(columns.end(),
+							{ "y" + suffix, "z" + suffix, "surface" + suffix });
+					row.insert(row.end(), { (double) yj * hy, (double) zk * hz,
+							grid[surfacePos + 1] - grid[1] });
 				}
 			}
-			outputFile << std::endl;
-			outputFile.close();
+			appendTimeSeries("surface", columns, row);
 		}
 
 		// Get the initial vacancy concentration
@@ -1281,6 +1232,9 @@ PetscErrorCode postEventFunction3D(TS ts, PetscInt nevents,
 	if (nevents == 0)
 		PetscFunctionReturn(0);
 
+	// The monitors sampling the events are due at the next time step
+	MonitorSchedule::notifyEvent();
+
 	// Gets the process ID
 	int procId;
 	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
@@ -1579,21 +1533,23 @@ PetscErrorCode postEventFunction3D(TS ts, PetscInt nevents,
 
 	// Write the surface positions
 	if (procId == 0) {
-		std::ofstream outputFile;
-		outputFile.open("surface.txt", ios::app);
-		outputFile << time << " ";
+		std::vector<std::string> columns = { "time" };
+		std::vector<double> row = { time };
 
 		// Loop on the possible yj
 		for (yj = 0; yj < My; yj++) {
 			for (zk = 0; zk < Mz; zk++) {
 				// Get the position of the surface at yj, zk
 				int surfacePos = solverHandler.getSurfacePosition(yj, zk);
-				outputFile << (double) yj * hy << " " << (double) zk * hz << " "
-						<< grid[surfacePos + 1] - grid[1] << " ";
+				std::string suffix = "_" + std::to_string(yj) + "_"
+						+ std::to_string(zk);
+				columns.insert(columns.end(),
+						{ "y" + suffix, "z" + suffix, "surface" + suffix });
+				row.insert(row.end(), { (double) yj * hy, (double) zk * hz,
+						grid[surfacePos + 1] - grid[1] });
 			}
 		}
-		outputFile << std::endl;
-		outputFile.close();
+		appendTimeSeries("surface", columns, row);
 	}
 
 	// Restore the solutionArray
@@ -1621,7 +1577,7 @@ PetscErrorCode setupPetsc3DMonitor(TS ts) {
 
 	// Flags to launch the monitors or not
 	PetscBool flagCheck, flagPerf, flagHeRetention, flagXeRetention, flagStatus, flag2DXYPlot,
-			flag2DXZPlot, flagTRIDYN;
+			flag2DXZPlot, flagTRIDYN, flagTelemetry;
 
 	// Check the option -check_collapse
 	ierr = PetscOptionsHasName(NULL, NULL, "-check_collapse", &flagCheck);
@@ -1633,6 +1589,11 @@ PetscErrorCode setupPetsc3DMonitor(TS ts) {
 	checkPetscError(ierr,
 			"setupPetsc3DMonitor: PetscOptionsHasName (-plot_perf) failed.");
 
+	// Check the option -telemetry
+	ierr = PetscOptionsHasName(NULL, NULL, "-telemetry", &flagTelemetry);
+	checkPetscError(ierr,
+			"setupPetsc3DMonitor: PetscOptionsHasName (-telemetry) failed.");
+
 	// Check the option -plot_2d_xy
 	ierr = PetscOptionsHasName(NULL, NULL, "-plot_2d_xy", &flag2DXYPlot);
 	checkPetscError(ierr,
@@ -1720,21 +1681,63 @@ PetscErrorCode setupPetsc3DMonitor(TS ts) {
 	// Set the monitor to save the status of the simulation in hdf5 file
 	if (flagStatus) {
 		// Find the stride to know how often the HDF5 file has to be written
+		PetscReal hdf5Stride = 0.0;
 		PetscBool flag;
-		ierr = PetscOptionsGetReal(NULL, NULL, "-start_stop", &hdf5Stride3D,
+		ierr = PetscOptionsGetReal(NULL, NULL, "-start_stop", &hdf5Stride,
 				&flag);
 		checkPetscError(ierr,
 				"setupPetsc3DMonitor: PetscOptionsGetInt (-start_stop) failed.");
 		if (!flag)
-			hdf5Stride3D = 1.0;
+			hdf5Stride = 1.0;
 
-		// Compute the correct hdf5Previous3D for a restart
+		// Find how often a full checkpoint is written, and the
+		// relative change to write in the ones in between
+		ierr = PetscOptionsGetInt(NULL, NULL, "-start_stop_keyframe",
+				&keyframeStride3D, NULL);
+		checkPetscError(ierr,
+				"setupPetsc3DMonitor: PetscOptionsGetInt (-start_stop_keyframe) failed.");
+		ierr = PetscOptionsGetReal(NULL, NULL, "-start_stop_delta_tol",
+				&deltaTolerance3D, NULL);
+		checkPetscError(ierr,
+				"setupPetsc3DMonitor: PetscOptionsGetReal (-start_stop_delta_tol) failed.");
+
+		// Find how many time steps are kept in the checkpoint file
+		ierr = PetscOptionsGetInt(NULL, NULL, "-start_stop_keep",
+				&nKeptTimeSteps3D, NULL);
+		checkPetscError(ierr,
+				"setupPetsc3DMonitor: PetscOptionsGetInt (-start_stop_keep) failed.");
+
+		// Find the analysis file and what is written in it
+		char analysisName[PETSC_MAX_PATH_LEN];
+		PetscBool flagAnalysis, flagNoConcs;
+		ierr = PetscOptionsGetString(NULL, NULL, "-start_stop_analysis",
+				analysisName, PETSC_MAX_PATH_LEN, &flagAnalysis);
+		checkPetscError(ierr,
+				"setupPetsc3DMonitor: PetscOptionsGetString (-start_stop_analysis) failed.");
+		if (flagAnalysis)
+			analysisName3D = analysisName;
+		ierr = PetscOptionsGetInt(NULL, NULL, "-start_stop_analysis_bits",
+				&analysisBits3D, NULL);
+		checkPetscError(ierr,
+				"setupPetsc3DMonitor: PetscOptionsGetInt (-start_stop_analysis_bits) failed.");
+		ierr = PetscOptionsHasName(NULL, NULL, "-start_stop_analysis_no_concs",
+				&flagNoConcs);
+		checkPetscError(ierr,
+				"setupPetsc3DMonitor: PetscOptionsHasName (-start_stop_analysis_no_concs) failed.");
+		analysisConcs3D = !flagNoConcs;
+
+		// Find the relative tolerance of the concentrations to write
+		ierr = PetscOptionsGetReal(NULL, NULL, "-start_stop_rel_tol",
+				&relTolerance3D, NULL);
+		checkPetscError(ierr,
+				"setupPetsc3DMonitor: PetscOptionsGetReal (-start_stop_rel_tol) failed.");
+
+		// Get the previous time if concentrations were stored
 		if (hasConcentrations) {
 			assert(lastTsGroup);
 
 			// Get the previous time from the HDF5 file
 			previousTime = lastTsGroup->readPreviousTime();
-			hdf5Previous3D = (int) (previousTime / hdf5Stride3D);
 		}
 
 		// Don't do anything if both files have the same name
@@ -1775,10 +1778,20 @@ PetscErrorCode setupPetsc3DMonitor(TS ts) {
 					hdf5OutputName3D, network);
 		}
 
-		// startStop3D will be called at each timestep
-		ierr = TSMonitorSet(ts, startStop3D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc3DMonitor: TSMonitorSet (startStop3D) failed.");
+		// Create the analysis file, it does not need the network
+		// as it is not meant to restart from
+		if (!analysisName3D.empty()) {
+			xolotlCore::XFile analysisFile(analysisName3D,
+					solverHandler.getXGrid(), network.getCompositionList(),
+					PETSC_COMM_WORLD, My,
+					solverHandler.getStepSizeY(), Mz, solverHandler.getStepSizeZ());
+		}
+
+		// startStop3D will be called on the stride
+		setScheduledMonitor(ts, "start_stop", startStop3D,
+				createCheckpointWriter(PETSC_COMM_WORLD),
+				destroyCheckpointWriter,
+				MonitorSchedule(MonitorSchedule::Cadence::Time, hdf5Stride));
 	}
 
 	// If the user wants the surface to be able to move
@@ -1813,9 +1826,7 @@ PetscErrorCode setupPetsc3DMonitor(TS ts) {
 			sputteringYield3D = solverHandler.getSputteringYield();
 
 			// Clear the file where the surface will be written
-			std::ofstream outputFile;
-			outputFile.open("surface.txt");
-			outputFile.close();
+			clearTimeSeries("surface");
 		}
 
 		// Bursting
@@ -1861,14 +1872,15 @@ PetscErrorCode setupPetsc3DMonitor(TS ts) {
 			perfPlot->setDataProvider(dataProvider);
 		}
 
-		// monitorPerf will be called at each timestep
-		ierr = TSMonitorSet(ts, monitorPerf, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc3DMonitor: TSMonitorSet (monitorPerf) failed.");
+		// monitorPerf will be called on its schedule
+		setScheduledMonitor(ts, "plot_perf", monitorPerf, NULL, NULL);
 	}
 
 	// Set the monitor to compute the helium fluence for the retention calculation
 	if (flagHeRetention) {
+		// Compute the contents from the solution directly
+		heRetentionWeights3D = createHeliumRetentionWeights(network);
+
 
 		// Get the previous time if concentrations were stored and initialize the fluence
 		if (hasConcentrations) {
@@ -1890,31 +1902,19 @@ PetscErrorCode setupPetsc3DMonitor(TS ts) {
 		checkPetscError(ierr,
 				"setupPetsc3DMonitor: TSMonitorSet (computeFluence) failed.");
 
-		// computeHeliumRetention3D will be called at each timestep
-		ierr = TSMonitorSet(ts, computeHeliumRetention3D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc3DMonitor: TSMonitorSet (computeHeliumRetention3D) failed.");
+		// computeHeliumRetention3D will be called on its schedule
+		setScheduledMonitor(ts, "helium_retention", computeHeliumRetention3D,
+				NULL, NULL);
 
 		// Uncomment to clear the file where the retention will be written
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt");
-		outputFile.close();
+		clearTimeSeries("retentionOut");
 	}
 
 	// Set the monitor to compute the xenon fluence and the retention
 	// for the retention calculation
 	if (flagXeRetention) {
-		// Loop on the xenon clusters
-		for (auto const& xeMapItem : network.getAll(ReactantType::Xe)) {
-			auto const& cluster = *(xeMapItem.second);
-
-			int id = cluster.getId() - 1;
-			// Add the Id to the vector
-			indices3D.push_back(id);
-			// Add the number of xenon of this cluster to the weight
-			weights3D.push_back(cluster.getSize());
-			radii3D.push_back(cluster.getReactionRadius());
-		}
+		// Compute the retention from the solution directly
+		xeRetentionWeights3D = createXenonRetentionWeights(network);
 
 		// Get the previous time if concentrations were stored and initialize the fluence
 		if (hasConcentrations) {
@@ -1939,15 +1939,14 @@ PetscErrorCode setupPetsc3DMonitor(TS ts) {
 		checkPetscError(ierr,
 				"setupPetsc3DMonitor: TSMonitorSet (computeFluence) failed.");
 
-		// computeXenonRetention3D will be called at each timestep
-		ierr = TSMonitorSet(ts, computeXenonRetention3D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc3DMonitor: TSMonitorSet (computeXenonRetention3D) failed.");
+		// computeXenonRetention3D will be called on its schedule, the flux
+		// to the GB being computed from the previous time
+		gbFluxTime3D = previousTime;
+		setScheduledMonitor(ts, "xenon_retention", computeXenonRetention3D,
+				NULL, NULL);
 
 		// Uncomment to clear the file where the retention will be written
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt");
-		outputFile.close();
+		clearTimeSeries("retentionOut");
 	}
 
 	// Set the monitor to save surface plots of clusters concentration
@@ -1976,10 +1975,9 @@ PetscErrorCode setupPetsc3DMonitor(TS ts) {
 			surfacePlotXY3D->setDataProvider(dataProvider);
 		}
 
-		// monitorSurfaceXY3D will be called at each timestep
-		ierr = TSMonitorSet(ts, monitorSurfaceXY3D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc3DMonitor: TSMonitorSet (monitorSurfaceXY3D) failed.");
+		// monitorSurfaceXY3D will be called on its schedule
+		setScheduledMonitor(ts, "plot_2d_xy", monitorSurfaceXY3D, NULL, NULL,
+				MonitorSchedule(MonitorSchedule::Cadence::Steps, 10));
 	}
 
 	// Set the monitor to save surface plots of clusters concentration
@@ -2008,18 +2006,28 @@ PetscErrorCode setupPetsc3DMonitor(TS ts) {
 			surfacePlotXZ3D->setDataProvider(dataProvider);
 		}
 
-		// monitorSurfaceXZ3D will be called at each timestep
-		ierr = TSMonitorSet(ts, monitorSurfaceXZ3D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc3DMonitor: TSMonitorSet (monitorSurfaceXZ3D) failed.");
+		// monitorSurfaceXZ3D will be called on its schedule
+		setScheduledMonitor(ts, "plot_2d_xz", monitorSurfaceXZ3D, NULL, NULL,
+				MonitorSchedule(MonitorSchedule::Cadence::Steps, 10));
 	}
 
 	// Set the monitor to output data for TRIDYN
 	if (flagTRIDYN) {
-		// computeTRIDYN3D will be called at each timestep
-		ierr = TSMonitorSet(ts, computeTRIDYN3D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc3DMonitor: TSMonitorSet (computeTRIDYN3D) failed.");
+		// Compute the contents from the solution directly
+		tridynWeights3D = createTRIDYNWeights(network);
+
+		// computeTRIDYN3D will be called on its schedule
+		setScheduledMonitor(ts, "tridyn", computeTRIDYN3D, NULL, NULL);
+	}
+
+	// Set the monitor to write what the solver did since the previous sample
+	if (flagTelemetry) {
+		// Register what is sampled and clear the file where the
+		// telemetry will be written
+		startTelemetry();
+
+		// monitorTelemetry will be called at each timestep by default
+		setScheduledMonitor(ts, "telemetry", monitorTelemetry, NULL, NULL);
 	}
 
 	// Set the monitor to simply change the previous time to the new time
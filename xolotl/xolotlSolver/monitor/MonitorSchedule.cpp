@@ -0,0 +1,198 @@
+// Includes
+#include "PetscSolver.h"
+#include <petscts.h>
+#include <petscsys.h>
+#include <cmath>
+#include <sstream>
+#include "xolotlSolver/monitor/MonitorSchedule.h"
+
+namespace xolotlSolver {
+
+// Declaration of the variables defined in Monitor.cpp
+extern double previousTime;
+
+unsigned long MonitorSchedule::nEvents = 0;
+PetscInt MonitorSchedule::nRejections = 0;
+
+MonitorSchedule::MonitorSchedule(Cadence _cadence, double _interval) :
+		cadence(_cadence), interval(_interval), started(false), previousIndex(
+				0), nextTime(0.0), nSampledEvents(0), nSampledRejections(0) {
+}
+
+MonitorSchedule MonitorSchedule::fromString(const std::string& desc) {
+
+	// Split the kind and the interval
+	auto sep = desc.find(':');
+	std::string kind = desc.substr(0, sep);
+	double value = 0.0;
+	if (sep != std::string::npos) {
+		std::istringstream valueStream(desc.substr(sep + 1));
+		if (!(valueStream >> value))
+			value = 0.0;
+	}
+
+	if (kind == "events")
+		return MonitorSchedule(Cadence::Events);
+	if (kind == "rejections")
+		return MonitorSchedule(Cadence::Rejections);
+	if (value > 0.0) {
+		// A number of steps is a whole number, at least one
+		if (kind == "steps" && value >= 1.0 && value == std::floor(value))
+			return MonitorSchedule(Cadence::Steps, value);
+		if (kind == "time")
+			return MonitorSchedule(Cadence::Time, value);
+		if (kind == "log")
+			return MonitorSchedule(Cadence::LogTime, value);
+	}
+
+	throw std::string(
+			"\nxolotlSolver::Monitor: invalid cadence \"" + desc
+					+ "\", use steps:N, time:dt, log:N, events, or rejections.");
+}
+
+bool MonitorSchedule::isDue(PetscInt timestep, PetscReal time, PetscReal dt) {
+
+	bool isFirst = !started;
+	started = true;
+
+	switch (cadence) {
+	case Cadence::Steps:
+		return isFirst || (timestep % (long) interval == 0);
+	case Cadence::Time: {
+		// Same tolerance as the previous strides, a step ending just
+		// before the next multiple of the interval samples it
+		long index = (long) ((time + dt / 10.0) / interval);
+		if (!isFirst && index <= previousIndex)
+			return false;
+		previousIndex = index;
+		return true;
+	}
+	case Cadence::LogTime:
+		if (!isFirst && time < nextTime)
+			return false;
+		nextTime = time * std::pow(10.0, 1.0 / interval);
+		return true;
+	case Cadence::Events:
+		if (!isFirst && nSampledEvents == nEvents)
+			return false;
+		nSampledEvents = nEvents;
+		return true;
+	case Cadence::Rejections:
+		if (!isFirst && nSampledRejections == nRejections)
+			return false;
+		nSampledRejections = nRejections;
+		return true;
+	}
+
+	return true;
+}
+
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "MonitorSchedule::readRejections")
+PetscErrorCode MonitorSchedule::readRejections(TS ts) {
+
+	PetscErrorCode ierr;
+
+	PetscFunctionBeginUser;
+
+	ierr = TSGetStepRejections(ts, &nRejections);
+	CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+
+MonitorSchedule getMonitorSchedule(const std::string& name,
+		const MonitorSchedule& defaultSchedule) {
+
+	// Look for the cadence option
+	std::string optionName = "-" + name + "_cadence";
+	char desc[PETSC_MAX_PATH_LEN];
+	PetscBool flag;
+	PetscErrorCode ierr = PetscOptionsGetString(NULL, NULL,
+			optionName.c_str(), desc, PETSC_MAX_PATH_LEN, &flag);
+	checkPetscError(ierr,
+			"getMonitorSchedule: PetscOptionsGetString (cadence) failed.");
+
+	if (!flag)
+		return defaultSchedule;
+
+	return MonitorSchedule::fromString(desc);
+}
+
+/**
+ * The context of a scheduled monitor.
+ */
+struct ScheduledMonitor {
+	//! The monitor function.
+	MonitorFunction monitor;
+
+	//! Its context.
+	void *ctx;
+
+	//! The function destroying its context.
+	MonitorDestroyFunction destroy;
+
+	//! When it is called.
+	MonitorSchedule schedule;
+};
+
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "monitorScheduled")
+/**
+ * This is a monitoring method that calls the monitor given in its context
+ * when it is due.
+ */
+PetscErrorCode monitorScheduled(TS ts, PetscInt timestep, PetscReal time,
+		Vec solution, void *ictx) {
+
+	PetscErrorCode ierr;
+
+	PetscFunctionBeginUser;
+
+	auto scheduled = (ScheduledMonitor *) ictx;
+
+	// Don't do anything if it is not due
+	ierr = MonitorSchedule::readRejections(ts);
+	CHKERRQ(ierr);
+	if (!scheduled->schedule.isDue(timestep, time, time - previousTime))
+		PetscFunctionReturn(0);
+
+	ierr = scheduled->monitor(ts, timestep, time, solution, scheduled->ctx);
+	CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "destroyScheduledMonitor")
+PetscErrorCode destroyScheduledMonitor(void **ctx) {
+
+	PetscErrorCode ierr;
+
+	PetscFunctionBeginUser;
+
+	auto scheduled = (ScheduledMonitor *) *ctx;
+	if (scheduled->destroy) {
+		ierr = scheduled->destroy(&scheduled->ctx);
+		CHKERRQ(ierr);
+	}
+	delete scheduled;
+	*ctx = NULL;
+
+	PetscFunctionReturn(0);
+}
+
+void setScheduledMonitor(TS ts, const std::string& name,
+		MonitorFunction monitor, void *ctx, MonitorDestroyFunction destroy,
+		const MonitorSchedule& defaultSchedule) {
+
+	auto scheduled = new ScheduledMonitor { monitor, ctx, destroy,
+			getMonitorSchedule(name, defaultSchedule) };
+
+	PetscErrorCode ierr = TSMonitorSet(ts, monitorScheduled, scheduled,
+			destroyScheduledMonitor);
+	checkPetscError(ierr,
+			"setScheduledMonitor: TSMonitorSet (monitorScheduled) failed.");
+}
+
+} // namespace xolotlSolver
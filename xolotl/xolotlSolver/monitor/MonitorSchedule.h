@@ -0,0 +1,149 @@
+#ifndef XSOLVER_MONITORSCHEDULE_H
+#define XSOLVER_MONITORSCHEDULE_H
+
+// Includes
+#include <petscts.h>
+#include <string>
+
+namespace xolotlSolver {
+
+/**
+ * The cadence at which a monitor samples the solution: every N time steps,
+ * every dt of simulated time, a number of times per decade of simulated
+ * time, after the events (surface motion, bursting), or after the time
+ * stepper rejected steps. Every schedule is due at the first time step it
+ * sees, including the first one after a restart since the time steps are
+ * counted from 0 again (the start/stop checkpoints were always written at
+ * the time step 0).
+ */
+class MonitorSchedule {
+public:
+	/**
+	 * The kinds of cadence.
+	 */
+	enum class Cadence {
+		Steps, Time, LogTime, Events, Rejections
+	};
+
+private:
+	//! The kind of cadence.
+	Cadence cadence;
+
+	//! The number of steps, the simulated time, or the number of samples
+	//! per decade between two samples.
+	double interval;
+
+	//! Whether the schedule saw a time step already.
+	bool started;
+
+	//! The index of the last time interval sampled.
+	long previousIndex;
+
+	//! The time of the next sample on the log scale.
+	double nextTime;
+
+	//! The number of events already sampled.
+	unsigned long nSampledEvents;
+
+	//! The number of events that happened since the beginning.
+	static unsigned long nEvents;
+
+	//! The number of rejected steps already sampled.
+	PetscInt nSampledRejections;
+
+	//! The number of steps rejected by the time stepper.
+	static PetscInt nRejections;
+
+public:
+	/**
+	 * Construct a schedule, due at every time step by default.
+	 *
+	 * @param _cadence The kind of cadence
+	 * @param _interval The steps, time, or samples per decade between
+	 * two samples, unused for the events and rejections
+	 */
+	MonitorSchedule(Cadence _cadence = Cadence::Steps, double _interval = 1.0);
+
+	/**
+	 * Create a schedule from its description: "steps:N" with N a whole
+	 * number at least 1, "time:dt", "log:N" for N samples per decade,
+	 * "events", or "rejections".
+	 * Throws an error message if the description is not valid.
+	 *
+	 * @param desc The description
+	 * @return The schedule
+	 */
+	static MonitorSchedule fromString(const std::string& desc);
+
+	/**
+	 * Whether the monitor has to sample the current time step, in which
+	 * case the schedule moves to its next sample.
+	 *
+	 * @param timestep The time step number
+	 * @param time The current time
+	 * @param dt The length of the current time step
+	 * @return True if the monitor is due
+	 */
+	bool isDue(PetscInt timestep, PetscReal time, PetscReal dt);
+
+	/**
+	 * Tell every schedule that an event happened, the ones on events
+	 * being due at the next time step.
+	 */
+	static void notifyEvent() {
+		nEvents++;
+	}
+
+	/**
+	 * Read the number of steps rejected by the time stepper, the schedules
+	 * on rejections being due when it grew. It has to be called before
+	 * isDue().
+	 *
+	 * @param ts The time stepper
+	 * @return The PETSc error code
+	 */
+	static PetscErrorCode readRejections(TS ts);
+};
+
+/**
+ * The type of the PETSc monitor functions.
+ */
+typedef PetscErrorCode (*MonitorFunction)(TS, PetscInt, PetscReal, Vec,
+		void *);
+
+/**
+ * The type of the PETSc monitor context destroy functions.
+ */
+typedef PetscErrorCode (*MonitorDestroyFunction)(void **);
+
+/**
+ * Get the schedule of a monitor from the option -<name>_cadence,
+ * or the default one if the option is not used.
+ * Throws an error message if the option is not valid.
+ *
+ * @param name The name of the monitor option, without the dash
+ * @param defaultSchedule The schedule without the option
+ * @return The schedule
+ */
+MonitorSchedule getMonitorSchedule(const std::string& name,
+		const MonitorSchedule& defaultSchedule = MonitorSchedule());
+
+/**
+ * Set a monitor that is only called, and so only reads the solution,
+ * when its schedule from getMonitorSchedule is due.
+ * Throws an error message if it cannot be set.
+ *
+ * @param ts The time stepper
+ * @param name The name of the monitor option, without the dash
+ * @param monitor The monitor function
+ * @param ctx The context of the monitor
+ * @param destroy The function destroying the context, if any
+ * @param defaultSchedule The schedule without the cadence option
+ */
+void setScheduledMonitor(TS ts, const std::string& name,
+		MonitorFunction monitor, void *ctx, MonitorDestroyFunction destroy,
+		const MonitorSchedule& defaultSchedule = MonitorSchedule());
+
+} // namespace xolotlSolver
+
+#endif // XSOLVER_MONITORSCHEDULE_H
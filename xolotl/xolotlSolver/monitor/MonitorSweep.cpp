@@ -0,0 +1,170 @@
+// Includes
+#include "PetscSolver.h"
+#include <petscts.h>
+#include <petscsys.h>
+#include <algorithm>
+#include "xolotlSolver/monitor/MonitorSweep.h"
+
+namespace xolotlSolver {
+
+// Declaration of the variables defined in Monitor.cpp
+extern double previousTime;
+
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "MonitorSweep::complete")
+PetscErrorCode MonitorSweep::complete(void) {
+
+	PetscErrorCode ierr;
+
+	PetscFunctionBeginUser;
+
+	// Nothing is pending
+	if (request == MPI_REQUEST_NULL)
+		PetscFunctionReturn(0);
+
+	// Most of the time the reduction is already over
+	MPI_Wait(&request, MPI_STATUS_IGNORE);
+
+	// Let each observable use its sums
+	for (int i = 0; i < observables.size(); i++) {
+		if (offsets[i + 1] == offsets[i])
+			continue;
+		ierr = observables[i]->finish(pendingTimestep, pendingTime,
+				sums.data() + offsets[i], writer);
+		CHKERRQ(ierr);
+	}
+
+	PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "MonitorSweep::run")
+PetscErrorCode MonitorSweep::run(TS ts, PetscInt timestep, PetscReal time,
+		Vec solution) {
+
+	// Initial declarations
+	PetscErrorCode ierr;
+	PetscInt xs, xm, Mx;
+
+	PetscFunctionBeginUser;
+
+	// The previous reduction has to be used before the observables
+	// start again
+	ierr = complete();
+	CHKERRQ(ierr);
+
+	// Find the observables due at this time step
+	ierr = MonitorSchedule::readRejections(ts);
+	CHKERRQ(ierr);
+	std::vector<bool> isDue(observables.size(), false);
+	bool anyDue = false;
+	for (int i = 0; i < observables.size(); i++) {
+		isDue[i] = schedules[i].isDue(timestep, time, time - previousTime);
+		anyDue = anyDue || isDue[i];
+	}
+
+	// Don't do anything if none of them is
+	if (!anyDue)
+		PetscFunctionReturn(0);
+
+	// Get the da from ts
+	DM da;
+	ierr = TSGetDM(ts, &da);
+	CHKERRQ(ierr);
+
+	// Get the corners of the grid
+	ierr = DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL);
+	CHKERRQ(ierr);
+
+	// Get the total size of the grid
+	ierr = DMDAGetInfo(da, PETSC_IGNORE, &Mx, PETSC_IGNORE, PETSC_IGNORE,
+	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
+	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
+	PETSC_IGNORE);
+	CHKERRQ(ierr);
+
+	// Lay out the slices of the observables in the buffer
+	offsets.assign(observables.size() + 1, 0);
+	bool usesNetwork = false, needsAll = false;
+	for (int i = 0; i < observables.size(); i++) {
+		int nValues = isDue[i] ? observables[i]->start(xs, xm, Mx) : 0;
+		offsets[i + 1] = offsets[i] + nValues;
+		if (nValues > 0) {
+			usesNetwork = usesNetwork || observables[i]->usesNetwork();
+			needsAll = needsAll || observables[i]->needsAllProcesses();
+		}
+	}
+	int nValues = offsets.back();
+
+	// Nothing to compute at this time step
+	if (nValues == 0)
+		PetscFunctionReturn(0);
+
+	localValues.assign(nValues, 0.0);
+	sums.assign(nValues, 0.0);
+
+	// Get the network to update if an observable uses it
+	auto& solverHandler = PetscSolver::getSolverHandler();
+	auto& network = solverHandler.getNetwork();
+
+	// Get the array of concentration
+	double **solutionArray;
+	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
+	CHKERRQ(ierr);
+
+	// Feed all the observables from a single pass over the local grid
+	for (PetscInt xi = xs; xi < xs + xm; xi++) {
+		// Get the pointer to the beginning of the solution data for this grid point
+		auto gridPointSolution = solutionArray[xi];
+
+		// Update the concentrations in the network once for everybody
+		if (usesNetwork)
+			network.updateConcentrationsFromArray(gridPointSolution);
+
+		for (int i = 0; i < observables.size(); i++) {
+			if (offsets[i + 1] == offsets[i])
+				continue;
+			observables[i]->accumulate(xi, gridPointSolution,
+					localValues.data() + offsets[i]);
+		}
+	}
+
+	// Restore the solutionArray
+	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
+	CHKERRQ(ierr);
+
+	// Start summing the values of all the observables at once, the
+	// observables will use them at the next sweep
+	if (needsAll) {
+		MPI_Iallreduce(localValues.data(), sums.data(), nValues, MPI_DOUBLE,
+		MPI_SUM, PETSC_COMM_WORLD, &request);
+	} else {
+		MPI_Ireduce(localValues.data(), sums.data(), nValues, MPI_DOUBLE,
+		MPI_SUM, 0, PETSC_COMM_WORLD, &request);
+	}
+	pendingTimestep = timestep;
+	pendingTime = time;
+
+	PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "destroyMonitorSweep")
+PetscErrorCode destroyMonitorSweep(void **ctx) {
+
+	PetscErrorCode ierr;
+
+	PetscFunctionBeginUser;
+
+	// Write the last observables before the files are closed, destroying
+	// the sweep even if it failed
+	auto sweep = (MonitorSweep *) *ctx;
+	ierr = sweep->complete();
+	delete sweep;
+	*ctx = NULL;
+	CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+
+} // namespace xolotlSolver
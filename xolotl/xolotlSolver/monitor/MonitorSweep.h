@@ -0,0 +1,195 @@
+#ifndef XSOLVER_MONITORSWEEP_H
+#define XSOLVER_MONITORSWEEP_H
+
+// Includes
+#include <petscts.h>
+#include <memory>
+#include <vector>
+#include "xolotlCore/io/TextFileWriter.h"
+#include "xolotlSolver/monitor/MonitorSchedule.h"
+
+namespace xolotlSolver {
+
+/**
+ * An observable computed by a monitor sweep over the local grid points.
+ * Each grid point adds its contribution to a slice of a buffer shared by
+ * all the observables of the sweep, the buffer is summed over the processes
+ * with a single reduction, and each observable then uses its sums.
+ *
+ * The reduction is not waited for during the time step it is started, so
+ * everything the observable needs in finish() has to be kept by start(),
+ * and the files should be written through the given writer.
+ */
+class SweepObservable {
+public:
+	/**
+	 * The destructor
+	 */
+	virtual ~SweepObservable() {
+	}
+
+	/**
+	 * Prepare the sweep of the current time step.
+	 *
+	 * @param xs The first local grid point in the x direction
+	 * @param xm The number of local grid points in the x direction
+	 * @param Mx The total number of grid points in the x direction
+	 * @return The number of values summed for this observable at this
+	 * time step, 0 to skip it
+	 */
+	virtual int start(PetscInt xs, PetscInt xm, PetscInt Mx) = 0;
+
+	/**
+	 * Whether the network concentrations have to be updated from the
+	 * grid point before it is accumulated.
+	 *
+	 * @return True if the network is used
+	 */
+	virtual bool usesNetwork() const {
+		return false;
+	}
+
+	/**
+	 * Whether the sums are needed on every process, instead of only
+	 * on the master process.
+	 *
+	 * @return True if every process uses the sums
+	 */
+	virtual bool needsAllProcesses() const {
+		return false;
+	}
+
+	/**
+	 * Add the contribution of a local grid point to the values,
+	 * which start at zero.
+	 *
+	 * @param xi The index of the grid point
+	 * @param concs The concentrations at the grid point
+	 * @param values The values of this observable
+	 */
+	virtual void accumulate(PetscInt xi, const double* concs,
+			double* values) = 0;
+
+	/**
+	 * Use the values summed over all the processes, at the latest before
+	 * the next call to start().
+	 *
+	 * @param timestep The time step number the values were computed at
+	 * @param time The time the values were computed at
+	 * @param sums The sums, only valid on the master process unless
+	 * needsAllProcesses() is true
+	 * @param writer The writer of the text files
+	 * @return The PETSc error code
+	 */
+	virtual PetscErrorCode finish(PetscInt timestep, PetscReal time,
+			const double* sums, xolotlCore::TextFileWriter& writer) = 0;
+};
+
+/**
+ * A sweep feeding all the enabled observables from a single pass over the
+ * local solution and a single packed reduction per time step, skipping
+ * both when none of them is due. It is meant to be the context of the
+ * sweep monitors.
+ *
+ * The reduction is nonblocking: it is completed at the next sweep, when
+ * a monitor needs its results, or by destroyMonitorSweep, so the
+ * processes don't wait for each other while monitoring. The observables
+ * write their files on a separate thread.
+ */
+class MonitorSweep {
+private:
+	//! The observables, in the order of their slices in the buffer.
+	std::vector<std::unique_ptr<SweepObservable> > observables;
+
+	//! When each observable is computed.
+	std::vector<MonitorSchedule> schedules;
+
+	//! The local values of all the observables.
+	std::vector<double> localValues;
+
+	//! The values summed over the processes.
+	std::vector<double> sums;
+
+	//! The start of the slice of each observable, equal to the next one
+	//! when it was skipped.
+	std::vector<int> offsets;
+
+	//! The reduction waiting to be completed, MPI_REQUEST_NULL if none.
+	MPI_Request request;
+
+	//! The time step number of the pending reduction.
+	PetscInt pendingTimestep;
+
+	//! The time of the pending reduction.
+	PetscReal pendingTime;
+
+	//! The writer of the text files of the observables.
+	xolotlCore::TextFileWriter writer;
+
+public:
+	/**
+	 * The constructor.
+	 */
+	MonitorSweep() :
+			request(MPI_REQUEST_NULL), pendingTimestep(0), pendingTime(0.0) {
+	}
+
+	/**
+	 * Wait for the pending reduction and let each observable use its sums,
+	 * doing nothing if there is none. It is called by the monitors needing
+	 * what the observables computed at the previous time step, like the
+	 * checkpoints, and has to be called by every process.
+	 *
+	 * @return The PETSc error code
+	 */
+	PetscErrorCode complete(void);
+
+	/**
+	 * Add an observable to the sweep.
+	 *
+	 * @param observable The observable
+	 * @param schedule When it is computed
+	 */
+	void add(std::unique_ptr<SweepObservable> observable,
+			const MonitorSchedule& schedule = MonitorSchedule()) {
+		observables.push_back(std::move(observable));
+		schedules.push_back(schedule);
+	}
+
+	/**
+	 * Whether the sweep has any observable.
+	 *
+	 * @return True if it has none
+	 */
+	bool empty() const {
+		return observables.empty();
+	}
+
+	/**
+	 * Run the sweep on the solution of the current time step, after
+	 * completing the one of the previous sweep.
+	 *
+	 * @param ts The time stepper
+	 * @param timestep The time step number
+	 * @param time The current time
+	 * @param solution The solution
+	 * @return The PETSc error code
+	 */
+	PetscErrorCode run(TS ts, PetscInt timestep, PetscReal time,
+			Vec solution);
+};
+
+/**
+ * Complete the pending reduction of the sweep, returning its error if
+ * any, and destroy the sweep once the solver is done. It has to be called
+ * by every process. It is meant to be given to TSMonitorSet as the
+ * monitor context destroy function.
+ *
+ * @param ctx The address of the sweep.
+ * @return The PETSc error code.
+ */
+PetscErrorCode destroyMonitorSweep(void **ctx);
+
+} // namespace xolotlSolver
+
+#endif // XSOLVER_MONITORSWEEP_H
@@ -2,6 +2,7 @@
 #include <PetscSolver1DHandler.h>
 #include <MathUtils.h>
 #include <Constants.h>
+#include <algorithm>
 
 namespace xcore = xolotlCore;
 
@@ -16,21 +17,6 @@ void PetscSolver1DHandler::createSolverContext(DM &da) {
 	// Degrees of freedom is the total number of clusters in the network
 	const int dof = network.getDOF();
 
-	/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-	 Create distributed array (DMDA) to manage parallel grid and vectors
-	 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
-
-	ierr = DMDACreate1d(PETSC_COMM_WORLD, DM_BOUNDARY_MIRROR, nX, dof, 1,
-	NULL, &da);
-	checkPetscError(ierr, "PetscSolver1DHandler::createSolverContext: "
-			"DMDACreate1d failed.");
-	ierr = DMSetFromOptions(da);
-	checkPetscError(ierr,
-			"PetscSolver1DHandler::createSolverContext: DMSetFromOptions failed.");
-	ierr = DMSetUp(da);
-	checkPetscError(ierr,
-			"PetscSolver1DHandler::createSolverContext: DMSetUp failed.");
-
 	// Set the position of the surface
 	surfacePosition = 0;
 	if (movingSurface)
@@ -53,6 +39,101 @@ void PetscSolver1DHandler::createSolverContext(DM &da) {
 		}
 	}
 
+	// Adapt the grid to the solution we are restarting from
+	if (not networkName.empty() and adaptiveGrid) {
+
+		xolotlCore::XFile xfile(networkName);
+		auto concGroup =
+				xfile.getGroup<xolotlCore::XFile::ConcentrationGroup>();
+		auto headerGroup = xfile.getGroup<xolotlCore::XFile::HeaderGroup>();
+		if (concGroup and concGroup->hasTimesteps() and headerGroup) {
+			// The solution was computed on the grid saved in the file
+			auto fileGrid = headerGroup->readXGrid();
+			int procId, nProcs;
+			MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+			MPI_Comm_size(PETSC_COMM_WORLD, &nProcs);
+			if (fileGrid.empty()) {
+				// Older files do not give the last step of the grid
+				if (procId == 0) {
+					std::cerr << "PetscSolver1DHandler: the grid of "
+							<< networkName << " is not saved with its "
+							"boundaries, it is not adapted." << std::endl;
+				}
+			} else if (fileGrid.size() != grid.size()) {
+				throw std::string(
+						"PetscSolver1DHandler::createSolverContext: the grid "
+								"of " + networkName + " has "
+								+ std::to_string(fileGrid.size() - 2)
+								+ " points instead of " + std::to_string(nX)
+								+ ", it cannot be adapted.");
+			} else {
+				grid = fileGrid;
+
+				// Each process reads a block of the grid points
+				auto tsGroup = concGroup->getLastTimestepGroup();
+				assert(tsGroup);
+				std::vector<int> counts(nProcs), displs(nProcs);
+				for (int p = 0; p < nProcs; p++) {
+					displs[p] = (p * nX) / nProcs;
+					counts[p] = ((p + 1) * nX) / nProcs - displs[p];
+				}
+				auto myConcs = tsGroup->readConcentrations(xfile,
+						displs[procId], counts[procId]);
+
+				// Compute the helium, vacancy, and interstitial content at
+				// each of these grid points
+				std::vector<double> myProfile(counts[procId], 0.0);
+				std::vector<double> gridPointConcs(dof, 0.0);
+				for (int i = 0; i < counts[procId]; i++) {
+					std::fill(gridPointConcs.begin(), gridPointConcs.end(),
+							0.0);
+					for (auto const& currConcData : myConcs[i]) {
+						gridPointConcs[currConcData.first] =
+								currConcData.second;
+					}
+					network.updateConcentrationsFromArray(
+							gridPointConcs.data());
+					myProfile[i] = network.getTotalAtomConcentration()
+							+ network.getTotalVConcentration()
+							+ network.getTotalIConcentration();
+				}
+
+				// Share the whole profile
+				std::vector<double> profile(nX, 0.0);
+				MPI_Allgatherv(myProfile.data(), counts[procId], MPI_DOUBLE,
+						profile.data(), counts.data(), displs.data(),
+						MPI_DOUBLE, PETSC_COMM_WORLD);
+
+				// Move the grid points
+				adaptGrid(profile, surfacePosition);
+			}
+		}
+	}
+
+	/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	 Create distributed array (DMDA) to manage parallel grid and vectors
+	 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+	// Split the grid depending on the cost of each point if asked
+	std::vector<PetscInt> lx;
+	if (BalanceGrid()) {
+		int nProcs;
+		MPI_Comm_size(PETSC_COMM_WORLD, &nProcs);
+		lx = ComputeOwnershipRanges(computeXCost( { surfacePosition }),
+				nProcs);
+	}
+
+	ierr = DMDACreate1d(PETSC_COMM_WORLD, DM_BOUNDARY_MIRROR, nX, dof, 1,
+			lx.empty() ? NULL : lx.data(), &da);
+	checkPetscError(ierr, "PetscSolver1DHandler::createSolverContext: "
+			"DMDACreate1d failed.");
+	ierr = DMSetFromOptions(da);
+	checkPetscError(ierr,
+			"PetscSolver1DHandler::createSolverContext: DMSetFromOptions failed.");
+	ierr = DMSetUp(da);
+	checkPetscError(ierr,
+			"PetscSolver1DHandler::createSolverContext: DMSetUp failed.");
+
 	// Initialize the surface of the first advection handler corresponding to the
 	// advection toward the surface (or a dummy one if it is deactivated)
 	advectionHandlers[0]->setLocation(grid[surfacePosition + 1] - grid[1]);
@@ -214,7 +295,10 @@ void PetscSolver1DHandler::initializeConcentration(DM &da, Vec &C) {
 		assert(concGroup);
 		auto tsGroup = concGroup->getLastTimestepGroup();
 		assert(tsGroup);
-		auto myConcs = tsGroup->readConcentrations(*xfile, xs, xm);
+		auto myConcs =
+				previousGrid.empty() ?
+						tsGroup->readConcentrations(*xfile, xs, xm) :
+						remapConcentrations(*xfile, *tsGroup, xs, xm);
 
 		// Apply the concentrations we just read.
 		for (auto i = 0; i < xm; ++i) {
@@ -223,8 +307,9 @@ void PetscSolver1DHandler::initializeConcentration(DM &da, Vec &C) {
 			for (auto const& currConcData : myConcs[i]) {
 				concOffset[currConcData.first] = currConcData.second;
 			}
-			// Set the temperature in the network
-			double temp = myConcs[i][myConcs[i].size() - 1].second;
+			// Set the temperature in the network, the one of the file if it
+			// has it (the last value), the initial one otherwise
+			double temp = concOffset[dof - 1];
 			network.setTemperature(temp, i);
 			// Update the modified trap-mutation rate
 			// that depends on the network reaction rates
@@ -246,6 +331,59 @@ void PetscSolver1DHandler::initializeConcentration(DM &da, Vec &C) {
 	return;
 }
 
+xolotlCore::XFile::TimestepGroup::Concs1DType PetscSolver1DHandler::remapConcentrations(
+		const xolotlCore::XFile& xfile,
+		const xolotlCore::XFile::TimestepGroup& tsGroup, int xs,
+		int xm) const {
+	// Degrees of freedom is the total number of clusters in the network
+	const int dof = network.getDOF();
+
+	// Only read the previous cells overlapping our cells, the cell of the
+	// grid point xi going from grid[xi] to grid[xi + 1]
+	int firstPrevious = std::upper_bound(previousGrid.begin(),
+			previousGrid.end(), grid[xs]) - previousGrid.begin() - 1;
+	firstPrevious = std::max(firstPrevious, 0);
+	int lastPrevious = firstPrevious + 1;
+	while (lastPrevious < nX && previousGrid[lastPrevious] < grid[xs + xm])
+		lastPrevious++;
+	auto previousConcs = tsGroup.readConcentrations(xfile, firstPrevious,
+			lastPrevious - firstPrevious);
+
+	xolotlCore::XFile::TimestepGroup::Concs1DType myConcs(xm);
+	std::vector<double> gridPointConcs(dof, 0.0);
+	for (int i = 0; i < xm; i++) {
+		int xi = xs + i;
+		double left = grid[xi], right = grid[xi + 1];
+
+		// Find the first previous cell overlapping this one
+		int j = std::upper_bound(previousGrid.begin(), previousGrid.end(), left)
+				- previousGrid.begin() - 1;
+		j = std::max(j, firstPrevious);
+
+		// Add the contribution of each overlapping previous cell
+		std::fill(gridPointConcs.begin(), gridPointConcs.end(), 0.0);
+		for (; j < lastPrevious && previousGrid[j] < right; j++) {
+			double overlap = std::min(right, previousGrid[j + 1])
+					- std::max(left, previousGrid[j]);
+			if (overlap <= 0.0)
+				continue;
+			double fraction = overlap / (right - left);
+			for (auto const& currConcData : previousConcs[j - firstPrevious]) {
+				gridPointConcs[currConcData.first] += currConcData.second
+						* fraction;
+			}
+		}
+
+		// Keep the non-zero values
+		for (int n = 0; n < dof; n++) {
+			if (std::fabs(gridPointConcs[n]) > 1.0e-16)
+				myConcs[i].emplace_back(n, gridPointConcs[n]);
+		}
+	}
+
+	return myConcs;
+}
+
 void PetscSolver1DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 		PetscReal ftime) {
 	PetscErrorCode ierr;
@@ -15,6 +15,23 @@ private:
 	//! The position of the surface
 	int surfacePosition;
 
+	/**
+	 * Compute the concentrations of the local grid points from the ones
+	 * on the grid before adaptation, conserving the quantity of each
+	 * cluster over the grid.  Only the grid points of the restart file
+	 * overlapping the local ones are read.
+	 *
+	 * @param xfile The restart file
+	 * @param tsGroup The time step group to restart from
+	 * @param xs The first local grid point
+	 * @param xm The number of local grid points
+	 * @return The concentrations in the format of the restart file
+	 */
+	xolotlCore::XFile::TimestepGroup::Concs1DType remapConcentrations(
+			const xolotlCore::XFile& xfile,
+			const xolotlCore::XFile::TimestepGroup& tsGroup, int xs,
+			int xm) const;
+
 public:
 
 	/**
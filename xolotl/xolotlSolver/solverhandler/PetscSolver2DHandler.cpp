@@ -13,22 +13,6 @@ void PetscSolver2DHandler::createSolverContext(DM &da) {
 	// Degrees of freedom is the total number of clusters in the network
 	const int dof = network.getDOF();
 
-	/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-	 Create distributed array (DMDA) to manage parallel grid and vectors
-	 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
-
-	ierr = DMDACreate2d(PETSC_COMM_WORLD, DM_BOUNDARY_MIRROR,
-			DM_BOUNDARY_PERIODIC, DMDA_STENCIL_STAR, nX, nY, PETSC_DECIDE,
-			PETSC_DECIDE, dof, 1, NULL, NULL, &da);
-	checkPetscError(ierr, "PetscSolver2DHandler::createSolverContext: "
-			"DMDACreate2d failed.");
-	ierr = DMSetFromOptions(da);
-	checkPetscError(ierr,
-			"PetscSolver2DHandler::createSolverContext: DMSetFromOptions failed.");
-	ierr = DMSetUp(da);
-	checkPetscError(ierr,
-			"PetscSolver2DHandler::createSolverContext: DMSetUp failed.");
-
 	// Set the position of the surface
 	for (int j = 0; j < nY; j++) {
 		surfacePosition.push_back(0);
@@ -59,6 +43,57 @@ void PetscSolver2DHandler::createSolverContext(DM &da) {
 		}
 	}
 
+	/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	 Create distributed array (DMDA) to manage parallel grid and vectors
+	 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+	ierr = DMDACreate2d(PETSC_COMM_WORLD, DM_BOUNDARY_MIRROR,
+			DM_BOUNDARY_PERIODIC, DMDA_STENCIL_STAR, nX, nY, PETSC_DECIDE,
+			PETSC_DECIDE, dof, 1, NULL, NULL, &da);
+	checkPetscError(ierr, "PetscSolver2DHandler::createSolverContext: "
+			"DMDACreate2d failed.");
+	ierr = DMSetFromOptions(da);
+	checkPetscError(ierr,
+			"PetscSolver2DHandler::createSolverContext: DMSetFromOptions failed.");
+	ierr = DMSetUp(da);
+	checkPetscError(ierr,
+			"PetscSolver2DHandler::createSolverContext: DMSetUp failed.");
+
+	// Split the grid in the x direction depending on the cost of each
+	// point if asked, keeping the process layout chosen by PETSc
+	if (BalanceGrid()) {
+		PetscInt m, n;
+		// Get the number of processes in each direction
+		ierr = DMDAGetInfo(da, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
+				PETSC_IGNORE, &m, &n, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
+				PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE);
+		checkPetscError(ierr, "PetscSolver2DHandler::createSolverContext: "
+				"DMDAGetInfo failed.");
+		// Keep the split in the other directions
+		const PetscInt *ly;
+		ierr = DMDAGetOwnershipRanges(da, NULL, &ly, NULL);
+		checkPetscError(ierr, "PetscSolver2DHandler::createSolverContext: "
+				"DMDAGetOwnershipRanges failed.");
+		std::vector<PetscInt> lyVec(ly, ly + n);
+		// Balance the x direction
+		auto lx = ComputeOwnershipRanges(computeXCost(surfacePosition), m);
+		// Create the DMDA again with the new split
+		ierr = DMDestroy(&da);
+		checkPetscError(ierr, "PetscSolver2DHandler::createSolverContext: "
+				"DMDestroy failed.");
+		ierr = DMDACreate2d(PETSC_COMM_WORLD, DM_BOUNDARY_MIRROR,
+				DM_BOUNDARY_PERIODIC, DMDA_STENCIL_STAR, nX, nY, m, n, dof, 1,
+				lx.data(), lyVec.data(), &da);
+		checkPetscError(ierr, "PetscSolver2DHandler::createSolverContext: "
+				"DMDACreate2d failed.");
+		ierr = DMSetFromOptions(da);
+		checkPetscError(ierr, "PetscSolver2DHandler::createSolverContext: "
+				"DMSetFromOptions failed.");
+		ierr = DMSetUp(da);
+		checkPetscError(ierr, "PetscSolver2DHandler::createSolverContext: "
+				"DMSetUp failed.");
+	}
+
 	// Prints the grid on one process
 	int procId;
 	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
@@ -222,28 +257,26 @@ void PetscSolver2DHandler::initializeConcentration(DM &da, Vec &C) {
 		auto tsGroup = concGroup->getLastTimestepGroup();
 		assert(tsGroup);
 
-		// Loop on the full grid
-		for (PetscInt j = 0; j < nY; j++) {
-			for (PetscInt i = 0; i < nX; i++) {
-				// Read the concentrations from the HDF5 file
-				auto concVector = tsGroup->readGridPoint(i, j);
-
-				// Change the concentration only if we are on the locally owned part of the grid
-				if (i >= xs && i < xs + xm && j >= ys && j < ys + ym) {
-					concOffset = concentrations[j][i];
-					// Loop on the concVector size
-					for (unsigned int l = 0; l < concVector.size(); l++) {
-						concOffset[(int) concVector.at(l).at(0)] =
-								concVector.at(l).at(1);
-					}
-					// Set the temperature in the network
-					double temp = concVector.at(concVector.size() - 1).at(1);
-					network.setTemperature(temp, i - xs);
-					// Update the modified trap-mutation rate
-					// that depends on the network reaction rates
-					mutationHandler->updateTrapMutationRate(network);
-					lastTemperature[i - xs] = temp;
+		// Read the concentrations from the HDF5 file for
+		// each of our grid points.
+		auto myConcs = tsGroup->readConcentrations(*xfile, xs, ys, xm, ym);
+
+		// Apply the concentrations we just read.
+		for (PetscInt j = 0; j < ym; j++) {
+			for (PetscInt i = 0; i < xm; i++) {
+				concOffset = concentrations[ys + j][xs + i];
+				auto const& pointConcs = myConcs[j * xm + i];
+				for (auto const& currConcData : pointConcs) {
+					concOffset[currConcData.first] = currConcData.second;
 				}
+				// Set the temperature in the network, the one of the file if it
+				// has it (the last value), the initial one otherwise
+				double temp = concOffset[dof - 1];
+				network.setTemperature(temp, i);
+				// Update the modified trap-mutation rate
+				// that depends on the network reaction rates
+				mutationHandler->updateTrapMutationRate(network);
+				lastTemperature[i] = temp;
 			}
 		}
 	}
@@ -13,23 +13,6 @@ void PetscSolver3DHandler::createSolverContext(DM &da) {
 	// Degrees of freedom is the total number of clusters in the network
 	const int dof = network.getDOF();
 
-	/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-	 Create distributed array (DMDA) to manage parallel grid and vectors
-	 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
-
-	ierr = DMDACreate3d(PETSC_COMM_WORLD, DM_BOUNDARY_MIRROR,
-			DM_BOUNDARY_PERIODIC, DM_BOUNDARY_PERIODIC, DMDA_STENCIL_STAR, nX,
-			nY, nZ, PETSC_DECIDE, PETSC_DECIDE, PETSC_DECIDE, dof, 1, NULL,
-			NULL, NULL, &da);
-	checkPetscError(ierr, "PetscSolver3DHandler::createSolverContext: "
-			"DMDACreate3d failed.");
-	ierr = DMSetFromOptions(da);
-	checkPetscError(ierr,
-			"PetscSolver3DHandler::createSolverContext: DMSetFromOptions failed.");
-	ierr = DMSetUp(da);
-	checkPetscError(ierr,
-			"PetscSolver3DHandler::createSolverContext: DMSetUp failed.");
-
 	// Set the position of the surface
 	// Loop on Y
 	for (int j = 0; j < nY; j++) {
@@ -74,6 +57,64 @@ void PetscSolver3DHandler::createSolverContext(DM &da) {
 		}
 	}
 
+	/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	 Create distributed array (DMDA) to manage parallel grid and vectors
+	 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+	ierr = DMDACreate3d(PETSC_COMM_WORLD, DM_BOUNDARY_MIRROR,
+			DM_BOUNDARY_PERIODIC, DM_BOUNDARY_PERIODIC, DMDA_STENCIL_STAR, nX,
+			nY, nZ, PETSC_DECIDE, PETSC_DECIDE, PETSC_DECIDE, dof, 1, NULL,
+			NULL, NULL, &da);
+	checkPetscError(ierr, "PetscSolver3DHandler::createSolverContext: "
+			"DMDACreate3d failed.");
+	ierr = DMSetFromOptions(da);
+	checkPetscError(ierr,
+			"PetscSolver3DHandler::createSolverContext: DMSetFromOptions failed.");
+	ierr = DMSetUp(da);
+	checkPetscError(ierr,
+			"PetscSolver3DHandler::createSolverContext: DMSetUp failed.");
+
+	// Split the grid in the x direction depending on the cost of each
+	// point if asked, keeping the process layout chosen by PETSc
+	if (BalanceGrid()) {
+		PetscInt m, n, p;
+		// Get the number of processes in each direction
+		ierr = DMDAGetInfo(da, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
+				PETSC_IGNORE, &m, &n, &p, PETSC_IGNORE, PETSC_IGNORE,
+				PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE);
+		checkPetscError(ierr, "PetscSolver3DHandler::createSolverContext: "
+				"DMDAGetInfo failed.");
+		// Keep the split in the other directions
+		const PetscInt *ly, *lz;
+		ierr = DMDAGetOwnershipRanges(da, NULL, &ly, &lz);
+		checkPetscError(ierr, "PetscSolver3DHandler::createSolverContext: "
+				"DMDAGetOwnershipRanges failed.");
+		std::vector<PetscInt> lyVec(ly, ly + n), lzVec(lz, lz + p);
+		// Balance the x direction
+		std::vector<int> surfaces;
+		for (auto const& surfaceRow : surfacePosition) {
+			surfaces.insert(surfaces.end(), surfaceRow.begin(),
+					surfaceRow.end());
+		}
+		auto lx = ComputeOwnershipRanges(computeXCost(surfaces), m);
+		// Create the DMDA again with the new split
+		ierr = DMDestroy(&da);
+		checkPetscError(ierr, "PetscSolver3DHandler::createSolverContext: "
+				"DMDestroy failed.");
+		ierr = DMDACreate3d(PETSC_COMM_WORLD, DM_BOUNDARY_MIRROR,
+				DM_BOUNDARY_PERIODIC, DM_BOUNDARY_PERIODIC, DMDA_STENCIL_STAR,
+				nX, nY, nZ, m, n, p, dof, 1, lx.data(), lyVec.data(),
+				lzVec.data(), &da);
+		checkPetscError(ierr, "PetscSolver3DHandler::createSolverContext: "
+				"DMDACreate3d failed.");
+		ierr = DMSetFromOptions(da);
+		checkPetscError(ierr, "PetscSolver3DHandler::createSolverContext: "
+				"DMSetFromOptions failed.");
+		ierr = DMSetUp(da);
+		checkPetscError(ierr, "PetscSolver3DHandler::createSolverContext: "
+				"DMSetUp failed.");
+	}
+
 	// Initialize the surface of the first advection handler corresponding to the
 	// advection toward the surface (or a dummy one if it is deactivated)
 	advectionHandlers[0]->setLocation(
@@ -243,32 +284,28 @@ void PetscSolver3DHandler::initializeConcentration(DM &da, Vec &C) {
 		auto tsGroup = concGroup->getLastTimestepGroup();
 		assert(tsGroup);
 
-		// Loop on the full grid
-		for (PetscInt k = 0; k < nZ; k++) {
-			for (PetscInt j = 0; j < nY; j++) {
-				for (PetscInt i = 0; i < nX; i++) {
-					// Read the concentrations from the HDF5 file
-					auto concVector = tsGroup->readGridPoint(i, j, k);
-
-					// Change the concentration only if we are on the locally
-					// owned part of the grid
-					if (i >= xs && i < xs + xm && j >= ys && j < ys + ym
-							&& k >= zs && k < zs + zm) {
-						concOffset = concentrations[k][j][i];
-						// Loop on the concVector size
-						for (unsigned int l = 0; l < concVector.size(); l++) {
-							concOffset[(int) concVector.at(l).at(0)] =
-									concVector.at(l).at(1);
-						}
-						// Set the temperature in the network
-						double temp = concVector.at(concVector.size() - 1).at(
-								1);
-						network.setTemperature(temp, i - xs);
-						// Update the modified trap-mutation rate
-						// that depends on the network reaction rates
-						mutationHandler->updateTrapMutationRate(network);
-						lastTemperature[i - xs] = temp;
+		// Read the concentrations from the HDF5 file for
+		// each of our grid points.
+		auto myConcs = tsGroup->readConcentrations(*xfile, xs, ys, zs, xm, ym,
+				zm);
+
+		// Apply the concentrations we just read.
+		for (PetscInt k = 0; k < zm; k++) {
+			for (PetscInt j = 0; j < ym; j++) {
+				for (PetscInt i = 0; i < xm; i++) {
+					concOffset = concentrations[zs + k][ys + j][xs + i];
+					auto const& pointConcs = myConcs[(k * ym + j) * xm + i];
+					for (auto const& currConcData : pointConcs) {
+						concOffset[currConcData.first] = currConcData.second;
 					}
+					// Set the temperature in the network, the one of the file if it
+					// has it (the last value), the initial one otherwise
+					double temp = concOffset[dof - 1];
+					network.setTemperature(temp, i);
+					// Update the modified trap-mutation rate
+					// that depends on the network reaction rates
+					mutationHandler->updateTrapMutationRate(network);
+					lastTemperature[i] = temp;
 				}
 			}
 		}
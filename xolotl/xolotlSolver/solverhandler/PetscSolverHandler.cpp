@@ -39,4 +39,72 @@ std::vector<PetscInt> PetscSolverHandler::ConvertToPetscSparseFillMap(
 	return ret;
 }
 
+std::vector<double> PetscSolverHandler::computeXCost(
+		const std::vector<int>& surfaces) const {
+	// Relative cost of a point that is not solved for, it still has
+	// to be communicated and filled
+	constexpr double inactiveCost = 0.05;
+
+	std::vector<double> cost(nX, 0.0);
+	for (auto surfacePos : surfaces) {
+		for (int xi = 0; xi < nX; xi++) {
+			// Same test as the one skipping the points in updateConcentration
+			if (xi < surfacePos + leftOffset || xi > nX - 1 - rightOffset)
+				cost[xi] += inactiveCost;
+			else
+				cost[xi] += 1.0;
+		}
+	}
+
+	return cost;
+}
+
+std::vector<PetscInt> PetscSolverHandler::ComputeOwnershipRanges(
+		const std::vector<double>& cost, int nParts) {
+	int nPoints = cost.size();
+	if (nParts > nPoints)
+		throw std::string(
+				"PetscSolverHandler Exception: there are more processes "
+						"than grid points to split.");
+
+	// Get the total cost
+	double totalCost = 0.0;
+	for (auto c : cost) {
+		totalCost += c;
+	}
+
+	// Move the boundary between two processes each time the cumulative
+	// cost reaches the next fraction of the total, while leaving at least
+	// one point to each process
+	std::vector<PetscInt> ranges(nParts, 0);
+	double cumulCost = 0.0;
+	int start = 0;
+	for (int p = 0; p < nParts - 1; p++) {
+		double target = totalCost * (double) (p + 1) / (double) nParts;
+		int end = start + 1;
+		cumulCost += cost[start];
+		// Leave enough points for the remaining processes
+		while (end < nPoints - (nParts - p - 1)
+				&& cumulCost + cost[end] / 2.0 < target) {
+			cumulCost += cost[end];
+			end++;
+		}
+		ranges[p] = end - start;
+		start = end;
+	}
+	ranges[nParts - 1] = nPoints - start;
+
+	return ranges;
+}
+
+bool PetscSolverHandler::BalanceGrid() {
+	PetscBool flag;
+	PetscErrorCode ierr = PetscOptionsHasName(NULL, NULL, "-balance_grid",
+			&flag);
+	checkPetscError(ierr, "PetscSolverHandler::BalanceGrid: "
+			"PetscOptionsHasName (-balance_grid) failed.");
+
+	return flag;
+}
+
 } // nmaespace xolotlSolver
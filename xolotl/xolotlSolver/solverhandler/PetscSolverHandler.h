@@ -97,6 +97,38 @@ protected:
 	static std::vector<PetscInt> ConvertToPetscSparseFillMap(size_t dof,
 			const xolotlCore::IReactionNetwork::SparseFillMap& fillMap);
 
+	/**
+	 * Compute the relative cost of each grid point in the x direction.
+	 * The points that are on the left of the surface or on the right
+	 * boundary are not solved for and are much cheaper than the others.
+	 *
+	 * @param surfaces The position of the surface for each (y, z) column
+	 * of the grid.
+	 * @return The cost of each grid point in the x direction.
+	 */
+	std::vector<double> computeXCost(const std::vector<int>& surfaces) const;
+
+	/**
+	 * Split the points of one direction of the grid between processes
+	 * so that each of them gets about the same total cost, in the format
+	 * of the lx, ly, lz arguments of DMDACreate.
+	 *
+	 * @param cost The cost of each grid point.
+	 * @param nParts The number of processes in this direction.
+	 * @return The number of grid points owned by each process.
+	 */
+	static std::vector<PetscInt> ComputeOwnershipRanges(
+			const std::vector<double>& cost, int nParts);
+
+	/**
+	 * Check the -balance_grid option, asking for the grid points in the
+	 * x direction to be split between processes depending on their cost
+	 * instead of uniformly.
+	 *
+	 * @return True if the option was given.
+	 */
+	static bool BalanceGrid();
+
 public:
 
 	/**
@@ -2,6 +2,7 @@
 #define SOLVERHANDLER_H
 
 // Includes
+#include <cmath>
 #include "ISolverHandler.h"
 #include "RandomNumberGenerator.h"
 #include "xolotlCore/io/XFile.h"
@@ -86,6 +87,12 @@ protected:
 	//! Which type of grid does the used want to use.
 	std::string useRegularGrid;
 
+	//! If the user wants to adapt the grid to the solution when restarting.
+	bool adaptiveGrid;
+
+	//! The grid in the x direction before it was adapted, empty if it wasn't.
+	std::vector<double> previousGrid;
+
 	//! If the user wants to move the surface.
 	bool movingSurface;
 
@@ -98,6 +105,12 @@ protected:
 	//! The depth parameter for the bubble bursting.
 	double tauBursting;
 
+	//! The compression of the concentrations in the checkpoint files.
+	xolotlCore::HDF5File::Compression checkpointCompression;
+
+	//! The compression of the concentrations in the analysis files.
+	xolotlCore::HDF5File::Compression analysisCompression;
+
 	//! The value to use to seed the random number generator.
 	unsigned int rngSeed;
 
@@ -290,6 +303,73 @@ protected:
 		return;
 	}
 
+	/**
+	 * Method moving the grid points in the x direction toward the places
+	 * where the given profile changes the most, keeping the same number of
+	 * points. The points up to the surface and the last ones are not moved.
+	 * The grid before adaptation is saved in previousGrid.
+	 *
+	 * The points are equidistributed in index space: each step of the
+	 * current grid gets a weight of one, plus up to gridAdaptationWeight
+	 * depending on how much the profile jumps over it, and the new points
+	 * split the total weight in equal parts. A profile without any jump
+	 * gives back the same grid.
+	 *
+	 * @param profile The value of the profile at each grid point
+	 * @param surfacePos The position of the surface on the grid
+	 */
+	void adaptGrid(const std::vector<double>& profile, int surfacePos) {
+		// How much more points can be put on the steepest parts
+		constexpr double gridAdaptationWeight = 4.0;
+
+		// Save the current grid
+		previousGrid = grid;
+
+		// The steps that can be modified are the ones between
+		// grid[first] and grid[last]
+		int first = surfacePos + 1, last = grid.size() - 2;
+		if (last - first < 2)
+			return;
+
+		// Get the profile jump over each step, step k is
+		// between the points k - 1 and k
+		std::vector<double> weights(last - first, 0.0);
+		double maxJump = 0.0;
+		for (int k = first; k < last; k++) {
+			weights[k - first] = std::fabs(profile[k] - profile[k - 1]);
+			maxJump = std::max(maxJump, weights[k - first]);
+		}
+
+		// Compute the cumulative weight
+		std::vector<double> cumulWeights(last - first + 1, 0.0);
+		for (int k = 0; k < weights.size(); k++) {
+			double weight = 1.0;
+			if (maxJump > 0.0)
+				weight += gridAdaptationWeight * weights[k] / maxJump;
+			cumulWeights[k + 1] = cumulWeights[k] + weight;
+		}
+
+		// Place the new points
+		double totalWeight = cumulWeights[weights.size()];
+		int k = 0;
+		for (int l = first + 1; l < last; l++) {
+			double target = totalWeight * (double) (l - first)
+					/ (double) (last - first);
+			// Find the step where the target weight is reached
+			while (cumulWeights[k + 1] < target)
+				k++;
+			// Interpolate in this step
+			double fraction = (target - cumulWeights[k])
+					/ (cumulWeights[k + 1] - cumulWeights[k]);
+			grid[l] = previousGrid[first + k]
+					+ fraction
+							* (previousGrid[first + k + 1]
+									- previousGrid[first + k]);
+		}
+
+		return;
+	}
+
 	/**
 	 * Constructor.
 	 *
@@ -300,7 +380,7 @@ protected:
 					0.0), hZ(0.0), leftOffset(1), rightOffset(1), bottomOffset(
 					1), topOffset(1), frontOffset(1), backOffset(1), initialVConc(
 					0.0), electronicStoppingPower(0.0), dimension(-1), portion(
-					0.0), useRegularGrid(""), movingSurface(false), bubbleBursting(
+					0.0), useRegularGrid(""), adaptiveGrid(false), movingSurface(false), bubbleBursting(
 					false), sputteringYield(0.0), fluxHandler(nullptr), temperatureHandler(
 					nullptr), diffusionHandler(nullptr), mutationHandler(
 					nullptr), resolutionHandler(nullptr), tauBursting(10.0), rngSeed(
@@ -414,6 +494,14 @@ public:
 		// Set the sputtering yield
 		tauBursting = options.getBurstingDepth();
 
+		// Set the compression of the checkpoint files
+		checkpointCompression.shuffle = options.useCheckpointShuffle();
+		checkpointCompression.deflateLevel = options.getCheckpointDeflateLevel();
+		// Only the analysis files can lose precision, the checkpoint
+		// files are restarted from
+		analysisCompression = checkpointCompression;
+		analysisCompression.lossyBits = options.getCheckpointLossyBits();
+
 		// Look at if the user wants to use a regular grid in the x direction
 		if (options.useRegularXGrid())
 			useRegularGrid = "regular";
@@ -421,6 +509,7 @@ public:
 			useRegularGrid = "NE";
 		else
 			useRegularGrid = "PSI";
+		adaptiveGrid = options.useAdaptiveXGrid();
 
 		// Set the boundary conditions (= 1: free surface; = 0: mirror or periodic)
 		leftOffset = options.getLeftBoundary();
@@ -517,6 +606,24 @@ public:
 		return tauBursting;
 	}
 
+	/**
+	 * Get the compression of the checkpoint files.
+	 * \see ISolverHandler.h
+	 */
+	const xolotlCore::HDF5File::Compression& getCheckpointCompression() const
+			override {
+		return checkpointCompression;
+	}
+
+	/**
+	 * Get the compression of the analysis files.
+	 * \see ISolverHandler.h
+	 */
+	const xolotlCore::HDF5File::Compression& getAnalysisCompression() const
+			override {
+		return analysisCompression;
+	}
+
 	/**
 	 * Get the grid left offset.
 	 * \see ISolverHandler.h
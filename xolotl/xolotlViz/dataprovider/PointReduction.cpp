@@ -0,0 +1,119 @@
+// Includes
+#include "PointReduction.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+
+namespace xolotlViz {
+
+namespace {
+
+/**
+ * The sums of the points falling in a bin.
+ */
+struct PointSum {
+	//! The number of points.
+	int n = 0;
+
+	//! Their sum, the time of the first one.
+	Point sum;
+
+	/**
+	 * Add a point.
+	 * @param p The point.
+	 */
+	void add(const Point& p) {
+		if (n == 0)
+			sum.t = p.t;
+		sum.x += p.x;
+		sum.y += p.y;
+		sum.z += p.z;
+		sum.value += p.value;
+		n++;
+	}
+
+	/**
+	 * Compute the average point.
+	 * @return The point.
+	 */
+	Point average() const {
+		Point p = sum;
+		p.x /= n;
+		p.y /= n;
+		p.z /= n;
+		p.value /= n;
+		return p;
+	}
+};
+
+} /* namespace */
+
+std::vector<Point> decimateMinMax(const std::vector<Point>& points,
+		int binSize) {
+	if (binSize <= 1)
+		return points;
+
+	std::vector<Point> reduced;
+	for (std::size_t first = 0; first < points.size(); first += binSize) {
+		std::size_t last = std::min(first + binSize, points.size());
+		// Find the smallest and largest values of the bin
+		std::size_t iMin = first, iMax = first;
+		for (std::size_t i = first + 1; i < last; i++) {
+			if (points[i].value < points[iMin].value)
+				iMin = i;
+			if (points[i].value > points[iMax].value)
+				iMax = i;
+		}
+		// Keep them in their order
+		reduced.push_back(points[std::min(iMin, iMax)]);
+		if (iMin != iMax)
+			reduced.push_back(points[std::max(iMin, iMax)]);
+	}
+
+	return reduced;
+}
+
+std::vector<Point> binLogX(const std::vector<Point>& points,
+		int binsPerDecade) {
+	if (binsPerDecade <= 0)
+		return points;
+
+	std::vector<Point> reduced;
+	std::map<long, PointSum> bins;
+	for (auto const& p : points) {
+		if (p.x <= 0.0) {
+			reduced.push_back(p);
+			continue;
+		}
+		// The small tolerance keeps the powers of ten in their own bin
+		long bin = std::floor(std::log10(p.x) * binsPerDecade + 1.0e-9);
+		bins[bin].add(p);
+	}
+	for (auto const& bin : bins) {
+		reduced.push_back(bin.second.average());
+	}
+
+	return reduced;
+}
+
+std::vector<Point> coarsenXY(const std::vector<Point>& points, int factor) {
+	if (factor <= 1)
+		return points;
+
+	std::map<std::pair<long, long>, PointSum> blocks;
+	for (auto const& p : points) {
+		// Row after row in y, as the points of the plots are
+		std::pair<long, long> block(std::floor(p.y / factor),
+				std::floor(p.x / factor));
+		blocks[block].add(p);
+	}
+	std::vector<Point> reduced;
+	for (auto const& block : blocks) {
+		reduced.push_back(block.second.average());
+	}
+
+	return reduced;
+}
+
+} /* namespace xolotlViz */
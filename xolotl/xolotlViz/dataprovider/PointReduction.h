@@ -0,0 +1,48 @@
+#ifndef POINTREDUCTION_H
+#define POINTREDUCTION_H
+
+// Includes
+#include "Point.h"
+#include <vector>
+
+namespace xolotlViz {
+
+/**
+ * Decimate a series of points, keeping from each bin of consecutive points
+ * the ones with the smallest and the largest value, in their original
+ * order, so that the peaks still show on the plot.
+ * @param points The points, in the order of their position.
+ * @param binSize The number of consecutive points of a bin, 1 or less to
+ * keep all of them.
+ * @return The decimated points, at most two per bin.
+ */
+std::vector<Point> decimateMinMax(const std::vector<Point>& points,
+		int binSize);
+
+/**
+ * Bin points on the logarithm of their x position (the cluster size),
+ * each bin giving a point at the average position and value of the points
+ * it contains.  The points with a position that is not positive are kept
+ * as they are.
+ * @param points The points.
+ * @param binsPerDecade The number of bins per decade of x, 0 or less to
+ * keep all the points.
+ * @return The binned points, sorted by position.
+ */
+std::vector<Point> binLogX(const std::vector<Point>& points,
+		int binsPerDecade);
+
+/**
+ * Coarsen points on a regular (x, y) grid, each block of factor x factor
+ * cells giving a point at the average position and value of the points it
+ * contains.
+ * @param points The points.
+ * @param factor The number of cells of a block in each direction, 1 or
+ * less to keep all the points.
+ * @return The coarsened points, sorted by block row after row in y.
+ */
+std::vector<Point> coarsenXY(const std::vector<Point>& points, int factor);
+
+} /* namespace xolotlViz */
+
+#endif